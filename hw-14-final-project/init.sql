@@ -7,12 +7,22 @@ CREATE TABLE IF NOT EXISTS rules (
     short_id VARCHAR(255) UNIQUE NOT NULL,
     target_url TEXT NOT NULL,
     condition TEXT NOT NULL,
-    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-    updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+    created_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    updated_at TIMESTAMP NOT NULL DEFAULT CURRENT_TIMESTAMP
 );
 
+-- Миграция таблиц, созданных без NOT NULL: строка с NULL в created_at
+-- выпадала из keyset-страниц, а курсор по ней не строился
+UPDATE rules SET created_at = COALESCE(updated_at, CURRENT_TIMESTAMP) WHERE created_at IS NULL;
+UPDATE rules SET updated_at = created_at WHERE updated_at IS NULL;
+ALTER TABLE rules ALTER COLUMN created_at SET NOT NULL;
+ALTER TABLE rules ALTER COLUMN updated_at SET NOT NULL;
+
 CREATE INDEX IF NOT EXISTS idx_rules_short_id ON rules(short_id);
 
+-- Индекс для keyset-пагинации списка правил (GET /rules?cursor=...)
+CREATE INDEX IF NOT EXISTS idx_rules_created_at_id ON rules(created_at DESC, id DESC);
+
 -- Вставляем тестовые правила
 INSERT INTO rules (short_id, target_url, condition) VALUES
 
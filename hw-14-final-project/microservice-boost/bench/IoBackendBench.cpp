@@ -0,0 +1,380 @@
+#include "BoostBeastApplication.hpp"
+#include "IoBackend.hpp"
+#include "IRequest.hpp"
+#include "IResponse.hpp"
+#include "PrerenderedResponse.hpp"
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @file IoBackendBench.cpp
+ * @brief Задержка и число системных вызовов сервера на запрос для epoll и io_uring
+ * @author Anton Tobolkin
+ *
+ * Запуск: io-backend-bench [одновременных клиентов] [запросов на клиента] [воркеров] [потоков клиента]
+ *
+ * Механизм задаётся сборкой, поэтому для сравнения бенчмарк собирается
+ * дважды: с -DUSE_IO_URING=OFF и с -DUSE_IO_URING=ON. Системные вызовы
+ * считаются по tracepoint raw_syscalls:sys_enter только для потоков
+ * сервера; без прав на perf_event_open (perf_event_paranoid, CAP_PERFMON)
+ * вместо числа выводится n/a.
+ */
+
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+namespace http = beast::http;
+using tcp = asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    /**
+     * @brief Тот же горячий путь, что у redirect-service: готовый 302
+     */
+    class RedirectHandler : public IHttpHandler
+    {
+    public:
+        void handle(IRequest&, IResponse& res) override
+        {
+            res.setPrerendered(response_);
+        }
+
+    private:
+        std::shared_ptr<const PrerenderedResponse> response_ =
+            PrerenderedResponse::redirect(302, "https://example.com/landing", {{"Cache-Control", "no-store"}});
+    };
+
+    class BenchApp : public BoostBeastApplication
+    {
+    public:
+        BenchApp(int port, int workers)
+        {
+            auto env = std::make_shared<Environment>();
+            env->setProperty("server.host", std::string("127.0.0.1"));
+            env->setProperty("server.port", port);
+            env->setProperty("server.workers", workers);
+            env->setProperty("server.io_backend", std::string(IoBackend::name(IoBackend::compiled())));
+            env_ = env;
+            handlers_[getHandlerKey("GET", "/r/promo")] = std::make_shared<RedirectHandler>();
+        }
+
+    protected:
+        void configureInjection() override {}
+    };
+
+    /**
+     * @brief Счётчик системных вызовов вызывающего потока и потоков, созданных им после
+     */
+    class SyscallCounter
+    {
+    public:
+        SyscallCounter()
+        {
+#ifdef __linux__
+            long id = tracepointId();
+            if (id < 0)
+            {
+                return;
+            }
+
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_TRACEPOINT;
+            attr.size = sizeof(attr);
+            attr.config = static_cast<std::uint64_t>(id);
+            attr.inherit = 1;
+            fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~SyscallCounter()
+        {
+#ifdef __linux__
+            if (fd_ >= 0)
+            {
+                close(fd_);
+            }
+#endif
+        }
+
+        SyscallCounter(const SyscallCounter&) = delete;
+        SyscallCounter& operator=(const SyscallCounter&) = delete;
+
+        bool available() const
+        {
+            return fd_ >= 0;
+        }
+
+        std::uint64_t read() const
+        {
+            std::uint64_t value = 0;
+#ifdef __linux__
+            if (fd_ >= 0 && ::read(fd_, &value, sizeof(value)) != sizeof(value))
+            {
+                value = 0;
+            }
+#endif
+            return value;
+        }
+
+    private:
+        int fd_ = -1;
+
+        static long tracepointId()
+        {
+            for (const char* path : {"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+                                     "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id"})
+            {
+                std::ifstream in(path);
+                long id = -1;
+                if (in >> id)
+                {
+                    return id;
+                }
+            }
+            return -1;
+        }
+    };
+
+    int findFreePort()
+    {
+        asio::io_context io;
+        tcp::acceptor probe(io, tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0));
+        return probe.local_endpoint().port();
+    }
+
+    /**
+     * @brief Клиент: соединение, запрос, ответ, закрытие - и так requests раз
+     *
+     * Сервер закрывает соединение после каждого ответа, поэтому
+     * в задержку входит и установка соединения.
+     */
+    class Client : public std::enable_shared_from_this<Client>
+    {
+    public:
+        Client(asio::io_context& io, const tcp::endpoint& endpoint, int requests)
+            : socket_(io), endpoint_(endpoint), remaining_(requests)
+        {
+            latencies.reserve(static_cast<std::size_t>(requests));
+            request_.method(http::verb::get);
+            request_.target("/r/promo");
+            request_.version(11);
+            request_.set(http::field::host, "127.0.0.1");
+        }
+
+        void sendNext()
+        {
+            if (remaining_-- == 0)
+            {
+                return;
+            }
+
+            sentAt_ = Clock::now();
+            socket_.async_connect(endpoint_, [self = shared_from_this()](beast::error_code ec) {
+                if (ec)
+                {
+                    self->fail();
+                    return;
+                }
+                http::async_write(self->socket_, self->request_, [self](beast::error_code writeEc, std::size_t) {
+                    if (writeEc)
+                    {
+                        self->fail();
+                        return;
+                    }
+                    self->onWritten();
+                });
+            });
+        }
+
+        std::vector<double> latencies;
+        int failed = 0;
+
+    private:
+        tcp::socket socket_;
+        tcp::endpoint endpoint_;
+        int remaining_;
+        http::request<http::empty_body> request_;
+        http::response<http::string_body> response_;
+        beast::flat_buffer buffer_;
+        Clock::time_point sentAt_;
+
+        void onWritten()
+        {
+            response_ = {};
+            buffer_.clear();
+            http::async_read(socket_, buffer_, response_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                if (ec)
+                {
+                    self->fail();
+                    return;
+                }
+                auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - self->sentAt_);
+                self->latencies.push_back(elapsed.count());
+                self->reconnect();
+            });
+        }
+
+        void fail()
+        {
+            ++failed;
+            reconnect();
+        }
+
+        void reconnect()
+        {
+            beast::error_code ec;
+            socket_.close(ec);
+            sendNext();
+        }
+    };
+
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0;
+        }
+        auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int connections = argc > 1 ? std::atoi(argv[1]) : 256;
+    int requests = argc > 2 ? std::atoi(argv[2]) : 200;
+    int workers = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / 2));
+    int clientThreads = argc > 4 ? std::atoi(argv[4]) : 2;
+    if (connections < 1 || requests < 1 || workers < 1 || clientThreads < 1)
+    {
+        std::cerr << "Usage: io-backend-bench [clients] [requests] [workers] [client threads]" << std::endl;
+        return 1;
+    }
+
+    // Сервер пишет в лог каждый запрос: это тоже write(2), который исказил бы счёт
+    auto* out = std::cout.rdbuf(nullptr);
+
+    int port = findFreePort();
+    BenchApp app(port, workers);
+    std::unique_ptr<SyscallCounter> counter;
+    std::atomic<bool> counterReady{false};
+
+    // Счётчик открывается в потоке сервера до start(), воркеры его наследуют
+    std::thread server([&] {
+        counter = std::make_unique<SyscallCounter>();
+        counterReady = true;
+        app.start();
+    });
+
+    while (!counterReady)
+    {
+        std::this_thread::yield();
+    }
+
+    asio::io_context client;
+    tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), static_cast<unsigned short>(port));
+    std::vector<std::shared_ptr<Client>> pool;
+    pool.reserve(static_cast<std::size_t>(connections));
+    for (int i = 0; i < connections; ++i)
+    {
+        pool.push_back(std::make_shared<Client>(client, endpoint, requests));
+    }
+
+    // Ждём, пока сервер начнёт принимать соединения
+    for (int attempt = 0;; ++attempt)
+    {
+        tcp::socket probe(client);
+        beast::error_code ec;
+        probe.connect(endpoint, ec);
+        if (!ec)
+        {
+            break;
+        }
+        if (attempt == 100)
+        {
+            std::cout.rdbuf(out);
+            std::cerr << "Server did not start: " << ec.message() << std::endl;
+            app.stop();
+            server.join();
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    std::uint64_t syscallsBefore = counter->read();
+    auto start = Clock::now();
+
+    for (auto& benchClient : pool)
+    {
+        benchClient->sendNext();
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i < clientThreads; ++i)
+    {
+        threads.emplace_back([&client] { client.run(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::uint64_t syscalls = counter->read() - syscallsBefore;
+
+    app.stop();
+    server.join();
+    std::cout.rdbuf(out);
+
+    std::vector<double> latencies;
+    int failed = 0;
+    for (const auto& benchClient : pool)
+    {
+        latencies.insert(latencies.end(), benchClient->latencies.begin(), benchClient->latencies.end());
+        failed += benchClient->failed;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto completed = latencies.size();
+
+    std::cout << "backend            " << IoBackend::name(IoBackend::compiled()) << std::endl;
+    std::cout << "connections        " << connections << std::endl;
+    std::cout << "workers            " << workers << std::endl;
+    std::cout << "requests           " << completed << " (" << failed << " failed)" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "requests/s         " << (elapsed > 0 ? static_cast<double>(completed) / elapsed : 0) << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "p50 latency, us    " << percentile(latencies, 0.50) << std::endl;
+    std::cout << "p99 latency, us    " << percentile(latencies, 0.99) << std::endl;
+    std::cout << "p99.9 latency, us  " << percentile(latencies, 0.999) << std::endl;
+    std::cout << std::setprecision(2);
+    if (counter->available() && completed > 0)
+    {
+        std::cout << "syscalls/request   "
+                  << static_cast<double>(syscalls) / static_cast<double>(completed) << std::endl;
+    }
+    else
+    {
+        std::cout << "syscalls/request   n/a (no perf_event_open access; try strace -c -f)" << std::endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
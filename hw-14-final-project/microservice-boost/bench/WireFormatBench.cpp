@@ -0,0 +1,117 @@
+#include "WireFormat.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file WireFormatBench.cpp
+ * @brief Размер и время кодирования ответов rule-service в JSON и MessagePack
+ * @author Anton Tobolkin
+ *
+ * Запуск: wire-format-bench [число правил] [повторов]
+ */
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+    json makeRule(int i)
+    {
+        return {
+            {"shortId", "promo-" + std::to_string(i)},
+            {"targetUrl", "https://example.com/landing/" + std::to_string(i) + "?utm_source=redirect"},
+            {"condition", "browser == \"Chrome\" AND country IN (\"RU\", \"KZ\") AND hour >= 9"},
+            {"version", std::to_string(1700000000000 + i)}
+        };
+    }
+
+    /**
+     * @brief Среднее время одного вызова fn в наносекундах
+     */
+    template <typename Fn>
+    double measure(int iterations, Fn&& fn)
+    {
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            fn();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start);
+        return elapsed.count() / iterations;
+    }
+
+    void report(const std::string& payload, WireFormat::Format format,
+                std::size_t bytes, double encodeNs, double decodeNs)
+    {
+        std::cout << std::left << std::setw(22) << payload
+                  << std::setw(10) << (format == WireFormat::Format::Json ? "json" : "msgpack")
+                  << std::right << std::setw(12) << bytes
+                  << std::setw(14) << std::fixed << std::setprecision(0) << encodeNs
+                  << std::setw(14) << decodeNs << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int ruleCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (ruleCount < 1 || iterations < 1)
+    {
+        std::cerr << "Usage: wire-format-bench [rules] [iterations]" << std::endl;
+        return 1;
+    }
+
+    std::vector<json> rules;
+    rules.reserve(ruleCount);
+    for (int i = 0; i < ruleCount; ++i)
+    {
+        rules.push_back(makeRule(i));
+    }
+
+    // Ответ POST /rules:batchGet на полный пакет
+    json batch = {{"rules", json::array()}, {"notModified", json::array()}};
+    for (int i = 0; i < 100 && i < ruleCount; ++i)
+    {
+        batch["rules"].push_back(rules[i]);
+    }
+
+    std::cout << std::left << std::setw(22) << "payload" << std::setw(10) << "format"
+              << std::right << std::setw(12) << "bytes" << std::setw(14) << "encode ns"
+              << std::setw(14) << "decode ns" << std::endl;
+
+    for (auto format : {WireFormat::Format::Json, WireFormat::Format::MessagePack})
+    {
+        // GET /rules/<id>: одно правило, время на вызов
+        std::string single = WireFormat::encode(rules[0], format);
+        double encodeNs = measure(iterations * 1000, [&] { WireFormat::encode(rules[0], format); });
+        double decodeNs = measure(iterations * 1000, [&] { WireFormat::decode(single, format); });
+        report("GET /rules/<id>", format, single.size(), encodeNs, decodeNs);
+
+        std::string batchBody = WireFormat::encode(batch, format);
+        encodeNs = measure(iterations * 10, [&] { WireFormat::encode(batch, format); });
+        decodeNs = measure(iterations * 10, [&] { WireFormat::decode(batchBody, format); });
+        report("POST /rules:batchGet", format, batchBody.size(), encodeNs, decodeNs);
+
+        // GET /rules/export: поток записей, время на всю выгрузку
+        std::string stream;
+        for (const auto& rule : rules)
+        {
+            WireFormat::appendRecord(stream, rule, format);
+        }
+        encodeNs = measure(iterations, [&] {
+            std::string out;
+            for (const auto& rule : rules)
+            {
+                WireFormat::appendRecord(out, rule, format);
+            }
+        });
+        decodeNs = measure(iterations, [&] { WireFormat::decodeRecords(stream, format); });
+        report("GET /rules/export", format, stream.size(), encodeNs, decodeNs);
+    }
+
+    return 0;
+}
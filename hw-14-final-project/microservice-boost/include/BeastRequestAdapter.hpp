@@ -4,6 +4,7 @@
 #include <boost/beast/http.hpp>
 #include <map>
 #include <string>
+#include <string_view>
 
 /**
  * @file BeastRequestAdapter.hpp
@@ -24,6 +25,13 @@ struct BeastRequestAdapter : IRequest
         return pos == std::string::npos ? target : target.substr(0, pos);
     }
 
+    std::string_view getPathView() const override
+    {
+        auto target = req_.target();
+        std::string_view view(target.data(), target.size());
+        return view.substr(0, view.find('?'));
+    }
+
     std::string getMethod() const override
     {
         return std::string(req_.method_string());
@@ -78,11 +86,28 @@ struct BeastRequestAdapter : IRequest
         return headers;
     }
     
+    std::string getHeader(const std::string& name) const override
+    {
+        auto it = req_.find(name);
+        return it == req_.end() ? std::string() : std::string(it->value());
+    }
+    
+    std::string_view getHeaderView(const std::string& name) const override
+    {
+        auto it = req_.find(name);
+        return it == req_.end() ? std::string_view() : std::string_view(it->value().data(), it->value().size());
+    }
+
     std::string getIp() const override
     {
         return ip_;
     }
 
+    std::string_view getIpView() const override
+    {
+        return ip_;
+    }
+
     int getPort() const override
     {
         return 80;
@@ -1,7 +1,9 @@
 #pragma once
 #include "IResponse.hpp"
 #include <boost/beast/http.hpp>
+#include <memory>
 #include <string>
+#include <utility>
 
 /**
  * @file BeastResponseAdapter.hpp
@@ -13,17 +15,67 @@ struct BeastResponseAdapter : IResponse {
         : res_(res) {}
 
     void setStatus(int code) override {
+        materialize();
         res_.result(boost::beast::http::status(code));
     }
 
     void setBody(const std::string& body) override {
+        materialize();
         res_.body() = body;
     }
 
     void setHeader(const std::string& name, const std::string& value) override {
+        materialize();
         res_.set(name, value);
     }
 
+    /**
+     * @brief Запомнить готовый ответ, сессия запишет его байты как есть
+     *
+     * Готовые байты - это HTTP/1.1, поэтому для других версий ответ
+     * сразу переносится в res_.
+     */
+    void setPrerendered(std::shared_ptr<const PrerenderedResponse> response) override {
+        prerendered_ = std::move(response);
+        if (res_.version() != 11) {
+            materialize();
+        }
+    }
+
+    /**
+     * @brief Забрать готовый ответ (nullptr, если ответ собран в res_)
+     */
+    std::shared_ptr<const PrerenderedResponse> takePrerendered() {
+        return std::exchange(prerendered_, nullptr);
+    }
+
+    /**
+     * @brief Запомнить генератор тела, сессия отправит его chunked-кодированием
+     */
+    void setChunkedBody(ChunkProducer producer) override {
+        chunkedBody_ = std::move(producer);
+    }
+
+    /**
+     * @brief Забрать генератор потокового тела (пустой, если тело обычное)
+     */
+    ChunkProducer takeChunkedBody() {
+        return std::exchange(chunkedBody_, nullptr);
+    }
+
 private:
+    /**
+     * @brief Перенести готовый ответ в res_, чтобы его можно было изменить
+     *
+     * Нужно, когда middleware дописывает заголовки после handler'а.
+     */
+    void materialize() {
+        if (auto response = std::exchange(prerendered_, nullptr)) {
+            IResponse::setPrerendered(std::move(response));
+        }
+    }
+
     boost::beast::http::response<boost::beast::http::string_body>& res_;
+    ChunkProducer chunkedBody_;
+    std::shared_ptr<const PrerenderedResponse> prerendered_;
 };
@@ -1,16 +1,32 @@
 #pragma once
 #include "IWebApplication.hpp"
+#include "AdmissionController.hpp"
 #include "IHttpHandler.hpp"
+#include "MiddlewareChain.hpp"
+#include "IResponse.hpp"
+#include "Environment.hpp"
+#include "ReloadableEnvironment.hpp"
+#include "ConfigWatcher.hpp"
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/http.hpp>
 #include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <map>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 class IRequest;
-class IResponse;
+struct BeastResponseAdapter;
 
 class BoostBeastApplication : public IWebApplication
 {
@@ -19,26 +35,160 @@ public:
     virtual ~BoostBeastApplication();
 
     void start() override;
+
+    /**
+     * @brief Плавная остановка
+     *
+     * Прекращает приём соединений; start() дожидается запросов в
+     * обработке (не дольше server.drain_timeout_ms) и только потом
+     * возвращает управление. Вызывается из любого потока, но не из
+     * обработчика сигнала: SIGINT и SIGTERM start() сам принимает через
+     * asio::signal_set и вызывает stop() в цикле io_context.
+     */
     void stop();
     void loadEnvironment(int argc, char* argv[]) override;
 
+    /**
+     * @brief Прочитать JSON-файл конфигурации в новый Environment
+     * @return nullptr, если файла нет
+     * @throws nlohmann::json::parse_error при ошибке разбора
+     */
+    static std::shared_ptr<Environment> readConfigFile(const std::string& path);
+
 protected:
     std::map<std::string, std::shared_ptr<IHttpHandler>> handlers_;
+
+    /// Тот же объект, что env_: подписка на перечитывание config.json
+    std::shared_ptr<ReloadableEnvironment> reloadableEnv_;
     
     std::shared_ptr<IHttpHandler> findHandler(const std::string& method, const std::string& path);
     std::string getHandlerKey(const std::string& method, const std::string& pattern) const;
 
+    /**
+     * @brief Добавить стадию, выполняемую до маршрутизации
+     *
+     * Стадии вызываются в порядке добавления; регистрировать их нужно
+     * в configureInjection(), до start().
+     */
+    void addMiddleware(std::shared_ptr<IHttpMiddleware> middleware);
+
+    /**
+     * @brief Вызывается при остановке, после закрытия приёма и до ожидания сессий
+     *
+     * Здесь будят обработчики, которые ждут событий (long-poll): иначе
+     * остановка ждала бы их таймаута.
+     */
+    virtual void onDrain() {}
+
 private:
+    /// Состояние принятого соединения
+    struct Session
+    {
+        boost::asio::ip::tcp::socket* socket = nullptr;
+        bool busy = false;  ///< Запрос прочитан и обрабатывается
+    };
+
+    class AsyncSession;
+    class Router;
+
+    /**
+     * @brief Ядро в режиме server.workers > 0
+     *
+     * Свой io_context, свой слушающий сокет (SO_REUSEPORT) и свои
+     * сессии: соединение принимается и обслуживается одним потоком.
+     */
+    struct Worker
+    {
+        std::unordered_set<AsyncSession*> sessions;  ///< Только из потока воркера
+        boost::asio::io_context io{1};
+        std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+        boost::asio::steady_timer acceptRetry{io};  ///< Пауза после ошибки accept
+        std::thread thread;
+    };
+
+    using ListenerFactory =
+        std::function<std::unique_ptr<boost::asio::ip::tcp::acceptor>(boost::asio::io_context&)>;
+
     std::unique_ptr<boost::asio::io_context> ioContext_;
     std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
-    bool running_;
+    std::unique_ptr<boost::asio::steady_timer> acceptRetry_;  ///< Пауза после ошибки accept
+    std::vector<std::unique_ptr<Worker>> workers_;
+    int runningWorkers_ = 0;  ///< Под sessionsMutex_
+    std::atomic<bool> running_;
+    std::atomic<bool> draining_;
+    std::chrono::milliseconds drainTimeout_;
+    std::unique_ptr<ConfigWatcher> configWatcher_;
 
-    void handleSession(boost::asio::ip::tcp::socket socket);
-    void loadJsonToEnvironment(const nlohmann::json& j, const std::string& prefix = "");
+    /// Лимиты соединений и запросов (создаётся в start())
+    std::unique_ptr<AdmissionController> admission_;
+    std::string overloadResponse_;  ///< Готовый ответ 503 для лишних соединений
+
+    /// Стадии до маршрутизации; router_ - последняя
+    MiddlewareChain middleware_;
+    std::unique_ptr<IHttpHandler> router_;
+
+    std::mutex sessionsMutex_;
+    std::condition_variable sessionsDone_;
+    std::map<std::uint64_t, Session> sessions_;
+    std::uint64_t nextSessionId_ = 0;
+
+    void acceptNext();
+
+    /**
+     * @brief Ответить 503 и закрыть соединение сверх server.admission.max_connections
+     */
+    void rejectConnection(boost::asio::ip::tcp::socket& socket);
+
+    /**
+     * @brief Запустить count воркеров, каждый со своим acceptor
+     * @param openListener Открывает слушающий сокет на io_context воркера
+     * @param pinning Закрепить поток воркера i за CPU i
+     */
+    void startWorkers(int count, bool pinning, const ListenerFactory& openListener);
+    void acceptOn(Worker& worker);
+
+    /**
+     * @brief Остановить приём на воркерах и дождаться их сессий
+     *
+     * Те же правила, что у drainSessions(): idle-соединения закрываются
+     * сразу, запросы в обработке получают drainTimeout_.
+     */
+    void drainWorkers();
+
+    /**
+     * @brief Дождаться завершения сессий после остановки приёма
+     *
+     * Соединения без запроса закрываются сразу, запросы в обработке
+     * получают drainTimeout_, оставшиеся по истечении срока
+     * принудительно закрываются. Потоки сессий используют приложение,
+     * поэтому метод возвращается только после завершения последней.
+     */
+    void drainSessions();
+    void beginSession(std::uint64_t id, boost::asio::ip::tcp::socket& socket);
+    void markBusy(std::uint64_t id);
+    void endSession(std::uint64_t id);
+
+    void handleSession(std::uint64_t id, boost::asio::ip::tcp::socket& socket);
+    static void loadJsonToEnvironment(const nlohmann::json& j, IEnvironment& target,
+                                      const std::string& prefix = "");
+    /**
+     * @brief Обработать запрос; потоковое или готовое тело сессия забирает из res
+     */
     void handleBeastRequest(
         const boost::beast::http::request<boost::beast::http::string_body>& req,
-        boost::beast::http::response<boost::beast::http::string_body>& res,
+        BeastResponseAdapter& res,
         const std::string& clientIp);
+    void writeChunkedResponse(
+        boost::asio::ip::tcp::socket& socket,
+        const boost::beast::http::response<boost::beast::http::string_body>& res,
+        const IResponse::ChunkProducer& producer);
     
     void handleRequest(IRequest& req, IResponse& res);
+
+    /**
+     * @brief Последняя стадия цепочки: допуск, поиск и вызов handler'а
+     *
+     * Исключения handler'а обрабатывает handleRequest().
+     */
+    void routeRequest(IRequest& req, IResponse& res);
 };
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Environment.hpp"
+#include "ReloadableEnvironment.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @file ConfigWatcher.hpp
+ * @brief Отслеживание изменений файла конфигурации
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ConfigWatcher
+ * @brief Перечитывает конфигурацию при изменении файла
+ *
+ * Раз в interval сравнивает время изменения файла с запомненным. Если файл
+ * изменился, загружает новый Environment и публикует его в
+ * ReloadableEnvironment. Файл с ошибкой не применяется - продолжает
+ * действовать прежняя конфигурация.
+ *
+ * Опрос вместо inotify выбран ради переносимости и работы с томами
+ * Docker/Kubernetes ConfigMap, где файл подменяется через symlink.
+ */
+class ConfigWatcher
+{
+public:
+    using Loader = std::function<std::shared_ptr<Environment>(const std::string& path)>;
+
+    /**
+     * @param path Путь к файлу конфигурации
+     * @param interval Период опроса
+     * @param loader Разбор файла в Environment, бросает исключение при ошибке
+     * @param env Куда публиковать новую конфигурацию
+     */
+    ConfigWatcher(std::string path,
+                  std::chrono::milliseconds interval,
+                  Loader loader,
+                  std::shared_ptr<ReloadableEnvironment> env);
+
+    ~ConfigWatcher();
+
+    /**
+     * @brief Проверить файл и перечитать, если он изменился
+     * @return true, если опубликована новая конфигурация
+     */
+    bool checkOnce();
+
+    void start();
+    void stop();
+
+private:
+    void run();
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    Loader loader_;
+    std::shared_ptr<ReloadableEnvironment> env_;
+
+    std::filesystem::file_time_type lastWrite_;
+
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
@@ -3,6 +3,10 @@
 #include "IHttpClient.hpp"
 #include <boost/asio.hpp>
 #include <boost/beast.hpp>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
 
 /**
  * @file HttpClient.hpp
@@ -12,6 +16,12 @@
 class HttpClient : public IHttpClient
 {
 public:
+    /**
+     * @param timeout Предельное время запроса целиком: соединение, запись
+     *        и чтение ответа (0 - без ограничения)
+     */
+    explicit HttpClient(std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
     /**
      * @brief Отправить HTTP запрос
      * @param request IRequest с методом, IP, портом, путём, телом и заголовками
@@ -19,4 +29,24 @@ public:
      * @return true если успешно, false в случае ошибки
      */
     bool send(const IRequest& request, IResponse& response) override;
+
+    /**
+     * @brief Прервать текущие запросы и отклонять новые
+     *
+     * Можно вызывать из любого потока: сокеты закрываются в потоках,
+     * которые ждут ответа, и их send() возвращает false.
+     */
+    void shutdown() override;
+
+private:
+    using Stream = std::shared_ptr<boost::beast::tcp_stream>;
+
+    const std::chrono::milliseconds timeout_;
+
+    std::mutex mutex_;
+    bool shutdown_ = false;
+    std::set<Stream> active_;   ///< Запросы, ждущие ответа
+
+    bool track(const Stream& stream);
+    void untrack(const Stream& stream);
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @file IoBackend.hpp
+ * @brief Механизм ввода-вывода Asio: epoll или io_uring
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class IoBackend
+ * @brief Выбор механизма ввода-вывода по server.io_backend
+ *
+ * Asio выбирает механизм при компиляции: io_uring для сокетов включается
+ * опцией CMake USE_IO_URING (нужна liburing). Настройка лишь сверяется
+ * со сборкой: запрошенный io_uring в сборке без него заменяется epoll
+ * с предупреждением, обратная подмена невозможна.
+ *
+ * Механизм влияет на асинхронные операции: приём соединений, сессии
+ * воркеров (server.workers > 0) и HttpClient, который соединяется,
+ * пишет и читает через async_* на io_context своего потока. Синхронные
+ * чтение и запись в режиме потока на соединение идут прямыми
+ * системными вызовами.
+ */
+class IoBackend
+{
+public:
+    enum class Kind
+    {
+        Epoll,
+        IoUring
+    };
+
+    /**
+     * @brief Разобрать значение server.io_backend ("epoll" или "io_uring")
+     * @throws std::invalid_argument для неизвестного значения
+     */
+    static Kind parse(const std::string& name);
+
+    static const char* name(Kind kind);
+
+    /**
+     * @brief Механизм, с которым собрана библиотека
+     */
+    static Kind compiled();
+
+    /**
+     * @brief Механизм, который будет работать при запрошенном в настройках
+     *
+     * Расхождение с compiled() пишется в лог.
+     */
+    static Kind resolve(Kind requested);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @file WireFormat.hpp
+ * @brief Кодирование тел запросов между сервисами: JSON или MessagePack
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class WireFormat
+ * @brief Выбор формата по Accept / Content-Type и кодирование json-значений
+ *
+ * JSON остаётся форматом по умолчанию: MessagePack выбирается, только
+ * если клиент явно попросил его в Accept. Потоки записей (экспорт)
+ * в JSON идут как NDJSON, в MessagePack каждая запись предваряется
+ * длиной в формате varint (LEB128).
+ */
+class WireFormat
+{
+public:
+    enum class Format
+    {
+        Json,
+        MessagePack
+    };
+
+    static constexpr const char* JSON_TYPE = "application/json";
+    static constexpr const char* NDJSON_TYPE = "application/x-ndjson";
+    static constexpr const char* MSGPACK_TYPE = "application/msgpack";
+
+    /**
+     * @brief Accept клиента, предпочитающего MessagePack: старый сервер ответит JSON
+     */
+    static constexpr const char* CLIENT_ACCEPT = "application/msgpack, application/json;q=0.5";
+
+    /**
+     * @brief Accept для предпочитаемого клиентом формата
+     */
+    static const char* accept(Format preferred);
+
+    /**
+     * @brief Формат ответа по заголовку Accept (учитывает q-параметры)
+     */
+    static Format negotiate(const std::string& accept);
+
+    /**
+     * @brief Формат тела по Content-Type (неизвестный тип считается JSON)
+     */
+    static Format fromContentType(const std::string& contentType);
+
+    /**
+     * @brief Content-Type для одиночного документа
+     */
+    static const char* contentType(Format format);
+
+    /**
+     * @brief Content-Type для потока записей
+     */
+    static const char* streamContentType(Format format);
+
+    static std::string encode(const nlohmann::json& value, Format format);
+
+    /**
+     * @throws nlohmann::json::exception если тело не разбирается
+     */
+    static nlohmann::json decode(const std::string& body, Format format);
+
+    /**
+     * @brief Дописать запись потока: строку NDJSON или varint-длину и MessagePack
+     */
+    static void appendRecord(std::string& out, const nlohmann::json& value, Format format);
+
+    /**
+     * @brief Разобрать поток записей
+     * @throws nlohmann::json::exception если запись обрезана или не разбирается
+     */
+    static std::vector<nlohmann::json> decodeRecords(const std::string& body, Format format);
+
+private:
+    static void appendVarint(std::string& out, std::size_t value);
+    static std::size_t readVarint(const std::string& in, std::size_t& pos);
+};
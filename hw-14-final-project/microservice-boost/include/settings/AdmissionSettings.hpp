@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "settings/IAdmissionSettings.hpp"
+#include "IEnvironment.hpp"
+
+/**
+ * @file AdmissionSettings.hpp
+ * @brief Реализация настроек допуска запросов (server.admission.*)
+ * @author Anton Tobolkin
+ */
+class AdmissionSettings : public IAdmissionSettings {
+public:
+    static constexpr int DEFAULT_RETRY_AFTER_S = 1;
+    static constexpr int DEFAULT_LATENCY_HALF_LIFE_MS = 1000;
+
+private:
+    int maxConnections_;
+    int maxInFlight_;
+    std::chrono::milliseconds latencyBudget_;
+    std::chrono::milliseconds latencyHalfLife_;
+    int retryAfterSeconds_;
+    std::vector<std::string> criticalRoutes_;
+    std::vector<std::string> lowPriorityRoutes_;
+    std::vector<std::string> untimedRoutes_;
+
+    // Маршруты перечисляются через запятую, как redirect_service.urls
+    static std::vector<std::string> parseRoutes(const std::string& routes) {
+        std::vector<std::string> result;
+        std::stringstream ss(routes);
+        std::string route;
+        while (std::getline(ss, route, ',')) {
+            route.erase(0, route.find_first_not_of(" \t"));
+            route.erase(route.find_last_not_of(" \t") + 1);
+            if (!route.empty()) {
+                result.push_back(route);
+            }
+        }
+        return result;
+    }
+
+public:
+    explicit AdmissionSettings(std::shared_ptr<IEnvironment> env) {
+        maxConnections_ = env->get<int>("server.admission.max_connections", 0);
+        maxInFlight_ = env->get<int>("server.admission.max_in_flight", 0);
+        latencyBudget_ = std::chrono::milliseconds(
+            env->get<int>("server.admission.latency_budget_ms", 0));
+        latencyHalfLife_ = std::chrono::milliseconds(std::max(1,
+            env->get<int>("server.admission.latency_half_life_ms", DEFAULT_LATENCY_HALF_LIFE_MS)));
+        retryAfterSeconds_ = env->get<int>("server.admission.retry_after_s", DEFAULT_RETRY_AFTER_S);
+        criticalRoutes_ = parseRoutes(env->get<std::string>("server.admission.critical_routes", ""));
+        lowPriorityRoutes_ = parseRoutes(env->get<std::string>("server.admission.low_priority_routes", ""));
+        untimedRoutes_ = parseRoutes(env->get<std::string>("server.admission.untimed_routes", ""));
+    }
+
+    int getMaxConnections() const override {
+        return maxConnections_;
+    }
+
+    int getMaxInFlight() const override {
+        return maxInFlight_;
+    }
+
+    std::chrono::milliseconds getLatencyBudget() const override {
+        return latencyBudget_;
+    }
+
+    std::chrono::milliseconds getLatencyHalfLife() const override {
+        return latencyHalfLife_;
+    }
+
+    int getRetryAfterSeconds() const override {
+        return retryAfterSeconds_;
+    }
+
+    std::vector<std::string> getCriticalRoutes() const override {
+        return criticalRoutes_;
+    }
+
+    std::vector<std::string> getLowPriorityRoutes() const override {
+        return lowPriorityRoutes_;
+    }
+
+    std::vector<std::string> getUntimedRoutes() const override {
+        return untimedRoutes_;
+    }
+};
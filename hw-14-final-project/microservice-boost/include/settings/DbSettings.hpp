@@ -1,6 +1,7 @@
 #pragma once
 #include "settings/IDbSettings.hpp"
 #include "IEnvironment.hpp"
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -29,6 +30,14 @@ public:
     std::string getName() const override;
     std::string getUser() const override;
     std::string getPassword() const override;
+    int getPoolSize() const override;
+    std::chrono::milliseconds getPoolValidationInterval() const override;
+
+    /// Размер пула, если db.pool_size не задан
+    static constexpr int DEFAULT_POOL_SIZE = 4;
+
+    /// Интервал проверки соединений, если db.pool_validation_interval_ms не задан
+    static constexpr int DEFAULT_POOL_VALIDATION_INTERVAL_MS = 5000;
 
 private:
     std::string host_;
@@ -36,4 +45,6 @@ private:
     std::string name_;
     std::string user_;
     std::string password_;
+    int poolSize_;
+    std::chrono::milliseconds poolValidationInterval_;
 };
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "settings/IRateLimitSettings.hpp"
+#include "IEnvironment.hpp"
+
+/**
+ * @file RateLimitSettings.hpp
+ * @brief Реализация настроек ограничения частоты запросов (rate_limit.*)
+ * @author Anton Tobolkin
+ */
+class RateLimitSettings : public IRateLimitSettings {
+public:
+    static constexpr std::size_t DEFAULT_MAX_CLIENTS = 100000;
+
+private:
+    std::vector<RateLimitRule> rules_;
+    std::size_t maxClients_;
+
+    static constexpr const char* HEADER_KEY_PREFIX = "header:";
+
+    /**
+     * Правило: "pattern rate burst [key]", где key - ip (по умолчанию)
+     * или header:<имя заголовка>. Некорректные правила пропускаются.
+     */
+    static bool parseRule(const std::string& text, RateLimitRule& rule) {
+        std::istringstream in(text);
+        std::string key = "ip";
+        if (!(in >> rule.pattern >> rule.ratePerSecond >> rule.burst)) {
+            return false;
+        }
+        in >> key;
+
+        if (rule.ratePerSecond <= 0 || rule.burst < 1) {
+            return false;
+        }
+        if (key == "ip") {
+            rule.keyHeader.clear();
+            return true;
+        }
+        if (key.rfind(HEADER_KEY_PREFIX, 0) == 0 && key.size() > std::string(HEADER_KEY_PREFIX).size()) {
+            rule.keyHeader = key.substr(std::string(HEADER_KEY_PREFIX).size());
+            return true;
+        }
+        return false;
+    }
+
+    // Правила перечисляются через запятую, как redirect_service.urls
+    static std::vector<RateLimitRule> parseRules(const std::string& rules) {
+        std::vector<RateLimitRule> result;
+        std::stringstream ss(rules);
+        std::string text;
+        while (std::getline(ss, text, ',')) {
+            text.erase(0, text.find_first_not_of(" \t"));
+            text.erase(text.find_last_not_of(" \t") + 1);
+            if (text.empty()) {
+                continue;
+            }
+
+            RateLimitRule rule;
+            if (parseRule(text, rule)) {
+                result.push_back(rule);
+            } else {
+                std::cerr << "[RateLimitSettings] Invalid rule skipped: " << text << std::endl;
+            }
+        }
+        return result;
+    }
+
+public:
+    explicit RateLimitSettings(std::shared_ptr<IEnvironment> env) {
+        rules_ = parseRules(env->get<std::string>("rate_limit.rules", ""));
+        int maxClients = env->get<int>("rate_limit.max_clients", static_cast<int>(DEFAULT_MAX_CLIENTS));
+        maxClients_ = maxClients > 0 ? static_cast<std::size_t>(maxClients) : DEFAULT_MAX_CLIENTS;
+    }
+
+    std::vector<RateLimitRule> getRules() const override {
+        return rules_;
+    }
+
+    std::size_t getMaxClients() const override {
+        return maxClients_;
+    }
+};
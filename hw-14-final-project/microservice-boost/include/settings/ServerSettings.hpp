@@ -1,18 +1,30 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <stdexcept>
+#include <thread>
 #include "settings/IServerSettings.hpp"
+#include "IoBackend.hpp"
 #include "IEnvironment.hpp"
 
 /**
  * @brief Реализация настроек сервера
  */
 class ServerSettings : public IServerSettings {
+public:
+    static constexpr int DEFAULT_DRAIN_TIMEOUT_MS = 10000;
+
 private:
     std::string host_;
     int port_;
+    std::chrono::milliseconds drainTimeout_{DEFAULT_DRAIN_TIMEOUT_MS};
+    bool reusePort_ = false;
+    int workers_ = 0;
+    bool cpuPinning_ = false;
+    IoBackend::Kind ioBackend_ = IoBackend::Kind::Epoll;
 
 public:
     explicit ServerSettings(std::shared_ptr<IEnvironment> env) {
@@ -27,6 +39,23 @@ public:
         } catch (...) {
             throw std::runtime_error("Missing required setting: server.port");
         }
+
+        drainTimeout_ = std::chrono::milliseconds(
+            env->get<int>("server.drain_timeout_ms", DEFAULT_DRAIN_TIMEOUT_MS));
+        reusePort_ = env->get<bool>("server.reuse_port", false);
+
+        // -1 - по числу ядер
+        workers_ = env->get<int>("server.workers", 0);
+        if (workers_ < 0) {
+            workers_ = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        cpuPinning_ = env->get<bool>("server.cpu_pinning", false);
+
+        try {
+            ioBackend_ = IoBackend::parse(env->get<std::string>("server.io_backend", "epoll"));
+        } catch (...) {
+            throw std::runtime_error("Invalid setting: server.io_backend (expected epoll or io_uring)");
+        }
     }
 
     std::string getHost() const override {
@@ -36,4 +65,27 @@ public:
     int getPort() const override {
         return port_;
     }
+
+    std::chrono::milliseconds getDrainTimeout() const override {
+        return drainTimeout_;
+    }
+
+    bool isReusePort() const override {
+        return reusePort_;
+    }
+
+    int getWorkers() const override {
+        return workers_;
+    }
+
+    bool isCpuPinning() const override {
+        return cpuPinning_;
+    }
+
+    /**
+     * @brief Запрошенный механизм ввода-вывода (фактический - IoBackend::resolve)
+     */
+    IoBackend::Kind getIoBackend() const {
+        return ioBackend_;
+    }
 };
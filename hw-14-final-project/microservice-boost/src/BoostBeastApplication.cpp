@@ -5,11 +5,31 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <algorithm>
+#include <array>
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <optional>
 #include <thread>
+#include <utility>
 #include "RouteMatcher.hpp"
 #include "settings/ServerSettings.hpp"
+#include "settings/AdmissionSettings.hpp"
+#include "IoBackend.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <unistd.h>
+#define BEAST_APP_HAS_POSIX_SOCKETS 1
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using json = nlohmann::json;
 
@@ -18,8 +38,246 @@ namespace http = beast::http;
 namespace asio = boost::asio;
 using tcp = asio::ip::tcp;
 
+namespace
+{
+    const std::string CONFIG_PATH = "config.json";
+
+    /// Сколько ждать сессии после принудительного закрытия их сокетов
+    constexpr std::chrono::seconds FORCE_CLOSE_GRACE{1};
+
+    /// Пауза перед повторным accept после ошибки (EMFILE/ENFILE не проходят сами)
+    constexpr std::chrono::milliseconds ACCEPT_RETRY_DELAY{50};
+
+    const std::string OVERLOAD_BODY = R"({"error": "Service overloaded"})";
+
+    std::string renderOverloadResponse(int retryAfterSeconds)
+    {
+        return "HTTP/1.1 503 Service Unavailable\r\n"
+               "Retry-After: " + std::to_string(retryAfterSeconds) + "\r\n"
+               "Content-Type: application/json\r\n"
+               "Content-Length: " + std::to_string(OVERLOAD_BODY.size()) + "\r\n"
+               "Connection: close\r\n\r\n" + OVERLOAD_BODY;
+    }
+
+    /// Заголовки сессии после готового ответа; завершают блок заголовков
+    const std::string PRERENDERED_TAIL_KEEP_ALIVE = "Server: BoostBeast\r\n\r\n";
+    const std::string PRERENDERED_TAIL_CLOSE = "Server: BoostBeast\r\nConnection: close\r\n\r\n";
+
+    /**
+     * @brief Буферы готового ответа для одной gather-записи в сокет
+     */
+    std::array<asio::const_buffer, 3> prerenderedBuffers(const PrerenderedResponse& response, bool keepAlive)
+    {
+        const std::string& tail = keepAlive ? PRERENDERED_TAIL_KEEP_ALIVE : PRERENDERED_TAIL_CLOSE;
+        return {asio::buffer(response.head()), asio::buffer(tail), asio::buffer(response.body())};
+    }
+
+    void closeSocket(tcp::socket* socket)
+    {
+        if (socket)
+        {
+            beast::error_code ec;
+            socket->shutdown(tcp::socket::shutdown_both, ec);
+        }
+    }
+
+    /// Слушающий сокет, переданный родительским процессом
+    struct InheritedSocket
+    {
+        tcp protocol;
+        int fd;
+    };
+
+    /**
+     * @brief Забрать сокет, переданный родительским процессом
+     *
+     * Соглашение socket activation: LISTEN_PID - pid получателя,
+     * LISTEN_FDS - число сокетов начиная с дескриптора 3.
+     */
+    std::optional<InheritedSocket> takeInheritedListenSocket()
+    {
+#ifdef BEAST_APP_HAS_POSIX_SOCKETS
+        const char* pid = std::getenv("LISTEN_PID");
+        const char* fds = std::getenv("LISTEN_FDS");
+        if (!pid || !fds || std::atol(pid) != static_cast<long>(::getpid()) || std::atoi(fds) < 1)
+        {
+            return std::nullopt;
+        }
+
+        // Дочерние процессы сокет не наследуют
+        ::unsetenv("LISTEN_PID");
+        ::unsetenv("LISTEN_FDS");
+
+        constexpr int LISTEN_FDS_START = 3;
+
+        sockaddr_storage address{};
+        socklen_t length = sizeof(address);
+        if (::getsockname(LISTEN_FDS_START, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+        {
+            std::cerr << "[Server] Inherited fd " << LISTEN_FDS_START << " is not a socket" << std::endl;
+            return std::nullopt;
+        }
+
+        return InheritedSocket{address.ss_family == AF_INET6 ? tcp::v6() : tcp::v4(), LISTEN_FDS_START};
+#else
+        return std::nullopt;
+#endif
+    }
+
+    /**
+     * @brief Открыть слушающий сокет
+     *
+     * Переданный родителем сокет используется как есть; иначе сокет
+     * создаётся заново, при reusePort - с SO_REUSEPORT, чтобы новая
+     * версия сервиса могла слушать порт, пока старая дорабатывает.
+     */
+    std::unique_ptr<tcp::acceptor> openAcceptor(asio::io_context& io,
+                                                const tcp::endpoint& endpoint,
+                                                bool reusePort,
+                                                const std::optional<InheritedSocket>& inherited)
+    {
+        auto acceptor = std::make_unique<tcp::acceptor>(io);
+
+        if (inherited)
+        {
+            acceptor->assign(inherited->protocol, inherited->fd);
+            std::cout << "[Server] Using inherited listening socket, fd=" << inherited->fd << std::endl;
+            return acceptor;
+        }
+
+        acceptor->open(endpoint.protocol());
+        acceptor->set_option(tcp::acceptor::reuse_address(true));
+
+        if (reusePort)
+        {
+#ifdef SO_REUSEPORT
+            using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+            acceptor->set_option(reuse_port(true));
+#else
+            std::cerr << "[Server] SO_REUSEPORT is not supported, option ignored" << std::endl;
+#endif
+        }
+
+        acceptor->bind(endpoint);
+        acceptor->listen(asio::socket_base::max_listen_connections);
+        return acceptor;
+    }
+
+    /// Второй дескриптор того же сокета: у каждого воркера свой acceptor
+    InheritedSocket duplicate(const InheritedSocket& socket)
+    {
+#ifdef BEAST_APP_HAS_POSIX_SOCKETS
+        int fd = ::dup(socket.fd);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Failed to duplicate inherited listening socket");
+        }
+        return InheritedSocket{socket.protocol, fd};
+#else
+        return socket;
+#endif
+    }
+
+    void pinToCpu(std::thread& thread, unsigned cpu)
+    {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        int rc = pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+        if (rc != 0)
+        {
+            std::cerr << "[Server] Failed to pin worker to CPU " << cpu << ", error " << rc << std::endl;
+        }
+#else
+        (void)thread;
+        std::cerr << "[Server] CPU pinning is not supported, CPU " << cpu << " ignored" << std::endl;
+#endif
+    }
+
+    /**
+     * @brief Ответ, который держит место в обработке до конца потокового тела
+     *
+     * Потоковое тело генерируется уже после возврата из handler'а, при записи
+     * ответа в сокет. Поэтому Ticket переезжает в генератор и освобождается
+     * вместе с ним, а не при выходе из routeRequest.
+     */
+    class AdmittedResponse : public IResponse
+    {
+    public:
+        AdmittedResponse(IResponse& inner, std::optional<AdmissionController::Ticket>& ticket)
+            : inner_(inner),
+              ticket_(ticket)
+        {
+        }
+
+        void setStatus(int code) override
+        {
+            inner_.setStatus(code);
+        }
+
+        void setBody(const std::string& body) override
+        {
+            inner_.setBody(body);
+        }
+
+        void setHeader(const std::string& name, const std::string& value) override
+        {
+            inner_.setHeader(name, value);
+        }
+
+        void setChunkedBody(ChunkProducer producer) override
+        {
+            if (!ticket_)
+            {
+                inner_.setChunkedBody(std::move(producer));
+                return;
+            }
+
+            // std::function требует копируемого захвата, Ticket только перемещается
+            auto held = std::make_shared<AdmissionController::Ticket>(std::move(*ticket_));
+            ticket_.reset();
+            inner_.setChunkedBody([held, producer = std::move(producer)](const ChunkWriter& write) {
+                producer(write);
+            });
+        }
+
+        void setPrerendered(std::shared_ptr<const PrerenderedResponse> response) override
+        {
+            inner_.setPrerendered(std::move(response));
+        }
+
+    private:
+        IResponse& inner_;
+        std::optional<AdmissionController::Ticket>& ticket_;
+    };
+}
+
+/**
+ * @brief Конечная стадия цепочки middleware - маршрутизация
+ */
+class BoostBeastApplication::Router : public IHttpHandler
+{
+public:
+    explicit Router(BoostBeastApplication& app)
+        : app_(app)
+    {
+    }
+
+    void handle(IRequest& req, IResponse& res) override
+    {
+        app_.routeRequest(req, res);
+    }
+
+private:
+    BoostBeastApplication& app_;
+};
+
 BoostBeastApplication::BoostBeastApplication()
-    : running_(false)
+    : running_(false),
+      draining_(false),
+      drainTimeout_(ServerSettings::DEFAULT_DRAIN_TIMEOUT_MS),
+      router_(std::make_unique<Router>(*this))
 {
     std::cout << "[App] BoostBeastApplication created" << std::endl;
 }
@@ -27,21 +285,20 @@ BoostBeastApplication::BoostBeastApplication()
 BoostBeastApplication::~BoostBeastApplication()
 {
     stop();
+    if (configWatcher_)
+    {
+        configWatcher_->stop();
+    }
     std::cout << "[App] BoostBeastApplication destroyed" << std::endl;
 }
 
 void BoostBeastApplication::stop()
 {
-    if (running_)
+    if (running_.exchange(false))
     {
         std::cout << "[App] Stopping application..." << std::endl;
-        running_ = false;
-        
-        if (acceptor_ && acceptor_->is_open())
-        {
-            acceptor_->close();
-        }
         
+        // Цикл приёма в start() завершится, дальше - ожидание сессий
         if (ioContext_)
         {
             ioContext_->stop();
@@ -58,25 +315,21 @@ void BoostBeastApplication::loadEnvironment(int argc, char* argv[])
     (void)argv;
     
     // Создаем окружение
-    env_ = std::make_shared<Environment>();
+    reloadableEnv_ = std::make_shared<ReloadableEnvironment>();
+    env_ = reloadableEnv_;
     
     // Пытаемся загрузить config.json
     try
     {
-        std::ifstream configFile("config.json");
+        auto config = readConfigFile(CONFIG_PATH);
         
-        if (!configFile.is_open())
+        if (!config)
         {
             std::cout << "[BoostBeastApplication] config.json not found" << std::endl;
             return;
         }
         
-        std::cout << "[BoostBeastApplication] Reading config.json..." << std::endl;
-        
-        json config = json::parse(configFile);
-        
-        // Рекурсивно загружаем весь JSON в Environment
-        loadJsonToEnvironment(config);
+        reloadableEnv_->publish(config);
         
         std::cout << "[BoostBeastApplication] Configuration loaded from config.json" << std::endl;
     }
@@ -90,9 +343,38 @@ void BoostBeastApplication::loadEnvironment(int argc, char* argv[])
         std::cerr << "[BoostBeastApplication] Error loading config: " << e.what() << std::endl;
         throw;
     }
+
+    // Перечитывание config.json на лету (0 - выключено)
+    int watchInterval = env_->get<int>("config.watch_interval_ms", 0);
+    if (watchInterval > 0)
+    {
+        configWatcher_ = std::make_unique<ConfigWatcher>(
+            CONFIG_PATH, std::chrono::milliseconds(watchInterval),
+            &BoostBeastApplication::readConfigFile, reloadableEnv_);
+        configWatcher_->start();
+    }
+}
+
+std::shared_ptr<Environment> BoostBeastApplication::readConfigFile(const std::string& path)
+{
+    std::ifstream configFile(path);
+    
+    if (!configFile.is_open())
+    {
+        return nullptr;
+    }
+    
+    std::cout << "[BoostBeastApplication] Reading " << path << "..." << std::endl;
+    
+    json config = json::parse(configFile);
+    
+    // Рекурсивно загружаем весь JSON в Environment
+    auto env = std::make_shared<Environment>();
+    loadJsonToEnvironment(config, *env);
+    return env;
 }
 
-void BoostBeastApplication::loadJsonToEnvironment(const json& j, const std::string& prefix)
+void BoostBeastApplication::loadJsonToEnvironment(const json& j, IEnvironment& target, const std::string& prefix)
 {
     for (auto it = j.begin(); it != j.end(); ++it)
     {
@@ -101,29 +383,29 @@ void BoostBeastApplication::loadJsonToEnvironment(const json& j, const std::stri
         if (it->is_object())
         {
             // Рекурсивно обрабатываем вложенные объекты
-            loadJsonToEnvironment(*it, key);
+            loadJsonToEnvironment(*it, target, key);
         }
         else if (it->is_string())
         {
             std::string value = it->get<std::string>();
             std::cout << "[BoostBeastApplication] Setting: " << key << " = " << value << std::endl;
-            env_->setProperty(key, value);
+            target.setProperty(key, value);
         }
         else if (it->is_number_integer())
         {
-            env_->setProperty(key, it->get<int>());
+            target.setProperty(key, it->get<int>());
         }
         else if (it->is_number_unsigned())
         {
-            env_->setProperty(key, static_cast<int>(it->get<unsigned int>()));
+            target.setProperty(key, static_cast<int>(it->get<unsigned int>()));
         }
         else if (it->is_boolean())
         {
-            env_->setProperty(key, it->get<bool>());
+            target.setProperty(key, it->get<bool>());
         }
         else if (it->is_number_float())
         {
-            env_->setProperty(key, it->get<double>());
+            target.setProperty(key, it->get<double>());
         }
         else if (it->is_array())
         {
@@ -145,9 +427,20 @@ void BoostBeastApplication::start()
         ServerSettings serverSettings(env_);
         std::string host = serverSettings.getHost();
         int port = serverSettings.getPort();
-        
+        drainTimeout_ = serverSettings.getDrainTimeout();
+        draining_ = false;
+
+        AdmissionSettings admissionSettings(env_);
+        admission_ = std::make_unique<AdmissionController>(admissionSettings);
+        overloadResponse_ = renderOverloadResponse(admission_->getRetryAfterSeconds());
+
         std::cout << "[App] Starting HTTP server..." << std::endl;
-        
+
+        // Механизм задан сборкой; при io_uring конструктор io_context бросит
+        // исключение, если ядро или seccomp его не разрешают
+        auto backend = IoBackend::resolve(serverSettings.getIoBackend());
+        std::cout << "[Server] I/O backend: " << IoBackend::name(backend) << std::endl;
+
         // Создаем IO контекст
         ioContext_ = std::make_unique<asio::io_context>();
 
@@ -155,36 +448,212 @@ void BoostBeastApplication::start()
         auto const address = asio::ip::make_address(host);
         tcp::endpoint endpoint{address, static_cast<unsigned short>(port)};
 
-        // Создаем acceptor
-        acceptor_ = std::make_unique<tcp::acceptor>(*ioContext_, endpoint);
+        auto inherited = takeInheritedListenSocket();
+        int workers = serverSettings.getWorkers();
+
+        if (workers > 0)
+        {
+            // Режим по ядрам: приём и обработка в потоках воркеров,
+            // ядро раздаёт соединения между сокетами SO_REUSEPORT
+            bool first = true;
+            startWorkers(workers, serverSettings.isCpuPinning(), [&](asio::io_context& io) {
+                auto socket = inherited;
+                if (socket && !std::exchange(first, false))
+                {
+                    socket = duplicate(*inherited);
+                }
+                return openAcceptor(io, endpoint, true, socket);
+            });
+        }
+        else
+        {
+            // Создаем acceptor
+            acceptor_ = openAcceptor(*ioContext_, endpoint, serverSettings.isReusePort(), inherited);
+            acceptRetry_ = std::make_unique<asio::steady_timer>(*ioContext_);
+        }
 
         std::cout << "[Server] Listening on " << host << ":" << port << std::endl;
         std::cout << "[Server] Server is ready to accept connections!" << std::endl;
 
         running_ = true;
 
-        // Accept loop
-        while (running_)
-        {
-            tcp::socket socket{*ioContext_};
-            acceptor_->accept(socket);
+        // Сигнал доставляется в цикл io_context: в самом обработчике
+        // сигнала нельзя ни писать в std::cout, ни останавливать сервер.
+        // После выхода из run() обработка снимается, и повторный Ctrl+C
+        // во время ожидания запросов завершает процесс сразу
+        asio::signal_set signals(*ioContext_, SIGINT, SIGTERM);
+        signals.async_wait([this](const beast::error_code& ec, int signal) {
+            if (!ec)
+            {
+                std::cout << "[Server] Received signal " << signal << ", stopping..." << std::endl;
+                stop();
+            }
+        });
 
-            std::cout << "[Server] New connection accepted" << std::endl;
-
-            std::thread([this](tcp::socket socket) {
-                handleSession(std::move(socket));
-            }, std::move(socket)).detach();
+        // Accept loop: работает до stop()
+        if (acceptor_)
+        {
+            acceptNext();
         }
+        auto guard = asio::make_work_guard(*ioContext_);
+        ioContext_->run();
     }
     catch (const std::exception& e)
     {
         std::cerr << "[Server] Error: " << e.what() << std::endl;
         running_ = false;
     }
+
+    // Новые соединения больше не принимаем, дорабатываем начатые
+    if (acceptor_)
+    {
+        beast::error_code ec;
+        acceptor_->close(ec);
+    }
+    onDrain();
+    drainSessions();
+    drainWorkers();
+}
+
+void BoostBeastApplication::acceptNext()
+{
+    acceptor_->async_accept([this](beast::error_code ec, tcp::socket socket) {
+        if (!running_)
+        {
+            return;
+        }
+
+        if (ec)
+        {
+            // Без паузы ошибка повторяется сразу же и цикл приёма крутит CPU
+            std::cerr << "[Server] Accept error: " << ec.message() << ", retrying in "
+                      << ACCEPT_RETRY_DELAY.count() << " ms" << std::endl;
+            acceptRetry_->expires_after(ACCEPT_RETRY_DELAY);
+            acceptRetry_->async_wait([this](beast::error_code waitEc) {
+                if (!waitEc && running_)
+                {
+                    acceptNext();
+                }
+            });
+            return;
+        }
+
+        if (!admission_->tryAcquireConnection())
+        {
+            rejectConnection(socket);
+        }
+        else
+        {
+            std::cout << "[Server] New connection accepted" << std::endl;
+
+            // Сессия учитывается до запуска потока, чтобы остановка её не пропустила
+            std::uint64_t id = 0;
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                id = nextSessionId_++;
+                sessions_.emplace(id, Session{});
+            }
+
+            auto session = std::make_unique<tcp::socket>(std::move(socket));
+            std::thread([this, id, session = std::move(session)]() mutable {
+                handleSession(id, *session);
+
+                // Сокет закрываем до endSession: после неё приложение
+                // вместе с io_context может быть уже уничтожено
+                session.reset();
+                admission_->releaseConnection();
+                endSession(id);
+            }).detach();
+        }
+
+        acceptNext();
+    });
+}
+
+void BoostBeastApplication::rejectConnection(tcp::socket& socket)
+{
+    std::cerr << "[Server] Connection limit reached, rejecting connection" << std::endl;
+
+    beast::error_code ec;
+    asio::write(socket, asio::buffer(overloadResponse_), ec);
+    socket.shutdown(tcp::socket::shutdown_send, ec);
+}
+
+void BoostBeastApplication::drainSessions()
+{
+    std::unique_lock<std::mutex> lock(sessionsMutex_);
+    draining_ = true;
+
+    if (sessions_.empty())
+    {
+        return;
+    }
+
+    std::cout << "[Server] Draining " << sessions_.size() << " connections..." << std::endl;
+
+    // Соединения, не приславшие запрос, ждать незачем
+    for (auto& entry : sessions_)
+    {
+        if (!entry.second.busy)
+        {
+            closeSocket(entry.second.socket);
+        }
+    }
+
+    if (!sessionsDone_.wait_for(lock, drainTimeout_, [this] { return sessions_.empty(); }))
+    {
+        std::cerr << "[Server] Drain timeout, closing " << sessions_.size()
+                  << " connections" << std::endl;
+
+        for (auto& entry : sessions_)
+        {
+            closeSocket(entry.second.socket);
+        }
+
+        // Закрытый сокет не прерывает обработчик: отсоединённый поток
+        // сессии нельзя бросить, он обращается к приложению до самого конца
+        if (!sessionsDone_.wait_for(lock, FORCE_CLOSE_GRACE, [this] { return sessions_.empty(); }))
+        {
+            std::cerr << "[Server] Waiting for " << sessions_.size()
+                      << " handlers to return" << std::endl;
+            sessionsDone_.wait(lock, [this] { return sessions_.empty(); });
+        }
+    }
+
+    std::cout << "[Server] Drain complete" << std::endl;
+}
+
+void BoostBeastApplication::beginSession(std::uint64_t id, tcp::socket& socket)
+{
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    sessions_[id].socket = &socket;
+
+    // Соединение принято перед самой остановкой
+    if (draining_)
+    {
+        closeSocket(&socket);
+    }
 }
 
-void BoostBeastApplication::handleSession(tcp::socket socket)
+void BoostBeastApplication::markBusy(std::uint64_t id)
 {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    sessions_[id].busy = true;
+}
+
+void BoostBeastApplication::endSession(std::uint64_t id)
+{
+    // Уведомление под блокировкой: сразу после неё drainSessions может
+    // вернуться, и приложение вместе с sessionsDone_ будет уничтожено
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    sessions_.erase(id);
+    sessionsDone_.notify_all();
+}
+
+void BoostBeastApplication::handleSession(std::uint64_t id, tcp::socket& socket)
+{
+    beginSession(id, socket);
+
     try
     {
         // Извлекаем IP клиента из сокета
@@ -205,6 +674,7 @@ void BoostBeastApplication::handleSession(tcp::socket socket)
         // Читаем HTTP запрос
         http::request<http::string_body> req;
         http::read(socket, buffer, req);
+        markBusy(id);
 
         std::cout << "[Session] Received request: " 
                   << req.method_string() << " " << req.target() << std::endl;
@@ -212,15 +682,29 @@ void BoostBeastApplication::handleSession(tcp::socket socket)
         // Создаем HTTP ответ
         http::response<http::string_body> res{http::status::ok, req.version()};
         res.set(http::field::server, "BoostBeast");
-        res.keep_alive(req.keep_alive());
+        res.keep_alive(req.keep_alive() && !draining_);
 
-        handleBeastRequest(req, res, clientIp);
+        BeastResponseAdapter response(res);
+        handleBeastRequest(req, response, clientIp);
 
-        // Отправляем ответ
-        http::write(socket, res);
+        // Отправляем ответ: готовый, потоковый (chunked) или обычный
+        int status = res.result_int();
+        if (auto prerendered = response.takePrerendered())
+        {
+            asio::write(socket, prerenderedBuffers(*prerendered, res.keep_alive()));
+            status = prerendered->status();
+        }
+        else if (auto chunkedBody = response.takeChunkedBody())
+        {
+            writeChunkedResponse(socket, res, chunkedBody);
+        }
+        else
+        {
+            http::write(socket, res);
+        }
 
         std::cout << "[Session] Response sent with status: " 
-                  << res.result_int() << std::endl;
+                  << status << std::endl;
 
         // Закрываем соединение
         beast::error_code ec;
@@ -245,52 +729,400 @@ void BoostBeastApplication::handleSession(tcp::socket socket)
     }
 }
 
-// метод создает адаптеры и вызывает виртуальный handleRequest
+/**
+ * @class BoostBeastApplication::AsyncSession
+ * @brief Соединение в режиме воркеров: чтение и запись без отдельного потока
+ *
+ * Живёт, пока на нём есть незавершённая асинхронная операция. Весь код
+ * сессии, включая handler, выполняется в потоке воркера-владельца.
+ */
+class BoostBeastApplication::AsyncSession : public std::enable_shared_from_this<AsyncSession>
+{
+public:
+    AsyncSession(BoostBeastApplication& app, Worker& worker, tcp::socket socket)
+        : app_(app), worker_(worker), socket_(std::move(socket))
+    {
+        worker_.sessions.insert(this);
+    }
+
+    ~AsyncSession()
+    {
+        worker_.sessions.erase(this);
+        app_.admission_->releaseConnection();
+    }
+
+    void start()
+    {
+        beast::error_code ec;
+        auto endpoint = socket_.remote_endpoint(ec);
+        clientIp_ = ec ? "0.0.0.0" : endpoint.address().to_string();
+
+        http::async_read(socket_, buffer_, req_,
+            [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                self->onRead(ec);
+            });
+    }
+
+    bool busy() const
+    {
+        return busy_;
+    }
+
+    void close()
+    {
+        closeSocket(&socket_);
+    }
+
+private:
+    void onRead(beast::error_code ec)
+    {
+        if (ec)
+        {
+            if (ec != http::error::end_of_stream && ec != asio::error::operation_aborted)
+            {
+                std::cerr << "[Session] Error: " << ec.message() << std::endl;
+            }
+            return;
+        }
+
+        busy_ = true;
+        std::cout << "[Session] Received request: "
+                  << req_.method_string() << " " << req_.target() << std::endl;
+
+        res_ = http::response<http::string_body>{http::status::ok, req_.version()};
+        res_.set(http::field::server, "BoostBeast");
+        res_.keep_alive(req_.keep_alive() && !app_.draining_);
+
+        try
+        {
+            BeastResponseAdapter response(res_);
+            app_.handleBeastRequest(req_, response, clientIp_);
+
+            // Готовый ответ живёт в prerendered_ до конца записи
+            prerendered_ = response.takePrerendered();
+            if (prerendered_)
+            {
+                asio::async_write(socket_, prerenderedBuffers(*prerendered_, res_.keep_alive()),
+                    [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                        self->onWrite(ec);
+                    });
+                return;
+            }
+
+            // Потоковое тело пишется синхронно: генератор сам вызывает запись
+            if (auto chunkedBody = response.takeChunkedBody())
+            {
+                app_.writeChunkedResponse(socket_, res_, chunkedBody);
+                finish();
+                return;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[Session] Unexpected error: " << e.what() << std::endl;
+            return;
+        }
+
+        http::async_write(socket_, res_,
+            [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                self->onWrite(ec);
+            });
+    }
+
+    void onWrite(beast::error_code ec)
+    {
+        if (ec)
+        {
+            std::cerr << "[Session] Write error: " << ec.message() << std::endl;
+            return;
+        }
+        finish();
+    }
+
+    void finish()
+    {
+        std::cout << "[Session] Response sent with status: "
+                  << (prerendered_ ? prerendered_->status() : res_.result_int()) << std::endl;
+
+        beast::error_code ec;
+        socket_.shutdown(tcp::socket::shutdown_send, ec);
+    }
+
+    BoostBeastApplication& app_;
+    Worker& worker_;
+    tcp::socket socket_;
+    beast::flat_buffer buffer_;
+    http::request<http::string_body> req_;
+    http::response<http::string_body> res_;
+    std::shared_ptr<const PrerenderedResponse> prerendered_;
+    std::string clientIp_;
+    bool busy_ = false;
+};
+
+void BoostBeastApplication::startWorkers(int count, bool pinning, const ListenerFactory& openListener)
+{
+#ifndef SO_REUSEPORT
+    if (count > 1)
+    {
+        std::cerr << "[Server] SO_REUSEPORT is not supported, starting 1 worker" << std::endl;
+        count = 1;
+    }
+#endif
+
+    unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->acceptor = openListener(worker->io);
+        acceptOn(*worker);
+
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            ++runningWorkers_;
+        }
+
+        // io_context воркера завершается сам, когда закрыт acceptor и нет сессий
+        worker->thread = std::thread([this, w = worker.get()] {
+            w->io.run();
+
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                --runningWorkers_;
+            }
+            sessionsDone_.notify_all();
+        });
+
+        if (pinning)
+        {
+            pinToCpu(worker->thread, static_cast<unsigned>(i) % cpus);
+        }
+
+        workers_.push_back(std::move(worker));
+    }
+
+    std::cout << "[Server] Started " << count << " workers"
+              << (pinning ? " pinned to CPUs" : "") << std::endl;
+}
+
+void BoostBeastApplication::acceptOn(Worker& worker)
+{
+    worker.acceptor->async_accept([this, &worker](beast::error_code ec, tcp::socket socket) {
+        if (ec == asio::error::operation_aborted || draining_)
+        {
+            return;
+        }
+
+        if (ec)
+        {
+            std::cerr << "[Server] Accept error: " << ec.message() << ", retrying in "
+                      << ACCEPT_RETRY_DELAY.count() << " ms" << std::endl;
+            worker.acceptRetry.expires_after(ACCEPT_RETRY_DELAY);
+            worker.acceptRetry.async_wait([this, &worker](beast::error_code waitEc) {
+                if (!waitEc && !draining_)
+                {
+                    acceptOn(worker);
+                }
+            });
+            return;
+        }
+
+        if (!admission_->tryAcquireConnection())
+        {
+            rejectConnection(socket);
+        }
+        else
+        {
+            std::make_shared<AsyncSession>(*this, worker, std::move(socket))->start();
+        }
+
+        acceptOn(worker);
+    });
+}
+
+void BoostBeastApplication::drainWorkers()
+{
+    if (workers_.empty())
+    {
+        return;
+    }
+
+    draining_ = true;
+    std::cout << "[Server] Draining " << workers_.size() << " workers..." << std::endl;
+
+    // Сессии принадлежат потокам воркеров - закрываем их там же
+    for (auto& worker : workers_)
+    {
+        asio::post(worker->io, [w = worker.get()] {
+            beast::error_code ec;
+            w->acceptor->close(ec);
+            w->acceptRetry.cancel();
+
+            for (auto* session : w->sessions)
+            {
+                if (!session->busy())
+                {
+                    session->close();
+                }
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(sessionsMutex_);
+    if (!sessionsDone_.wait_for(lock, drainTimeout_, [this] { return runningWorkers_ == 0; }))
+    {
+        std::cerr << "[Server] Drain timeout, closing worker connections" << std::endl;
+
+        for (auto& worker : workers_)
+        {
+            asio::post(worker->io, [w = worker.get()] {
+                for (auto* session : w->sessions)
+                {
+                    session->close();
+                }
+            });
+        }
+
+        if (!sessionsDone_.wait_for(lock, FORCE_CLOSE_GRACE, [this] { return runningWorkers_ == 0; }))
+        {
+            for (auto& worker : workers_)
+            {
+                worker->io.stop();
+            }
+        }
+    }
+    lock.unlock();
+
+    for (auto& worker : workers_)
+    {
+        worker->thread.join();
+    }
+    workers_.clear();
+
+    std::cout << "[Server] Workers stopped" << std::endl;
+}
+
+// метод создает адаптер запроса и вызывает виртуальный handleRequest
 void BoostBeastApplication::handleBeastRequest(
     const http::request<http::string_body>& req,
-    http::response<http::string_body>& res,
+    BeastResponseAdapter& res,
     const std::string& clientIp)
 {
-    // Создаем адаптеры
+    // Создаем адаптер запроса
     BeastRequestAdapter requestAdapter(req, clientIp);
-    BeastResponseAdapter responseAdapter(res);
-    
+
     // Вызываем виртуальный метод
-    handleRequest(requestAdapter, responseAdapter);
+    handleRequest(requestAdapter, res);
 }
 
-void BoostBeastApplication::handleRequest(IRequest& req, IResponse& res)
+void BoostBeastApplication::writeChunkedResponse(
+    tcp::socket& socket,
+    const http::response<http::string_body>& res,
+    const IResponse::ChunkProducer& producer)
 {
-    std::string path = req.getPath();
-    std::string method = req.getMethod();
-
-    std::cout << "[BoostBeastApplication] " << method << " " << path
-              << " from " << req.getIp() << std::endl;
+    // Копируем статус и заголовки, тело пойдёт кусками
+    http::response<http::empty_body> head{res.result(), res.version()};
+    for (const auto& field : res)
+    {
+        head.set(field.name_string(), field.value());
+    }
+    head.chunked(true);
 
-    auto handler = findHandler(method, path);
+    http::response_serializer<http::empty_body> serializer{head};
+    http::write_header(socket, serializer);
 
-    if (handler)
-    {
-        try
+    size_t chunks = 0;
+    producer([&socket, &chunks](const std::string& chunk) {
+        // Пустой chunk означает конец потока - пропускаем его
+        if (chunk.empty())
         {
-            handler->handle(req, res);
+            return true;
         }
-        catch (const std::exception& e)
+
+        beast::error_code ec;
+        asio::write(socket, http::make_chunk(asio::buffer(chunk)), ec);
+        if (ec)
         {
-            std::cerr << "[BoostBeastApplication] Handler error: " << e.what() << std::endl;
-            res.setStatus(500);
-            res.setHeader("Content-Type", "application/json");
-            res.setBody(R"({"error": "Internal server error"})");
+            std::cerr << "[Session] Chunk write error: " << ec.message() << std::endl;
+            return false;
         }
+
+        ++chunks;
+        return true;
+    });
+
+    // Завершающий chunk отправляется только если генератор отработал без исключений,
+    // иначе клиент увидит оборванный поток, а не "успешно" усечённые данные
+    asio::write(socket, http::make_chunk_last());
+
+    std::cout << "[Session] Chunked response sent: " << chunks << " chunks" << std::endl;
+}
+
+void BoostBeastApplication::addMiddleware(std::shared_ptr<IHttpMiddleware> middleware)
+{
+    middleware_.add(std::move(middleware));
+}
+
+void BoostBeastApplication::handleRequest(IRequest& req, IResponse& res)
+{
+    std::cout << "[BoostBeastApplication] " << req.getMethod() << " " << req.getPath()
+              << " from " << req.getIp() << std::endl;
+
+    try
+    {
+        middleware_.handle(req, res, *router_);
     }
-    else
+    catch (const std::exception& e)
+    {
+        std::cerr << "[BoostBeastApplication] Handler error: " << e.what() << std::endl;
+        res.setStatus(500);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Internal server error"})");
+    }
+}
+
+void BoostBeastApplication::routeRequest(IRequest& req, IResponse& res)
+{
+    std::string path = req.getPath();
+    std::string method = req.getMethod();
+
+    auto handler = findHandler(method, path);
+
+    if (!handler)
     {
         std::cout << "[BoostBeastApplication] No handler found" << std::endl;
 
         res.setStatus(404);
         res.setHeader("Content-Type", "application/json");
         res.setBody(R"({"error": "Not found"})");
+        return;
     }
+
+    // Под перегрузкой отвечаем сразу, не занимая handler
+    std::optional<AdmissionController::Ticket> ticket;
+    if (admission_)
+    {
+        ticket = admission_->admit(admission_->classify(path), admission_->isTimed(path));
+        if (!ticket)
+        {
+            std::cerr << "[BoostBeastApplication] Overloaded, shedding " << method << " " << path
+                      << " (in flight: " << admission_->inFlight() << ")" << std::endl;
+            res.setStatus(503);
+            res.setHeader("Retry-After", std::to_string(admission_->getRetryAfterSeconds()));
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(OVERLOAD_BODY);
+            return;
+        }
+    }
+
+    if (!ticket)
+    {
+        handler->handle(req, res);
+        return;
+    }
+
+    AdmittedResponse admitted(res, ticket);
+    handler->handle(req, admitted);
 }
 
 std::shared_ptr<IHttpHandler> BoostBeastApplication::findHandler(
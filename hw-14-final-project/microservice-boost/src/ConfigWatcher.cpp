@@ -0,0 +1,96 @@
+#include "ConfigWatcher.hpp"
+#include <iostream>
+
+/**
+ * @file ConfigWatcher.cpp
+ * @brief Реализация отслеживания файла конфигурации
+ * @author Anton Tobolkin
+ */
+
+namespace fs = std::filesystem;
+
+ConfigWatcher::ConfigWatcher(std::string path,
+                             std::chrono::milliseconds interval,
+                             Loader loader,
+                             std::shared_ptr<ReloadableEnvironment> env)
+    : path_(std::move(path)),
+      interval_(interval),
+      loader_(std::move(loader)),
+      env_(std::move(env))
+{
+    // Текущий файл уже загружен - отсчитываем изменения от него
+    std::error_code ec;
+    lastWrite_ = fs::last_write_time(path_, ec);
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    stop();
+}
+
+bool ConfigWatcher::checkOnce()
+{
+    std::error_code ec;
+    auto writeTime = fs::last_write_time(path_, ec);
+    if (ec || writeTime == lastWrite_)
+    {
+        return false;
+    }
+    lastWrite_ = writeTime;
+
+    try
+    {
+        auto config = loader_(path_);
+        if (!config)
+        {
+            return false;
+        }
+
+        env_->publish(config);
+        std::cout << "[ConfigWatcher] Configuration reloaded from " << path_ << std::endl;
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[ConfigWatcher] Keeping previous configuration, reload failed: "
+                  << e.what() << std::endl;
+        return false;
+    }
+}
+
+void ConfigWatcher::start()
+{
+    if (worker_.joinable())
+    {
+        return;
+    }
+
+    std::cout << "[ConfigWatcher] Watching " << path_ << " every "
+              << interval_.count() << "ms" << std::endl;
+    worker_ = std::thread(&ConfigWatcher::run, this);
+}
+
+void ConfigWatcher::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stopped_.notify_all();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+    }
+}
+
+void ConfigWatcher::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_.wait_for(lock, interval_, [this] { return stopping_; }))
+    {
+        lock.unlock();
+        checkOnce();
+        lock.lock();
+    }
+}
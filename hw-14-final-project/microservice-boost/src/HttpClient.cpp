@@ -6,6 +6,11 @@ namespace beast = boost::beast;
 namespace http = beast::http;
 namespace asio = boost::asio;
 
+HttpClient::HttpClient(std::chrono::milliseconds timeout)
+    : timeout_(timeout)
+{
+}
+
 bool HttpClient::send(const IRequest& request, IResponse& response)
 {
     try
@@ -15,13 +20,13 @@ bool HttpClient::send(const IRequest& request, IResponse& response)
         std::cout << "[HttpClient] Sending " << request.getMethod() 
                   << " " << request.getIp() << ":" << portStr << request.getPath() << std::endl;
 
-        asio::io_context ioc;
+        // io_context нужен на время одного запроса; один на поток,
+        // чтобы не создавать epoll/io_uring на запрос
+        static thread_local asio::io_context ioc;
+        ioc.restart();
         tcp::resolver resolver(ioc);
         auto results = resolver.resolve(request.getIp(), portStr);
 
-        beast::tcp_stream stream(ioc);
-        stream.connect(results);
-
         // Формируем HTTP запрос
         http::request<http::string_body> req;
         req.method(http::string_to_verb(request.getMethod()));
@@ -48,17 +53,49 @@ bool HttpClient::send(const IRequest& request, IResponse& response)
 
         req.prepare_payload();
 
-        // Отправляем запрос
-        http::write(stream, req);
+        auto stream = std::make_shared<beast::tcp_stream>(ioc);
+        if (!track(stream))
+        {
+            throw std::runtime_error("client is shut down");
+        }
+
+        // Асинхронные операции: у синхронных в Beast нет таймаута, и их
+        // нельзя безопасно прервать из другого потока
+        if (timeout_.count() > 0)
+        {
+            stream->expires_after(timeout_);
+        }
 
-        // Читаем ответ
         beast::flat_buffer buffer;
         http::response<http::string_body> res;
-        http::read(stream, buffer, res);
+        beast::error_code ec;
+        stream->async_connect(results, [&](beast::error_code connectEc, const tcp::endpoint&) {
+            if (connectEc)
+            {
+                ec = connectEc;
+                return;
+            }
+            http::async_write(*stream, req, [&](beast::error_code writeEc, std::size_t) {
+                if (writeEc)
+                {
+                    ec = writeEc;
+                    return;
+                }
+                http::async_read(*stream, buffer, res, [&](beast::error_code readEc, std::size_t) {
+                    ec = readEc;
+                });
+            });
+        });
+        ioc.run();
+        untrack(stream);
+
+        if (ec)
+        {
+            throw beast::system_error(ec);
+        }
 
         // Закрываем соединение
-        beast::error_code ec;
-        stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+        stream->socket().shutdown(tcp::socket::shutdown_both, ec);
 
         std::cout << "[HttpClient] Received status: " << res.result_int() << std::endl;
 
@@ -81,3 +118,34 @@ bool HttpClient::send(const IRequest& request, IResponse& response)
         return false;
     }
 }
+
+void HttpClient::shutdown()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+
+    // Закрытие выполняется в потоке запроса, внутри его ioc.run()
+    for (const auto& stream : active_)
+    {
+        asio::post(stream->get_executor(), [stream] {
+            stream->close();
+        });
+    }
+}
+
+bool HttpClient::track(const Stream& stream)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_)
+    {
+        return false;
+    }
+    active_.insert(stream);
+    return true;
+}
+
+void HttpClient::untrack(const Stream& stream)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    active_.erase(stream);
+}
@@ -0,0 +1,52 @@
+#include "IoBackend.hpp"
+#include <boost/asio/detail/config.hpp>
+#include <iostream>
+#include <stdexcept>
+
+IoBackend::Kind IoBackend::parse(const std::string& name)
+{
+    if (name == "epoll")
+    {
+        return Kind::Epoll;
+    }
+    if (name == "io_uring")
+    {
+        return Kind::IoUring;
+    }
+    throw std::invalid_argument("Unknown I/O backend: " + name);
+}
+
+const char* IoBackend::name(Kind kind)
+{
+    return kind == Kind::IoUring ? "io_uring" : "epoll";
+}
+
+IoBackend::Kind IoBackend::compiled()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    return Kind::IoUring;
+#else
+    return Kind::Epoll;
+#endif
+}
+
+IoBackend::Kind IoBackend::resolve(Kind requested)
+{
+    Kind actual = compiled();
+    if (requested == actual)
+    {
+        return actual;
+    }
+
+    if (requested == Kind::IoUring)
+    {
+        std::cerr << "[IoBackend] io_uring requested, but the build has no io_uring support "
+                  << "(cmake -DUSE_IO_URING=ON); falling back to epoll" << std::endl;
+    }
+    else
+    {
+        std::cerr << "[IoBackend] epoll requested, but the build uses io_uring for all sockets; "
+                  << "rebuild with -DUSE_IO_URING=OFF to switch back" << std::endl;
+    }
+    return actual;
+}
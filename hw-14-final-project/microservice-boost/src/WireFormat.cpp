@@ -0,0 +1,185 @@
+#include "WireFormat.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+    std::string trimLower(const std::string& value)
+    {
+        auto begin = value.find_first_not_of(" \t");
+        if (begin == std::string::npos)
+        {
+            return "";
+        }
+        auto end = value.find_last_not_of(" \t");
+        std::string result = value.substr(begin, end - begin + 1);
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        return result;
+    }
+
+    bool isMsgpackType(const std::string& mediaType)
+    {
+        return mediaType == "application/msgpack" ||
+               mediaType == "application/x-msgpack" ||
+               mediaType == "application/vnd.msgpack";
+    }
+}
+
+WireFormat::Format WireFormat::negotiate(const std::string& accept)
+{
+    double msgpackQ = 0;
+    double jsonQ = accept.empty() ? 1.0 : 0;
+
+    std::stringstream ranges(accept);
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        std::stringstream parts(range);
+        std::string mediaType;
+        std::getline(parts, mediaType, ';');
+        mediaType = trimLower(mediaType);
+
+        double q = 1.0;
+        std::string param;
+        while (std::getline(parts, param, ';'))
+        {
+            param = trimLower(param);
+            if (param.rfind("q=", 0) == 0)
+            {
+                q = std::strtod(param.c_str() + 2, nullptr);
+            }
+        }
+
+        if (isMsgpackType(mediaType))
+        {
+            msgpackQ = std::max(msgpackQ, q);
+        }
+        else
+        {
+            jsonQ = std::max(jsonQ, q);
+        }
+    }
+
+    // При равном весе предпочитаем более компактный формат
+    return msgpackQ > 0 && msgpackQ >= jsonQ ? Format::MessagePack : Format::Json;
+}
+
+WireFormat::Format WireFormat::fromContentType(const std::string& contentType)
+{
+    std::string mediaType = trimLower(contentType.substr(0, contentType.find(';')));
+    return isMsgpackType(mediaType) ? Format::MessagePack : Format::Json;
+}
+
+const char* WireFormat::accept(Format preferred)
+{
+    return preferred == Format::MessagePack ? CLIENT_ACCEPT : JSON_TYPE;
+}
+
+const char* WireFormat::contentType(Format format)
+{
+    return format == Format::MessagePack ? MSGPACK_TYPE : JSON_TYPE;
+}
+
+const char* WireFormat::streamContentType(Format format)
+{
+    return format == Format::MessagePack ? MSGPACK_TYPE : NDJSON_TYPE;
+}
+
+std::string WireFormat::encode(const nlohmann::json& value, Format format)
+{
+    if (format == Format::Json)
+    {
+        return value.dump();
+    }
+
+    std::string out;
+    nlohmann::json::to_msgpack(value, out);
+    return out;
+}
+
+nlohmann::json WireFormat::decode(const std::string& body, Format format)
+{
+    if (format == Format::Json)
+    {
+        return nlohmann::json::parse(body);
+    }
+    return nlohmann::json::from_msgpack(body);
+}
+
+void WireFormat::appendRecord(std::string& out, const nlohmann::json& value, Format format)
+{
+    if (format == Format::Json)
+    {
+        out += value.dump();
+        out += '\n';
+        return;
+    }
+
+    std::string record = encode(value, format);
+    appendVarint(out, record.size());
+    out += record;
+}
+
+std::vector<nlohmann::json> WireFormat::decodeRecords(const std::string& body, Format format)
+{
+    std::vector<nlohmann::json> records;
+
+    if (format == Format::Json)
+    {
+        std::stringstream lines(body);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            if (!line.empty())
+            {
+                records.push_back(nlohmann::json::parse(line));
+            }
+        }
+        return records;
+    }
+
+    std::size_t pos = 0;
+    while (pos < body.size())
+    {
+        std::size_t length = readVarint(body, pos);
+        if (length > body.size() - pos)
+        {
+            throw nlohmann::json::parse_error::create(110, pos, "truncated record", nullptr);
+        }
+        records.push_back(nlohmann::json::from_msgpack(body.begin() + pos, body.begin() + pos + length));
+        pos += length;
+    }
+    return records;
+}
+
+void WireFormat::appendVarint(std::string& out, std::size_t value)
+{
+    while (value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+std::size_t WireFormat::readVarint(const std::string& in, std::size_t& pos)
+{
+    std::size_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= in.size())
+        {
+            break;
+        }
+        auto byte = static_cast<unsigned char>(in[pos++]);
+        value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+    throw nlohmann::json::parse_error::create(110, pos, "truncated varint", nullptr);
+}
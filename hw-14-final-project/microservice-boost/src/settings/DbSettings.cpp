@@ -38,6 +38,20 @@ DbSettings::DbSettings(std::shared_ptr<IEnvironment> env)
     } catch (...) {
         throw std::runtime_error("Missing required setting: db.password");
     }
+
+    // Необязательный параметр
+    poolSize_ = env->get<int>("db.pool_size", DEFAULT_POOL_SIZE);
+    if (poolSize_ < 1)
+    {
+        throw std::runtime_error("Invalid setting: db.pool_size must be positive");
+    }
+
+    int validationInterval = env->get<int>("db.pool_validation_interval_ms", DEFAULT_POOL_VALIDATION_INTERVAL_MS);
+    if (validationInterval < 0)
+    {
+        throw std::runtime_error("Invalid setting: db.pool_validation_interval_ms must not be negative");
+    }
+    poolValidationInterval_ = std::chrono::milliseconds(validationInterval);
 }
 
 std::string DbSettings::getHost() const
@@ -63,4 +77,14 @@ std::string DbSettings::getUser() const
 std::string DbSettings::getPassword() const
 {
     return password_;
+}
+
+int DbSettings::getPoolSize() const
+{
+    return poolSize_;
+}
+
+std::chrono::milliseconds DbSettings::getPoolValidationInterval() const
+{
+    return poolValidationInterval_;
 }
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "settings/AdmissionSettings.hpp"
+#include "Environment.hpp"
+
+/**
+ * @file AdmissionSettingsTest.cpp
+ * @brief Unit-тесты для AdmissionSettings
+ */
+
+// По умолчанию лимитов нет
+TEST(AdmissionSettingsTest, DefaultsAreUnlimited)
+{
+    auto env = std::make_shared<Environment>();
+
+    AdmissionSettings settings(env);
+
+    EXPECT_EQ(settings.getMaxConnections(), 0);
+    EXPECT_EQ(settings.getMaxInFlight(), 0);
+    EXPECT_EQ(settings.getLatencyBudget(), std::chrono::milliseconds(0));
+    EXPECT_EQ(settings.getLatencyHalfLife(),
+              std::chrono::milliseconds(AdmissionSettings::DEFAULT_LATENCY_HALF_LIFE_MS));
+    EXPECT_EQ(settings.getRetryAfterSeconds(), AdmissionSettings::DEFAULT_RETRY_AFTER_S);
+    EXPECT_TRUE(settings.getCriticalRoutes().empty());
+    EXPECT_TRUE(settings.getLowPriorityRoutes().empty());
+    EXPECT_TRUE(settings.getUntimedRoutes().empty());
+}
+
+// Лимиты и списки маршрутов через запятую
+TEST(AdmissionSettingsTest, ReadsLimitsAndRoutes)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("server.admission.max_connections", 1000);
+    env->setProperty("server.admission.max_in_flight", 64);
+    env->setProperty("server.admission.latency_budget_ms", 50);
+    env->setProperty("server.admission.latency_half_life_ms", 200);
+    env->setProperty("server.admission.retry_after_s", 3);
+    env->setProperty("server.admission.critical_routes", std::string("/r/*"));
+    env->setProperty("server.admission.low_priority_routes", std::string("/cache/invalidate, /cache/invalidate/*,"));
+    env->setProperty("server.admission.untimed_routes", std::string("/rules/changes"));
+
+    AdmissionSettings settings(env);
+
+    EXPECT_EQ(settings.getMaxConnections(), 1000);
+    EXPECT_EQ(settings.getMaxInFlight(), 64);
+    EXPECT_EQ(settings.getLatencyBudget(), std::chrono::milliseconds(50));
+    EXPECT_EQ(settings.getLatencyHalfLife(), std::chrono::milliseconds(200));
+    EXPECT_EQ(settings.getRetryAfterSeconds(), 3);
+    EXPECT_EQ(settings.getCriticalRoutes(), std::vector<std::string>{"/r/*"});
+    EXPECT_EQ(settings.getLowPriorityRoutes(),
+              (std::vector<std::string>{"/cache/invalidate", "/cache/invalidate/*"}));
+    EXPECT_EQ(settings.getUntimedRoutes(), std::vector<std::string>{"/rules/changes"});
+}
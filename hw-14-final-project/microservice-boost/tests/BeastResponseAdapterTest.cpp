@@ -64,3 +64,78 @@ TEST(BeastResponseAdapterTest, Combined)
     EXPECT_EQ(res["Server"], "MyServer");
     EXPECT_EQ(res.body(), "OK");
 }
+
+// Тест: потоковое тело не пишется в body, а сохраняется для сессии
+TEST(BeastResponseAdapterTest, ChunkedBodyIsDeferred)
+{
+    namespace http = boost::beast::http;
+
+    http::response<http::string_body> res;
+    BeastResponseAdapter adapter(res);
+
+    adapter.setChunkedBody([](const IResponse::ChunkWriter& write) {
+        write("chunk");
+    });
+
+    EXPECT_TRUE(res.body().empty());
+
+    auto producer = adapter.takeChunkedBody();
+    ASSERT_TRUE(producer);
+
+    std::string collected;
+    producer([&collected](const std::string& chunk) {
+        collected += chunk;
+        return true;
+    });
+    EXPECT_EQ(collected, "chunk");
+
+    // Повторно генератор не отдаётся
+    EXPECT_FALSE(adapter.takeChunkedBody());
+}
+
+// Готовый ответ HTTP/1.1 остаётся сессии, res не заполняется
+TEST(BeastResponseAdapterTest, KeepsPrerenderedForSession)
+{
+    namespace http = boost::beast::http;
+
+    http::response<http::string_body> res{http::status::ok, 11};
+    BeastResponseAdapter adapter(res);
+    auto prerendered = PrerenderedResponse::redirect(302, "https://example.com");
+
+    adapter.setPrerendered(prerendered);
+
+    EXPECT_EQ(adapter.takePrerendered(), prerendered);
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.count(http::field::location), 0u);
+}
+
+// Изменение ответа после setPrerendered переносит готовый ответ в res
+TEST(BeastResponseAdapterTest, MaterializesPrerenderedOnChange)
+{
+    namespace http = boost::beast::http;
+
+    http::response<http::string_body> res{http::status::ok, 11};
+    BeastResponseAdapter adapter(res);
+
+    adapter.setPrerendered(PrerenderedResponse::redirect(302, "https://example.com"));
+    adapter.setHeader("X-Trace", "1");
+
+    EXPECT_EQ(adapter.takePrerendered(), nullptr);
+    EXPECT_EQ(res.result_int(), 302);
+    EXPECT_EQ(res[http::field::location], "https://example.com");
+    EXPECT_EQ(res["X-Trace"], "1");
+}
+
+// Для HTTP/1.0 готовые байты HTTP/1.1 не подходят
+TEST(BeastResponseAdapterTest, MaterializesPrerenderedForHttp10)
+{
+    namespace http = boost::beast::http;
+
+    http::response<http::string_body> res{http::status::ok, 10};
+    BeastResponseAdapter adapter(res);
+
+    adapter.setPrerendered(PrerenderedResponse::redirect(302, "https://example.com"));
+
+    EXPECT_EQ(adapter.takePrerendered(), nullptr);
+    EXPECT_EQ(res.result_int(), 302);
+}
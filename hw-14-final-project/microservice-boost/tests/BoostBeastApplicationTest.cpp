@@ -0,0 +1,512 @@
+#include <gtest/gtest.h>
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "BoostBeastApplication.hpp"
+#include "IRequest.hpp"
+#include "IResponse.hpp"
+
+/**
+ * @file BoostBeastApplicationTest.cpp
+ * @brief Тесты плавной остановки BoostBeastApplication
+ */
+
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+namespace http = beast::http;
+using tcp = asio::ip::tcp;
+
+namespace
+{
+// Свободный порт: занимаем эфемерный и сразу отпускаем
+int findFreePort()
+{
+    asio::io_context io;
+    tcp::acceptor probe(io, tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0));
+    return probe.local_endpoint().port();
+}
+
+http::response<http::string_body> get(tcp::socket& socket, const std::string& target)
+{
+    http::request<http::string_body> req{http::verb::get, target, 11};
+    req.set(http::field::host, "127.0.0.1");
+    http::write(socket, req);
+
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    http::read(socket, buffer, res);
+    return res;
+}
+
+tcp::socket connectWithRetry(asio::io_context& io, int port)
+{
+    tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), static_cast<unsigned short>(port));
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        tcp::socket socket(io);
+        beast::error_code ec;
+        socket.connect(endpoint, ec);
+        if (!ec)
+        {
+            return socket;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    throw std::runtime_error("Server did not start");
+}
+}
+
+class SlowHandler : public IHttpHandler
+{
+public:
+    explicit SlowHandler(std::chrono::milliseconds delay) : delay_(delay) {}
+
+    void handle(IRequest&, IResponse& res) override
+    {
+        if (!signalled_.exchange(true))
+        {
+            started.set_value();
+        }
+        std::this_thread::sleep_for(delay_);
+        res.setStatus(200);
+        res.setBody("done");
+    }
+
+    std::promise<void> started;
+
+private:
+    std::chrono::milliseconds delay_;
+    std::atomic<bool> signalled_{false};
+};
+
+// Долгий опрос: ждёт wake() не дольше 10 секунд
+class WaitingHandler : public IHttpHandler
+{
+public:
+    void handle(IRequest&, IResponse& res) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        started = true;
+        changed_.notify_all();
+        changed_.wait_for(lock, std::chrono::seconds(10), [this] { return woken_; });
+        res.setStatus(200);
+        res.setBody("woken");
+        finished = true;
+    }
+
+    void wake()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        woken_ = true;
+        changed_.notify_all();
+    }
+
+    void waitStarted()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return started; });
+    }
+
+    bool started = false;
+    std::atomic<bool> finished{false};
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool woken_ = false;
+};
+
+// Потоковое тело: генератор ждёт wake() уже после возврата из handle()
+class StreamingHandler : public IHttpHandler
+{
+public:
+    void handle(IRequest&, IResponse& res) override
+    {
+        res.setStatus(200);
+        res.setChunkedBody([this](const IResponse::ChunkWriter& write) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            started_ = true;
+            changed_.notify_all();
+            changed_.wait_for(lock, std::chrono::seconds(10), [this] { return woken_; });
+            write("streamed");
+        });
+    }
+
+    void wake()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        woken_ = true;
+        changed_.notify_all();
+    }
+
+    void waitStarted()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return started_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool started_ = false;
+    bool woken_ = false;
+};
+
+class PrerenderedHandler : public IHttpHandler
+{
+public:
+    void handle(IRequest&, IResponse& res) override
+    {
+        res.setPrerendered(response_);
+    }
+
+private:
+    std::shared_ptr<const PrerenderedResponse> response_ =
+        PrerenderedResponse::redirect(302, "https://example.com/target", {{"Cache-Control", "no-store"}});
+};
+
+class DrainTestApp : public BoostBeastApplication
+{
+public:
+    DrainTestApp(int port, std::shared_ptr<IHttpHandler> handler, int workers = 0)
+    {
+        auto env = std::make_shared<Environment>();
+        env->setProperty("server.host", std::string("127.0.0.1"));
+        env->setProperty("server.port", port);
+        env->setProperty("server.drain_timeout_ms", 5000);
+        env->setProperty("server.workers", workers);
+        env_ = env;
+        handlers_[getHandlerKey("GET", "/slow")] = handler;
+        handlers_[getHandlerKey("GET", "/prerendered")] = std::make_shared<PrerenderedHandler>();
+    }
+
+    void setProperty(const std::string& key, const std::any& value)
+    {
+        env_->setProperty(key, value);
+    }
+
+    using BoostBeastApplication::addMiddleware;
+
+    std::function<void()> drainHook;
+
+protected:
+    void configureInjection() override {}
+
+    void onDrain() override
+    {
+        if (drainHook)
+        {
+            drainHook();
+        }
+    }
+};
+
+// Отвечает 403 на /blocked, падает на /boom, остальным добавляет заголовок
+class GateMiddleware : public IHttpMiddleware
+{
+public:
+    void handle(IRequest& req, IResponse& res, IHttpHandler& next) override
+    {
+        if (req.getPath() == "/blocked")
+        {
+            res.setStatus(403);
+            return;
+        }
+        if (req.getPath() == "/boom")
+        {
+            throw std::runtime_error("middleware failure");
+        }
+        next.handle(req, res);
+        res.setHeader("X-Gate", "passed");
+    }
+};
+
+// Запрос, начатый до stop(), дорабатывается и получает ответ
+TEST(BoostBeastApplicationTest, StopFinishesInFlightRequest)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<SlowHandler>(std::chrono::milliseconds(200));
+    DrainTestApp app(port, handler);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+
+    http::request<http::string_body> req{http::verb::get, "/slow", 11};
+    req.set(http::field::host, "127.0.0.1");
+    http::write(socket, req);
+
+    handler->started.get_future().wait();
+    app.stop();
+
+    beast::flat_buffer buffer;
+    http::response<http::string_body> res;
+    http::read(socket, buffer, res);
+
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.body(), "done");
+
+    server.join();
+}
+
+// Соединение без запроса закрывается сразу, не дожидаясь drain timeout
+TEST(BoostBeastApplicationTest, StopClosesIdleConnections)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)));
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    auto begin = std::chrono::steady_clock::now();
+    app.stop();
+    server.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(2));
+
+    char byte = 0;
+    beast::error_code ec;
+    socket.read_some(asio::buffer(&byte, 1), ec);
+    EXPECT_EQ(ec, asio::error::eof);
+}
+
+// Режим воркеров: соединения обслуживаются io_context воркеров
+TEST(BoostBeastApplicationTest, WorkersServeRequests)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)), 2);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    for (int i = 0; i < 8; ++i)
+    {
+        auto socket = connectWithRetry(io, port);
+        auto res = get(socket, i % 2 ? "/slow" : "/missing");
+        EXPECT_EQ(res.result_int(), i % 2 ? 200 : 404);
+    }
+
+    app.stop();
+    server.join();
+}
+
+// Режим воркеров: запрос в обработке дорабатывается после stop()
+TEST(BoostBeastApplicationTest, WorkersFinishInFlightRequest)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<SlowHandler>(std::chrono::milliseconds(200));
+    DrainTestApp app(port, handler, 2);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto idle = connectWithRetry(io, port);
+    auto socket = connectWithRetry(io, port);
+
+    auto response = std::async(std::launch::async, [&socket] { return get(socket, "/slow"); });
+    handler->started.get_future().wait();
+    app.stop();
+
+    auto res = response.get();
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.body(), "done");
+
+    server.join();
+
+    char byte = 0;
+    beast::error_code ec;
+    idle.read_some(asio::buffer(&byte, 1), ec);
+    EXPECT_EQ(ec, asio::error::eof);
+}
+
+// SIGTERM обрабатывается в цикле io_context и плавно останавливает сервер
+TEST(BoostBeastApplicationTest, SignalStopsServer)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)));
+    std::thread server([&app] { app.start(); });
+
+    // Ответ на запрос - значит, цикл приёма и обработка сигналов уже работают
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    EXPECT_EQ(get(socket, "/slow").result_int(), 200);
+
+    std::raise(SIGTERM);
+    server.join();
+}
+
+// Сверх лимита запросов в обработке сервер сразу отвечает 503
+TEST(BoostBeastApplicationTest, ShedsRequestsOverInFlightLimit)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<SlowHandler>(std::chrono::milliseconds(300));
+    DrainTestApp app(port, handler);
+    app.setProperty("server.admission.max_in_flight", 1);
+    app.setProperty("server.admission.retry_after_s", 2);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto busy = connectWithRetry(io, port);
+    auto pending = std::async(std::launch::async, [&busy] { return get(busy, "/slow"); });
+    handler->started.get_future().wait();
+
+    auto shed = connectWithRetry(io, port);
+    auto res = get(shed, "/slow");
+    EXPECT_EQ(res.result_int(), 503);
+    EXPECT_EQ(res[http::field::retry_after], "2");
+
+    EXPECT_EQ(pending.get().result_int(), 200);
+
+    app.stop();
+    server.join();
+}
+
+// Потоковый ответ занимает место в обработке, пока пишется тело
+TEST(BoostBeastApplicationTest, ChunkedBodyHoldsAdmissionTicket)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<StreamingHandler>();
+    DrainTestApp app(port, handler);
+    app.setProperty("server.admission.max_in_flight", 1);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto busy = connectWithRetry(io, port);
+    auto pending = std::async(std::launch::async, [&busy] { return get(busy, "/slow"); });
+    handler->waitStarted();
+
+    auto shed = connectWithRetry(io, port);
+    EXPECT_EQ(get(shed, "/slow").result_int(), 503);
+
+    handler->wake();
+    auto res = pending.get();
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.body(), "streamed");
+
+    app.stop();
+    server.join();
+}
+
+// Middleware выполняется до маршрутизации и может ответить сам
+TEST(BoostBeastApplicationTest, MiddlewareRunsBeforeRouting)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)));
+    app.addMiddleware(std::make_shared<GateMiddleware>());
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto passed = connectWithRetry(io, port);
+    auto res = get(passed, "/slow");
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res["X-Gate"], "passed");
+
+    auto blocked = connectWithRetry(io, port);
+    EXPECT_EQ(get(blocked, "/blocked").result_int(), 403);
+
+    auto failed = connectWithRetry(io, port);
+    EXPECT_EQ(get(failed, "/boom").result_int(), 500);
+
+    app.stop();
+    server.join();
+}
+
+// Готовый ответ уходит в сокет как есть и разбирается клиентом
+TEST(BoostBeastApplicationTest, WritesPrerenderedResponse)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)));
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    auto res = get(socket, "/prerendered");
+
+    EXPECT_EQ(res.result_int(), 302);
+    EXPECT_EQ(res[http::field::location], "https://example.com/target");
+    EXPECT_EQ(res[http::field::cache_control], "no-store");
+    EXPECT_EQ(res[http::field::server], "BoostBeast");
+    EXPECT_TRUE(res.body().empty());
+
+    app.stop();
+    server.join();
+}
+
+// То же в режиме воркеров (асинхронная запись)
+TEST(BoostBeastApplicationTest, WorkersWritePrerenderedResponse)
+{
+    int port = findFreePort();
+    DrainTestApp app(port, std::make_shared<SlowHandler>(std::chrono::milliseconds(0)), 1);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    auto res = get(socket, "/prerendered");
+
+    EXPECT_EQ(res.result_int(), 302);
+    EXPECT_EQ(res[http::field::location], "https://example.com/target");
+
+    app.stop();
+    server.join();
+}
+
+// onDrain будит долгий опрос: остановка не ждёт его таймаута
+TEST(BoostBeastApplicationTest, DrainHookReleasesWaitingHandlers)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<WaitingHandler>();
+    DrainTestApp app(port, handler);
+    app.drainHook = [handler] { handler->wake(); };
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    auto pending = std::async(std::launch::async, [&socket] { return get(socket, "/slow"); });
+    handler->waitStarted();
+
+    auto started = std::chrono::steady_clock::now();
+    app.stop();
+    server.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(2));
+    auto res = pending.get();
+    EXPECT_EQ(res.result_int(), 200);
+    EXPECT_EQ(res.body(), "woken");
+}
+
+// start() не возвращается, пока поток сессии ещё в обработчике, даже после drain timeout
+TEST(BoostBeastApplicationTest, StopWaitsForHandlerPastDrainTimeout)
+{
+    int port = findFreePort();
+    auto handler = std::make_shared<WaitingHandler>();
+    DrainTestApp app(port, handler);
+    app.setProperty("server.drain_timeout_ms", 50);
+    std::thread server([&app] { app.start(); });
+
+    asio::io_context io;
+    auto socket = connectWithRetry(io, port);
+    http::request<http::string_body> req{http::verb::get, "/slow", 11};
+    req.set(http::field::host, "127.0.0.1");
+    http::write(socket, req);
+    handler->waitStarted();
+
+    // Обработчик отпускается позже, чем истекают drain timeout и FORCE_CLOSE_GRACE
+    std::thread waker([handler] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        handler->wake();
+    });
+
+    app.stop();
+    server.join();
+
+    EXPECT_TRUE(handler->finished.load());
+    waker.join();
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "ConfigWatcher.hpp"
+#include "BoostBeastApplication.hpp"
+#include <cstdio>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+void writeConfig(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path, std::ios::trunc);
+    out << content;
+}
+
+// Сдвигаем время изменения, чтобы не зависеть от точности часов ФС
+void touchLater(const std::string& path, int seconds)
+{
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(seconds));
+}
+}
+
+// Изменённый файл перечитывается и публикуется подписчикам
+TEST(ConfigWatcherTest, ReloadsChangedFile)
+{
+    const std::string path = ::testing::TempDir() + "watched-config.json";
+    writeConfig(path, R"({"cache": {"capacity": 100}})");
+
+    auto env = std::make_shared<ReloadableEnvironment>(BoostBeastApplication::readConfigFile(path));
+    int seenCapacity = 0;
+    env->subscribe([&](std::shared_ptr<IEnvironment> snapshot) {
+        seenCapacity = snapshot->get<int>("cache.capacity");
+    });
+
+    ConfigWatcher watcher(path, std::chrono::milliseconds(10),
+                          &BoostBeastApplication::readConfigFile, env);
+
+    EXPECT_FALSE(watcher.checkOnce());
+
+    writeConfig(path, R"({"cache": {"capacity": 500}})");
+    touchLater(path, 1);
+
+    EXPECT_TRUE(watcher.checkOnce());
+    EXPECT_EQ(seenCapacity, 500);
+    EXPECT_EQ(env->get<int>("cache.capacity"), 500);
+
+    std::remove(path.c_str());
+}
+
+// Файл с ошибкой не применяется
+TEST(ConfigWatcherTest, KeepsPreviousConfigOnParseError)
+{
+    const std::string path = ::testing::TempDir() + "broken-config.json";
+    writeConfig(path, R"({"cache": {"capacity": 100}})");
+
+    auto env = std::make_shared<ReloadableEnvironment>(BoostBeastApplication::readConfigFile(path));
+    ConfigWatcher watcher(path, std::chrono::milliseconds(10),
+                          &BoostBeastApplication::readConfigFile, env);
+
+    writeConfig(path, R"({"cache": {"capacity": )");
+    touchLater(path, 1);
+
+    EXPECT_FALSE(watcher.checkOnce());
+    EXPECT_EQ(env->get<int>("cache.capacity"), 100);
+
+    std::remove(path.c_str());
+}
@@ -26,6 +26,58 @@ TEST(DbSettingsTest, LoadSuccess)
     EXPECT_EQ(settings.getName(), "appdb");
     EXPECT_EQ(settings.getUser(), "admin");
     EXPECT_EQ(settings.getPassword(), "secret");
+    EXPECT_EQ(settings.getPoolSize(), DbSettings::DEFAULT_POOL_SIZE);
+    EXPECT_EQ(settings.getPoolValidationInterval().count(), DbSettings::DEFAULT_POOL_VALIDATION_INTERVAL_MS);
+}
+
+// Размер пула соединений задаётся явно
+TEST(DbSettingsTest, PoolSizeFromEnvironment)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("db.host", std::string("localhost"));
+    env->setProperty("db.port", 5432);
+    env->setProperty("db.name", std::string("appdb"));
+    env->setProperty("db.user", std::string("admin"));
+    env->setProperty("db.password", std::string("secret"));
+    env->setProperty("db.pool_size", 16);
+
+    DbSettings settings(env);
+
+    EXPECT_EQ(settings.getPoolSize(), 16);
+}
+
+// Интервал проверки соединений пула задаётся явно, отрицательный запрещён
+TEST(DbSettingsTest, PoolValidationIntervalFromEnvironment)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("db.host", std::string("localhost"));
+    env->setProperty("db.port", 5432);
+    env->setProperty("db.name", std::string("appdb"));
+    env->setProperty("db.user", std::string("admin"));
+    env->setProperty("db.password", std::string("secret"));
+    env->setProperty("db.pool_validation_interval_ms", 0);
+
+    EXPECT_EQ(DbSettings(env).getPoolValidationInterval().count(), 0);
+
+    env->setProperty("db.pool_validation_interval_ms", -1);
+    EXPECT_THROW({
+        DbSettings settings(env);
+    }, std::runtime_error);
+}
+
+TEST(DbSettingsTest, InvalidPoolSize)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("db.host", std::string("localhost"));
+    env->setProperty("db.port", 5432);
+    env->setProperty("db.name", std::string("appdb"));
+    env->setProperty("db.user", std::string("admin"));
+    env->setProperty("db.password", std::string("secret"));
+    env->setProperty("db.pool_size", 0);
+
+    EXPECT_THROW({
+        DbSettings settings(env);
+    }, std::runtime_error);
 }
 
 // ===== Проверка отсутствующих параметров =====
@@ -118,3 +118,80 @@ TEST(HttpClientTest, SendRealHttpRequest)
     ASSERT_TRUE(headers.find("Server") != headers.end());
     ASSERT_EQ(headers["Server"], "TestServer");
 }
+
+// -----------------------------------------------------------------------------
+//            Сервер, который принимает соединение и молчит
+// -----------------------------------------------------------------------------
+
+class SilentServer
+{
+public:
+    SilentServer()
+        : acceptor_(ioc_, tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), 0)),
+          socket_(ioc_)
+    {
+        thread_ = std::thread([this] {
+            beast::error_code ec;
+            acceptor_.accept(socket_, ec);
+        });
+    }
+
+    ~SilentServer()
+    {
+        beast::error_code ec;
+        acceptor_.close(ec);
+        thread_.join();
+    }
+
+    int port() const { return acceptor_.local_endpoint().port(); }
+
+private:
+    boost::asio::io_context ioc_;
+    tcp::acceptor acceptor_;
+    tcp::socket socket_;
+    std::thread thread_;
+};
+
+// Запрос без ответа завершается по предельному времени
+TEST(HttpClientTest, TimeoutAbortsSilentServer)
+{
+    SilentServer server;
+
+    HttpClient client(std::chrono::milliseconds(100));
+    TestRequest request;
+    request.port = server.port();
+    TestResponse response;
+
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_FALSE(client.send(request, response));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(5));
+    EXPECT_EQ(response.getStatus(), 500);
+}
+
+// shutdown() из другого потока прерывает ожидание ответа и отклоняет новые запросы
+TEST(HttpClientTest, ShutdownAbortsPendingRequest)
+{
+    SilentServer server;
+
+    HttpClient client;
+    TestRequest request;
+    request.port = server.port();
+
+    std::atomic<bool> done{false};
+    bool ok = true;
+    std::thread caller([&] {
+        TestResponse response;
+        ok = client.send(request, response);
+        done = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(done.load());
+    client.shutdown();
+    caller.join();
+
+    EXPECT_FALSE(ok);
+
+    TestResponse again;
+    EXPECT_FALSE(client.send(request, again));
+}
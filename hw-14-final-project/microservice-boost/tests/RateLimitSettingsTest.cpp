@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "settings/RateLimitSettings.hpp"
+#include "Environment.hpp"
+
+/**
+ * @file RateLimitSettingsTest.cpp
+ * @brief Unit-тесты для RateLimitSettings
+ */
+
+// По умолчанию ограничений нет
+TEST(RateLimitSettingsTest, DefaultsHaveNoRules)
+{
+    auto env = std::make_shared<Environment>();
+
+    RateLimitSettings settings(env);
+
+    EXPECT_TRUE(settings.getRules().empty());
+    EXPECT_EQ(settings.getMaxClients(), RateLimitSettings::DEFAULT_MAX_CLIENTS);
+}
+
+// Правила через запятую; некорректные пропускаются
+TEST(RateLimitSettingsTest, ParsesRules)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("rate_limit.rules",
+                     std::string("/r/* 100 200 ip, /cache/invalidate 5 10 header:X-Api-Key, /bad x 1, /api 1 0,/x 1 1 cookie"));
+    env->setProperty("rate_limit.max_clients", 5000);
+
+    RateLimitSettings settings(env);
+    auto rules = settings.getRules();
+
+    ASSERT_EQ(rules.size(), 2u);
+    EXPECT_EQ(rules[0].pattern, "/r/*");
+    EXPECT_DOUBLE_EQ(rules[0].ratePerSecond, 100);
+    EXPECT_DOUBLE_EQ(rules[0].burst, 200);
+    EXPECT_TRUE(rules[0].keyHeader.empty());
+    EXPECT_EQ(rules[1].pattern, "/cache/invalidate");
+    EXPECT_EQ(rules[1].keyHeader, "X-Api-Key");
+    EXPECT_EQ(settings.getMaxClients(), 5000u);
+}
@@ -65,4 +65,59 @@ TEST(ServerSettingsTest, InvalidHostType)
     EXPECT_THROW({
         ServerSettings settings(env);
     }, std::runtime_error);
-}
\ No newline at end of file
+}
+// Параметры остановки и передачи порта
+TEST(ServerSettingsTest, DrainAndReusePort)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("server.host", std::string("127.0.0.1"));
+    env->setProperty("server.port", 8080);
+
+    ServerSettings defaults(env);
+    EXPECT_EQ(defaults.getDrainTimeout(),
+              std::chrono::milliseconds(ServerSettings::DEFAULT_DRAIN_TIMEOUT_MS));
+    EXPECT_FALSE(defaults.isReusePort());
+
+    env->setProperty("server.drain_timeout_ms", 500);
+    env->setProperty("server.reuse_port", true);
+
+    ServerSettings custom(env);
+    EXPECT_EQ(custom.getDrainTimeout(), std::chrono::milliseconds(500));
+    EXPECT_TRUE(custom.isReusePort());
+}
+
+// Режим воркеров: явное число и "по числу ядер"
+TEST(ServerSettingsTest, Workers)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("server.host", std::string("127.0.0.1"));
+    env->setProperty("server.port", 8080);
+
+    EXPECT_EQ(ServerSettings(env).getWorkers(), 0);
+    EXPECT_FALSE(ServerSettings(env).isCpuPinning());
+
+    env->setProperty("server.workers", 4);
+    env->setProperty("server.cpu_pinning", true);
+    EXPECT_EQ(ServerSettings(env).getWorkers(), 4);
+    EXPECT_TRUE(ServerSettings(env).isCpuPinning());
+
+    env->setProperty("server.workers", -1);
+    EXPECT_GE(ServerSettings(env).getWorkers(), 1);
+}
+
+// Механизм ввода-вывода: epoll по умолчанию, неизвестное значение - ошибка
+TEST(ServerSettingsTest, IoBackend)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("server.host", std::string("127.0.0.1"));
+    env->setProperty("server.port", 8080);
+
+    EXPECT_EQ(ServerSettings(env).getIoBackend(), IoBackend::Kind::Epoll);
+
+    env->setProperty("server.io_backend", std::string("io_uring"));
+    EXPECT_EQ(ServerSettings(env).getIoBackend(), IoBackend::Kind::IoUring);
+    EXPECT_EQ(IoBackend::resolve(IoBackend::Kind::IoUring), IoBackend::compiled());
+
+    env->setProperty("server.io_backend", std::string("kqueue"));
+    EXPECT_THROW(ServerSettings{env}, std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "WireFormat.hpp"
+
+/**
+ * @file WireFormatTest.cpp
+ * @brief Unit-тесты для WireFormat
+ */
+
+using json = nlohmann::json;
+
+// MessagePack выбирается только по явной просьбе клиента
+TEST(WireFormatTest, NegotiatesByAcceptAndQuality)
+{
+    EXPECT_EQ(WireFormat::negotiate(""), WireFormat::Format::Json);
+    EXPECT_EQ(WireFormat::negotiate("*/*"), WireFormat::Format::Json);
+    EXPECT_EQ(WireFormat::negotiate("application/json"), WireFormat::Format::Json);
+    EXPECT_EQ(WireFormat::negotiate(WireFormat::CLIENT_ACCEPT), WireFormat::Format::MessagePack);
+    EXPECT_EQ(WireFormat::negotiate("Application/X-MsgPack"), WireFormat::Format::MessagePack);
+    EXPECT_EQ(WireFormat::negotiate("application/json, application/msgpack;q=0.1"),
+              WireFormat::Format::Json);
+    EXPECT_EQ(WireFormat::negotiate("application/msgpack;q=0"), WireFormat::Format::Json);
+
+    EXPECT_EQ(WireFormat::fromContentType("application/msgpack"), WireFormat::Format::MessagePack);
+    EXPECT_EQ(WireFormat::fromContentType("application/json; charset=utf-8"), WireFormat::Format::Json);
+}
+
+// Оба формата восстанавливают исходный документ, MessagePack короче
+TEST(WireFormatTest, EncodeDecodeRoundTrip)
+{
+    json rule = {{"shortId", "abc"}, {"targetUrl", "https://example.com/landing"},
+                 {"condition", "browser == \"Chrome\""}, {"version", "17"}};
+
+    for (auto format : {WireFormat::Format::Json, WireFormat::Format::MessagePack})
+    {
+        EXPECT_EQ(WireFormat::decode(WireFormat::encode(rule, format), format), rule);
+    }
+
+    EXPECT_LT(WireFormat::encode(rule, WireFormat::Format::MessagePack).size(),
+              WireFormat::encode(rule, WireFormat::Format::Json).size());
+}
+
+// Поток записей: varint-длина перед каждой записью MessagePack
+TEST(WireFormatTest, RecordStreamRoundTrip)
+{
+    std::vector<json> records = {{{"n", 1}}, {{"text", std::string(300, 'x')}}, {{"n", 3}}};
+
+    for (auto format : {WireFormat::Format::Json, WireFormat::Format::MessagePack})
+    {
+        std::string body;
+        for (const auto& record : records)
+        {
+            WireFormat::appendRecord(body, record, format);
+        }
+        EXPECT_EQ(WireFormat::decodeRecords(body, format), records);
+    }
+}
+
+// Обрезанная запись - ошибка разбора, а не молча потерянные данные
+TEST(WireFormatTest, TruncatedRecordThrows)
+{
+    std::string body;
+    WireFormat::appendRecord(body, {{"text", std::string(300, 'x')}}, WireFormat::Format::MessagePack);
+    body.resize(body.size() - 10);
+
+    EXPECT_THROW(WireFormat::decodeRecords(body, WireFormat::Format::MessagePack), json::exception);
+    EXPECT_THROW(WireFormat::decodeRecords(std::string(1, '\x80'), WireFormat::Format::MessagePack),
+                 json::exception);
+}
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "RouteMatcher.hpp"
+#include "settings/IAdmissionSettings.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file AdmissionController.hpp
+ * @brief Допуск запросов и сброс нагрузки с приоритетами маршрутов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @brief Приоритет маршрута при сбросе нагрузки
+ */
+enum class RequestPriority
+{
+    Critical,  ///< Отсекается последним
+    Normal,
+    Low        ///< Отсекается первым
+};
+
+/**
+ * @class AdmissionController
+ * @brief Решает, принять запрос или сразу ответить 503
+ *
+ * Глубина очереди - число запросов в обработке. Приоритету доступна
+ * своя доля лимита maxInFlight: Critical - весь лимит, Normal - 3/4,
+ * Low - 1/2, поэтому при росте очереди первыми отсекаются служебные
+ * маршруты. Если сглаженное время обработки превышает бюджет, Low
+ * отсекается полностью, а Normal получает половину лимита.
+ *
+ * Оценка времени обновляется только завершёнными запросами, поэтому без
+ * новых замеров она экспоненциально забывается (getLatencyHalfLife):
+ * иначе отсечённый Low-трафик никогда не дал бы оценке опуститься.
+ * Маршруты долгого опроса (getUntimedRoutes) в оценку не входят.
+ *
+ * Все методы потокобезопасны и не берут блокировок.
+ */
+class AdmissionController
+{
+public:
+    /**
+     * @class Ticket
+     * @brief RAII-место в обработке; при разрушении учитывает время запроса
+     */
+    class Ticket
+    {
+    public:
+        Ticket(Ticket&& other) noexcept
+            : controller_(std::exchange(other.controller_, nullptr)),
+              startedAt_(other.startedAt_),
+              timed_(other.timed_)
+        {
+        }
+
+        Ticket& operator=(Ticket&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                controller_ = std::exchange(other.controller_, nullptr);
+                startedAt_ = other.startedAt_;
+                timed_ = other.timed_;
+            }
+            return *this;
+        }
+
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        ~Ticket()
+        {
+            release();
+        }
+
+    private:
+        friend class AdmissionController;
+
+        Ticket(AdmissionController* controller, bool timed)
+            : controller_(controller), startedAt_(Clock::now()), timed_(timed)
+        {
+        }
+
+        void release()
+        {
+            if (controller_)
+            {
+                controller_->finish(Clock::now() - startedAt_, timed_);
+                controller_ = nullptr;
+            }
+        }
+
+        AdmissionController* controller_;
+        std::chrono::steady_clock::time_point startedAt_;
+        bool timed_;
+    };
+
+    explicit AdmissionController(const IAdmissionSettings& settings)
+        : maxConnections_(settings.getMaxConnections()),
+          maxInFlight_(settings.getMaxInFlight()),
+          latencyBudget_(settings.getLatencyBudget()),
+          latencyHalfLifeUs_(std::max<std::int64_t>(1,
+              std::chrono::duration_cast<std::chrono::microseconds>(settings.getLatencyHalfLife()).count())),
+          retryAfterSeconds_(settings.getRetryAfterSeconds()),
+          criticalRoutes_(settings.getCriticalRoutes()),
+          lowPriorityRoutes_(settings.getLowPriorityRoutes()),
+          untimedRoutes_(settings.getUntimedRoutes())
+    {
+    }
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    /**
+     * @brief Приоритет пути по спискам маршрутов из настроек
+     */
+    RequestPriority classify(const std::string& path) const
+    {
+        if (matchesAny(criticalRoutes_, path))
+        {
+            return RequestPriority::Critical;
+        }
+        if (matchesAny(lowPriorityRoutes_, path))
+        {
+            return RequestPriority::Low;
+        }
+        return RequestPriority::Normal;
+    }
+
+    /**
+     * @brief Входит ли время запроса по пути в сглаженное время обработки
+     */
+    bool isTimed(const std::string& path) const
+    {
+        return !matchesAny(untimedRoutes_, path);
+    }
+
+    /**
+     * @brief Занять место в обработке
+     * @param timed Учесть время запроса в оценке (false для долгого опроса)
+     * @return nullopt, если запрос нужно отсечь
+     */
+    std::optional<Ticket> admit(RequestPriority priority, bool timed = true)
+    {
+        int limit = limitFor(priority);
+
+        int current = inFlight_.load(std::memory_order_relaxed);
+        do
+        {
+            if (limit >= 0 && current >= limit)
+            {
+                shed_.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+        } while (!inFlight_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+
+        return Ticket(this, timed);
+    }
+
+    /**
+     * @brief Учесть новое соединение
+     * @return false, если достигнут лимит соединений
+     */
+    bool tryAcquireConnection()
+    {
+        int current = connections_.load(std::memory_order_relaxed);
+        do
+        {
+            if (maxConnections_ > 0 && current >= maxConnections_)
+            {
+                return false;
+            }
+        } while (!connections_.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+
+        return true;
+    }
+
+    void releaseConnection()
+    {
+        connections_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    int getRetryAfterSeconds() const
+    {
+        return retryAfterSeconds_;
+    }
+
+    int inFlight() const
+    {
+        return inFlight_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t shedCount() const
+    {
+        return shed_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Сглаженное время обработки запроса с учётом забывания
+     */
+    std::chrono::microseconds latencyEstimate() const
+    {
+        return std::chrono::microseconds(decayed(latencyUs_.load(std::memory_order_relaxed), nowUs()));
+    }
+
+    bool isOverBudget() const
+    {
+        return latencyBudget_.count() > 0 && latencyEstimate() > latencyBudget_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Вес нового замера в скользящем среднем: 1/8
+    static constexpr std::int64_t LATENCY_SMOOTHING = 8;
+
+    static std::int64_t nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /// Оценка, ослабленная вдвое за каждый период полураспада без замеров
+    std::int64_t decayed(std::int64_t estimate, std::int64_t now) const
+    {
+        std::int64_t idle = now - sampledAtUs_.load(std::memory_order_relaxed);
+        if (estimate == 0 || idle <= 0)
+        {
+            return estimate;
+        }
+        double factor = std::exp2(-static_cast<double>(idle) / static_cast<double>(latencyHalfLifeUs_));
+        return static_cast<std::int64_t>(static_cast<double>(estimate) * factor);
+    }
+
+    static bool matchesAny(const std::vector<std::string>& patterns, const std::string& path)
+    {
+        for (const auto& pattern : patterns)
+        {
+            if (pattern == path || RouteMatcher::matches(pattern, path))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Лимит для приоритета; -1 - без ограничения
+    int limitFor(RequestPriority priority) const
+    {
+        bool overBudget = isOverBudget();
+
+        if (priority == RequestPriority::Low && overBudget)
+        {
+            return 0;
+        }
+        if (maxInFlight_ <= 0)
+        {
+            return -1;
+        }
+
+        switch (priority)
+        {
+        case RequestPriority::Critical:
+            return maxInFlight_;
+        case RequestPriority::Normal:
+            return std::max(1, overBudget ? maxInFlight_ / 2 : maxInFlight_ * 3 / 4);
+        case RequestPriority::Low:
+            return std::max(1, maxInFlight_ / 2);
+        }
+        return maxInFlight_;
+    }
+
+    void finish(Clock::duration elapsed, bool timed)
+    {
+        inFlight_.fetch_sub(1, std::memory_order_relaxed);
+        if (!timed)
+        {
+            return;
+        }
+
+        auto sample = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+        std::int64_t now = nowUs();
+        std::int64_t current = latencyUs_.load(std::memory_order_relaxed);
+        std::int64_t next = 0;
+        do
+        {
+            // Замер сглаживается с уже забытой частью оценки
+            std::int64_t base = decayed(current, now);
+            next = base == 0 ? sample : base + (sample - base) / LATENCY_SMOOTHING;
+        } while (!latencyUs_.compare_exchange_weak(current, next, std::memory_order_relaxed));
+        sampledAtUs_.store(now, std::memory_order_relaxed);
+    }
+
+    const int maxConnections_;
+    const int maxInFlight_;
+    const std::chrono::milliseconds latencyBudget_;
+    const std::int64_t latencyHalfLifeUs_;
+    const int retryAfterSeconds_;
+    const std::vector<std::string> criticalRoutes_;
+    const std::vector<std::string> lowPriorityRoutes_;
+    const std::vector<std::string> untimedRoutes_;
+
+    std::atomic<int> connections_{0};
+    std::atomic<int> inFlight_{0};
+    std::atomic<std::int64_t> latencyUs_{0};
+    std::atomic<std::int64_t> sampledAtUs_{0};   ///< Время последнего замера, мкс от эпохи Clock
+    std::atomic<std::uint64_t> shed_{0};
+};
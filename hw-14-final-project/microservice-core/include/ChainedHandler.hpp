@@ -0,0 +1,37 @@
+#pragma once
+
+#include "IHttpHandler.hpp"
+#include "MiddlewareChain.hpp"
+#include <memory>
+#include <utility>
+
+/**
+ * @file ChainedHandler.hpp
+ * @brief Handler со своей цепочкой middleware
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ChainedHandler
+ * @brief Оборачивает handler цепочкой стадий одного маршрута
+ *
+ * Регистрируется вместо исходного handler'а, когда стадия нужна не
+ * всем маршрутам (например, авторизация только для служебного API).
+ */
+class ChainedHandler : public IHttpHandler
+{
+public:
+    ChainedHandler(std::shared_ptr<const MiddlewareChain> chain, std::shared_ptr<IHttpHandler> handler)
+        : chain_(std::move(chain)), handler_(std::move(handler))
+    {
+    }
+
+    void handle(IRequest& req, IResponse& res) override
+    {
+        chain_->handle(req, res, *handler_);
+    }
+
+private:
+    std::shared_ptr<const MiddlewareChain> chain_;
+    std::shared_ptr<IHttpHandler> handler_;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * @file CircuitBreaker.hpp
+ * @brief Автомат "closed / open / half-open" для вызовов внешнего сервиса
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class CircuitBreaker
+ * @brief Перестаёт обращаться к сервису после серии отказов
+ *
+ * После failureThreshold отказов подряд автомат размыкается: вызовы
+ * отклоняются сразу, без ожидания таймаута. Через openTimeout один
+ * пробный вызов пропускается (half-open): успех замыкает автомат,
+ * отказ размыкает его снова. Нулевой порог отключает автомат.
+ */
+class CircuitBreaker
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State
+    {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    CircuitBreaker(int failureThreshold, std::chrono::milliseconds openTimeout)
+        : failureThreshold_(failureThreshold), openTimeout_(openTimeout)
+    {
+    }
+
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+    /**
+     * @brief Можно ли сейчас обращаться к сервису
+     *
+     * В half-open разрешается только один пробный вызов, пока по нему
+     * не вызван recordSuccess или recordFailure.
+     */
+    bool allowRequest(Clock::time_point now = Clock::now())
+    {
+        if (failureThreshold_ <= 0)
+        {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        switch (state_)
+        {
+        case State::Closed:
+            return true;
+        case State::Open:
+            if (now - openedAt_ < openTimeout_)
+            {
+                return false;
+            }
+            state_ = State::HalfOpen;
+            probeInFlight_ = true;
+            return true;
+        case State::HalfOpen:
+            if (probeInFlight_)
+            {
+                return false;
+            }
+            probeInFlight_ = true;
+            return true;
+        }
+        return true;
+    }
+
+    void recordSuccess()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_ = State::Closed;
+        failures_ = 0;
+        probeInFlight_ = false;
+    }
+
+    void recordFailure(Clock::time_point now = Clock::now())
+    {
+        if (failureThreshold_ <= 0)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        probeInFlight_ = false;
+        if (state_ == State::HalfOpen || ++failures_ >= failureThreshold_)
+        {
+            state_ = State::Open;
+            openedAt_ = now;
+            failures_ = 0;
+        }
+    }
+
+    State state() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return state_;
+    }
+
+private:
+    const int failureThreshold_;
+    const std::chrono::milliseconds openTimeout_;
+
+    mutable std::mutex mutex_;
+    State state_ = State::Closed;
+    int failures_ = 0;
+    bool probeInFlight_ = false;
+    Clock::time_point openedAt_{};
+};
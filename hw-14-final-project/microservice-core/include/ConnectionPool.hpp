@@ -0,0 +1,281 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @file ConnectionPool.hpp
+ * @brief Ограниченный пул соединений с проверкой здоровья
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ConnectionPool
+ * @brief Потокобезопасный пул из не более чем maxSize соединений
+ *
+ * Соединение выдаётся одному потоку через Lease и возвращается в пул
+ * при разрушении Lease. Перед выдачей соединение проверяется healthCheck,
+ * нерабочие (а также помеченные через Lease::invalidate) пересоздаются
+ * фабрикой. Пул должен переживать все выданные Lease.
+ *
+ * Проверка может стоить обращения к серверу (SELECT 1), поэтому
+ * соединение, вернувшееся в пул менее validationInterval назад, выдаётся
+ * без неё: за ним только что успешно работали. При нулевом интервале
+ * проверяется каждая выдача.
+ *
+ * @tparam Connection Тип соединения (например, pqxx::connection)
+ */
+template <typename Connection>
+class ConnectionPool
+{
+public:
+    using Factory = std::function<std::unique_ptr<Connection>()>;
+    using HealthCheck = std::function<bool(Connection&)>;
+
+    /**
+     * @class Lease
+     * @brief RAII-владение соединением из пула
+     */
+    class Lease
+    {
+    public:
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)),
+              connection_(std::move(other.connection_))
+        {
+        }
+
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                pool_ = std::exchange(other.pool_, nullptr);
+                connection_ = std::move(other.connection_);
+            }
+            return *this;
+        }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease()
+        {
+            release();
+        }
+
+        Connection& operator*() const { return *connection_; }
+        Connection* operator->() const { return connection_.get(); }
+
+        /**
+         * @brief Пометить соединение сломанным: в пул оно не вернётся
+         */
+        void invalidate()
+        {
+            connection_.reset();
+        }
+
+    private:
+        friend class ConnectionPool;
+
+        Lease(ConnectionPool* pool, std::unique_ptr<Connection> connection)
+            : pool_(pool), connection_(std::move(connection))
+        {
+        }
+
+        void release()
+        {
+            if (pool_)
+            {
+                pool_->giveBack(std::move(connection_));
+                pool_ = nullptr;
+            }
+        }
+
+        ConnectionPool* pool_;
+        std::unique_ptr<Connection> connection_;
+    };
+
+    /**
+     * @brief Создать пул и сразу открыть все соединения
+     * @param maxSize Максимальное число соединений (> 0)
+     * @param factory Создаёт новое соединение, бросает исключение при ошибке
+     * @param healthCheck Проверка соединения перед выдачей
+     * @param acquireTimeout Сколько ждать свободного соединения в acquire()
+     * @param validationInterval Сколько соединение считается рабочим после возврата в пул
+     * @throws std::invalid_argument если maxSize == 0
+     * @throws любое исключение фабрики
+     */
+    ConnectionPool(std::size_t maxSize,
+                   Factory factory,
+                   HealthCheck healthCheck,
+                   std::chrono::milliseconds acquireTimeout = std::chrono::seconds(5),
+                   std::chrono::milliseconds validationInterval = std::chrono::milliseconds(0))
+        : maxSize_(maxSize),
+          factory_(std::move(factory)),
+          healthCheck_(std::move(healthCheck)),
+          acquireTimeout_(acquireTimeout),
+          validationInterval_(validationInterval)
+    {
+        if (maxSize_ == 0)
+        {
+            throw std::invalid_argument("ConnectionPool size must be positive");
+        }
+
+        for (std::size_t i = 0; i < maxSize_; ++i)
+        {
+            idle_.push_back(Idle{factory_(), Clock::now()});
+        }
+        total_ = maxSize_;
+    }
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * @brief Взять соединение, дожидаясь освобождения не дольше acquireTimeout
+     * @throws std::runtime_error если свободного соединения не дождались
+     * @throws любое исключение фабрики при пересоздании соединения
+     */
+    Lease acquire()
+    {
+        std::unique_ptr<Connection> connection;
+        bool validated = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            bool ready = available_.wait_for(lock, acquireTimeout_, [this] {
+                return !idle_.empty() || total_ < maxSize_;
+            });
+            if (!ready)
+            {
+                throw std::runtime_error("ConnectionPool: timed out waiting for a connection");
+            }
+
+            if (!idle_.empty())
+            {
+                connection = std::move(idle_.back().connection);
+                validated = Clock::now() - idle_.back().returnedAt < validationInterval_;
+                idle_.pop_back();
+            }
+            else
+            {
+                // Резервируем место под новое соединение, создаём его вне блокировки
+                ++total_;
+            }
+        }
+
+        // Проверка и пересоздание - без блокировки, чтобы не тормозить остальных
+        try
+        {
+            if (connection && !validated && !healthCheck_(*connection))
+            {
+                connection.reset();
+            }
+            if (!connection)
+            {
+                connection = factory_();
+            }
+        }
+        catch (...)
+        {
+            giveBack(nullptr);
+            throw;
+        }
+
+        return Lease(this, std::move(connection));
+    }
+
+    /**
+     * @brief Изменить максимальный размер пула на лету
+     *
+     * При увеличении новые соединения создаются по мере спроса. При
+     * уменьшении лишние свободные соединения закрываются сразу, а выданные
+     * сверх лимита - при возврате.
+     *
+     * @throws std::invalid_argument если maxSize == 0
+     */
+    void resize(std::size_t maxSize)
+    {
+        if (maxSize == 0)
+        {
+            throw std::invalid_argument("ConnectionPool size must be positive");
+        }
+
+        // Лишние соединения закрываются после снятия блокировки
+        std::vector<Idle> surplus;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            maxSize_ = maxSize;
+            while (total_ > maxSize_ && !idle_.empty())
+            {
+                surplus.push_back(std::move(idle_.back()));
+                idle_.pop_back();
+                --total_;
+            }
+        }
+        // Ожидающие могут получить место под новое соединение
+        available_.notify_all();
+    }
+
+    /**
+     * @brief Максимальный размер пула
+     */
+    std::size_t maxSize() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return maxSize_;
+    }
+
+    /**
+     * @brief Число свободных соединений в пуле
+     */
+    std::size_t idleCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Idle
+    {
+        std::unique_ptr<Connection> connection;
+        Clock::time_point returnedAt;   ///< Когда соединение последний раз было рабочим
+    };
+
+    void giveBack(std::unique_ptr<Connection> connection)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (connection && total_ <= maxSize_)
+            {
+                idle_.push_back(Idle{std::move(connection), Clock::now()});
+            }
+            else
+            {
+                // Сломанное соединение или лишнее после resize() освобождает место
+                --total_;
+            }
+        }
+        available_.notify_one();
+    }
+
+    std::size_t maxSize_;
+    Factory factory_;
+    HealthCheck healthCheck_;
+    std::chrono::milliseconds acquireTimeout_;
+    std::chrono::milliseconds validationInterval_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<Idle> idle_;
+    std::size_t total_ = 0;   ///< Выданные + свободные соединения
+};
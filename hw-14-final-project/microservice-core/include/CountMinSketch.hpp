@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+/**
+ * @file CountMinSketch.hpp
+ * @brief Приближённые счётчики частот в памяти фиксированного размера
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class CountMinSketch
+ * @brief depth строк по width счётчиков, ключ задаётся 64-битным хешем
+ *
+ * Оценка частоты - минимум по строкам, она никогда не меньше истинной
+ * и завышена не более чем на долю ~e/width от всех событий. Счётчики
+ * атомарные: add не берёт блокировок. decay делит все счётчики
+ * пополам, чтобы старые события весили меньше новых.
+ *
+ * Таблица хранится в shards копиях, поток пишет только в свою. Иначе
+ * все ядра делают fetch_add в одни и те же строки кэша горячих ключей.
+ * Оценка складывает копии по каждому счётчику и даёт тот же результат,
+ * что и одна таблица, но читает shards * depth счётчиков.
+ */
+class CountMinSketch
+{
+public:
+    /**
+     * @param width Счётчиков в строке (округляется вверх до степени двойки)
+     * @param depth Число строк (независимых хешей)
+     * @param shards Число копий таблицы для записи из разных потоков
+     */
+    CountMinSketch(std::size_t width, std::size_t depth, std::size_t shards = 1)
+        : depth_(std::max<std::size_t>(1, depth)),
+          shards_(std::max<std::size_t>(1, shards))
+    {
+        std::size_t rounded = 1;
+        while (rounded < width)
+        {
+            rounded <<= 1;
+        }
+        mask_ = rounded - 1;
+        counters_.reset(new std::atomic<std::uint32_t>[size()]);
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            counters_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Учесть событие ключа в копии текущего потока
+     * @return Оценка частоты ключа по этой копии с учётом события;
+     *         при shards > 1 она не больше общей оценки estimate()
+     */
+    std::uint32_t add(std::uint64_t hash)
+    {
+        std::size_t base = shard() * (mask_ + 1) * depth_;
+        std::uint32_t estimate = std::numeric_limits<std::uint32_t>::max();
+        for (std::size_t row = 0; row < depth_; ++row)
+        {
+            std::uint32_t value = counters_[base + slot(hash, row)].fetch_add(1, std::memory_order_relaxed) + 1;
+            estimate = std::min(estimate, value);
+        }
+        return estimate;
+    }
+
+    std::uint32_t estimate(std::uint64_t hash) const
+    {
+        std::size_t stride = (mask_ + 1) * depth_;
+        std::uint32_t estimate = std::numeric_limits<std::uint32_t>::max();
+        for (std::size_t row = 0; row < depth_; ++row)
+        {
+            std::size_t index = slot(hash, row);
+            std::uint32_t sum = 0;
+            for (std::size_t shard = 0; shard < shards_; ++shard)
+            {
+                sum += counters_[shard * stride + index].load(std::memory_order_relaxed);
+            }
+            estimate = std::min(estimate, sum);
+        }
+        return estimate;
+    }
+
+    /**
+     * @brief Уменьшить все счётчики вдвое
+     *
+     * Параллельные add не блокируются; событие, пришедшее во время
+     * деления, может потеряться - для приближённых счётчиков это допустимо.
+     */
+    void decay()
+    {
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            counters_[i].store(counters_[i].load(std::memory_order_relaxed) >> 1,
+                               std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Копия таблицы, в которую пишет текущий поток
+     *
+     * Потоки получают номера по порядку первого обращения, поэтому при
+     * числе потоков не больше shards каждый пишет в свою копию.
+     */
+    std::size_t shard() const
+    {
+        static std::atomic<std::size_t> nextThread{0};
+        thread_local const std::size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return thread % shards_;
+    }
+
+    std::size_t width() const
+    {
+        return mask_ + 1;
+    }
+
+    std::size_t depth() const
+    {
+        return depth_;
+    }
+
+    std::size_t shards() const
+    {
+        return shards_;
+    }
+
+private:
+    std::size_t size() const
+    {
+        return (mask_ + 1) * depth_ * shards_;
+    }
+
+    std::size_t slot(std::uint64_t hash, std::size_t row) const
+    {
+        // Своя перемешивающая функция для каждой строки (splitmix64)
+        std::uint64_t x = hash + 0x9E3779B97F4A7C15ULL * (row + 1);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return row * (mask_ + 1) + (static_cast<std::size_t>(x) & mask_);
+    }
+
+    std::size_t depth_;
+    std::size_t shards_;
+    std::size_t mask_ = 0;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> counters_;
+};
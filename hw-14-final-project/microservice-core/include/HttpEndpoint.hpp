@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * @file HttpEndpoint.hpp
+ * @brief Разобранный адрес HTTP-сервиса
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct HttpEndpoint
+ * @brief Хост и порт, проверенные один раз при чтении настроек
+ *
+ * Клиенты получают готовую структуру из Settings и не разбирают URL на
+ * каждый запрос.
+ */
+struct HttpEndpoint
+{
+    std::string host;
+    int port = 0;
+
+    /**
+     * @brief Разобрать URL вида http://host:port[/]
+     * @throws std::runtime_error если формат или порт некорректны
+     */
+    static HttpEndpoint parse(const std::string& url)
+    {
+        const std::string scheme = "http://";
+        if (url.compare(0, scheme.size(), scheme) != 0)
+        {
+            throw std::runtime_error("Invalid URL format: " + url);
+        }
+
+        std::string authority = url.substr(scheme.size());
+        if (!authority.empty() && authority.back() == '/')
+        {
+            authority.pop_back();
+        }
+
+        auto colon = authority.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == authority.size())
+        {
+            throw std::runtime_error("Invalid URL format: " + url);
+        }
+
+        std::string host = authority.substr(0, colon);
+        std::string port = authority.substr(colon + 1);
+        if (port.size() > 5 || port.find_first_not_of("0123456789") != std::string::npos ||
+            host.find('/') != std::string::npos)
+        {
+            throw std::runtime_error("Invalid URL format: " + url);
+        }
+
+        int portNumber = std::stoi(port);
+        if (portNumber < 1 || portNumber > 65535)
+        {
+            throw std::runtime_error("Invalid port in URL: " + url);
+        }
+
+        return HttpEndpoint{host, portNumber};
+    }
+
+    /**
+     * @brief Обратно в URL (для логов)
+     */
+    std::string toString() const
+    {
+        return "http://" + host + ":" + std::to_string(port);
+    }
+
+    bool operator==(const HttpEndpoint& other) const
+    {
+        return host == other.host && port == other.port;
+    }
+};
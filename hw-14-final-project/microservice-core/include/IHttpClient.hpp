@@ -18,4 +18,12 @@ public:
      * @return true если успешно, false в случае ошибки
      */
     virtual bool send(const IRequest& request, IResponse& response) = 0;
+
+    /**
+     * @brief Прервать текущие запросы и отклонять новые (из любого потока)
+     *
+     * Нужен владельцу, который ждёт долгого ответа и должен быстро
+     * остановиться. Реализация по умолчанию ничего не делает.
+     */
+    virtual void shutdown() {}
 };
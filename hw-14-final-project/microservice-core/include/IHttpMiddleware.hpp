@@ -0,0 +1,31 @@
+#pragma once
+
+#include "IHttpHandler.hpp"
+
+/**
+ * @file IHttpMiddleware.hpp
+ * @brief Интерфейс промежуточного обработчика HTTP запросов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class IHttpMiddleware
+ * @brief Стадия, выполняемая до маршрутизации запроса
+ *
+ * Middleware получает продолжение цепочки next и решает сам: передать
+ * запрос дальше (next.handle) или сразу сформировать ответ. Код после
+ * next.handle выполняется, когда ответ уже готов.
+ */
+class IHttpMiddleware
+{
+public:
+    virtual ~IHttpMiddleware() = default;
+
+    /**
+     * @brief Обработать запрос
+     * @param req HTTP запрос
+     * @param res HTTP ответ
+     * @param next Следующий middleware или маршрутизация к handler'у
+     */
+    virtual void handle(IRequest& req, IResponse& res, IHttpHandler& next) = 0;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <map>
 
 /**
@@ -33,11 +34,58 @@ struct IRequest {
      */
     virtual std::map<std::string, std::string> getHeaders() const = 0;
 
+    /**
+     * @brief Получить один заголовок (пустая строка, если его нет)
+     *
+     * Реализация по умолчанию копирует все заголовки; адаптеры
+     * переопределяют её поиском без копирования.
+     */
+    virtual std::string getHeader(const std::string& name) const
+    {
+        auto headers = getHeaders();
+        auto it = headers.find(name);
+        return it == headers.end() ? std::string() : it->second;
+    }
+
     /**
      * @brief Получить IP-адрес (клиента при входящем сообщении, получателя при исходящем)
      */
     virtual std::string getIp() const = 0;
 
+    /**
+     * @brief Путь запроса без копирования; время жизни - как у getHeaderView
+     */
+    virtual std::string_view getPathView() const
+    {
+        thread_local std::string buffer;
+        buffer = getPath();
+        return buffer;
+    }
+
+    /**
+     * @brief Заголовок без копирования (пустое представление, если его нет)
+     *
+     * Адаптеры возвращают представление внутрь запроса, оно живёт вместе
+     * с ним. Реализация по умолчанию копирует значение в буфер потока:
+     * представление действительно до следующего вызова в этом потоке.
+     */
+    virtual std::string_view getHeaderView(const std::string& name) const
+    {
+        thread_local std::string buffer;
+        buffer = getHeader(name);
+        return buffer;
+    }
+
+    /**
+     * @brief IP-адрес без копирования; время жизни - как у getHeaderView
+     */
+    virtual std::string_view getIpView() const
+    {
+        thread_local std::string buffer;
+        buffer = getIp();
+        return buffer;
+    }
+
     /**
      * @brief Получить порт (для входящих - 80 по умолчанию, для исходящих - целевой порт)
      */
@@ -1,5 +1,8 @@
 #pragma once
+#include "PrerenderedResponse.hpp"
 #include <string>
+#include <functional>
+#include <memory>
 
 /**
  * @file IResponse.hpp
@@ -7,6 +10,17 @@
  * @author Anton Tobolkin
  */
 struct IResponse {
+    /**
+     * @brief Функция записи очередного куска тела ответа
+     * @return false если клиент отключился и генерацию нужно прекратить
+     */
+    using ChunkWriter = std::function<bool(const std::string& chunk)>;
+
+    /**
+     * @brief Генератор тела ответа, пишет куски через переданный ChunkWriter
+     */
+    using ChunkProducer = std::function<void(const ChunkWriter& write)>;
+
     virtual ~IResponse() = default;
 
     /**
@@ -23,4 +37,39 @@ struct IResponse {
      */
     virtual void setHeader(const std::string& name, const std::string& value) = 0;
 
+    /**
+     * @brief Установить потоковое тело ответа (Transfer-Encoding: chunked)
+     *
+     * Реализация по умолчанию собирает все куски в строку и вызывает setBody.
+     * Сетевые адаптеры переопределяют метод и отправляют куски клиенту
+     * по мере генерации, не держа всё тело в памяти.
+     *
+     * @param producer Генератор тела, вызывается после отправки заголовков
+     */
+    virtual void setChunkedBody(ChunkProducer producer)
+    {
+        std::string body;
+        producer([&body](const std::string& chunk) {
+            body += chunk;
+            return true;
+        });
+        setBody(body);
+    }
+
+    /**
+     * @brief Отдать заранее собранный ответ целиком
+     *
+     * Реализация по умолчанию переносит статус, заголовки и тело через
+     * setStatus/setHeader/setBody. Сетевые адаптеры переопределяют метод
+     * и пишут готовые байты в сокет, не сериализуя заголовки заново.
+     */
+    virtual void setPrerendered(std::shared_ptr<const PrerenderedResponse> response)
+    {
+        setStatus(response->status());
+        for (const auto& [name, value] : response->headers())
+        {
+            setHeader(name, value);
+        }
+        setBody(response->body());
+    }
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "IHttpHandler.hpp"
+#include "IHttpMiddleware.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @file MiddlewareChain.hpp
+ * @brief Цепочка middleware вокруг IHttpHandler
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class MiddlewareChain
+ * @brief Упорядоченный набор стадий, завершающийся handler'ом
+ *
+ * Цепочка собирается при конфигурации приложения и дальше только
+ * читается, поэтому handle() можно вызывать из нескольких потоков.
+ * Пустая цепочка сразу вызывает конечный handler; иначе переходы
+ * между стадиями - объекты на стеке, без выделений памяти.
+ */
+class MiddlewareChain
+{
+public:
+    /**
+     * @brief Добавить стадию в конец цепочки (ближе к handler'у)
+     */
+    void add(std::shared_ptr<IHttpMiddleware> middleware)
+    {
+        middlewares_.push_back(std::move(middleware));
+    }
+
+    bool empty() const
+    {
+        return middlewares_.empty();
+    }
+
+    std::size_t size() const
+    {
+        return middlewares_.size();
+    }
+
+    /**
+     * @brief Провести запрос через все стадии до terminal
+     * @param terminal Обработчик, который получает запрос после последней стадии
+     */
+    void handle(IRequest& req, IResponse& res, IHttpHandler& terminal) const
+    {
+        if (middlewares_.empty())
+        {
+            terminal.handle(req, res);
+            return;
+        }
+
+        Link(middlewares_, 0, terminal).handle(req, res);
+    }
+
+private:
+    /**
+     * @brief Продолжение цепочки для стадии index
+     */
+    class Link final : public IHttpHandler
+    {
+    public:
+        Link(const std::vector<std::shared_ptr<IHttpMiddleware>>& middlewares,
+             std::size_t index, IHttpHandler& terminal)
+            : middlewares_(middlewares), index_(index), terminal_(terminal)
+        {
+        }
+
+        void handle(IRequest& req, IResponse& res) override
+        {
+            if (index_ == middlewares_.size())
+            {
+                terminal_.handle(req, res);
+                return;
+            }
+
+            Link next(middlewares_, index_ + 1, terminal_);
+            middlewares_[index_]->handle(req, res, next);
+        }
+
+    private:
+        const std::vector<std::shared_ptr<IHttpMiddleware>>& middlewares_;
+        std::size_t index_;
+        IHttpHandler& terminal_;
+    };
+
+    std::vector<std::shared_ptr<IHttpMiddleware>> middlewares_;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file PrerenderedResponse.hpp
+ * @brief Заранее сериализованный HTTP-ответ
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class PrerenderedResponse
+ * @brief Неизменяемый ответ, строка статуса и заголовки которого собраны один раз
+ *
+ * Создаётся вместе с данными, из которых получается (например, при
+ * кэшировании правила), и затем разделяется всеми запросами. Сетевой
+ * адаптер отправляет head() и body() без повторной сериализации,
+ * дописывая только заголовки соединения и пустую строку.
+ */
+class PrerenderedResponse
+{
+public:
+    using Headers = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @param status Код ответа
+     * @param headers Заголовки без Content-Length (он добавляется сам)
+     * @param body Тело ответа
+     * @throws std::invalid_argument если имя или значение заголовка небезопасно
+     */
+    PrerenderedResponse(int status, Headers headers, std::string body = "");
+
+    /**
+     * @brief Можно ли вставить строку в заголовок как есть
+     *
+     * Заголовки склеиваются в готовый блок без сериализатора Beast,
+     * поэтому CR, LF, NUL и другие управляющие символы (кроме табуляции)
+     * запрещены: иначе значение могло бы дописать свои заголовки или тело.
+     */
+    static bool isSafeHeaderValue(const std::string& value);
+
+    /**
+     * @brief Ответ-переадресация на location
+     * @param status 301, 302, 307 или 308
+     */
+    static std::shared_ptr<const PrerenderedResponse> redirect(
+        int status, const std::string& location, Headers extraHeaders = {});
+
+    int status() const
+    {
+        return status_;
+    }
+
+    const Headers& headers() const
+    {
+        return headers_;
+    }
+
+    const std::string& body() const
+    {
+        return body_;
+    }
+
+    /**
+     * @brief Строка статуса HTTP/1.1 и заголовки, каждая строка с CRLF,
+     *        без завершающей пустой строки
+     */
+    const std::string& head() const
+    {
+        return head_;
+    }
+
+    /**
+     * @brief Поясняющая фраза для кода ответа ("Found" для 302)
+     */
+    static const char* reasonPhrase(int status);
+
+private:
+    int status_;
+    Headers headers_;
+    std::string body_;
+    std::string head_;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "IHttpMiddleware.hpp"
+#include "TokenBucketTable.hpp"
+#include "settings/IRateLimitSettings.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file RateLimitMiddleware.hpp
+ * @brief Ограничение частоты запросов одного клиента
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class RateLimitMiddleware
+ * @brief Token bucket на клиента для маршрутов из настроек
+ *
+ * Клиент определяется по IP или по заголовку правила (например,
+ * X-Forwarded-For за балансировщиком; без заголовка - по IP). Корзины
+ * разных правил независимы. При исчерпании корзины запрос не доходит
+ * до маршрутизации: ответ 429 с Retry-After.
+ *
+ * Отказы считаются в rejectedRequests(); в лог попадает не больше
+ * одного отказа за REJECT_LOG_INTERVAL, иначе под атакой лог сам
+ * становится узким местом.
+ */
+class RateLimitMiddleware : public IHttpMiddleware
+{
+public:
+    /// Не чаще одной строки лога об отказах за интервал
+    static constexpr std::chrono::seconds REJECT_LOG_INTERVAL{1};
+
+    explicit RateLimitMiddleware(const IRateLimitSettings& settings);
+
+    void handle(IRequest& req, IResponse& res, IHttpHandler& next) override;
+
+    /**
+     * @brief Сколько клиентов сейчас отслеживается
+     */
+    std::size_t trackedClients() const;
+
+    /**
+     * @brief Сколько запросов отклонено с момента создания
+     */
+    std::uint64_t rejectedRequests() const;
+
+private:
+    /**
+     * @brief Индекс первого правила для пути, -1 если ни одно не подходит
+     */
+    int findRule(const std::string& path) const;
+
+    static std::uint64_t hashKey(std::string_view client, int ruleIndex);
+
+    void reportRejected(const RateLimitRule& rule, std::string_view client,
+                        TokenBucketTable::Clock::time_point now);
+
+    std::vector<RateLimitRule> rules_;
+    TokenBucketTable buckets_;
+    std::atomic<std::uint64_t> rejected_{0};
+    std::atomic<TokenBucketTable::Clock::rep> lastReport_;  ///< Время последней строки лога, тики Clock
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Environment.hpp"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @file ReloadableEnvironment.hpp
+ * @brief Окружение с атомарной подменой конфигурации на лету
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ReloadableEnvironment
+ * @brief IEnvironment поверх неизменяемого снимка Environment
+ *
+ * Читатели берут текущий снимок через std::atomic_load и никогда не видят
+ * конфигурацию в промежуточном состоянии. publish() подменяет снимок
+ * целиком и оповещает подписчиков - так компоненты (кэши, пулы) меняют
+ * размеры без перезапуска. Подписчик получает собственную копию нового
+ * снимка и может передать её в конструктор любых Settings.
+ *
+ * setProperty() тоже публикует новый снимок (копирование при записи), но
+ * подписчиков не оповещает: он нужен для первоначальной загрузки.
+ */
+class ReloadableEnvironment : public IEnvironment
+{
+public:
+    using Listener = std::function<void(std::shared_ptr<IEnvironment>)>;
+
+    ReloadableEnvironment()
+        : snapshot_(std::make_shared<const Environment>())
+    {
+    }
+
+    explicit ReloadableEnvironment(std::shared_ptr<const Environment> initial)
+        : snapshot_(std::move(initial))
+    {
+    }
+
+    std::any getProperty(const std::string& key) const override
+    {
+        return snapshot()->getProperty(key);
+    }
+
+    void setProperty(const std::string& key, const std::any& value) override
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto next = std::make_shared<Environment>(*snapshot());
+        next->setProperty(key, value);
+        std::atomic_store(&snapshot_, std::shared_ptr<const Environment>(next));
+    }
+
+    /**
+     * @brief Текущий снимок конфигурации
+     */
+    std::shared_ptr<const Environment> snapshot() const
+    {
+        return std::atomic_load(&snapshot_);
+    }
+
+    /**
+     * @brief Подменить конфигурацию и оповестить подписчиков
+     *
+     * Исключение подписчика логируется и не мешает остальным.
+     */
+    void publish(std::shared_ptr<const Environment> next)
+    {
+        std::vector<Listener> listeners;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            std::atomic_store(&snapshot_, next);
+            for (const auto& [id, listener] : listeners_)
+            {
+                listeners.push_back(listener);
+            }
+        }
+
+        for (const auto& listener : listeners)
+        {
+            try
+            {
+                listener(std::make_shared<Environment>(*next));
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[ReloadableEnvironment] Listener failed: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    /**
+     * @brief Подписаться на новые снимки
+     * @return Идентификатор для unsubscribe()
+     */
+    std::size_t subscribe(Listener listener)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        std::size_t id = nextId_++;
+        listeners_.emplace(id, std::move(listener));
+        return id;
+    }
+
+    void unsubscribe(std::size_t id)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        listeners_.erase(id);
+    }
+
+private:
+    std::shared_ptr<const Environment> snapshot_;   ///< Только через std::atomic_load/atomic_store
+
+    std::mutex writeMutex_;
+    std::map<std::size_t, Listener> listeners_;
+    std::size_t nextId_ = 0;
+};
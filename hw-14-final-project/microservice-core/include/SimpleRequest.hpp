@@ -2,6 +2,7 @@
 
 #include "IRequest.hpp"
 #include <string>
+#include <string_view>
 #include <map>
 
 /**
@@ -37,6 +38,27 @@ struct SimpleRequest : IRequest
         return headers_;
     }
 
+    std::string getHeader(const std::string& name) const override
+    {
+        return std::string(getHeaderView(name));
+    }
+
+    std::string_view getPathView() const override
+    {
+        return path_;
+    }
+
+    std::string_view getHeaderView(const std::string& name) const override
+    {
+        auto it = headers_.find(name);
+        return it == headers_.end() ? std::string_view() : std::string_view(it->second);
+    }
+
+    std::string_view getIpView() const override
+    {
+        return ip_;
+    }
+
 private:
     std::string method_;
     std::string path_;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IResponse.hpp"
+#include <algorithm>
+#include <cctype>
 #include <string>
 #include <map>
 
@@ -36,6 +38,25 @@ public:
     std::string getBody() const { return body_; }
     std::map<std::string, std::string> getHeaders() const { return headers_; }
 
+    /**
+     * @brief Значение заголовка без учёта регистра имени ("" если нет)
+     */
+    std::string getHeader(const std::string& name) const
+    {
+        for (const auto& [key, value] : headers_)
+        {
+            if (key.size() == name.size() &&
+                std::equal(key.begin(), key.end(), name.begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) ==
+                           std::tolower(static_cast<unsigned char>(b));
+                }))
+            {
+                return value;
+            }
+        }
+        return "";
+    }
+
 private:
     int status_;
     std::string body_;
@@ -1,10 +1,22 @@
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <unordered_map>
 #include <shared_mutex>
 #include <memory>
 #include <mutex>
+#include <vector>
 
+/**
+ * @brief Потокобезопасная хэш-таблица с вытеснением по алгоритму CLOCK
+ *
+ * Ключи стоят в кольце в порядке вставки. find() отмечает запись как
+ * прочитанную (атомарный флаг, под разделяемой блокировкой). При нехватке
+ * места стрелка обходит кольцо от самых старых записей: отмеченная
+ * получает второй шанс (флаг сбрасывается), первая неотмеченная
+ * вытесняется. Новые ключи встают позади стрелки и проверяются последними.
+ */
 template <typename K, typename V>
 class ThreadSafeMap
 {
@@ -14,14 +26,86 @@ public:
     void insert(const K &key, const std::shared_ptr<V> &value)
     {
         std::unique_lock<std::shared_mutex> lock(mutex_); // ← UNIQUE_LOCK для WRITE!
-        map_[key] = value;
+        store(key, value);
+    }
+
+    /**
+     * @brief Вставить, не давая размеру превысить maxSize
+     *
+     * Если ключа нет и места не осталось, вытесняются записи,
+     * которые давно не читались (CLOCK). 0 - без ограничения.
+     */
+    void insertBounded(const K &key, const std::shared_ptr<V> &value, std::size_t maxSize)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (maxSize != 0 && map_.find(key) == map_.end())
+        {
+            while (!map_.empty() && map_.size() >= maxSize)
+            {
+                erase(victim());
+            }
+        }
+        store(key, value);
+    }
+
+    /**
+     * @brief Вставить с фильтром допуска: при нехватке места новый ключ
+     *        вытесняет запись, только если admit(ключ, вытесняемый ключ)
+     * @return false, если ключ не допущен
+     */
+    template <typename Admit>
+    bool insertBounded(const K &key, const std::shared_ptr<V> &value, std::size_t maxSize, Admit &&admit)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (maxSize != 0 && map_.find(key) == map_.end())
+        {
+            while (!map_.empty() && map_.size() >= maxSize)
+            {
+                auto candidate = victim();
+                if (!admit(key, candidate->first))
+                {
+                    return false;
+                }
+                erase(candidate);
+            }
+        }
+        store(key, value);
+        return true;
+    }
+
+    /**
+     * @brief Вытеснять записи (CLOCK), пока размер больше maxSize
+     */
+    void trimTo(std::size_t maxSize)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        while (map_.size() > maxSize)
+        {
+            erase(victim());
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return map_.size();
     }
 
     std::shared_ptr<V> find(const K &key) const
     {
         std::shared_lock<std::shared_mutex> lock(mutex_); // ← shared_lock для READ
         auto it = map_.find(key);
-        return (it != map_.end()) ? it->second : nullptr;
+        if (it == map_.end())
+        {
+            return nullptr;
+        }
+        // Только чтение, пока флаг уже стоит: запись на каждом попадании
+        // гоняла бы строку кэша горячего ключа между ядрами читателей
+        if (!it->second.referenced.load(std::memory_order_relaxed))
+        {
+            it->second.referenced.store(true, std::memory_order_relaxed);
+        }
+        return it->second.value;
     }
 
     bool contains(const K &key) const
@@ -33,13 +117,19 @@ public:
     void remove(const K &key)
     {
         std::unique_lock<std::shared_mutex> lock(mutex_); // ← UNIQUE_LOCK для WRITE!
-        map_.erase(key);
+        auto it = map_.find(key);
+        if (it != map_.end())
+        {
+            erase(it);
+        }
     }
 
     void clear()
     {
         std::unique_lock<std::shared_mutex> lock(mutex_); // ← UNIQUE_LOCK для WRITE!
         map_.clear();
+        ring_.clear();
+        hand_ = ring_.end();
     }
 
     std::vector<std::shared_ptr<V>> getAll() const
@@ -47,14 +137,67 @@ public:
         std::shared_lock<std::shared_mutex> lock(mutex_);
         std::vector<std::shared_ptr<V>> result;
         result.reserve(map_.size());
-        for (const auto &[key, value] : map_)
+        for (const auto &[key, entry] : map_)
         {
-            result.push_back(value);
+            result.push_back(entry.value);
         }
         return result;
     }
 
 private:
+    using RingIterator = typename std::list<K>::iterator;
+
+    struct Entry
+    {
+        std::shared_ptr<V> value;
+        RingIterator position;
+        mutable std::atomic<bool> referenced{false};
+    };
+
+    using MapIterator = typename std::unordered_map<K, Entry>::iterator;
+
     mutable std::shared_mutex mutex_;
-    std::unordered_map<K, std::shared_ptr<V>> map_;
+    std::unordered_map<K, Entry> map_;
+    std::list<K> ring_;                  ///< Ключи в порядке вставки
+    RingIterator hand_ = ring_.end();    ///< Следующий кандидат на вытеснение
+
+    void store(const K &key, const std::shared_ptr<V> &value)
+    {
+        auto [it, inserted] = map_.try_emplace(key);
+        it->second.value = value;
+        if (inserted)
+        {
+            it->second.position = ring_.insert(hand_, key);
+        }
+    }
+
+    /**
+     * @brief Первая неотмеченная запись от стрелки; map_ не пуст
+     */
+    MapIterator victim()
+    {
+        while (true)
+        {
+            if (hand_ == ring_.end())
+            {
+                hand_ = ring_.begin();
+            }
+            auto it = map_.find(*hand_);
+            if (!it->second.referenced.exchange(false, std::memory_order_relaxed))
+            {
+                return it;
+            }
+            ++hand_;
+        }
+    }
+
+    void erase(MapIterator it)
+    {
+        if (hand_ == it->second.position)
+        {
+            ++hand_;
+        }
+        ring_.erase(it->second.position);
+        map_.erase(it);
+    }
 };
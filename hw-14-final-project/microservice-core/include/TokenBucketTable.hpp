@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file TokenBucketTable.hpp
+ * @brief Шардированная таблица token bucket'ов ограниченного размера
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class TokenBucketTable
+ * @brief Корзины клиентов, адресуемые 64-битным хешем ключа
+ *
+ * Память выделяется один раз в конструкторе: каждый шард - массив
+ * слотов с открытой адресацией и своим мьютексом. Корзина пополняется
+ * лениво, при обращении, по прошедшему времени. Если в окне поиска нет
+ * свободного слота, вытесняется корзина, к которой дольше всех не
+ * обращались (вытесненный клиент начнёт с полной корзины).
+ */
+class TokenBucketTable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Результат попытки взять токен
+     */
+    struct Decision
+    {
+        bool allowed;
+        std::chrono::milliseconds retryAfter;  ///< Когда появится токен (если отказ)
+    };
+
+    /**
+     * @param capacity Сколько клиентов помнить (округляется вверх по шардам)
+     * @param shards Число шардов (независимых блокировок)
+     */
+    explicit TokenBucketTable(std::size_t capacity, std::size_t shards = DEFAULT_SHARDS)
+        : shardCount_(std::max<std::size_t>(1, shards)),
+          shards_(new Shard[shardCount_])
+    {
+        // Не меньше окна поиска, иначе соседние ключи вытесняют друг друга
+        std::size_t perShard = PROBE_LIMIT;
+        while (perShard * shardCount_ < capacity)
+        {
+            perShard <<= 1;
+        }
+        slotMask_ = perShard - 1;
+
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            shards_[i].slots.resize(perShard);
+        }
+    }
+
+    /**
+     * @brief Взять токен из корзины ключа
+     * @param key Хеш ключа клиента
+     * @param ratePerSecond Скорость пополнения
+     * @param burst Ёмкость корзины
+     */
+    Decision take(std::uint64_t key, double ratePerSecond, double burst, Clock::time_point now)
+    {
+        Shard& shard = shards_[(key >> 32) % shardCount_];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Slot& slot = findSlot(shard, key, now, burst);
+
+        // Ленивое пополнение за прошедшее время
+        double elapsed = std::chrono::duration<double>(now - slot.updatedAt).count();
+        if (elapsed > 0)
+        {
+            slot.tokens = std::min(burst, slot.tokens + elapsed * ratePerSecond);
+            slot.updatedAt = now;
+        }
+
+        if (slot.tokens >= 1.0)
+        {
+            slot.tokens -= 1.0;
+            return {true, std::chrono::milliseconds(0)};
+        }
+
+        double wait = ratePerSecond > 0 ? (1.0 - slot.tokens) / ratePerSecond : 1.0;
+        return {false, std::chrono::milliseconds(static_cast<std::int64_t>(std::ceil(wait * 1000)))};
+    }
+
+    /**
+     * @brief Сколько клиентов сейчас отслеживается
+     */
+    std::size_t size() const
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shardCount_; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            total += shards_[i].used;
+        }
+        return total;
+    }
+
+    std::size_t capacity() const
+    {
+        return shardCount_ * (slotMask_ + 1);
+    }
+
+private:
+    static constexpr std::size_t DEFAULT_SHARDS = 16;
+
+    /// Сколько соседних слотов просматривается при поиске
+    static constexpr std::size_t PROBE_LIMIT = 8;
+
+    struct Slot
+    {
+        std::uint64_t key = 0;
+        bool used = false;
+        double tokens = 0;
+        Clock::time_point updatedAt{};
+    };
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::vector<Slot> slots;
+        std::size_t used = 0;
+    };
+
+    Slot& findSlot(Shard& shard, std::uint64_t key, Clock::time_point now, double burst)
+    {
+        std::size_t start = static_cast<std::size_t>(key) & slotMask_;
+        Slot* freeSlot = nullptr;
+        Slot* oldest = nullptr;
+
+        for (std::size_t i = 0; i < PROBE_LIMIT; ++i)
+        {
+            Slot& slot = shard.slots[(start + i) & slotMask_];
+            if (slot.used && slot.key == key)
+            {
+                return slot;
+            }
+            if (!slot.used)
+            {
+                if (!freeSlot)
+                {
+                    freeSlot = &slot;
+                }
+            }
+            else if (!oldest || slot.updatedAt < oldest->updatedAt)
+            {
+                oldest = &slot;
+            }
+        }
+
+        Slot* target = freeSlot ? freeSlot : oldest;
+        if (!target->used)
+        {
+            ++shard.used;
+        }
+
+        // Новый клиент начинает с полной корзины
+        *target = Slot{key, true, burst, now};
+        return *target;
+    }
+
+    std::size_t shardCount_;
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t slotMask_ = 0;
+};
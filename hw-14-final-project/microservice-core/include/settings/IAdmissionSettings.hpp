@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @file IAdmissionSettings.hpp
+ * @brief Интерфейс настроек допуска запросов под нагрузкой
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @interface IAdmissionSettings
+ * @brief Лимиты, при превышении которых сервер отвечает 503
+ *
+ * Нулевой лимит означает "без ограничения".
+ */
+class IAdmissionSettings
+{
+public:
+    virtual ~IAdmissionSettings() = default;
+
+    /**
+     * @brief Максимум одновременно открытых соединений
+     */
+    virtual int getMaxConnections() const = 0;
+
+    /**
+     * @brief Максимум запросов, одновременно находящихся в handler'ах
+     */
+    virtual int getMaxInFlight() const = 0;
+
+    /**
+     * @brief Допустимое (сглаженное) время обработки запроса
+     */
+    virtual std::chrono::milliseconds getLatencyBudget() const = 0;
+
+    /**
+     * @brief За сколько сглаженное время обработки вдвое забывается без новых замеров
+     */
+    virtual std::chrono::milliseconds getLatencyHalfLife() const = 0;
+
+    /**
+     * @brief Значение заголовка Retry-After в ответе 503, секунды
+     */
+    virtual int getRetryAfterSeconds() const = 0;
+
+    /**
+     * @brief Маршруты, которые отсекаются последними (например, маршруты /r/...)
+     */
+    virtual std::vector<std::string> getCriticalRoutes() const = 0;
+
+    /**
+     * @brief Маршруты, которые отсекаются первыми (служебные API)
+     */
+    virtual std::vector<std::string> getLowPriorityRoutes() const = 0;
+
+    /**
+     * @brief Маршруты, время которых не входит в сглаженное время обработки
+     *
+     * Долгий опрос держит запрос, пока не появятся данные: его длительность
+     * задаёт клиент, а не нагрузка на сервер.
+     */
+    virtual std::vector<std::string> getUntimedRoutes() const = 0;
+};
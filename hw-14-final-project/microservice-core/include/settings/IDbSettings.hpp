@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <string>
 
 /**
@@ -40,4 +41,14 @@ public:
      * @brief Получить пароль
      */
     virtual std::string getPassword() const = 0;
+
+    /**
+     * @brief Получить размер пула соединений
+     */
+    virtual int getPoolSize() const = 0;
+
+    /**
+     * @brief Сколько соединение, вернувшееся в пул, выдаётся без проверки SELECT 1
+     */
+    virtual std::chrono::milliseconds getPoolValidationInterval() const = 0;
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file IRateLimitSettings.hpp
+ * @brief Интерфейс настроек ограничения частоты запросов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct RateLimitRule
+ * @brief Token bucket для маршрутов, подходящих под pattern
+ */
+struct RateLimitRule
+{
+    std::string pattern;        ///< Шаблон маршрута (как у handler'ов, например /r/*)
+    double ratePerSecond = 0;   ///< Скорость пополнения
+    double burst = 0;           ///< Ёмкость корзины
+    std::string keyHeader;      ///< Заголовок-ключ клиента; пусто - IP
+};
+
+/**
+ * @interface IRateLimitSettings
+ * @brief Правила ограничения частоты запросов на клиента
+ */
+class IRateLimitSettings
+{
+public:
+    virtual ~IRateLimitSettings() = default;
+
+    /**
+     * @brief Правила в порядке проверки; применяется первое подходящее
+     */
+    virtual std::vector<RateLimitRule> getRules() const = 0;
+
+    /**
+     * @brief Максимум одновременно отслеживаемых клиентов
+     */
+    virtual std::size_t getMaxClients() const = 0;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 /**
@@ -12,4 +13,16 @@ public:
     virtual ~IServerSettings() = default;
     virtual std::string getHost() const = 0;
     virtual int getPort() const = 0;
+
+    /// Сколько после stop() ждать завершения запросов в обработке
+    virtual std::chrono::milliseconds getDrainTimeout() const = 0;
+
+    /// Разрешить второму процессу слушать тот же порт (SO_REUSEPORT)
+    virtual bool isReusePort() const = 0;
+
+    /// Число воркеров со своим io_context и acceptor (0 - поток на соединение)
+    virtual int getWorkers() const = 0;
+
+    /// Закреплять потоки воркеров за CPU
+    virtual bool isCpuPinning() const = 0;
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "PrerenderedResponse.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @file PrerenderedResponse.cpp
+ * @brief Сборка заранее сериализованного HTTP-ответа
+ * @author Anton Tobolkin
+ */
+
+PrerenderedResponse::PrerenderedResponse(int status, Headers headers, std::string body)
+    : status_(status), headers_(std::move(headers)), body_(std::move(body))
+{
+    head_ = "HTTP/1.1 " + std::to_string(status_) + " " + reasonPhrase(status_) + "\r\n";
+    for (const auto& [name, value] : headers_)
+    {
+        if (name.empty() || name.find(':') != std::string::npos ||
+            !isSafeHeaderValue(name) || !isSafeHeaderValue(value))
+        {
+            throw std::invalid_argument("Unsafe header: " + name);
+        }
+        head_ += name + ": " + value + "\r\n";
+    }
+    head_ += "Content-Length: " + std::to_string(body_.size()) + "\r\n";
+}
+
+std::shared_ptr<const PrerenderedResponse> PrerenderedResponse::redirect(
+    int status, const std::string& location, Headers extraHeaders)
+{
+    Headers headers;
+    headers.reserve(extraHeaders.size() + 1);
+    headers.emplace_back("Location", location);
+    for (auto& header : extraHeaders)
+    {
+        headers.push_back(std::move(header));
+    }
+    return std::make_shared<const PrerenderedResponse>(status, std::move(headers));
+}
+
+bool PrerenderedResponse::isSafeHeaderValue(const std::string& value)
+{
+    return std::none_of(value.begin(), value.end(), [](char c) {
+        auto code = static_cast<unsigned char>(c);
+        return (code < 0x20 && c != '\t') || code == 0x7F;
+    });
+}
+
+const char* PrerenderedResponse::reasonPhrase(int status)
+{
+    switch (status)
+    {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 307: return "Temporary Redirect";
+    case 308: return "Permanent Redirect";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default: return "";
+    }
+}
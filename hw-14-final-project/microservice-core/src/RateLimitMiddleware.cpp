@@ -0,0 +1,113 @@
+#include "RateLimitMiddleware.hpp"
+#include "RouteMatcher.hpp"
+#include <iostream>
+
+/**
+ * @file RateLimitMiddleware.cpp
+ * @brief Реализация ограничения частоты запросов
+ * @author Anton Tobolkin
+ */
+
+RateLimitMiddleware::RateLimitMiddleware(const IRateLimitSettings& settings)
+    : rules_(settings.getRules()),
+      buckets_(settings.getMaxClients()),
+      lastReport_((TokenBucketTable::Clock::now() - REJECT_LOG_INTERVAL).time_since_epoch().count())
+{
+    for (const auto& rule : rules_)
+    {
+        std::cout << "[RateLimitMiddleware] " << rule.pattern << ": " << rule.ratePerSecond
+                  << "/s, burst " << rule.burst << ", key "
+                  << (rule.keyHeader.empty() ? std::string("ip") : rule.keyHeader) << std::endl;
+    }
+}
+
+void RateLimitMiddleware::handle(IRequest& req, IResponse& res, IHttpHandler& next)
+{
+    int ruleIndex = findRule(req.getPath());
+    if (ruleIndex < 0)
+    {
+        next.handle(req, res);
+        return;
+    }
+
+    const auto& rule = rules_[ruleIndex];
+
+    // Ключ хешируем прямо в запросе, без копии строки
+    std::string_view client = rule.keyHeader.empty() ? std::string_view() : req.getHeaderView(rule.keyHeader);
+    if (client.empty())
+    {
+        client = req.getIpView();
+    }
+
+    auto now = TokenBucketTable::Clock::now();
+    auto decision = buckets_.take(hashKey(client, ruleIndex), rule.ratePerSecond, rule.burst, now);
+    if (!decision.allowed)
+    {
+        // Округляем вверх: Retry-After в целых секундах
+        auto retryAfter = (decision.retryAfter.count() + 999) / 1000;
+
+        reportRejected(rule, client, now);
+        res.setStatus(429);
+        res.setHeader("Retry-After", std::to_string(retryAfter));
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Too many requests"})");
+        return;
+    }
+
+    next.handle(req, res);
+}
+
+std::size_t RateLimitMiddleware::trackedClients() const
+{
+    return buckets_.size();
+}
+
+std::uint64_t RateLimitMiddleware::rejectedRequests() const
+{
+    return rejected_.load(std::memory_order_relaxed);
+}
+
+void RateLimitMiddleware::reportRejected(const RateLimitRule& rule, std::string_view client,
+                                         TokenBucketTable::Clock::time_point now)
+{
+    std::uint64_t rejected = rejected_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    // Строку лога пишет один поток за интервал, остальные только считают
+    auto last = lastReport_.load(std::memory_order_relaxed);
+    auto ticks = now.time_since_epoch().count();
+    if (ticks - last < std::chrono::duration_cast<TokenBucketTable::Clock::duration>(REJECT_LOG_INTERVAL).count() ||
+        !lastReport_.compare_exchange_strong(last, ticks, std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    std::cerr << "[RateLimitMiddleware] Rate limit exceeded for " << client << " on " << rule.pattern
+              << " (" << rejected << " requests rejected in total)" << std::endl;
+}
+
+int RateLimitMiddleware::findRule(const std::string& path) const
+{
+    for (std::size_t i = 0; i < rules_.size(); ++i)
+    {
+        if (rules_[i].pattern == path || RouteMatcher::matches(rules_[i].pattern, path))
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::uint64_t RateLimitMiddleware::hashKey(std::string_view client, int ruleIndex)
+{
+    // FNV-1a по ключу клиента, затем перемешиваем с номером правила
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char ch : client)
+    {
+        hash ^= ch;
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= static_cast<std::uint64_t>(ruleIndex + 1) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+    return hash;
+}
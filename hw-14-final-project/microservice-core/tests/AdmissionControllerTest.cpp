@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "AdmissionController.hpp"
+#include <thread>
+
+namespace
+{
+class StubAdmissionSettings : public IAdmissionSettings
+{
+public:
+    int maxConnections = 0;
+    int maxInFlight = 0;
+    std::chrono::milliseconds latencyBudget{0};
+    std::chrono::milliseconds latencyHalfLife{1000};
+    std::vector<std::string> criticalRoutes;
+    std::vector<std::string> lowPriorityRoutes;
+    std::vector<std::string> untimedRoutes;
+
+    int getMaxConnections() const override { return maxConnections; }
+    int getMaxInFlight() const override { return maxInFlight; }
+    std::chrono::milliseconds getLatencyBudget() const override { return latencyBudget; }
+    std::chrono::milliseconds getLatencyHalfLife() const override { return latencyHalfLife; }
+    int getRetryAfterSeconds() const override { return 1; }
+    std::vector<std::string> getCriticalRoutes() const override { return criticalRoutes; }
+    std::vector<std::string> getLowPriorityRoutes() const override { return lowPriorityRoutes; }
+    std::vector<std::string> getUntimedRoutes() const override { return untimedRoutes; }
+};
+}
+
+// Без лимитов все запросы принимаются
+TEST(AdmissionControllerTest, UnlimitedAdmitsEverything)
+{
+    StubAdmissionSettings settings;
+    AdmissionController controller(settings);
+
+    std::vector<AdmissionController::Ticket> tickets;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto ticket = controller.admit(RequestPriority::Low);
+        ASSERT_TRUE(ticket.has_value());
+        tickets.push_back(std::move(*ticket));
+    }
+    EXPECT_EQ(controller.inFlight(), 100);
+    EXPECT_TRUE(controller.tryAcquireConnection());
+}
+
+// Низкий приоритет отсекается раньше высокого
+TEST(AdmissionControllerTest, PriorityGetsShareOfInFlightLimit)
+{
+    StubAdmissionSettings settings;
+    settings.maxInFlight = 4;
+    AdmissionController controller(settings);
+
+    auto first = controller.admit(RequestPriority::Low);
+    auto second = controller.admit(RequestPriority::Low);
+    ASSERT_TRUE(first && second);
+    EXPECT_FALSE(controller.admit(RequestPriority::Low).has_value());   // 1/2 лимита
+
+    auto third = controller.admit(RequestPriority::Normal);
+    ASSERT_TRUE(third);
+    EXPECT_FALSE(controller.admit(RequestPriority::Normal).has_value()); // 3/4 лимита
+
+    auto fourth = controller.admit(RequestPriority::Critical);
+    ASSERT_TRUE(fourth);
+    EXPECT_FALSE(controller.admit(RequestPriority::Critical).has_value());
+
+    EXPECT_EQ(controller.shedCount(), 3u);
+}
+
+// Освобождённое место снова доступно
+TEST(AdmissionControllerTest, TicketReleasesSlot)
+{
+    StubAdmissionSettings settings;
+    settings.maxInFlight = 1;
+    AdmissionController controller(settings);
+
+    {
+        auto ticket = controller.admit(RequestPriority::Critical);
+        ASSERT_TRUE(ticket);
+        EXPECT_FALSE(controller.admit(RequestPriority::Critical).has_value());
+    }
+
+    EXPECT_EQ(controller.inFlight(), 0);
+    EXPECT_TRUE(controller.admit(RequestPriority::Critical).has_value());
+}
+
+// Превышение бюджета времени отсекает низкий приоритет
+TEST(AdmissionControllerTest, LatencyOverBudgetShedsLowPriority)
+{
+    StubAdmissionSettings settings;
+    settings.latencyBudget = std::chrono::milliseconds(1);
+    AdmissionController controller(settings);
+
+    {
+        auto slow = controller.admit(RequestPriority::Normal);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_TRUE(controller.isOverBudget());
+    EXPECT_FALSE(controller.admit(RequestPriority::Low).has_value());
+    EXPECT_TRUE(controller.admit(RequestPriority::Normal).has_value());
+    EXPECT_TRUE(controller.admit(RequestPriority::Critical).has_value());
+}
+
+// Без новых замеров оценка забывается, и Low снова допускается
+TEST(AdmissionControllerTest, LatencyEstimateDecaysWithoutSamples)
+{
+    StubAdmissionSettings settings;
+    settings.latencyBudget = std::chrono::milliseconds(1);
+    settings.latencyHalfLife = std::chrono::milliseconds(5);
+    AdmissionController controller(settings);
+
+    {
+        auto slow = controller.admit(RequestPriority::Normal);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    EXPECT_FALSE(controller.admit(RequestPriority::Low).has_value());
+
+    // 20 мс за 20 периодов полураспада - меньше микросекунды
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_FALSE(controller.isOverBudget());
+    EXPECT_TRUE(controller.admit(RequestPriority::Low).has_value());
+}
+
+// Долгий опрос не попадает в оценку времени обработки
+TEST(AdmissionControllerTest, UntimedRoutesDoNotAffectLatency)
+{
+    StubAdmissionSettings settings;
+    settings.latencyBudget = std::chrono::milliseconds(1);
+    settings.untimedRoutes = {"/rules/changes"};
+    AdmissionController controller(settings);
+
+    EXPECT_FALSE(controller.isTimed("/rules/changes"));
+    EXPECT_TRUE(controller.isTimed("/rules/promo"));
+
+    {
+        auto poll = controller.admit(RequestPriority::Normal, controller.isTimed("/rules/changes"));
+        ASSERT_TRUE(poll);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    EXPECT_EQ(controller.inFlight(), 0);
+    EXPECT_EQ(controller.latencyEstimate(), std::chrono::microseconds(0));
+    EXPECT_TRUE(controller.admit(RequestPriority::Low).has_value());
+}
+
+// Лимит соединений
+TEST(AdmissionControllerTest, ConnectionLimit)
+{
+    StubAdmissionSettings settings;
+    settings.maxConnections = 2;
+    AdmissionController controller(settings);
+
+    EXPECT_TRUE(controller.tryAcquireConnection());
+    EXPECT_TRUE(controller.tryAcquireConnection());
+    EXPECT_FALSE(controller.tryAcquireConnection());
+
+    controller.releaseConnection();
+    EXPECT_TRUE(controller.tryAcquireConnection());
+}
+
+// Приоритет определяется по шаблонам маршрутов
+TEST(AdmissionControllerTest, ClassifiesRoutes)
+{
+    StubAdmissionSettings settings;
+    settings.criticalRoutes = {"/r/*"};
+    settings.lowPriorityRoutes = {"/rules", "/rules/*", "/cache/invalidate/*"};
+    AdmissionController controller(settings);
+
+    EXPECT_EQ(controller.classify("/r/promo"), RequestPriority::Critical);
+    EXPECT_EQ(controller.classify("/rules"), RequestPriority::Low);
+    EXPECT_EQ(controller.classify("/rules/promo"), RequestPriority::Low);
+    EXPECT_EQ(controller.classify("/cache/invalidate/promo"), RequestPriority::Low);
+    EXPECT_EQ(controller.classify("/health"), RequestPriority::Normal);
+}
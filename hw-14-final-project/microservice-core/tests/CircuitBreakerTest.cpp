@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "CircuitBreaker.hpp"
+
+/**
+ * @file CircuitBreakerTest.cpp
+ * @brief Unit-тесты для CircuitBreaker
+ */
+
+using namespace std::chrono_literals;
+
+// Серия отказов размыкает автомат, вызовы отклоняются до таймаута
+TEST(CircuitBreakerTest, OpensAfterConsecutiveFailures)
+{
+    CircuitBreaker breaker(3, 1000ms);
+    auto now = CircuitBreaker::Clock::now();
+
+    breaker.recordFailure(now);
+    breaker.recordFailure(now);
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Closed);
+    EXPECT_TRUE(breaker.allowRequest(now));
+
+    breaker.recordFailure(now);
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Open);
+    EXPECT_FALSE(breaker.allowRequest(now + 500ms));
+}
+
+// Успех между отказами сбрасывает счётчик
+TEST(CircuitBreakerTest, SuccessResetsFailureCount)
+{
+    CircuitBreaker breaker(2, 1000ms);
+    auto now = CircuitBreaker::Clock::now();
+
+    breaker.recordFailure(now);
+    breaker.recordSuccess();
+    breaker.recordFailure(now);
+
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Closed);
+}
+
+// После таймаута пропускается один пробный вызов
+TEST(CircuitBreakerTest, HalfOpenAllowsSingleProbe)
+{
+    CircuitBreaker breaker(1, 1000ms);
+    auto now = CircuitBreaker::Clock::now();
+
+    breaker.recordFailure(now);
+    ASSERT_EQ(breaker.state(), CircuitBreaker::State::Open);
+
+    EXPECT_TRUE(breaker.allowRequest(now + 1000ms));
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::HalfOpen);
+    EXPECT_FALSE(breaker.allowRequest(now + 1001ms));
+
+    // Неудачная проба размыкает автомат заново
+    breaker.recordFailure(now + 1001ms);
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Open);
+    EXPECT_FALSE(breaker.allowRequest(now + 1500ms));
+
+    // Удачная проба замыкает его
+    EXPECT_TRUE(breaker.allowRequest(now + 2001ms));
+    breaker.recordSuccess();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Closed);
+    EXPECT_TRUE(breaker.allowRequest(now + 2001ms));
+}
+
+// Нулевой порог отключает автомат
+TEST(CircuitBreakerTest, ZeroThresholdDisablesBreaker)
+{
+    CircuitBreaker breaker(0, 1000ms);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        breaker.recordFailure();
+    }
+
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::Closed);
+    EXPECT_TRUE(breaker.allowRequest());
+}
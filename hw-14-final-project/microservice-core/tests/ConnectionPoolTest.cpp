@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "ConnectionPool.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @file ConnectionPoolTest.cpp
+ * @brief Unit-тесты для ConnectionPool
+ */
+
+namespace
+{
+struct FakeConnection
+{
+    int id;
+    bool healthy = true;
+};
+
+// Фабрика нумерует созданные соединения
+struct CountingFactory
+{
+    std::shared_ptr<std::atomic<int>> created = std::make_shared<std::atomic<int>>(0);
+
+    std::unique_ptr<FakeConnection> operator()() const
+    {
+        return std::make_unique<FakeConnection>(FakeConnection{++*created});
+    }
+};
+
+bool isHealthy(FakeConnection& c)
+{
+    return c.healthy;
+}
+}
+
+// Все соединения открываются при создании пула
+TEST(ConnectionPoolTest, CreatesConnectionsEagerly)
+{
+    CountingFactory factory;
+    ConnectionPool<FakeConnection> pool(3, factory, isHealthy);
+
+    EXPECT_EQ(*factory.created, 3);
+    EXPECT_EQ(pool.idleCount(), 3u);
+}
+
+// Соединение возвращается в пул и переиспользуется
+TEST(ConnectionPoolTest, ReusesReleasedConnection)
+{
+    CountingFactory factory;
+    ConnectionPool<FakeConnection> pool(1, factory, isHealthy);
+
+    int firstId = 0;
+    {
+        auto lease = pool.acquire();
+        firstId = lease->id;
+        EXPECT_EQ(pool.idleCount(), 0u);
+    }
+    EXPECT_EQ(pool.idleCount(), 1u);
+
+    auto lease = pool.acquire();
+    EXPECT_EQ(lease->id, firstId);
+    EXPECT_EQ(*factory.created, 1);
+}
+
+// Пул ограничен: при исчерпании acquire ждёт и падает по таймауту
+TEST(ConnectionPoolTest, AcquireTimesOutWhenExhausted)
+{
+    ConnectionPool<FakeConnection> pool(1, CountingFactory{}, isHealthy,
+                                        std::chrono::milliseconds(20));
+
+    auto lease = pool.acquire();
+    EXPECT_THROW(pool.acquire(), std::runtime_error);
+}
+
+// Нездоровое соединение пересоздаётся перед выдачей
+TEST(ConnectionPoolTest, ReplacesUnhealthyConnection)
+{
+    CountingFactory factory;
+    ConnectionPool<FakeConnection> pool(1, factory, isHealthy);
+
+    {
+        auto lease = pool.acquire();
+        lease->healthy = false;
+    }
+
+    auto lease = pool.acquire();
+    EXPECT_TRUE(lease->healthy);
+    EXPECT_EQ(lease->id, 2);
+}
+
+// Недавно возвращённое соединение выдаётся без проверки, простоявшее дольше интервала - проверяется
+TEST(ConnectionPoolTest, HealthCheckSkippedWithinValidationInterval)
+{
+    CountingFactory factory;
+    int checks = 0;
+    auto countingCheck = [&checks](FakeConnection& c) {
+        ++checks;
+        return c.healthy;
+    };
+    ConnectionPool<FakeConnection> pool(1, factory, countingCheck,
+                                        std::chrono::seconds(1), std::chrono::milliseconds(100));
+
+    pool.acquire();
+    pool.acquire();
+    EXPECT_EQ(checks, 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    {
+        auto lease = pool.acquire();
+        lease->healthy = false;
+    }
+    EXPECT_EQ(checks, 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    auto lease = pool.acquire();
+    EXPECT_EQ(checks, 2);
+    EXPECT_EQ(lease->id, 2);
+}
+
+// Помеченное сломанным соединение не возвращается, место освобождается
+TEST(ConnectionPoolTest, InvalidatedConnectionIsRecreated)
+{
+    CountingFactory factory;
+    ConnectionPool<FakeConnection> pool(1, factory, isHealthy,
+                                        std::chrono::milliseconds(20));
+
+    {
+        auto lease = pool.acquire();
+        lease.invalidate();
+    }
+    EXPECT_EQ(pool.idleCount(), 0u);
+
+    auto lease = pool.acquire();
+    EXPECT_EQ(lease->id, 2);
+}
+
+// Ошибка фабрики при пересоздании не "съедает" место в пуле
+TEST(ConnectionPoolTest, FactoryFailureKeepsCapacity)
+{
+    auto fail = std::make_shared<bool>(false);
+    auto created = std::make_shared<int>(0);
+    ConnectionPool<FakeConnection> pool(
+        1,
+        [fail, created] {
+            if (*fail)
+            {
+                throw std::runtime_error("connect failed");
+            }
+            return std::make_unique<FakeConnection>(FakeConnection{++*created});
+        },
+        isHealthy,
+        std::chrono::milliseconds(20));
+
+    pool.acquire().invalidate();
+
+    *fail = true;
+    EXPECT_THROW(pool.acquire(), std::runtime_error);
+
+    *fail = false;
+    auto lease = pool.acquire();
+    EXPECT_EQ(lease->id, 2);
+}
+
+// Нулевой размер пула запрещён
+TEST(ConnectionPoolTest, ZeroSizeThrows)
+{
+    EXPECT_THROW((ConnectionPool<FakeConnection>(0, CountingFactory{}, isHealthy)),
+                 std::invalid_argument);
+}
+
+// Одновременно выдано не больше maxSize соединений
+TEST(ConnectionPoolTest, ConcurrentLeasesAreBounded)
+{
+    ConnectionPool<FakeConnection> pool(2, CountingFactory{}, isHealthy);
+
+    std::atomic<int> inUse{0};
+    std::atomic<int> maxInUse{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto lease = pool.acquire();
+                int now = ++inUse;
+                int prev = maxInUse.load();
+                while (now > prev && !maxInUse.compare_exchange_weak(prev, now))
+                {
+                }
+                std::this_thread::yield();
+                --inUse;
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_LE(maxInUse.load(), 2);
+    EXPECT_EQ(pool.idleCount(), 2u);
+}
+
+// Уменьшение закрывает свободные соединения, выданные - при возврате
+TEST(ConnectionPoolTest, ResizeShrinksAndGrows)
+{
+    CountingFactory factory;
+    ConnectionPool<FakeConnection> pool(3, factory, isHealthy);
+
+    {
+        auto first = pool.acquire();
+        auto second = pool.acquire();
+        pool.resize(1);
+        EXPECT_EQ(pool.maxSize(), 1u);
+        EXPECT_EQ(pool.idleCount(), 0u);
+    }
+    // Из двух выданных в пул вернулось одно
+    EXPECT_EQ(pool.idleCount(), 1u);
+
+    pool.resize(2);
+    auto a = pool.acquire();
+    auto b = pool.acquire();   // новое соединение создаётся по требованию
+    EXPECT_EQ(factory.created->load(), 4);
+
+    EXPECT_THROW(pool.resize(0), std::invalid_argument);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "CountMinSketch.hpp"
+#include <thread>
+#include <vector>
+
+/**
+ * @file CountMinSketchTest.cpp
+ * @brief Unit-тесты для CountMinSketch
+ */
+
+// Оценка не меньше истинной частоты и близка к ней при малой загрузке
+TEST(CountMinSketchTest, EstimateNeverUndercounts)
+{
+    CountMinSketch sketch(1024, 4);
+
+    for (std::uint64_t key = 1; key <= 100; ++key)
+    {
+        for (std::uint64_t i = 0; i < key; ++i)
+        {
+            sketch.add(key * 0x100000001B3ULL);
+        }
+    }
+
+    for (std::uint64_t key = 1; key <= 100; ++key)
+    {
+        std::uint32_t estimate = sketch.estimate(key * 0x100000001B3ULL);
+        EXPECT_GE(estimate, key);
+        EXPECT_LE(estimate, key + 50);
+    }
+    EXPECT_EQ(sketch.estimate(0xDEADBEEF), 0u);
+}
+
+// Ширина округляется до степени двойки, decay делит счётчики пополам
+TEST(CountMinSketchTest, DecayHalvesCounters)
+{
+    CountMinSketch sketch(1000, 3);
+    EXPECT_EQ(sketch.width(), 1024u);
+    EXPECT_EQ(sketch.depth(), 3u);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        sketch.add(42);
+    }
+    EXPECT_EQ(sketch.add(42), 11u);
+
+    sketch.decay();
+    EXPECT_EQ(sketch.estimate(42), 5u);
+}
+
+// Параллельные add не теряют событий
+TEST(CountMinSketchTest, ConcurrentAddsAreCounted)
+{
+    CountMinSketch sketch(64, 2);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&sketch] {
+            for (int i = 0; i < 10000; ++i)
+            {
+                sketch.add(7);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(sketch.estimate(7), 40000u);
+}
+
+// Каждый поток пишет в свою копию, оценка складывает все копии
+TEST(CountMinSketchTest, ShardedAddsSumAcrossThreads)
+{
+    CountMinSketch sketch(64, 2, 4);
+    EXPECT_EQ(sketch.shards(), 4u);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&sketch] {
+            for (int i = 0; i < 10000; ++i)
+            {
+                sketch.add(7);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(sketch.estimate(7), 40000u);
+
+    sketch.decay();
+    EXPECT_EQ(sketch.estimate(7), 20000u);
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include "HttpEndpoint.hpp"
+
+TEST(HttpEndpointTest, ParsesHostAndPort) {
+    auto endpoint = HttpEndpoint::parse("http://rule-service:8081");
+    EXPECT_EQ(endpoint.host, "rule-service");
+    EXPECT_EQ(endpoint.port, 8081);
+    EXPECT_EQ(endpoint.toString(), "http://rule-service:8081");
+}
+
+TEST(HttpEndpointTest, AcceptsTrailingSlash) {
+    EXPECT_EQ(HttpEndpoint::parse("http://localhost:9000/"), (HttpEndpoint{"localhost", 9000}));
+}
+
+TEST(HttpEndpointTest, RejectsInvalidUrls) {
+    EXPECT_THROW(HttpEndpoint::parse("https://localhost:8080"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://localhost"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://:8080"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://localhost:80a"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://localhost:8080/path"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://localhost:0"), std::runtime_error);
+    EXPECT_THROW(HttpEndpoint::parse("http://localhost:70000"), std::runtime_error);
+}
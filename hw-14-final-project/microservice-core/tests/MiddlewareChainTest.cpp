@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "MiddlewareChain.hpp"
+#include "ChainedHandler.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+#include <string>
+
+/**
+ * @file MiddlewareChainTest.cpp
+ * @brief Unit-тесты для MiddlewareChain и ChainedHandler
+ */
+
+namespace
+{
+// Дописывает свою метку в общий журнал до и после продолжения цепочки
+class TracingMiddleware : public IHttpMiddleware
+{
+public:
+    TracingMiddleware(std::string& trace, std::string name, bool stop = false)
+        : trace_(trace), name_(std::move(name)), stop_(stop)
+    {
+    }
+
+    void handle(IRequest& req, IResponse& res, IHttpHandler& next) override
+    {
+        trace_ += name_ + ">";
+        if (stop_)
+        {
+            res.setStatus(403);
+            return;
+        }
+        next.handle(req, res);
+        trace_ += "<" + name_;
+    }
+
+private:
+    std::string& trace_;
+    std::string name_;
+    bool stop_;
+};
+
+class TracingHandler : public IHttpHandler
+{
+public:
+    explicit TracingHandler(std::string& trace) : trace_(trace) {}
+
+    void handle(IRequest&, IResponse& res) override
+    {
+        trace_ += "handler";
+        res.setStatus(200);
+    }
+
+private:
+    std::string& trace_;
+};
+}
+
+// Пустая цепочка сразу вызывает handler
+TEST(MiddlewareChainTest, EmptyChainCallsTerminal)
+{
+    std::string trace;
+    MiddlewareChain chain;
+    TracingHandler handler(trace);
+    SimpleRequest req("GET", "/", "", "127.0.0.1", 80);
+    SimpleResponse res;
+
+    chain.handle(req, res, handler);
+
+    EXPECT_TRUE(chain.empty());
+    EXPECT_EQ(trace, "handler");
+    EXPECT_EQ(res.getStatus(), 200);
+}
+
+// Стадии вызываются в порядке добавления и видят готовый ответ на обратном пути
+TEST(MiddlewareChainTest, StagesWrapHandlerInOrder)
+{
+    std::string trace;
+    MiddlewareChain chain;
+    chain.add(std::make_shared<TracingMiddleware>(trace, "a"));
+    chain.add(std::make_shared<TracingMiddleware>(trace, "b"));
+    TracingHandler handler(trace);
+    SimpleRequest req("GET", "/", "", "127.0.0.1", 80);
+    SimpleResponse res;
+
+    chain.handle(req, res, handler);
+
+    EXPECT_EQ(chain.size(), 2u);
+    EXPECT_EQ(trace, "a>b>handler<b<a");
+}
+
+// Стадия может ответить сама, не вызывая продолжение
+TEST(MiddlewareChainTest, StageCanShortCircuit)
+{
+    std::string trace;
+    MiddlewareChain chain;
+    chain.add(std::make_shared<TracingMiddleware>(trace, "a"));
+    chain.add(std::make_shared<TracingMiddleware>(trace, "deny", true));
+    chain.add(std::make_shared<TracingMiddleware>(trace, "c"));
+    TracingHandler handler(trace);
+    SimpleRequest req("GET", "/", "", "127.0.0.1", 80);
+    SimpleResponse res;
+
+    chain.handle(req, res, handler);
+
+    EXPECT_EQ(trace, "a>deny><a");
+    EXPECT_EQ(res.getStatus(), 403);
+}
+
+// ChainedHandler добавляет стадии одному маршруту
+TEST(MiddlewareChainTest, ChainedHandlerWrapsSingleHandler)
+{
+    std::string trace;
+    auto chain = std::make_shared<MiddlewareChain>();
+    chain->add(std::make_shared<TracingMiddleware>(trace, "auth"));
+    ChainedHandler handler(chain, std::make_shared<TracingHandler>(trace));
+    SimpleRequest req("GET", "/", "", "127.0.0.1", 80);
+    SimpleResponse res;
+
+    handler.handle(req, res);
+
+    EXPECT_EQ(trace, "auth>handler<auth");
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "PrerenderedResponse.hpp"
+#include "SimpleResponse.hpp"
+#include <stdexcept>
+
+/**
+ * @file PrerenderedResponseTest.cpp
+ * @brief Unit-тесты для PrerenderedResponse
+ */
+
+// Строка статуса и заголовки собираются один раз в конструкторе
+TEST(PrerenderedResponseTest, RendersHead)
+{
+    PrerenderedResponse response(200, {{"Content-Type", "text/plain"}}, "hello");
+
+    EXPECT_EQ(response.head(),
+              "HTTP/1.1 200 OK\r\n"
+              "Content-Type: text/plain\r\n"
+              "Content-Length: 5\r\n");
+    EXPECT_EQ(response.body(), "hello");
+}
+
+// Переадресация: Location идёт первым, затем дополнительные заголовки
+TEST(PrerenderedResponseTest, RedirectFactory)
+{
+    auto response = PrerenderedResponse::redirect(302, "https://example.com", {{"Cache-Control", "no-store"}});
+
+    EXPECT_EQ(response->status(), 302);
+    EXPECT_EQ(response->head(),
+              "HTTP/1.1 302 Found\r\n"
+              "Location: https://example.com\r\n"
+              "Cache-Control: no-store\r\n"
+              "Content-Length: 0\r\n");
+}
+
+// CR, LF и NUL в значении дописали бы в ответ чужие заголовки - такой ответ не собирается
+TEST(PrerenderedResponseTest, RejectsControlCharacters)
+{
+    EXPECT_TRUE(PrerenderedResponse::isSafeHeaderValue("https://example.com/a?b=c\td"));
+    EXPECT_FALSE(PrerenderedResponse::isSafeHeaderValue("https://example.com\r\nSet-Cookie: a=b"));
+    EXPECT_FALSE(PrerenderedResponse::isSafeHeaderValue("https://example.com\nX: y"));
+    EXPECT_FALSE(PrerenderedResponse::isSafeHeaderValue(std::string("https://example.com\0x", 21)));
+
+    EXPECT_THROW(PrerenderedResponse::redirect(302, "https://example.com\r\n\r\n<html>"), std::invalid_argument);
+    EXPECT_THROW(PrerenderedResponse(200, {{"X-Bad\r\nY", "1"}}), std::invalid_argument);
+    EXPECT_THROW(PrerenderedResponse(200, {{"", "1"}}), std::invalid_argument);
+}
+
+// Реализация IResponse по умолчанию переносит ответ через setStatus/setHeader/setBody
+TEST(PrerenderedResponseTest, DefaultResponseAppliesFields)
+{
+    SimpleResponse res;
+
+    res.setPrerendered(PrerenderedResponse::redirect(307, "/new"));
+
+    EXPECT_EQ(res.getStatus(), 307);
+    EXPECT_EQ(res.getHeaders()["Location"], "/new");
+    EXPECT_EQ(res.getBody(), "");
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "RateLimitMiddleware.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+
+/**
+ * @file RateLimitMiddlewareTest.cpp
+ * @brief Unit-тесты для RateLimitMiddleware
+ */
+
+namespace
+{
+class StubRateLimitSettings : public IRateLimitSettings
+{
+public:
+    std::vector<RateLimitRule> rules;
+
+    std::vector<RateLimitRule> getRules() const override { return rules; }
+    std::size_t getMaxClients() const override { return 1024; }
+};
+
+class CountingHandler : public IHttpHandler
+{
+public:
+    int calls = 0;
+
+    void handle(IRequest&, IResponse& res) override
+    {
+        ++calls;
+        res.setStatus(302);
+    }
+};
+
+// Пропускает запросы, пока не получит первый 429
+int passedRequests(RateLimitMiddleware& middleware, CountingHandler& next, SimpleRequest& req)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        SimpleResponse res;
+        middleware.handle(req, res, next);
+        if (res.getStatus() == 429)
+        {
+            return i;
+        }
+    }
+    return 100;
+}
+}
+
+// После burst запросов клиент получает 429 с Retry-After
+TEST(RateLimitMiddlewareTest, RejectsClientOverBurst)
+{
+    StubRateLimitSettings settings;
+    settings.rules = {{"/r/*", 0.5, 3, ""}};
+    RateLimitMiddleware middleware(settings);
+    CountingHandler next;
+
+    SimpleRequest req("GET", "/r/promo", "", "10.0.0.1", 80);
+    EXPECT_EQ(passedRequests(middleware, next, req), 3);
+    EXPECT_EQ(next.calls, 3);
+
+    SimpleResponse res;
+    middleware.handle(req, res, next);
+    EXPECT_EQ(res.getStatus(), 429);
+    EXPECT_EQ(res.getHeaders()["Retry-After"], "2");
+
+    // Другой IP ограничивается отдельно
+    SimpleRequest other("GET", "/r/promo", "", "10.0.0.2", 80);
+    SimpleResponse otherRes;
+    middleware.handle(other, otherRes, next);
+    EXPECT_EQ(otherRes.getStatus(), 302);
+
+    // Отказы считаются, даже если в лог попал только первый
+    EXPECT_EQ(middleware.rejectedRequests(), 2u);
+}
+
+// Маршруты без правила не ограничиваются
+TEST(RateLimitMiddlewareTest, UnmatchedRoutesPassThrough)
+{
+    StubRateLimitSettings settings;
+    settings.rules = {{"/r/*", 1, 1, ""}};
+    RateLimitMiddleware middleware(settings);
+    CountingHandler next;
+
+    SimpleRequest req("DELETE", "/cache/invalidate", "", "10.0.0.1", 80);
+    EXPECT_EQ(passedRequests(middleware, next, req), 100);
+    EXPECT_EQ(middleware.trackedClients(), 0u);
+}
+
+// Ключ клиента из заголовка; без заголовка - IP
+TEST(RateLimitMiddlewareTest, KeysByHeaderWithIpFallback)
+{
+    StubRateLimitSettings settings;
+    settings.rules = {{"/r/*", 1, 2, "X-Api-Key"}};
+    RateLimitMiddleware middleware(settings);
+    CountingHandler next;
+
+    SimpleRequest first("GET", "/r/a", "", "10.0.0.1", 80, {{"X-Api-Key", "team-a"}});
+    SimpleRequest sameKey("GET", "/r/a", "", "10.0.0.9", 80, {{"X-Api-Key", "team-a"}});
+    SimpleRequest anonymous("GET", "/r/a", "", "10.0.0.1", 80);
+
+    EXPECT_EQ(passedRequests(middleware, next, first), 2);
+    EXPECT_EQ(passedRequests(middleware, next, sameKey), 0);
+    EXPECT_EQ(passedRequests(middleware, next, anonymous), 2);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "ReloadableEnvironment.hpp"
+
+TEST(ReloadableEnvironmentTest, SetPropertyPublishesNewSnapshot) {
+    ReloadableEnvironment env;
+    auto before = env.snapshot();
+
+    env.setProperty("port", 8080);
+
+    EXPECT_EQ(env.get<int>("port"), 8080);
+    EXPECT_THROW(before->getProperty("port"), std::runtime_error);
+}
+
+TEST(ReloadableEnvironmentTest, PublishReplacesConfigAndNotifies) {
+    ReloadableEnvironment env;
+    env.setProperty("cache.capacity", 100);
+
+    int notified = 0;
+    int seenCapacity = 0;
+    env.subscribe([&](std::shared_ptr<IEnvironment> snapshot) {
+        ++notified;
+        seenCapacity = snapshot->get<int>("cache.capacity");
+    });
+
+    auto next = std::make_shared<Environment>();
+    next->setProperty("cache.capacity", 500);
+    env.publish(next);
+
+    EXPECT_EQ(notified, 1);
+    EXPECT_EQ(seenCapacity, 500);
+    EXPECT_EQ(env.get<int>("cache.capacity"), 500);
+}
+
+TEST(ReloadableEnvironmentTest, UnsubscribeAndFailingListener) {
+    ReloadableEnvironment env;
+
+    int calls = 0;
+    auto id = env.subscribe([&](std::shared_ptr<IEnvironment>) { ++calls; });
+    env.subscribe([](std::shared_ptr<IEnvironment>) { throw std::runtime_error("bad value"); });
+
+    EXPECT_NO_THROW(env.publish(std::make_shared<Environment>()));
+    EXPECT_EQ(calls, 1);
+
+    env.unsubscribe(id);
+    env.publish(std::make_shared<Environment>());
+    EXPECT_EQ(calls, 1);
+}
@@ -63,3 +63,26 @@ TEST(SimpleResponseTest, MultipleHeaders)
     EXPECT_EQ(headers["Content-Type"], "application/json");
     EXPECT_EQ(headers["Cache-Control"], "no-cache");
 }
+
+// Поиск заголовка без учёта регистра имени
+TEST(SimpleResponseTest, GetHeaderIgnoresCase)
+{
+    SimpleResponse res;
+    res.setHeader("ETag", "\"42\"");
+
+    EXPECT_EQ(res.getHeader("etag"), "\"42\"");
+    EXPECT_EQ(res.getHeader("ETag"), "\"42\"");
+    EXPECT_EQ(res.getHeader("Location"), "");
+}
+
+// Потоковое тело по умолчанию собирается в обычное тело
+TEST(SimpleResponseTest, ChunkedBodyFallsBackToBody)
+{
+    SimpleResponse res;
+    res.setChunkedBody([](const IResponse::ChunkWriter& write) {
+        write("first\n");
+        write("second\n");
+    });
+
+    EXPECT_EQ(res.getBody(), "first\nsecond\n");
+}
@@ -93,3 +93,67 @@ TEST(ThreadSafeMapTest, OverwriteExistingKey)
     ASSERT_NE(v, nullptr);
     EXPECT_EQ(*v, "new");
 }
+
+// ограничение размера при вставке
+TEST(ThreadSafeMapTest, InsertBoundedEvictsWhenFull)
+{
+    ThreadSafeMap<int, std::string> map;
+
+    map.insertBounded(1, std::make_shared<std::string>("a"), 2);
+    map.insertBounded(2, std::make_shared<std::string>("b"), 2);
+    map.insertBounded(2, std::make_shared<std::string>("b2"), 2);
+    EXPECT_EQ(map.size(), 2u);
+
+    map.insertBounded(3, std::make_shared<std::string>("c"), 2);
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_TRUE(map.contains(3));
+
+    map.trimTo(1);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+// фильтр допуска решает, вытеснять ли запись ради нового ключа
+TEST(ThreadSafeMapTest, InsertBoundedWithAdmission)
+{
+    ThreadSafeMap<int, std::string> map;
+    auto admitLarger = [](int candidate, int victim) { return candidate > victim; };
+
+    EXPECT_TRUE(map.insertBounded(5, std::make_shared<std::string>("a"), 1, admitLarger));
+    EXPECT_FALSE(map.insertBounded(3, std::make_shared<std::string>("b"), 1, admitLarger));
+    EXPECT_TRUE(map.contains(5));
+
+    // Существующий ключ обновляется без проверки
+    EXPECT_TRUE(map.insertBounded(5, std::make_shared<std::string>("a2"), 1, admitLarger));
+    EXPECT_EQ(*map.find(5), "a2");
+
+    EXPECT_TRUE(map.insertBounded(9, std::make_shared<std::string>("c"), 1, admitLarger));
+    EXPECT_FALSE(map.contains(5));
+    EXPECT_TRUE(map.contains(9));
+}
+
+// вытесняется самая старая непрочитанная запись, прочитанная получает второй шанс
+TEST(ThreadSafeMapTest, InsertBoundedEvictsByClock)
+{
+    ThreadSafeMap<int, std::string> map;
+
+    for (int key = 1; key <= 3; ++key)
+    {
+        map.insertBounded(key, std::make_shared<std::string>("v"), 3);
+    }
+    map.insertBounded(4, std::make_shared<std::string>("v"), 3);
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_TRUE(map.contains(3));
+    EXPECT_TRUE(map.contains(4));
+
+    ASSERT_NE(map.find(2), nullptr);
+    map.insertBounded(5, std::make_shared<std::string>("v"), 3);
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_TRUE(map.contains(4));
+    EXPECT_TRUE(map.contains(5));
+
+    map.remove(2);
+    map.trimTo(1);
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_TRUE(map.contains(5));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "TokenBucketTable.hpp"
+
+/**
+ * @file TokenBucketTableTest.cpp
+ * @brief Unit-тесты для TokenBucketTable
+ */
+
+using namespace std::chrono_literals;
+
+// Новый клиент получает полную корзину, затем отказ с Retry-After
+TEST(TokenBucketTableTest, BurstThenReject)
+{
+    TokenBucketTable table(16);
+    auto now = TokenBucketTable::Clock::now();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(table.take(42, 1.0, 3.0, now).allowed);
+    }
+
+    auto decision = table.take(42, 1.0, 3.0, now);
+    EXPECT_FALSE(decision.allowed);
+    EXPECT_GT(decision.retryAfter.count(), 0);
+    EXPECT_LE(decision.retryAfter, 1000ms);
+}
+
+// Токены восстанавливаются со временем, но не выше burst
+TEST(TokenBucketTableTest, LazyRefillIsCappedByBurst)
+{
+    TokenBucketTable table(16);
+    auto now = TokenBucketTable::Clock::now();
+
+    EXPECT_TRUE(table.take(7, 10.0, 2.0, now).allowed);
+    EXPECT_TRUE(table.take(7, 10.0, 2.0, now).allowed);
+    EXPECT_FALSE(table.take(7, 10.0, 2.0, now).allowed);
+
+    // Через 100 мс при 10/с появляется один токен
+    EXPECT_TRUE(table.take(7, 10.0, 2.0, now + 100ms).allowed);
+    EXPECT_FALSE(table.take(7, 10.0, 2.0, now + 100ms).allowed);
+
+    // Через минуту корзина полна, но только до burst
+    auto later = now + 60s;
+    EXPECT_TRUE(table.take(7, 10.0, 2.0, later).allowed);
+    EXPECT_TRUE(table.take(7, 10.0, 2.0, later).allowed);
+    EXPECT_FALSE(table.take(7, 10.0, 2.0, later).allowed);
+}
+
+// Клиенты не влияют друг на друга
+TEST(TokenBucketTableTest, KeysAreIndependent)
+{
+    TokenBucketTable table(16);
+    auto now = TokenBucketTable::Clock::now();
+
+    EXPECT_TRUE(table.take(1, 1.0, 1.0, now).allowed);
+    EXPECT_FALSE(table.take(1, 1.0, 1.0, now).allowed);
+    EXPECT_TRUE(table.take(2, 1.0, 1.0, now).allowed);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+// Число клиентов ограничено ёмкостью таблицы
+TEST(TokenBucketTableTest, MemoryIsBounded)
+{
+    TokenBucketTable table(64, 4);
+    auto now = TokenBucketTable::Clock::now();
+
+    for (std::uint64_t key = 0; key < 10000; ++key)
+    {
+        table.take(key * 0x9E3779B97F4A7C15ULL, 1.0, 1.0, now + std::chrono::microseconds(key));
+    }
+
+    EXPECT_LE(table.size(), table.capacity());
+    EXPECT_GE(table.capacity(), 64u);
+}
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "BoostBeastApplication.hpp"
+#include "adapters/RuleChangeSubscriber.hpp"
+#include "analytics/RedirectAnalytics.hpp"
+#include "analytics/HotKeyTracker.hpp"
+#include <memory>
+#include <string>
+#include <thread>
 
 /**
  * @file RedirectServiceApp.hpp
@@ -19,4 +25,11 @@ public:
     ~RedirectServiceApp() override;
 
     void configureInjection() override;
+
+private:
+    std::shared_ptr<RuleChangeSubscriber> changeSubscriber_;   ///< Поток изменений правил
+    std::shared_ptr<RedirectAnalytics> analytics_;             ///< Подсчёт редиректов
+    std::shared_ptr<HotKeyTracker> hotKeys_;                   ///< Самые запрашиваемые правила
+    std::string warmupPath_;                                   ///< Список прогрева кэша
+    std::thread warmup_;                                       ///< Прогрев кэша при старте
 };
\ No newline at end of file
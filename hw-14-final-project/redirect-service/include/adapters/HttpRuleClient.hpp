@@ -1,9 +1,19 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "ports/IRuleClient.hpp"
 #include "HttpClient.hpp"
+#include "CircuitBreaker.hpp"
 #include "settings/IRuleServiceSettings.hpp"
 #include "cache/IRulesCache.hpp"
 
@@ -12,17 +22,113 @@
  * @brief HTTP клиент для получения правил от rule-service
  * @author Anton Tobolkin
  */
+
+/**
+ * @class HttpRuleClient
+ * @brief Правила из кэша, при промахе - GET /rules/<key>
+ *
+ * Запись старше soft TTL отдаётся сразу, а обновляется фоновым потоком.
+ * Запись старше hard TTL запрашивается синхронно, но если rule-service
+ * не ответил или автомат разомкнут, отдаётся устаревшая запись. Пока
+ * автомат разомкнут, промахи кэша не ждут rule-service.
+ *
+ * Если задано окно пакетирования, одновременные промахи собираются в
+ * один POST /rules:batchGet: первый промах ждёт окно (или заполнения
+ * пакета) и отправляет запрос, остальные ждут его результат. Фоновое
+ * обновление тоже идёт пакетами.
+ */
 class HttpRuleClient : public IRuleClient
 {
 private:
+    /**
+     * @brief Итог запроса к rule-service
+     */
+    enum class FetchStatus
+    {
+        Found,
+        NotFound,
+        Failed   ///< Сеть, 5xx или некорректный ответ
+    };
+
     std::shared_ptr<IHttpClient> httpClient_;
     std::shared_ptr<IRuleServiceSettings> settings_;
     std::shared_ptr<IRulesCache> cache_;
+    CircuitBreaker breaker_;
+
+    std::mutex refreshMutex_;
+    std::condition_variable refreshReady_;
+    std::deque<std::string> refreshQueue_;
+    std::unordered_set<std::string> refreshPending_;  ///< Ключи в очереди или в работе
+    bool stopping_ = false;
+    std::thread refresher_;
+
+    /**
+     * @brief Пакет промахов, собираемый за окно
+     */
+    struct PendingBatch
+    {
+        std::vector<std::string> keys;
+        bool done = false;
+        std::unordered_map<std::string, Rule> rules;   ///< Найденные правила
+    };
+
+    std::mutex batchMutex_;
+    std::condition_variable batchChanged_;
+    std::shared_ptr<PendingBatch> openBatch_;   ///< Пакет, к которому можно присоединиться
+
+    /**
+     * @brief Запросить правило и обновить кэш по ответу
+     *
+     * Found сохраняет правило, NotFound удаляет его из кэша.
+     *
+     * @param rule На входе - закэшированная копия (её версия уходит в
+     *             If-None-Match, при 304 она и остаётся), на выходе - актуальное правило
+     */
+    FetchStatus fetch(const std::string &key, std::optional<Rule> &rule);
+
+    /**
+     * @brief Запросить несколько правил одним POST /rules:batchGet и обновить кэш
+     *
+     * @param keys Ключи без повторов
+     * @param cached Закэшированные копии: их версии уходят в ifNoneMatch
+     * @param rules Актуальные правила (неизменённые - из cached)
+     * @return false, если rule-service не ответил
+     */
+    bool fetchMany(const std::vector<std::string> &keys,
+                   const std::unordered_map<std::string, Rule> &cached,
+                   std::unordered_map<std::string, Rule> &rules);
+
+    /**
+     * @brief Промах кэша через общий пакет
+     */
+    std::optional<Rule> fetchCoalesced(const std::string &key);
+
+    /**
+     * @brief Версия из заголовка ETag: без кавычек и префикса W/
+     */
+    static std::string unquoteETag(const std::string &etag);
+
+    /**
+     * @brief Поставить ключ в очередь фонового обновления (поток запускается лениво)
+     */
+    void scheduleRefresh(const std::string &key);
+
+    void runRefresher();
 
 public:
     HttpRuleClient(std::shared_ptr<IHttpClient> httpClient,
                    std::shared_ptr<IRuleServiceSettings> settings,
                    std::shared_ptr<IRulesCache> cache);
 
+    /**
+     * @brief Останавливает поток фонового обновления
+     */
+    ~HttpRuleClient();
+
     std::optional<Rule> findByKey(const std::string &key) override;
+
+    /**
+     * @brief Сколько ключей ждут фонового обновления
+     */
+    std::size_t pendingRefreshes();
 };
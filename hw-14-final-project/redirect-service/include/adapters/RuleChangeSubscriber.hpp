@@ -0,0 +1,81 @@
+#pragma once
+
+#include "IHttpClient.hpp"
+#include "settings/IRuleServiceSettings.hpp"
+#include "cache/IRulesCache.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @file RuleChangeSubscriber.hpp
+ * @brief Подписка на поток изменений правил rule-service
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class RuleChangeSubscriber
+ * @brief Держит long-poll GET /rules/changes и применяет изменения к кэшу
+ *
+ * Запоминает эпоху и версию последнего полученного изменения. Если
+ * rule-service ответил reset (первый запрос, перезапуск или потерянная
+ * история), кэш очищается целиком. Upsert обновляет правило вместе с его
+ * версией, только если оно уже закэшировано; для остальных ключей и для
+ * delete запись удаляется, что заодно отбрасывает загрузку этого ключа,
+ * начатую до изменения (IRulesCache::fill). Так реплика видит изменения
+ * сразу, даже если инвалидирующий запрос rule-service до неё не дошёл.
+ */
+class RuleChangeSubscriber
+{
+public:
+    /**
+     * @param httpClient Клиент только для подписки: stop() вызывает его shutdown()
+     */
+    RuleChangeSubscriber(std::shared_ptr<IHttpClient> httpClient,
+                         std::shared_ptr<IRuleServiceSettings> settings,
+                         std::shared_ptr<IRulesCache> cache);
+
+    /**
+     * @brief Останавливает фоновый поток
+     */
+    ~RuleChangeSubscriber();
+
+    /**
+     * @brief Один запрос к rule-service с применением ответа
+     * @return false, если rule-service недоступен или ответ некорректен
+     */
+    bool pollOnce();
+
+    /**
+     * @brief Запустить опрос в фоновом потоке
+     */
+    void start();
+
+    /**
+     * @brief Остановить опрос
+     *
+     * Текущий long-poll запрос прерывается через IHttpClient::shutdown().
+     */
+    void stop();
+
+    const std::string& epoch() const { return epoch_; }
+    uint64_t version() const { return version_; }
+
+private:
+    void run();
+
+    std::shared_ptr<IHttpClient> httpClient_;
+    std::shared_ptr<IRuleServiceSettings> settings_;
+    std::shared_ptr<IRulesCache> cache_;
+
+    std::string epoch_;      ///< Эпоха журнала rule-service
+    uint64_t version_ = 0;   ///< Последняя применённая версия
+
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
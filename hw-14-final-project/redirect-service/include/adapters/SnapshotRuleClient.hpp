@@ -0,0 +1,156 @@
+#pragma once
+
+#include "ports/IRuleClient.hpp"
+#include "ports/IRuleEvaluator.hpp"
+#include "cache/RuleIndex.hpp"
+#include "cache/MappedRuleIndex.hpp"
+#include "IHttpClient.hpp"
+#include "settings/IRuleServiceSettings.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file SnapshotRuleClient.hpp
+ * @brief Клиент правил на локальном снимке rule-service
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class SnapshotRuleClient
+ * @brief IRuleClient, отвечающий только из памяти
+ *
+ * Загружает все правила страницами GET /rules/export?after=&limit=,
+ * разбирает условия заранее и строит неизменяемый RuleIndex. Дальше
+ * фоновый поток держит long-poll GET /rules/changes и применяет каждую
+ * порцию изменений к новой версии индекса (RuleIndex::apply), подменяя
+ * указатель атомарно. findByKey никогда не ходит в сеть: читатели берут
+ * текущий индекс и работают с ним без блокировок.
+ *
+ * Перед выгрузкой запоминается версия журнала изменений, после неё
+ * применяются все изменения начиная с этой версии. Upsert и delete
+ * идемпотентны, поэтому изменения, попавшие и в выгрузку, и в поток,
+ * дают то же состояние. Сброс журнала (reset) ведёт к полной перезагрузке.
+ *
+ * Если задан services.rule_snapshot.path, снимок сохраняется в файл
+ * (MappedRuleIndex) после полной загрузки, раз в минуту при изменениях
+ * и при остановке. При старте файл отображается в память, и правила
+ * отдаются из него сразу, а поток изменений догоняет rule-service с
+ * сохранённой версии. Индекс в памяти собирается из файла только при
+ * первом изменении и без разбора условий: разбираются изменённые правила,
+ * остальные - при первом обращении, как и до сборки.
+ */
+class SnapshotRuleClient : public IRuleClient
+{
+public:
+    /**
+     * @param httpClient Клиент только для снимка: stop() вызывает его shutdown()
+     */
+    SnapshotRuleClient(std::shared_ptr<IHttpClient> httpClient,
+                       std::shared_ptr<IRuleServiceSettings> settings,
+                       std::shared_ptr<IRuleEvaluator> evaluator);
+
+    /**
+     * @brief Останавливает фоновый поток
+     */
+    ~SnapshotRuleClient() override;
+
+    std::optional<Rule> findByKey(const std::string& key) override;
+
+    /**
+     * @brief Полностью перезагрузить снимок
+     * @return false, если rule-service недоступен
+     */
+    bool loadSnapshot();
+
+    /**
+     * @brief Дождаться изменений и применить их к снимку
+     * @return false, если rule-service недоступен
+     */
+    bool pollChanges();
+
+    /**
+     * @brief Открыть сохранённый снимок из файла
+     * @return false, если файл не задан, отсутствует или повреждён
+     */
+    bool restoreSnapshot();
+
+    /**
+     * @brief Загрузить снимок (из файла или rule-service) и запустить фоновое обновление
+     */
+    void start();
+
+    /**
+     * @brief Остановить фоновое обновление
+     *
+     * Текущий long-poll прерывается через IHttpClient::shutdown().
+     */
+    void stop();
+
+    /**
+     * @brief Текущий индекс в памяти (пустой, пока правила читаются из файла)
+     */
+    std::shared_ptr<const RuleIndex> index() const;
+
+    uint64_t version() const { return version_; }
+
+private:
+    /**
+     * @brief GET к rule-service, тело ответа при статусе 200
+     * @param format Формат тела по Content-Type ответа
+     */
+    std::optional<std::string> fetch(const std::string& path, WireFormat::Format& format);
+
+    /**
+     * @brief Разобрать условие правила и собрать его ответ 302
+     *
+     * При ошибке разбора остаётся строковое условие.
+     */
+    Rule compileRule(Rule rule);
+
+    void publish(std::shared_ptr<const RuleIndex> index);
+
+    /**
+     * @brief Правило файла снимка, подготовленное (условие и ответ 302) при первом обращении
+     */
+    Rule mappedRule(const MappedRuleIndex& mapped, uint32_t record);
+
+    /**
+     * @brief Правила текущего снимка
+     *
+     * Правила из файла снимка не готовятся: подготовленные ранее
+     * переносятся как есть, остальные подготовит findByKey по требованию.
+     */
+    std::vector<Rule> currentRules();
+
+    /**
+     * @brief Сохранить индекс в файл, если он задан
+     */
+    void saveSnapshot();
+
+    void run();
+
+    std::shared_ptr<IHttpClient> httpClient_;
+    std::shared_ptr<IRuleServiceSettings> settings_;
+    std::shared_ptr<IRuleEvaluator> evaluator_;
+
+    std::shared_ptr<const RuleIndex> index_;          ///< Только через std::atomic_load/atomic_store
+    std::shared_ptr<const MappedRuleIndex> mapped_;   ///< Снимок из файла; после сборки index_ - кеш разобранных условий
+
+    std::string epoch_;      ///< Эпоха журнала изменений снимка
+    uint64_t version_ = 0;   ///< Последняя применённая версия
+    bool loaded_ = false;
+    bool dirty_ = false;     ///< Есть изменения, не сохранённые в файл
+    std::chrono::steady_clock::time_point savedAt_;
+
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "analytics/IAnalyticsSink.hpp"
+#include <fstream>
+#include <string>
+
+/**
+ * @file FileAnalyticsSink.hpp
+ * @brief Счётчики редиректов в локальный файл NDJSON
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class FileAnalyticsSink
+ * @brief Дописывает каждую пачку в конец файла, по строке на счётчик
+ *
+ * Строка: {"bucket":..., "shortId":..., "outcome":..., "count":...}.
+ * Файл подходит для загрузки в хранилище одним bulk-запросом.
+ */
+class FileAnalyticsSink : public IAnalyticsSink
+{
+public:
+    /**
+     * @throws std::runtime_error если файл не открывается на запись
+     */
+    explicit FileAnalyticsSink(const std::string& path);
+
+    void write(const std::vector<RedirectCount>& counts) override;
+
+    static const char* outcomeName(RedirectOutcome outcome);
+
+private:
+    std::string path_;
+    std::ofstream out_;
+};
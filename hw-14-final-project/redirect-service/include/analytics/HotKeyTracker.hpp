@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CountMinSketch.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file HotKeyTracker.hpp
+ * @brief Поиск самых запрашиваемых shortId в потоке редиректов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct HotKey
+ * @brief Ключ из top-K и оценка числа обращений к нему
+ */
+struct HotKey
+{
+    std::string shortId;
+    std::uint64_t hits;
+};
+
+/**
+ * @class HotKeyTracker
+ * @brief Count-min sketch и top-K кандидатов в памяти фиксированного размера
+ *
+ * Частоты считает CountMinSketch без блокировок. Top-K - упорядоченное
+ * множество (min-куча с поиском по ключу): новый ключ попадает в него,
+ * только если его оценка выше минимальной. Проверка по атомарному
+ * порогу, поэтому блокировка берётся редко: когда ключ обгоняет порог,
+ * и только на каждом UPDATE_STRIDE-м обращении к нему.
+ *
+ * Каждые decayInterval учтённых обращений все счётчики делятся пополам,
+ * так что top-K следит за текущим трафиком, а не за всей историей.
+ *
+ * При shards > 1 и sketch, и счётчик обращений разбиты по потокам:
+ * hit() пишет только в свою копию и не делит строки кэша с другими
+ * ядрами. Цена - память (shards копий sketch) и чтение всех копий при
+ * оценке, которая в hit() нужна лишь на каждом UPDATE_STRIDE-м
+ * обращении потока. Деление счётчиков запускает копия, набравшая
+ * decayInterval / shards обращений.
+ */
+class HotKeyTracker
+{
+public:
+    /// Ключ из top-K обновляется на каждом UPDATE_STRIDE-м обращении
+    static constexpr std::uint32_t UPDATE_STRIDE = 8;
+
+    /**
+     * @param k Сколько ключей держать в top-K
+     * @param width Ширина sketch
+     * @param depth Число строк sketch
+     * @param sampleRate Учитывать каждое sampleRate-е обращение потока (1 - все)
+     * @param decayInterval Через сколько учтённых обращений делить счётчики (0 - никогда)
+     * @param shards Число копий счётчиков для записи из разных потоков
+     */
+    HotKeyTracker(std::size_t k, std::size_t width, std::size_t depth,
+                  std::uint32_t sampleRate = 1, std::uint64_t decayInterval = 0,
+                  std::size_t shards = 1);
+
+    /**
+     * @brief Учесть обращение к ключу
+     */
+    void hit(const std::string& key);
+
+    /**
+     * @brief Оценка числа обращений к ключу
+     */
+    std::uint64_t estimate(const std::string& key) const;
+
+    /**
+     * @brief Самые частые ключи по убыванию оценки
+     */
+    std::vector<HotKey> top(std::size_t limit) const;
+
+    /**
+     * @brief Сколько обращений учтено (с поправкой на выборку)
+     */
+    std::uint64_t totalHits() const;
+
+    std::size_t capacity() const
+    {
+        return k_;
+    }
+
+private:
+    /// Счётчик обращений одной копии, на своей строке кэша
+    struct alignas(64) ShardHits
+    {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    void admit(const std::string& key, std::uint32_t count);
+    void decay();
+
+    const std::size_t k_;
+    const std::uint32_t sampleRate_;
+    const std::uint64_t decayInterval_;   ///< На одну копию
+
+    CountMinSketch sketch_;
+    std::unique_ptr<ShardHits[]> hits_;
+    std::atomic<std::uint32_t> threshold_{0};   ///< Минимум top-K, когда он заполнен
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::uint32_t> top_;
+    std::set<std::pair<std::uint32_t, std::string>> byCount_;
+};
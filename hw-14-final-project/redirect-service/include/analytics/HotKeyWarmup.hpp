@@ -0,0 +1,30 @@
+#pragma once
+
+#include "analytics/HotKeyTracker.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @file HotKeyWarmup.hpp
+ * @brief Список горячих shortId для прогрева кэша после перезапуска
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class HotKeyWarmup
+ * @brief Файл с shortId по одному на строку, самые горячие - первыми
+ */
+class HotKeyWarmup
+{
+public:
+    /**
+     * @brief Записать список через временный файл и переименование
+     * @return false, если файл не удалось записать
+     */
+    static bool save(const std::string& path, const std::vector<HotKey>& keys);
+
+    /**
+     * @brief Прочитать список (пустой, если файла нет)
+     */
+    static std::vector<std::string> load(const std::string& path);
+};
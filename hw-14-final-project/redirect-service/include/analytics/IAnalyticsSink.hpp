@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ports/IRedirectAnalytics.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file IAnalyticsSink.hpp
+ * @brief Интерфейс хранилища агрегированных счётчиков редиректов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct RedirectCount
+ * @brief Число редиректов shortId с одним исходом за интервал времени
+ */
+struct RedirectCount
+{
+    std::int64_t bucketStart;   ///< Начало интервала, секунды Unix time
+    std::string shortId;
+    RedirectOutcome outcome;
+    std::uint64_t count;
+};
+
+/**
+ * @class IAnalyticsSink
+ * @brief Принимает счётчики пачкой
+ *
+ * Один и тот же (bucketStart, shortId, outcome) может прийти в разных
+ * пачках: хранилище складывает count, а не заменяет его.
+ */
+class IAnalyticsSink
+{
+public:
+    virtual ~IAnalyticsSink() = default;
+
+    /**
+     * @throws std::exception если пачку не удалось сохранить
+     */
+    virtual void write(const std::vector<RedirectCount>& counts) = 0;
+};
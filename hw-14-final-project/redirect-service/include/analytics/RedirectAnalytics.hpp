@@ -0,0 +1,175 @@
+#pragma once
+
+#include "ports/IRedirectAnalytics.hpp"
+#include "analytics/IAnalyticsSink.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file RedirectAnalytics.hpp
+ * @brief Асинхронный подсчёт редиректов с пакетной записью
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class RedirectAnalytics
+ * @brief Кольцевые буферы потоков и фоновый агрегатор
+ *
+ * Каждый поток, вызывающий record, пишет в свой кольцевой буфер
+ * (один писатель, один читатель): без блокировок и без выделения
+ * памяти после первого круга - строки слотов переиспользуют ёмкость.
+ * Буфер завершившегося потока возвращается в пул и достаётся следующему
+ * новому потоку, поэтому в режиме "поток на соединение" буферов столько,
+ * сколько было одновременно живых потоков, а не соединений.
+ * Интервал события берётся из грубых часов, которые обновляет
+ * агрегатор, а не из системного времени.
+ *
+ * Раз в flushInterval агрегатор вычитывает буферы, сворачивает события
+ * в счётчики (интервал, shortId, исход) и отдаёт их хранилищу одной
+ * пачкой. Если буфер потока полон, событие отбрасывается и учитывается
+ * в dropped(). Если хранилище не приняло пачку, счётчики остаются до
+ * следующей записи.
+ */
+class RedirectAnalytics : public IRedirectAnalytics
+{
+public:
+    /**
+     * @param sink Куда записываются счётчики
+     * @param bucket Длительность интервала агрегации
+     * @param flushInterval Как часто вычитывать буферы и писать пачку
+     * @param bufferSize Ёмкость буфера одного потока (округляется до степени двойки)
+     */
+    RedirectAnalytics(std::shared_ptr<IAnalyticsSink> sink,
+                      std::chrono::seconds bucket,
+                      std::chrono::milliseconds flushInterval,
+                      std::size_t bufferSize);
+
+    /**
+     * @brief Останавливает агрегатор и записывает накопленное
+     */
+    ~RedirectAnalytics();
+
+    void record(const std::string& shortId, RedirectOutcome outcome) override;
+
+    /**
+     * @brief Запустить фоновую агрегацию
+     */
+    void start();
+
+    /**
+     * @brief Остановить агрегацию, записав всё, что успели записать потоки
+     */
+    void stop();
+
+    /**
+     * @brief Вычитать буферы и записать пачку (вызывается агрегатором)
+     */
+    void flush();
+
+    /**
+     * @brief Сколько событий отброшено из-за полных буферов
+     */
+    std::uint64_t dropped() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Сколько буферов выделено за всё время
+     */
+    std::size_t buffers() const;
+
+private:
+    struct Event
+    {
+        std::string shortId;
+        RedirectOutcome outcome = RedirectOutcome::Redirected;
+        std::int64_t bucketStart = 0;
+    };
+
+    /**
+     * @brief Буфер одного потока: head пишет поток, tail - агрегатор
+     */
+    struct Ring
+    {
+        explicit Ring(std::size_t capacity) : slots(capacity), mask(capacity - 1) {}
+
+        std::vector<Event> slots;
+        const std::size_t mask;
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+    };
+
+    /**
+     * @brief Все буферы экземпляра и список свободных
+     *
+     * Переживает экземпляр, пока на него ссылаются потоки: буфер
+     * возвращается при выходе потока, когда экземпляра может уже не быть.
+     */
+    struct RingPool
+    {
+        explicit RingPool(std::size_t ringCapacity) : capacity(ringCapacity) {}
+
+        Ring* acquire();
+        void release(Ring* ring);
+
+        /**
+         * @brief Текущий список буферов; сами буферы живут, пока жив пул
+         */
+        std::vector<Ring*> snapshot();
+
+        const std::size_t capacity;
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<Ring>> rings;
+        std::vector<Ring*> free;
+    };
+
+    /**
+     * @brief Буфер, взятый потоком; при выходе потока возвращается в пул
+     */
+    struct LocalRing
+    {
+        std::uint64_t owner = 0;   ///< id экземпляра, а не адрес: память может быть переиспользована
+        Ring* ring = nullptr;
+        std::weak_ptr<RingPool> pool;
+
+        void reset();
+        ~LocalRing() { reset(); }
+    };
+
+    using CountKey = std::tuple<std::int64_t, std::string, RedirectOutcome>;
+
+    static LocalRing& localCache();
+    Ring* localRing();
+    void updateBucket();
+    void run();
+
+    const std::uint64_t id_;   ///< Отличает экземпляры в кэше буфера потока
+    std::shared_ptr<IAnalyticsSink> sink_;
+    const std::int64_t bucketSeconds_;
+    const std::chrono::milliseconds flushInterval_;
+    std::size_t ringCapacity_ = 2;
+
+    std::atomic<std::int64_t> bucketStart_{0};   ///< Грубые часы для record
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::shared_ptr<RingPool> pool_;
+
+    std::mutex flushMutex_;
+    std::map<CountKey, std::uint64_t> pending_;   ///< Счётчики, ещё не принятые хранилищем
+
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stopping_ = false;
+    std::thread worker_;
+};
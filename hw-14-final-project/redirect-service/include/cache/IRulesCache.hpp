@@ -1,11 +1,22 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <optional>
 #include "domain/Rule.hpp"
 
 
+/**
+ * @brief Правило из кэша вместе с моментом его сохранения
+ */
+struct CachedRule
+{
+    Rule rule;
+    std::chrono::steady_clock::time_point storedAt;  ///< Когда правило попало в кэш
+};
+
 /**
  * @brief Интерфейс кэша правил
  */
@@ -21,6 +32,22 @@ public:
      */
     virtual std::optional<Rule> find(const std::string& id) = 0;
 
+    /**
+     * @brief Найти правило вместе с его возрастом
+     *
+     * Кэш, не хранящий время сохранения, отдаёт правило как только что
+     * сохранённое: такие записи никогда не устаревают.
+     */
+    virtual std::optional<CachedRule> findEntry(const std::string& id)
+    {
+        auto rule = find(id);
+        if (!rule)
+        {
+            return std::nullopt;
+        }
+        return CachedRule{std::move(*rule), std::chrono::steady_clock::now()};
+    }
+
     /**
      * @brief Удалить правило из кэша по ID
      * @param id ID правила
@@ -38,4 +65,26 @@ public:
      * @param rule Само правило
      */
     virtual void put(const std::string& id, const Rule& rule) = 0;
+
+    /**
+     * @brief Поколение ключа: меняется при каждом put, remove и clear
+     *
+     * Загрузчик запоминает поколение до запроса к rule-service и сохраняет
+     * ответ через fill(). Кэш без поколений всегда отдаёт 0.
+     */
+    virtual uint64_t generation(const std::string& /*id*/) const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief Сохранить правило, загруженное при поколении generation
+     *
+     * Если ключ с тех пор меняли (изменение из журнала, инвалидация),
+     * загруженное значение могло устареть и в кэше не остаётся.
+     */
+    virtual void fill(const std::string& id, const Rule& rule, uint64_t /*generation*/)
+    {
+        put(id, rule);
+    }
 };
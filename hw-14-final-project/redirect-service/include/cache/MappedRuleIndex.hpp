@@ -0,0 +1,115 @@
+#pragma once
+
+#include "domain/Rule.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file MappedRuleIndex.hpp
+ * @brief Индекс правил в бинарном файле, отображённом в память
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class MappedRuleIndex
+ * @brief Снимок правил на диске, читаемый без разбора
+ *
+ * Формат файла (little-endian, все смещения от начала файла):
+ * - заголовок: сигнатура, версия формата, эпоха и версия журнала
+ *   изменений rule-service, на которых снят снимок;
+ * - хеш-таблица с открытой адресацией: слот = FNV-1a хеш shortId
+ *   и номер записи;
+ * - записи: смещения и длины shortId, targetUrl и условия в арене;
+ * - арена строк.
+ *
+ * Файл не содержит указателей, поэтому open() сводится к mmap и проверке
+ * заголовка - время старта не зависит от числа правил. Строки копируются
+ * только для найденного правила, условие разбирается (и ответ 302
+ * собирается) при первом обращении и запоминается вместе с правилом.
+ */
+class MappedRuleIndex
+{
+public:
+    /// Версия формата; файл другой версии игнорируется
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    ~MappedRuleIndex();
+
+    MappedRuleIndex(const MappedRuleIndex&) = delete;
+    MappedRuleIndex& operator=(const MappedRuleIndex&) = delete;
+
+    /**
+     * @brief Открыть файл снимка
+     * @return Индекс или nullptr, если файла нет или он повреждён
+     */
+    static std::shared_ptr<MappedRuleIndex> open(const std::string& path);
+
+    /**
+     * @brief Записать снимок (через временный файл и rename)
+     *
+     * Временный файл и каталог сбрасываются на диск (fsync), поэтому после
+     * сбоя по пути лежит либо прежний, либо новый снимок целиком.
+     *
+     * @param rules Правила без повторов shortId
+     * @param epoch Эпоха журнала изменений rule-service
+     * @param version Последняя версия журнала, вошедшая в снимок
+     * @return true при успехе
+     */
+    static bool write(const std::string& path,
+                      const std::vector<Rule>& rules,
+                      const std::string& epoch,
+                      uint64_t version);
+
+    /**
+     * @brief Номер записи по shortId
+     */
+    std::optional<uint32_t> lookup(const std::string& key) const;
+
+    /**
+     * @brief Правило по номеру записи (без предкомпилированного условия)
+     */
+    Rule rule(uint32_t record) const;
+
+    /**
+     * @brief Запомненное подготовленное правило записи или nullptr
+     *
+     * Подготовленное правило несёт готовый ответ 302 и разобранное условие;
+     * compiled == nullptr в нём означает, что условие не разобралось.
+     */
+    std::shared_ptr<const Rule> prepared(uint32_t record) const;
+
+    /**
+     * @brief Запомнить подготовленное правило записи
+     */
+    void setPrepared(uint32_t record, std::shared_ptr<const Rule> rule) const;
+
+    uint32_t size() const { return ruleCount_; }
+    const std::string& epoch() const { return epoch_; }
+    uint64_t version() const { return version_; }
+
+private:
+    MappedRuleIndex() = default;
+
+    std::string arenaString(uint32_t offset, uint32_t length) const;
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;          ///< data_ получен через mmap
+    std::vector<char> buffer_;     ///< Копия файла, если mmap недоступен
+
+    uint32_t ruleCount_ = 0;
+    uint64_t slotMask_ = 0;
+    uint64_t slotsOffset_ = 0;
+    uint64_t recordsOffset_ = 0;
+    uint64_t arenaOffset_ = 0;
+    uint64_t arenaSize_ = 0;
+
+    std::string epoch_;
+    uint64_t version_ = 0;
+
+    /// Подготовленные правила по номеру записи, доступ через std::atomic_load/atomic_store
+    mutable std::vector<std::shared_ptr<const Rule>> prepared_;
+};
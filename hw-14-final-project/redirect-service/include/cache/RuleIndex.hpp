@@ -0,0 +1,93 @@
+#pragma once
+
+#include "domain/Rule.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file RuleIndex.hpp
+ * @brief Неизменяемый индекс правил по shortId
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class RuleIndex
+ * @brief Хеш-таблица с открытой адресацией, построенная один раз
+ *
+ * Таблица заполнена не более чем наполовину, в слоте хранится хеш ключа,
+ * поэтому поиск обычно укладывается в одно-два сравнения строк. После
+ * построения индекс не меняется и читается из любого числа потоков без
+ * блокировок; обновление - это сборка новой версии и подмена указателя.
+ *
+ * Правила хранятся по указателям: новая версия (apply) разделяет
+ * с предыдущей все неизменённые правила и копирует только массивы
+ * указателей и слотов.
+ */
+class RuleIndex
+{
+public:
+    using RulePtr = std::shared_ptr<const Rule>;
+
+    /**
+     * @brief Изменение для apply: правило с ключом key или его удаление (rule == nullptr)
+     */
+    struct Change
+    {
+        std::string key;
+        RulePtr rule;
+    };
+
+    RuleIndex() = default;
+
+    /**
+     * @brief Построить индекс
+     * @param rules Правила; при повторе ключа остаётся последнее
+     */
+    explicit RuleIndex(std::vector<Rule> rules);
+
+    /**
+     * @brief Новая версия индекса с изменениями, применёнными по порядку
+     */
+    std::shared_ptr<const RuleIndex> apply(const std::vector<Change>& changes) const;
+
+    /**
+     * @brief Найти правило
+     * @return Указатель на правило внутри индекса или nullptr
+     */
+    const Rule* find(const std::string& key) const;
+
+    /**
+     * @brief Все правила индекса (для сохранения снимка)
+     */
+    const std::vector<RulePtr>& rules() const { return rules_; }
+
+    std::size_t size() const { return rules_.size(); }
+
+private:
+    struct Slot
+    {
+        std::size_t hash = 0;
+        uint32_t index = EMPTY;   ///< Позиция в rules_
+    };
+
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    std::vector<RulePtr> rules_;
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+
+    /**
+     * @brief Слот ключа или первый свободный слот его цепочки
+     */
+    std::size_t probe(std::size_t hash, const std::string& key) const;
+
+    void upsert(RulePtr rule);
+    void erase(const std::string& key);
+
+    /**
+     * @brief Перестроить слоты под count правил с заполнением не больше половины
+     */
+    void rehash(std::size_t count);
+};
@@ -2,31 +2,123 @@
 
 #include "IRulesCache.hpp"
 #include "ThreadSafeMap.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <iostream>
 #include "domain/Rule.hpp"
+#include "domain/RedirectResponse.hpp"
 
 
 /**
  * @brief Реализация потокобезопасного кэша правил
+ *
+ * Ёмкость можно менять на лету (setCapacity), при переполнении вытесняются
+ * давно не читавшиеся записи (CLOCK). 0 - без ограничения. Запись помнит момент
+ * сохранения, по нему HttpRuleClient решает, пора ли её обновить.
+ *
+ * С фильтром допуска новый ключ попадает в полный кэш, только если
+ * фильтр предпочёл его вытесняемому (например, по частоте обращений).
+ *
+ * Поколения ключей хранятся счётчиками по GENERATION_STRIPES полосам хеша:
+ * совпадение полосы лишь изредка отбрасывает годное заполнение, которое
+ * загрузится повторно при следующем обращении.
  */
 class RulesCache : public IRulesCache
 {
 private:
-    ThreadSafeMap<std::string, Rule> cache_;
+    static constexpr std::size_t GENERATION_STRIPES = 256;
+
+    ThreadSafeMap<std::string, CachedRule> cache_;
+    std::atomic<std::size_t> capacity_;
+    std::function<bool(const std::string&, const std::string&)> admission_;
+    std::array<std::atomic<uint64_t>, GENERATION_STRIPES> generations_{};
+    std::atomic<uint64_t> cleared_{0};   ///< Число clear(), входит в поколение каждого ключа
+
+    std::atomic<uint64_t>& stripe(const std::string& id)
+    {
+        return generations_[std::hash<std::string>{}(id) % GENERATION_STRIPES];
+    }
+
+    const std::atomic<uint64_t>& stripe(const std::string& id) const
+    {
+        return generations_[std::hash<std::string>{}(id) % GENERATION_STRIPES];
+    }
+
+    void store(const std::string& id, const Rule& rule)
+    {
+        auto cached = std::make_shared<CachedRule>(
+            CachedRule{rule, std::chrono::steady_clock::now()});
+        if (!cached->rule.redirect)
+        {
+            cached->rule.redirect = RedirectResponse::render(cached->rule.targetUrl);
+        }
+        if (!admission_)
+        {
+            cache_.insertBounded(id, std::move(cached), capacity_);
+        }
+        else if (!cache_.insertBounded(id, std::move(cached), capacity_, admission_))
+        {
+            std::cout << "[RulesCache] Rule not admitted: " << id << std::endl;
+        }
+    }
 
 public:
-    RulesCache() = default;
+    using AdmissionPolicy = std::function<bool(const std::string& candidate, const std::string& victim)>;
+
+    explicit RulesCache(std::size_t capacity = 0)
+        : capacity_(capacity)
+    {
+    }
+
     ~RulesCache() = default;
 
+    /**
+     * @brief Изменить ёмкость, лишние записи вытесняются сразу
+     */
+    void setCapacity(std::size_t capacity)
+    {
+        std::cout << "[RulesCache] Capacity set to " << capacity << std::endl;
+        capacity_ = capacity;
+        if (capacity != 0)
+        {
+            cache_.trimTo(capacity);
+        }
+    }
+
+    /**
+     * @brief Задать фильтр допуска; вызывается до начала обслуживания запросов
+     */
+    void setAdmissionPolicy(AdmissionPolicy admission)
+    {
+        admission_ = std::move(admission);
+    }
+
+    std::size_t size() const
+    {
+        return cache_.size();
+    }
+
     std::optional<Rule> find(const std::string& id) override
     {
-        auto rule = cache_.find(id);
-        if (rule)
+        auto entry = findEntry(id);
+        if (entry)
+        {
+            return std::move(entry->rule);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<CachedRule> findEntry(const std::string& id) override
+    {
+        auto entry = cache_.find(id);
+        if (entry)
         {
             std::cout << "[RulesCache] Cache hit for rule: " << id << std::endl;
-            return *rule;
+            return *entry;
         }
         std::cout << "[RulesCache] Cache miss for rule: " << id << std::endl;
         return std::nullopt;
@@ -35,18 +127,45 @@ public:
     void remove(const std::string& id) override
     {
         std::cout << "[RulesCache] Removing rule from cache: " << id << std::endl;
+        ++stripe(id);
         cache_.remove(id);
     }
 
     void clear() override
     {
         std::cout << "[RulesCache] Clearing all cache" << std::endl;
+        ++cleared_;
         cache_.clear();
     }
 
+    /**
+     * @brief Сохранить правило; готовый ответ 302 собирается здесь, один раз
+     */
     void put(const std::string& id, const Rule& rule) override
     {
         std::cout << "[RulesCache] Caching rule: " << id << std::endl;
-        cache_.insert(id, std::make_shared<Rule>(rule));
+        ++stripe(id);
+        store(id, rule);
+    }
+
+    uint64_t generation(const std::string& id) const override
+    {
+        return stripe(id).load() + cleared_.load();
+    }
+
+    /**
+     * @brief Сохранить загруженное правило, если ключ не меняли с generation
+     *
+     * Правило сначала сохраняется, потом поколение сверяется ещё раз:
+     * изменение до сверки снимет запись здесь, изменение после - само.
+     */
+    void fill(const std::string& id, const Rule& rule, uint64_t generation) override
+    {
+        store(id, rule);
+        if (this->generation(id) != generation)
+        {
+            std::cout << "[RulesCache] Discarding stale fill: " << id << std::endl;
+            cache_.remove(id);
+        }
     }
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <functional>
 #include <string>
+#include <string_view>
 #include <map>
 
 /**
@@ -14,10 +16,28 @@
  * @brief Запрос на переадресацию
  * 
  * Содержит контекст запроса для оценки DSL условий.
+ * Заголовки читаются через header(): хендлер передаёт headerLookup,
+ * который ищет их прямо во входящем запросе, без копии всех заголовков.
  */
 struct RedirectRequest
 {
     std::string shortId;                        ///< Короткий ID из URL (/r/{shortId})
     std::string ip;                             ///< IP адрес клиента
-    std::map<std::string, std::string> headers; ///< HTTP заголовки (включая User-Agent)
+    std::map<std::string, std::string> headers; ///< HTTP заголовки, если не задан headerLookup
+
+    /// Поиск заголовка во входящем запросе; представление живёт, пока жив запрос
+    std::function<std::string_view(const std::string&)> headerLookup = nullptr;
+
+    /**
+     * @brief Значение заголовка (пусто, если его нет)
+     */
+    std::string_view header(const std::string& name) const
+    {
+        if (headerLookup)
+        {
+            return headerLookup(name);
+        }
+        auto it = headers.find(name);
+        return it == headers.end() ? std::string_view() : std::string_view(it->second);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "PrerenderedResponse.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+
+/**
+ * @file RedirectResponse.hpp
+ * @brief Готовый ответ 302 для правила
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct RedirectResponse
+ * @brief Сборка ответа-переадресации, который правило хранит при себе
+ */
+struct RedirectResponse
+{
+    /**
+     * @brief Ответ 302 на targetUrl
+     *
+     * Правило может измениться в любой момент, а инвалидация кэша не
+     * доходит до браузеров, поэтому ответ запрещено кэшировать.
+     *
+     * @return nullptr, если targetUrl нельзя поместить в Location
+     *         (управляющие символы, см. PrerenderedResponse::isSafeHeaderValue)
+     */
+    static std::shared_ptr<const PrerenderedResponse> render(const std::string& targetUrl)
+    {
+        if (!PrerenderedResponse::isSafeHeaderValue(targetUrl))
+        {
+            std::cerr << "[RedirectResponse] Target URL contains control characters, not rendered" << std::endl;
+            return nullptr;
+        }
+        return PrerenderedResponse::redirect(302, targetUrl, {{"Cache-Control", "no-store"}});
+    }
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PrerenderedResponse.hpp"
+#include <memory>
 #include <string>
 
 /**
@@ -17,4 +19,5 @@ struct RedirectResult
     bool success;              ///< Успешно ли выполнен редирект
     std::string targetUrl;     ///< Целевой URL (если успешно)
     std::string errorMessage;  ///< Сообщение об ошибке (если неуспешно)
+    std::shared_ptr<const PrerenderedResponse> response{};  ///< Готовый ответ (если успешно)
 };
\ No newline at end of file
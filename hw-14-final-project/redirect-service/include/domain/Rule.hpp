@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
+struct ASTNode;
+class PrerenderedResponse;
+
 /**
  * @file Rule.hpp
  * @brief Доменная сущность - правило редиректа
@@ -17,4 +21,7 @@ struct Rule
     std::string key;           ///< Короткий ID (например "promo", "docs")
     std::string targetUrl;     ///< Целевой URL для редиректа
     std::string condition;     ///< DSL условие (например "browser == chrome")
+    std::shared_ptr<const ASTNode> compiled{};   ///< Предкомпилированное условие (может отсутствовать)
+    std::shared_ptr<const PrerenderedResponse> redirect{};  ///< Готовый ответ 302 (может отсутствовать)
+    std::string version{};     ///< ETag правила в rule-service, для условного запроса (может отсутствовать)
 };
\ No newline at end of file
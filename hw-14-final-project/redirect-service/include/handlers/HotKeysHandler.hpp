@@ -0,0 +1,54 @@
+#pragma once
+
+#include "IHttpHandler.hpp"
+#include "analytics/HotKeyTracker.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <memory>
+#include <iostream>
+
+/**
+ * @brief Handler для просмотра самых запрашиваемых правил
+ * GET /admin/hot-keys?limit=N
+ *
+ * Ответ: {"totalHits": ..., "keys": [{"shortId": ..., "hits": ...}, ...]},
+ * hits - оценка сверху по count-min sketch.
+ */
+class HotKeysHandler : public IHttpHandler
+{
+private:
+    std::shared_ptr<HotKeyTracker> tracker_;
+
+public:
+    explicit HotKeysHandler(std::shared_ptr<HotKeyTracker> tracker)
+        : tracker_(tracker) {}
+
+    void handle(IRequest& req, IResponse& res) override
+    {
+        std::size_t limit = tracker_->capacity();
+        auto params = req.getParams();
+        if (params.count("limit"))
+        {
+            const std::string& value = params.at("limit");
+            if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos)
+            {
+                res.setStatus(400);
+                res.setHeader("Content-Type", "application/json");
+                res.setBody(R"({"error": "Invalid limit"})");
+                return;
+            }
+            limit = std::min<std::size_t>(limit, std::stoul(value));
+        }
+
+        nlohmann::json keys = nlohmann::json::array();
+        for (const auto& hotKey : tracker_->top(limit))
+        {
+            keys.push_back({{"shortId", hotKey.shortId}, {"hits", hotKey.hits}});
+        }
+
+        std::cout << "[HotKeysHandler] Returned " << keys.size() << " hot keys" << std::endl;
+        res.setStatus(200);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(nlohmann::json{{"totalHits", tracker_->totalHits()}, {"keys", keys}}.dump());
+    }
+};
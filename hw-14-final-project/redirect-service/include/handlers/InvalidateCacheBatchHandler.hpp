@@ -0,0 +1,46 @@
+#pragma once
+
+#include "IHttpHandler.hpp"
+#include "cache/IRulesCache.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <iostream>
+
+/**
+ * @brief Handler для пакетной инвалидации правил
+ * POST /cache/invalidate  {"keys": ["ruleId1", "ruleId2", ...]}
+ */
+class InvalidateCacheBatchHandler : public IHttpHandler
+{
+private:
+    std::shared_ptr<IRulesCache> cache_;
+
+public:
+    explicit InvalidateCacheBatchHandler(std::shared_ptr<IRulesCache> cache)
+        : cache_(cache) {}
+
+    void handle(IRequest& req, IResponse& res) override
+    {
+        auto body = nlohmann::json::parse(req.getBody(), nullptr, false);
+        if (body.is_discarded() || !body.contains("keys") || !body["keys"].is_array())
+        {
+            std::cerr << "[InvalidateCacheBatchHandler] Invalid request body" << std::endl;
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Expected {\"keys\": [...]}"})");
+            return;
+        }
+
+        std::cout << "[InvalidateCacheBatchHandler] Removing " << body["keys"].size()
+                  << " rules from cache" << std::endl;
+        for (const auto& key : body["keys"])
+        {
+            if (key.is_string())
+            {
+                cache_->remove(key.get<std::string>());
+            }
+        }
+        res.setStatus(204); // No Content
+        res.setBody("");
+    }
+};
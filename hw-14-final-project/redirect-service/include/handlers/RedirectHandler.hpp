@@ -3,6 +3,7 @@
 #include "IHttpHandler.hpp"
 #include "ports/IRedirectService.hpp"
 #include <memory>
+#include <string_view>
 
 /**
  * @file RedirectHandler.hpp
@@ -27,7 +28,7 @@ private:
     /**
      * @brief Извлечь shortId из пути
      * @param path Путь запроса (например "/r/promo")
-     * @return shortId или пустая строка
+     * @return shortId (представление внутрь path) или пустая строка
      */
-    std::string extractShortId(const std::string& path) const;
+    std::string_view extractShortId(std::string_view path) const;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @file IRedirectAnalytics.hpp
+ * @brief Интерфейс порта для учёта исходов редиректов
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @brief Чем закончился запрос редиректа
+ */
+enum class RedirectOutcome
+{
+    Redirected,       ///< Условие выполнено, отдан 302
+    ConditionFailed,  ///< Правило есть, условие не выполнено
+    NotFound          ///< Правила нет
+};
+
+/**
+ * @class IRedirectAnalytics
+ * @brief Порт для подсчёта редиректов по shortId
+ *
+ * Вызывается на горячем пути каждого редиректа, поэтому реализация
+ * не должна блокироваться и обращаться к хранилищу синхронно.
+ */
+class IRedirectAnalytics
+{
+public:
+    virtual ~IRedirectAnalytics() = default;
+
+    virtual void record(const std::string& shortId, RedirectOutcome outcome) = 0;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "domain/RedirectRequest.hpp"
+#include <memory>
 #include <string>
 
+struct ASTNode;
+
 /**
  * @file IRuleEvaluator.hpp
  * @brief Интерфейс порта для оценки DSL условий
@@ -25,4 +28,20 @@ public:
      * @return true если условие выполнено
      */
     virtual bool evaluate(const std::string& condition, const RedirectRequest& req) = 0;
+
+    /**
+     * @brief Заранее разобрать DSL условие
+     * @param condition DSL строка
+     * @return AST условия
+     * @throws std::runtime_error при синтаксической ошибке
+     */
+    virtual std::shared_ptr<const ASTNode> compile(const std::string& condition) = 0;
+
+    /**
+     * @brief Оценить заранее разобранное условие без обращения к кэшу AST
+     * @param condition Результат compile()
+     * @param req Контекст запроса
+     * @return true если условие выполнено
+     */
+    virtual bool evaluateCompiled(const ASTNode& condition, const RedirectRequest& req) = 0;
 };
\ No newline at end of file
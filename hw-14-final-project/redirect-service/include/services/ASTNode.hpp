@@ -2,6 +2,10 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+
+class DecisionMemo;
+class ChainStats;
 
 /**
  * @file ASTNode.hpp
@@ -16,7 +20,9 @@
 enum class NodeType {
     Literal,      ///< Литерал: "chrome", "2026-01-01"
     Variable,     ///< Переменная: browser, date, country
-    BinaryOp      ///< Бинарная операция: ==, !=, <, >, AND, OR
+    BinaryOp,     ///< Бинарная операция: ==, !=, <, >, AND, OR
+    Constant,     ///< Известный при компиляции результат: value "true" или "false"
+    Chain         ///< N-арная цепочка AND/OR (строит ConditionOptimizer)
 };
 
 /**
@@ -49,6 +55,9 @@ struct ASTNode {
     OperatorType op;                      ///< Оператор (для BinaryOp)
     std::shared_ptr<ASTNode> left;        ///< Левый потомок (для BinaryOp)
     std::shared_ptr<ASTNode> right;       ///< Правый потомок (для BinaryOp)
+    std::vector<std::shared_ptr<ASTNode>> operands;  ///< Операнды (для Chain)
+    std::shared_ptr<ChainStats> stats;    ///< Счётчики селективности операндов (для Chain)
+    std::shared_ptr<DecisionMemo> memo;   ///< Запомненные решения (только у корня разобранного условия)
     
     /**
      * @brief Создать узел-литерал
@@ -68,4 +77,17 @@ struct ASTNode {
         std::shared_ptr<ASTNode> left,
         std::shared_ptr<ASTNode> right
     );
+
+    /**
+     * @brief Создать узел-константу
+     */
+    static std::shared_ptr<ASTNode> makeConstant(bool value);
+
+    /**
+     * @brief Создать n-арную цепочку AND/OR
+     */
+    static std::shared_ptr<ASTNode> makeChain(
+        OperatorType op,
+        std::vector<std::shared_ptr<ASTNode>> operands
+    );
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "services/ASTNode.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @file ChainStats.hpp
+ * @brief Наблюдаемая селективность операндов цепочки AND/OR
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ChainStats
+ * @brief Порядок вычисления операндов цепочки, подстраиваемый под трафик
+ *
+ * Первым выгодно вычислять операнд, который дёшев и чаще других
+ * завершает цепочку (false для AND, true для OR). Ранг операнда -
+ * стоимость, делённая на наблюдаемую вероятность такого исхода.
+ * Порядок упакован в одно 64-битное слово (по 4 бита на позицию),
+ * поэтому читается без блокировок и меняется одной записью.
+ */
+class ChainStats
+{
+public:
+    /// Предел числа операндов, порядок которых упаковывается в 64 бита
+    static constexpr std::size_t MAX_OPERANDS = 16;
+
+    /// Счётчики обновляет каждое SAMPLE_RATE-е вычисление потока
+    static constexpr std::uint32_t SAMPLE_RATE = 16;
+
+    /// Через сколько записанных вычислений пересчитывается порядок
+    static constexpr std::uint32_t REORDER_INTERVAL = 256;
+
+    /**
+     * @param op And или Or
+     * @param costs Оценка стоимости каждого операнда
+     */
+    ChainStats(OperatorType op, std::vector<double> costs)
+        : op_(op), costs_(std::move(costs))
+    {
+        std::uint64_t identity = 0;
+        for (std::size_t i = 0; i < costs_.size(); ++i)
+        {
+            identity |= static_cast<std::uint64_t>(i) << (4 * i);
+        }
+        order_.store(identity, std::memory_order_relaxed);
+    }
+
+    std::uint64_t order() const
+    {
+        return order_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Номер операнда на позиции position в порядке order
+     */
+    static std::size_t operandAt(std::uint64_t order, std::size_t position)
+    {
+        return static_cast<std::size_t>((order >> (4 * position)) & 0xF);
+    }
+
+    /**
+     * @brief Учесть результат операнда в записываемом вычислении
+     */
+    void record(std::size_t operand, bool result)
+    {
+        counters_[operand].evaluations.fetch_add(1, std::memory_order_relaxed);
+        if (result)
+        {
+            counters_[operand].passes.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Завершить записываемое вычисление; периодически пересчитывает порядок
+     */
+    void finishSample()
+    {
+        if (samples_.fetch_add(1, std::memory_order_relaxed) % REORDER_INTERVAL == REORDER_INTERVAL - 1)
+        {
+            reorder();
+        }
+    }
+
+    /**
+     * @brief Пересчитать порядок по накопленным счётчикам
+     *
+     * Счётчики после пересчёта делятся пополам, чтобы порядок
+     * следовал за изменением трафика.
+     */
+    void reorder()
+    {
+        std::vector<std::pair<double, std::size_t>> ranked;
+        ranked.reserve(costs_.size());
+
+        for (std::size_t i = 0; i < costs_.size(); ++i)
+        {
+            std::uint32_t evaluations = counters_[i].evaluations.load(std::memory_order_relaxed);
+            std::uint32_t passes = std::min(evaluations, counters_[i].passes.load(std::memory_order_relaxed));
+
+            // Оценка Лапласа: без наблюдений вероятность 1/2
+            std::uint32_t decisive = op_ == OperatorType::And ? evaluations - passes : passes;
+            double probability = (decisive + 1.0) / (evaluations + 2.0);
+            ranked.emplace_back(costs_[i] / probability, i);
+
+            counters_[i].evaluations.store(evaluations / 2, std::memory_order_relaxed);
+            counters_[i].passes.store(passes / 2, std::memory_order_relaxed);
+        }
+
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::uint64_t order = 0;
+        for (std::size_t position = 0; position < ranked.size(); ++position)
+        {
+            order |= static_cast<std::uint64_t>(ranked[position].second) << (4 * position);
+        }
+        order_.store(order, std::memory_order_relaxed);
+    }
+
+private:
+    struct Counter
+    {
+        std::atomic<std::uint32_t> evaluations{0};
+        std::atomic<std::uint32_t> passes{0};
+    };
+
+    OperatorType op_;
+    std::vector<double> costs_;
+    std::array<Counter, MAX_OPERANDS> counters_;
+    std::atomic<std::uint64_t> order_{0};
+    std::atomic<std::uint32_t> samples_{0};
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "services/ASTNode.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file ConditionOptimizer.hpp
+ * @brief Оптимизирующий проход по разобранному DSL-условию
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ConditionOptimizer
+ * @brief Переписывает AST условия в эквивалентное, но более дешёвое
+ *
+ * - вложенные AND/OR одного вида сливаются в n-арную цепочку (Chain);
+ * - константы сворачиваются: одиночные литералы и переменные - true,
+ *   сравнения не вида "переменная оп литерал" - false;
+ * - повторяющиеся операнды цепочки удаляются;
+ * - операнды сортируются по оценке стоимости, а ChainStats уточняет
+ *   порядок по наблюдаемой селективности во время работы.
+ */
+class ConditionOptimizer
+{
+public:
+    /**
+     * @brief Оптимизировать условие
+     * @param root Результат RuleParser::parse
+     * @return Новый корень (исходное дерево не изменяется)
+     */
+    static std::shared_ptr<ASTNode> optimize(const std::shared_ptr<ASTNode>& root);
+
+    /**
+     * @brief Оценка стоимости вычисления узла в условных единицах
+     */
+    static double cost(const ASTNode& node);
+
+    /**
+     * @brief Каноническая запись узла (для поиска повторов)
+     */
+    static std::string describe(const ASTNode& node);
+
+private:
+    static bool isComparison(const ASTNode& node);
+    static double variableCost(const std::string& name);
+    static std::shared_ptr<ASTNode> optimizeChain(OperatorType op, const ASTNode& node);
+    static void collectOperands(OperatorType op, const std::shared_ptr<ASTNode>& node,
+                                std::vector<std::shared_ptr<ASTNode>>& operands);
+};
@@ -3,8 +3,11 @@
 #include "ports/IRuleEvaluator.hpp"
 #include "services/ASTNode.hpp"
 #include "services/RuleParser.hpp"
+#include "services/DecisionMemo.hpp"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @file DSLEvaluator.hpp
@@ -17,6 +20,16 @@
  * @brief Вычисляет DSL-условия с внутренним кэшем AST
  * 
  * Кэширует распарсенные AST для ускорения повторных вычислений.
+ * Разобранное условие проходит через ConditionOptimizer: AND/OR
+ * становятся n-арными цепочками, операнды которых вычисляются от
+ * дешёвых и наиболее решающих к дорогим.
+ * Если условие читает только переменные с малым числом значений
+ * (browser, country, date), к корню AST прикладывается DecisionMemo:
+ * повторное вычисление для тех же значений - одна проверка по хешу,
+ * а условие только от date пересчитывается раз в сутки. Ключ таблицы
+ * строится из сырого User-Agent, а не из browser: разбор заголовка
+ * выполняется только при промахе.
+ *
  * Поддерживаемый синтаксис:
  * - Переменные: browser, date, country
  * - Операторы: ==, !=, <, >, <=, >=, AND, OR
@@ -36,6 +49,10 @@ public:
      */
     bool evaluate(const std::string& condition, const RedirectRequest& req) override;
 
+    std::shared_ptr<const ASTNode> compile(const std::string& condition) override;
+
+    bool evaluateCompiled(const ASTNode& condition, const RedirectRequest& req) override;
+
 private:
     // Кэш: condition → AST
     std::unordered_map<std::string, std::shared_ptr<ASTNode>> cache_;
@@ -43,11 +60,42 @@ private:
     // Парсер
     RuleParser parser_;
     
+    /**
+     * @brief Приложить к корню таблицу решений, если условие её допускает
+     */
+    static void attachMemo(ASTNode& root);
+
+    /**
+     * @brief Собрать имена переменных условия без повторов
+     */
+    static void collectVariables(const ASTNode* ast, std::vector<std::string>& names);
+
+    /**
+     * @brief Переменная с небольшим числом различных значений
+     */
+    static bool isMemoizable(const std::string& varName);
+
+    /**
+     * @brief Текущая дата YYYY-MM-DD (пересчитывается раз в минуту)
+     * @return Значение из кэша потока
+     */
+    static const std::string& currentDate();
+
+    /**
+     * @brief Добавить к ключу DecisionMemo дешёвый вход, определяющий значение переменной
+     */
+    std::uint64_t mixMemoInput(std::uint64_t key, const std::string& varName, const RedirectRequest& req);
+
     /**
      * @brief Вычислить AST-узел
      */
-    bool evaluateAST(const std::shared_ptr<ASTNode>& ast, const RedirectRequest& req);
+    bool evaluateAST(const ASTNode* ast, const RedirectRequest& req);
     
+    /**
+     * @brief Вычислить n-арную цепочку в порядке, выбранном ChainStats
+     */
+    bool evaluateChain(const ASTNode& chain, const RedirectRequest& req);
+
     /**
      * @brief Получить значение переменной из запроса
      */
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file DecisionMemo.hpp
+ * @brief Таблица запомненных решений одного условия
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class DecisionMemo
+ * @brief Решение условия по хешу значений переменных, которые оно читает
+ *
+ * Таблица фиксированного размера без блокировок: слот хранит биты 1-62
+ * хеша, бит занятости (63) и само решение (бит 0), коллизия слотов просто
+ * вытесняет старую запись. Ложное совпадение возможно лишь при совпадении
+ * этих 62 бит хеша.
+ */
+class DecisionMemo
+{
+public:
+    static constexpr std::size_t SLOTS = 64;
+
+    /**
+     * @param footprint Переменные условия (без повторов)
+     */
+    explicit DecisionMemo(std::vector<std::string> footprint)
+        : footprint_(std::move(footprint))
+    {
+        for (auto& slot : slots_)
+        {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Переменные, от которых зависит решение
+     */
+    const std::vector<std::string>& footprint() const
+    {
+        return footprint_;
+    }
+
+    std::optional<bool> find(std::uint64_t key) const
+    {
+        std::uint64_t entry = slots_[index(key)].load(std::memory_order_relaxed);
+        if ((entry & ~DECISION_BIT) != tag(key))
+        {
+            return std::nullopt;
+        }
+        return (entry & DECISION_BIT) != 0;
+    }
+
+    void store(std::uint64_t key, bool decision)
+    {
+        slots_[index(key)].store(tag(key) | (decision ? DECISION_BIT : 0), std::memory_order_relaxed);
+    }
+
+    /// Начальное значение ключа для mix
+    static constexpr std::uint64_t SEED = 14695981039346656037ULL;
+
+    /**
+     * @brief Добавить к ключу очередное значение (FNV-1a и байт-разделитель 0xff)
+     */
+    static std::uint64_t mix(std::uint64_t hash, std::string_view value)
+    {
+        for (unsigned char ch : value)
+        {
+            hash ^= ch;
+            hash *= 1099511628211ULL;
+        }
+        hash ^= 0xff;
+        hash *= 1099511628211ULL;
+        return hash;
+    }
+
+    /**
+     * @brief Ключ таблицы по значениям переменных (в порядке footprint())
+     */
+    static std::uint64_t hashValues(const std::vector<std::string>& values)
+    {
+        std::uint64_t hash = SEED;
+        for (const auto& value : values)
+        {
+            hash = mix(hash, value);
+        }
+        return hash;
+    }
+
+private:
+    static constexpr std::uint64_t DECISION_BIT = 1;
+    static constexpr std::uint64_t OCCUPIED_BIT = 1ULL << 63;
+
+    // Старший бит отличает занятый слот от пустого (0)
+    static std::uint64_t tag(std::uint64_t key)
+    {
+        return (key | OCCUPIED_BIT) & ~DECISION_BIT;
+    }
+
+    static std::size_t index(std::uint64_t key)
+    {
+        return static_cast<std::size_t>(key >> 1) % SLOTS;
+    }
+
+    std::vector<std::string> footprint_;
+    std::array<std::atomic<std::uint64_t>, SLOTS> slots_;
+};
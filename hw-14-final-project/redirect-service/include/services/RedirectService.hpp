@@ -3,6 +3,8 @@
 #include "ports/IRedirectService.hpp"
 #include "ports/IRuleClient.hpp"
 #include "ports/IRuleEvaluator.hpp"
+#include "ports/IRedirectAnalytics.hpp"
+#include "analytics/HotKeyTracker.hpp"
 #include <memory>
 
 /**
@@ -16,14 +18,17 @@
  * @brief Сервис переадресации
  * 
  * Получает правило из IRuleClient, проверяет условие через IRuleEvaluator,
- * возвращает целевой URL.
+ * возвращает целевой URL. Исход каждого запроса передаётся в
+ * IRedirectAnalytics, а shortId - в HotKeyTracker, если они заданы.
  */
 class RedirectService : public IRedirectService
 {
 public:
     RedirectService(
         std::shared_ptr<IRuleClient> ruleClient,
-        std::shared_ptr<IRuleEvaluator> evaluator
+        std::shared_ptr<IRuleEvaluator> evaluator,
+        std::shared_ptr<IRedirectAnalytics> analytics = nullptr,
+        std::shared_ptr<HotKeyTracker> hotKeys = nullptr
     );
     
     RedirectResult redirect(const RedirectRequest& req) override;
@@ -31,4 +36,6 @@ public:
 private:
     std::shared_ptr<IRuleClient> ruleClient_;
     std::shared_ptr<IRuleEvaluator> evaluator_;
+    std::shared_ptr<IRedirectAnalytics> analytics_;
+    std::shared_ptr<HotKeyTracker> hotKeys_;
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "IEnvironment.hpp"
+
+/**
+ * @file AnalyticsSettings.hpp
+ * @brief Настройки подсчёта редиректов (analytics.*)
+ * @author Anton Tobolkin
+ */
+class AnalyticsSettings
+{
+private:
+    static constexpr int DEFAULT_BUCKET_SECONDS = 60;
+    static constexpr int DEFAULT_FLUSH_MS = 1000;
+    static constexpr int DEFAULT_BUFFER_SIZE = 4096;
+
+    bool enabled_;
+    std::string path_;
+    std::chrono::seconds bucket_;
+    std::chrono::milliseconds flushInterval_;
+    std::size_t bufferSize_;
+
+public:
+    explicit AnalyticsSettings(std::shared_ptr<IEnvironment> env)
+    {
+        enabled_ = env->get<bool>("analytics.enabled", false);
+        path_ = env->get<std::string>("analytics.path", "analytics.ndjson");
+        bucket_ = std::chrono::seconds(
+            std::max(1, env->get<int>("analytics.bucket_seconds", DEFAULT_BUCKET_SECONDS)));
+        flushInterval_ = std::chrono::milliseconds(
+            std::max(1, env->get<int>("analytics.flush_ms", DEFAULT_FLUSH_MS)));
+        bufferSize_ = static_cast<std::size_t>(
+            std::max(2, env->get<int>("analytics.buffer_size", DEFAULT_BUFFER_SIZE)));
+    }
+
+    bool isEnabled() const
+    {
+        return enabled_;
+    }
+
+    /**
+     * @brief Файл NDJSON, в который дописываются счётчики
+     */
+    const std::string& getPath() const
+    {
+        return path_;
+    }
+
+    /**
+     * @brief Длительность интервала, за который суммируются редиректы
+     */
+    std::chrono::seconds getBucket() const
+    {
+        return bucket_;
+    }
+
+    /**
+     * @brief Как часто счётчики записываются в файл
+     */
+    std::chrono::milliseconds getFlushInterval() const
+    {
+        return flushInterval_;
+    }
+
+    /**
+     * @brief Сколько событий помещается в буфер одного потока между записями
+     */
+    std::size_t getBufferSize() const
+    {
+        return bufferSize_;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "IEnvironment.hpp"
+
+/**
+ * @file HotKeySettings.hpp
+ * @brief Настройки поиска горячих shortId (hot_keys.*)
+ * @author Anton Tobolkin
+ */
+class HotKeySettings
+{
+private:
+    static constexpr int DEFAULT_TOP_K = 100;
+    static constexpr int DEFAULT_WIDTH = 4096;
+    static constexpr int DEFAULT_DEPTH = 4;
+    static constexpr int DEFAULT_DECAY_INTERVAL = 1000000;
+
+    bool enabled_;
+    std::size_t topK_;
+    std::size_t width_;
+    std::size_t depth_;
+    std::uint32_t sampleRate_;
+    std::uint64_t decayInterval_;
+    std::size_t shards_;
+    bool admission_;
+    std::string warmupPath_;
+
+public:
+    explicit HotKeySettings(std::shared_ptr<IEnvironment> env)
+    {
+        enabled_ = env->get<bool>("hot_keys.enabled", false);
+        topK_ = static_cast<std::size_t>(std::max(1, env->get<int>("hot_keys.top_k", DEFAULT_TOP_K)));
+        width_ = static_cast<std::size_t>(std::max(16, env->get<int>("hot_keys.width", DEFAULT_WIDTH)));
+        depth_ = static_cast<std::size_t>(std::clamp(env->get<int>("hot_keys.depth", DEFAULT_DEPTH), 1, 16));
+        sampleRate_ = static_cast<std::uint32_t>(std::max(1, env->get<int>("hot_keys.sample_rate", 1)));
+        decayInterval_ = static_cast<std::uint64_t>(
+            std::max(0, env->get<int>("hot_keys.decay_interval", DEFAULT_DECAY_INTERVAL)));
+        // 0 - по копии счётчиков на ядро
+        int shards = env->get<int>("hot_keys.shards", 0);
+        if (shards <= 0)
+        {
+            shards = static_cast<int>(std::thread::hardware_concurrency());
+        }
+        shards_ = static_cast<std::size_t>(std::clamp(shards, 1, 256));
+        admission_ = env->get<bool>("hot_keys.cache_admission", false);
+        warmupPath_ = env->get<std::string>("hot_keys.warmup_path", "");
+    }
+
+    bool isEnabled() const
+    {
+        return enabled_;
+    }
+
+    /**
+     * @brief Сколько горячих ключей отслеживать
+     */
+    std::size_t getTopK() const
+    {
+        return topK_;
+    }
+
+    std::size_t getWidth() const
+    {
+        return width_;
+    }
+
+    std::size_t getDepth() const
+    {
+        return depth_;
+    }
+
+    /**
+     * @brief Учитывать каждое N-е обращение потока
+     */
+    std::uint32_t getSampleRate() const
+    {
+        return sampleRate_;
+    }
+
+    /**
+     * @brief Через сколько учтённых обращений счётчики делятся пополам (0 - никогда)
+     */
+    std::uint64_t getDecayInterval() const
+    {
+        return decayInterval_;
+    }
+
+    /**
+     * @brief Число копий счётчиков: потоки пишут в свои и не делят строки кэша
+     */
+    std::size_t getShards() const
+    {
+        return shards_;
+    }
+
+    /**
+     * @brief Вытеснять запись полного кэша только ради более частого ключа
+     */
+    bool isCacheAdmissionEnabled() const
+    {
+        return admission_;
+    }
+
+    /**
+     * @brief Файл списка прогрева: читается при старте, пишется при остановке (пусто - не вести)
+     */
+    const std::string& getWarmupPath() const
+    {
+        return warmupPath_;
+    }
+};
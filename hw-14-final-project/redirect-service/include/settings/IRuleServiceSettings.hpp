@@ -1,5 +1,8 @@
 #pragma once
 
+#include "HttpEndpoint.hpp"
+#include "WireFormat.hpp"
+#include <chrono>
 #include <string>
 
 /**
@@ -13,4 +16,85 @@ public:
     virtual ~IRuleServiceSettings() = default;
     
     virtual std::string getUrl() const = 0;
+
+    /**
+     * @brief Адрес rule-service, разобранный при создании настроек
+     */
+    virtual const HttpEndpoint& getEndpoint() const = 0;
+
+    /**
+     * @brief Обслуживать редиректы из локального снимка всех правил
+     *
+     * В этом режиме правила не запрашиваются у rule-service на каждый
+     * промах кэша: снимок загружается целиком и обновляется по потоку
+     * изменений.
+     */
+    virtual bool isSnapshotMode() const = 0;
+
+    /**
+     * @brief Файл для сохранения снимка между перезапусками (пусто - не сохранять)
+     */
+    virtual std::string getSnapshotPath() const = 0;
+
+    /**
+     * @brief Сколько правил запрашивать одной страницей GET /rules/export
+     */
+    virtual int getSnapshotPageSize() const = 0;
+
+    /**
+     * @brief Подписываться ли на поток изменений GET /rules/changes
+     */
+    virtual bool isChangeStreamEnabled() const = 0;
+
+    /**
+     * @brief Сколько rule-service держит long-poll запрос без изменений
+     */
+    virtual std::chrono::milliseconds getChangeStreamTimeout() const = 0;
+
+    /**
+     * @brief Возраст записи кэша, после которого она обновляется в фоне
+     *
+     * Устаревшая запись отдаётся сразу, не дожидаясь rule-service.
+     * 0 - записи не обновляются по возрасту.
+     */
+    virtual std::chrono::milliseconds getCacheSoftTtl() const = 0;
+
+    /**
+     * @brief Возраст записи, после которого она запрашивается синхронно
+     *
+     * Если rule-service недоступен, запись всё равно отдаётся.
+     * 0 - записи не истекают.
+     */
+    virtual std::chrono::milliseconds getCacheHardTtl() const = 0;
+
+    /**
+     * @brief Сколько отказов rule-service подряд размыкают автомат (0 - не размыкать)
+     */
+    virtual int getBreakerFailureThreshold() const = 0;
+
+    /**
+     * @brief Сколько автомат остаётся разомкнутым до пробного запроса
+     */
+    virtual std::chrono::milliseconds getBreakerOpenTimeout() const = 0;
+
+    /**
+     * @brief Сколько ждать других промахов кэша, чтобы запросить их одним POST /rules:batchGet
+     *
+     * 0 - каждый промах запрашивается отдельным GET /rules/<key>.
+     */
+    virtual std::chrono::milliseconds getBatchWindow() const = 0;
+
+    /**
+     * @brief Максимум правил в одном пакетном запросе
+     */
+    virtual int getBatchMaxSize() const = 0;
+
+    /**
+     * @brief Предпочитаемый формат обмена с rule-service
+     *
+     * При MessagePack клиенты просят его в Accept и отправляют в нём
+     * тела запросов; ответы разбираются по Content-Type, поэтому
+     * rule-service без поддержки MessagePack продолжает работать.
+     */
+    virtual WireFormat::Format getWireFormat() const = 0;
 };
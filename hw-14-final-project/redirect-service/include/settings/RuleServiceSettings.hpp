@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <stdexcept>
@@ -9,7 +12,27 @@
 class RuleServiceSettings : public IRuleServiceSettings
 {
 private:
+    static constexpr int DEFAULT_CHANGES_TIMEOUT_MS = 25000;
+    static constexpr int DEFAULT_BREAKER_FAILURES = 5;
+    static constexpr int DEFAULT_BREAKER_OPEN_MS = 5000;
+    static constexpr int DEFAULT_BATCH_MAX_SIZE = 32;
+    static constexpr int MAX_BATCH_SIZE = 100;   ///< Предел POST /rules:batchGet
+    static constexpr int DEFAULT_SNAPSHOT_PAGE_SIZE = 5000;
+
     std::string url_;
+    HttpEndpoint endpoint_;
+    bool snapshotMode_ = false;
+    std::string snapshotPath_;
+    int snapshotPageSize_ = DEFAULT_SNAPSHOT_PAGE_SIZE;
+    bool changeStreamEnabled_ = true;
+    std::chrono::milliseconds changeStreamTimeout_{DEFAULT_CHANGES_TIMEOUT_MS};
+    std::chrono::milliseconds cacheSoftTtl_{0};
+    std::chrono::milliseconds cacheHardTtl_{0};
+    int breakerFailureThreshold_ = DEFAULT_BREAKER_FAILURES;
+    std::chrono::milliseconds breakerOpenTimeout_{DEFAULT_BREAKER_OPEN_MS};
+    std::chrono::milliseconds batchWindow_{0};
+    int batchMaxSize_ = DEFAULT_BATCH_MAX_SIZE;
+    WireFormat::Format wireFormat_ = WireFormat::Format::Json;
 
 public:
     explicit RuleServiceSettings(std::shared_ptr<IEnvironment> env)
@@ -25,10 +48,110 @@ public:
             std::cerr << "[RuleServiceSettings] Error: " << e.what() << std::endl;
             throw std::runtime_error("Missing required setting: services.rule_service_url");
         }
+
+        // Некорректный URL обнаруживается при старте, а не на первом запросе
+        endpoint_ = HttpEndpoint::parse(url_);
+
+        snapshotMode_ = env->get<bool>("services.rule_snapshot.enabled", false);
+        snapshotPath_ = env->get<std::string>("services.rule_snapshot.path", "");
+        snapshotPageSize_ = std::max(
+            1, env->get<int>("services.rule_snapshot.page_size", DEFAULT_SNAPSHOT_PAGE_SIZE));
+        changeStreamEnabled_ = env->get<bool>("services.rule_changes.enabled", true);
+        changeStreamTimeout_ = std::chrono::milliseconds(
+            env->get<int>("services.rule_changes.timeout_ms", DEFAULT_CHANGES_TIMEOUT_MS));
+
+        cacheSoftTtl_ = std::chrono::milliseconds(
+            std::max(0, env->get<int>("services.rule_cache.soft_ttl_ms", 0)));
+        cacheHardTtl_ = std::chrono::milliseconds(
+            std::max(0, env->get<int>("services.rule_cache.hard_ttl_ms", 0)));
+        breakerFailureThreshold_ = std::max(
+            0, env->get<int>("services.rule_breaker.failure_threshold", DEFAULT_BREAKER_FAILURES));
+        breakerOpenTimeout_ = std::chrono::milliseconds(
+            std::max(0, env->get<int>("services.rule_breaker.open_ms", DEFAULT_BREAKER_OPEN_MS)));
+
+        batchWindow_ = std::chrono::milliseconds(
+            std::max(0, env->get<int>("services.rule_batch.window_ms", 0)));
+        batchMaxSize_ = std::clamp(
+            env->get<int>("services.rule_batch.max_size", DEFAULT_BATCH_MAX_SIZE), 1, MAX_BATCH_SIZE);
+
+        std::string wireFormat = env->get<std::string>("services.rule_wire_format", "json");
+        if (wireFormat == "msgpack")
+        {
+            wireFormat_ = WireFormat::Format::MessagePack;
+        }
+        else if (wireFormat != "json")
+        {
+            throw std::runtime_error("Invalid services.rule_wire_format: " + wireFormat);
+        }
     }
 
     std::string getUrl() const override
     {
         return url_;
     }
+
+    const HttpEndpoint& getEndpoint() const override
+    {
+        return endpoint_;
+    }
+
+    bool isSnapshotMode() const override
+    {
+        return snapshotMode_;
+    }
+
+    std::string getSnapshotPath() const override
+    {
+        return snapshotPath_;
+    }
+
+    int getSnapshotPageSize() const override
+    {
+        return snapshotPageSize_;
+    }
+
+    bool isChangeStreamEnabled() const override
+    {
+        return changeStreamEnabled_;
+    }
+
+    std::chrono::milliseconds getChangeStreamTimeout() const override
+    {
+        return changeStreamTimeout_;
+    }
+
+    std::chrono::milliseconds getCacheSoftTtl() const override
+    {
+        return cacheSoftTtl_;
+    }
+
+    std::chrono::milliseconds getCacheHardTtl() const override
+    {
+        return cacheHardTtl_;
+    }
+
+    int getBreakerFailureThreshold() const override
+    {
+        return breakerFailureThreshold_;
+    }
+
+    std::chrono::milliseconds getBreakerOpenTimeout() const override
+    {
+        return breakerOpenTimeout_;
+    }
+
+    std::chrono::milliseconds getBatchWindow() const override
+    {
+        return batchWindow_;
+    }
+
+    int getBatchMaxSize() const override
+    {
+        return batchMaxSize_;
+    }
+
+    WireFormat::Format getWireFormat() const override
+    {
+        return wireFormat_;
+    }
 };
@@ -1,22 +1,7 @@
 #include "RedirectServiceApp.hpp"
 #include <iostream>
-#include <csignal>
 #include <memory>
 
-// Глобальный указатель для обработки сигналов
-std::unique_ptr<RedirectServiceApp> g_app;
-
-void signalHandler(int signal)
-{
-    std::cout << std::endl;
-    std::cout << "[Main] Received signal " << signal << ", stopping server..." << std::endl;
-    
-    if (g_app)
-    {
-        g_app->stop();
-    }
-}
-
 /**
  * @brief Точка входа в приложение
  */
@@ -24,17 +9,13 @@ int main(int argc, char* argv[])
 {
     try
     {
-        // Настраиваем обработчик сигналов
-        std::signal(SIGINT, signalHandler);
-        std::signal(SIGTERM, signalHandler);
-
         std::cout << "========================================" << std::endl;
         std::cout << "  Redirect Service - Microservice Demo " << std::endl;
         std::cout << "========================================" << std::endl;
         std::cout << std::endl;
 
-        // Создаем приложение
-        g_app = std::make_unique<RedirectServiceApp>();
+        // Создаем приложение; SIGINT/SIGTERM обрабатывает сервер в start()
+        auto app = std::make_unique<RedirectServiceApp>();
         
         std::cout << "========================================" << std::endl;
         std::cout << "  Starting server..." << std::endl;
@@ -43,7 +24,7 @@ int main(int argc, char* argv[])
         std::cout << std::endl;
 
         // Запуск (блокирующий вызов) с передачей аргументов
-        g_app->run(argc, argv);
+        app->run(argc, argv);
 
         std::cout << "[Main] Application stopped" << std::endl;
     }
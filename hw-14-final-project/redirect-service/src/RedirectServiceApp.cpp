@@ -1,6 +1,8 @@
 #include "RedirectServiceApp.hpp"
 #include <boost/di.hpp>
+#include <algorithm>
 #include "adapters/HttpRuleClient.hpp"
+#include "adapters/SnapshotRuleClient.hpp"
 #include "services/RedirectService.hpp"
 #include "ports/IRedirectService.hpp"
 #include "ports/IRuleClient.hpp"
@@ -18,10 +20,24 @@
 #include "cache/RulesCache.hpp"
 #include "handlers/InvalidateCacheHandler.hpp"
 #include "handlers/InvalidateCacheByKeyHandler.hpp"
+#include "handlers/InvalidateCacheBatchHandler.hpp"
+#include "RateLimitMiddleware.hpp"
+#include "settings/RateLimitSettings.hpp"
+#include "settings/AnalyticsSettings.hpp"
+#include "analytics/FileAnalyticsSink.hpp"
+#include "analytics/HotKeyWarmup.hpp"
+#include "settings/HotKeySettings.hpp"
+#include "handlers/HotKeysHandler.hpp"
 
 
 namespace di = boost::di;
 
+namespace
+{
+    /// Запас сверх времени long-poll, после которого запрос к /rules/changes считается зависшим
+    constexpr std::chrono::seconds CHANGE_STREAM_GRACE{5};
+}
+
 /**
  * @file RedirectServiceApp.cpp
  * @brief Реализация главного класса приложения
@@ -35,6 +51,17 @@ RedirectServiceApp::RedirectServiceApp()
 
 RedirectServiceApp::~RedirectServiceApp()
 {
+    if (warmup_.joinable())
+    {
+        warmup_.join();
+    }
+
+    // Следующий запуск прогреет кэш текущими горячими ключами
+    if (hotKeys_ && !warmupPath_.empty())
+    {
+        HotKeyWarmup::save(warmupPath_, hotKeys_->top(hotKeys_->capacity()));
+    }
+
     std::cout << "[RedirectServiceApp] Application destroyed" << std::endl;
 }
 
@@ -42,14 +69,101 @@ void RedirectServiceApp::configureInjection()
 {
     std::cout << "[RedirectServiceApp] Configuring DI injector..." << std::endl;
 
+    // Источник правил выбирается настройкой, поэтому зависимости
+    // IRuleClient собираем вручную, остальное создаётся через DI
+    auto ruleServiceSettings = std::make_shared<RuleServiceSettings>(env_);
+    auto httpClient = std::make_shared<HttpClient>();
+    auto cache = std::make_shared<RulesCache>(
+        static_cast<std::size_t>(std::max(0, env_->get<int>("rules_cache.capacity", 0))));
+
+    // Ёмкость кэша меняется без перезапуска при правке config.json
+    reloadableEnv_->subscribe([cache](std::shared_ptr<IEnvironment> env) {
+        cache->setCapacity(static_cast<std::size_t>(std::max(0, env->get<int>("rules_cache.capacity", 0))));
+    });
+    auto evaluator = std::make_shared<DSLEvaluator>();
+
+    // Фоновым long-poll свой клиент: при остановке его запросы прерываются
+    // (shutdown), и у каждого есть предельное время на случай зависшего rule-service
+    auto streamClient = std::make_shared<HttpClient>(
+        ruleServiceSettings->getChangeStreamTimeout() + CHANGE_STREAM_GRACE);
+
+    std::shared_ptr<IRuleClient> ruleClient;
+    if (ruleServiceSettings->isSnapshotMode())
+    {
+        // Все правила в памяти, запросы к rule-service только из фонового потока
+        auto snapshotClient = std::make_shared<SnapshotRuleClient>(
+            streamClient, ruleServiceSettings, evaluator);
+        snapshotClient->start();
+        ruleClient = snapshotClient;
+    }
+    else
+    {
+        ruleClient = std::make_shared<HttpRuleClient>(httpClient, ruleServiceSettings, cache);
+
+        // Подписка на изменения правил дополняет инвалидацию по запросу rule-service
+        if (ruleServiceSettings->isChangeStreamEnabled())
+        {
+            changeSubscriber_ = std::make_shared<RuleChangeSubscriber>(
+                streamClient, ruleServiceSettings, cache);
+            changeSubscriber_->start();
+        }
+    }
+
+    // Горячие ключи: admin-эндпоинт, допуск в кэш и список прогрева
+    HotKeySettings hotKeySettings(env_);
+    if (hotKeySettings.isEnabled())
+    {
+        hotKeys_ = std::make_shared<HotKeyTracker>(
+            hotKeySettings.getTopK(), hotKeySettings.getWidth(), hotKeySettings.getDepth(),
+            hotKeySettings.getSampleRate(), hotKeySettings.getDecayInterval(),
+            hotKeySettings.getShards());
+
+        if (hotKeySettings.isCacheAdmissionEnabled())
+        {
+            auto hotKeys = hotKeys_;
+            cache->setAdmissionPolicy([hotKeys](const std::string& candidate, const std::string& victim) {
+                return hotKeys->estimate(candidate) >= hotKeys->estimate(victim);
+            });
+        }
+
+        warmupPath_ = hotKeySettings.getWarmupPath();
+        auto warmupKeys = warmupPath_.empty() || ruleServiceSettings->isSnapshotMode()
+            ? std::vector<std::string>{}
+            : HotKeyWarmup::load(warmupPath_);
+        if (!warmupKeys.empty())
+        {
+            std::cout << "[RedirectServiceApp] Warming up cache with "
+                      << warmupKeys.size() << " hot keys" << std::endl;
+            warmup_ = std::thread([ruleClient, warmupKeys] {
+                for (const auto& key : warmupKeys)
+                {
+                    ruleClient->findByKey(key);
+                }
+            });
+        }
+    }
+
+    // Счётчики редиректов пишет фоновый поток, редирект только кладёт событие в буфер
+    AnalyticsSettings analyticsSettings(env_);
+    if (analyticsSettings.isEnabled())
+    {
+        analytics_ = std::make_shared<RedirectAnalytics>(
+            std::make_shared<FileAnalyticsSink>(analyticsSettings.getPath()),
+            analyticsSettings.getBucket(),
+            analyticsSettings.getFlushInterval(),
+            analyticsSettings.getBufferSize());
+        analytics_->start();
+    }
+    auto redirectService = std::make_shared<RedirectService>(ruleClient, evaluator, analytics_, hotKeys_);
+
     auto injector = di::make_injector(
         di::bind<IEnvironment>().to(env_),
-        di::bind<IRulesCache>().to<RulesCache>().in(di::singleton),
-        di::bind<IRuleServiceSettings>().to<RuleServiceSettings>().in(di::singleton),
-        di::bind<IHttpClient>().to<HttpClient>().in(di::singleton),
-        di::bind<IRuleClient>().to<HttpRuleClient>().in(di::singleton),
-        di::bind<IRuleEvaluator>().to<DSLEvaluator>().in(di::singleton),
-        di::bind<IRedirectService>().to<RedirectService>().in(di::singleton));
+        di::bind<IRulesCache>().to(cache),
+        di::bind<IRuleServiceSettings>().to(ruleServiceSettings),
+        di::bind<IHttpClient>().to(httpClient),
+        di::bind<IRuleClient>().to(ruleClient),
+        di::bind<IRuleEvaluator>().to(evaluator),
+        di::bind<IRedirectService>().to(redirectService));
 
     handlers_[getHandlerKey("GET", "/r/*")] =
         injector.create<std::shared_ptr<RedirectHandler>>();
@@ -60,6 +174,21 @@ void RedirectServiceApp::configureInjection()
     handlers_[getHandlerKey("DELETE", "/cache/invalidate/*")] =
         injector.create<std::shared_ptr<InvalidateCacheByKeyHandler>>();
 
+    handlers_[getHandlerKey("POST", "/cache/invalidate")] =
+        injector.create<std::shared_ptr<InvalidateCacheBatchHandler>>();
+
+    if (hotKeys_)
+    {
+        handlers_[getHandlerKey("GET", "/admin/hot-keys")] = std::make_shared<HotKeysHandler>(hotKeys_);
+    }
+
+    // Ограничение частоты запросов одного клиента, до маршрутизации
+    RateLimitSettings rateLimitSettings(env_);
+    if (!rateLimitSettings.getRules().empty())
+    {
+        addMiddleware(std::make_shared<RateLimitMiddleware>(rateLimitSettings));
+    }
+
     std::cout << "[RedirectServiceApp] DI injector configured, registered "
               << handlers_.size() << " handlers" << std::endl;
 }
@@ -1,35 +1,36 @@
 #include "adapters/HttpRuleClient.hpp"
 #include "SimpleRequest.hpp"
 #include "SimpleResponse.hpp"
+#include "WireFormat.hpp"
+#include <algorithm>
 #include <iostream>
 #include <nlohmann/json.hpp>
-#include <regex>
 
 
 using json = nlohmann::json;
 
 
-std::pair<std::string, int> parseUrl(const std::string &url)
+HttpRuleClient::HttpRuleClient(std::shared_ptr<IHttpClient> httpClient,
+                               std::shared_ptr<IRuleServiceSettings> settings,
+                               std::shared_ptr<IRulesCache> cache)
+    : httpClient_(httpClient), settings_(settings), cache_(cache),
+      breaker_(settings->getBreakerFailureThreshold(), settings->getBreakerOpenTimeout())
 {
-    std::regex urlRegex(R"(http://([^:]+):(\d+))");
-    std::smatch match;
-
-    if (std::regex_match(url, match, urlRegex))
-    {
-        std::string host = match[1].str();
-        int port = std::stoi(match[2].str());
-        return {host, port};
-    }
-
-    throw std::runtime_error("Invalid URL format: " + url);
 }
 
 
-HttpRuleClient::HttpRuleClient(std::shared_ptr<IHttpClient> httpClient,
-                               std::shared_ptr<IRuleServiceSettings> settings,
-                               std::shared_ptr<IRulesCache> cache)
-    : httpClient_(httpClient), settings_(settings), cache_(cache)
+HttpRuleClient::~HttpRuleClient()
 {
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        stopping_ = true;
+    }
+    refreshReady_.notify_all();
+
+    if (refresher_.joinable())
+    {
+        refresher_.join();
+    }
 }
 
 
@@ -38,55 +39,446 @@ std::optional<Rule> HttpRuleClient::findByKey(const std::string &key)
     try
     {
         // Проверяем кэш
-        auto cachedRule = cache_->find(key);
-        if (cachedRule)
+        auto cached = cache_->findEntry(key);
+        if (cached)
         {
-            std::cout << "[HttpRuleClient] Found rule in cache: " << key << std::endl;
-            return cachedRule;
-        }
+            auto age = std::chrono::steady_clock::now() - cached->storedAt;
+            auto hardTtl = settings_->getCacheHardTtl();
 
-        std::cout << "[HttpRuleClient] Fetching rule by key: " << key << std::endl;
+            if (hardTtl.count() == 0 || age < hardTtl)
+            {
+                auto softTtl = settings_->getCacheSoftTtl();
+                if (softTtl.count() > 0 && age >= softTtl)
+                {
+                    scheduleRefresh(key);
+                }
 
-        auto [host, port] = parseUrl(settings_->getUrl());
+                std::cout << "[HttpRuleClient] Found rule in cache: " << key << std::endl;
+                return std::move(cached->rule);
+            }
 
-        SimpleRequest request(
-            "GET",
-            "/rules/" + key,
-            "",
-            host,
-            port,
-            {{"Accept", "application/json"}});
+            // Запись истекла: спрашиваем rule-service, при сбое отдаём что есть
+            if (!breaker_.allowRequest())
+            {
+                std::cerr << "[HttpRuleClient] Rule service unavailable, serving stale rule: " << key << std::endl;
+                return std::move(cached->rule);
+            }
 
-        SimpleResponse response(200, "");
+            std::optional<Rule> rule = cached->rule;
+            switch (fetch(key, rule))
+            {
+            case FetchStatus::Found:
+                return rule;
+            case FetchStatus::NotFound:
+                return std::nullopt;
+            case FetchStatus::Failed:
+                std::cerr << "[HttpRuleClient] Serving stale rule: " << key << std::endl;
+                return std::move(cached->rule);
+            }
+            return std::nullopt;
+        }
 
-        if (!httpClient_->send(request, response))
+        if (!breaker_.allowRequest())
         {
-            std::cerr << "[HttpRuleClient] Failed to send request" << std::endl;
+            std::cerr << "[HttpRuleClient] Rule service unavailable, skipping fetch: " << key << std::endl;
             return std::nullopt;
         }
 
-        if (response.getStatus() != 200)
+        if (settings_->getBatchWindow().count() > 0)
         {
-            std::cerr << "[HttpRuleClient] Rule not found, status: " << response.getStatus() << std::endl;
-            return std::nullopt;
+            return fetchCoalesced(key);
         }
 
-        json data = json::parse(response.getBody());
+        std::optional<Rule> rule;
+        fetch(key, rule);
+        return rule;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "[HttpRuleClient] Error: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+
+std::size_t HttpRuleClient::pendingRefreshes()
+{
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    return refreshPending_.size();
+}
+
+
+HttpRuleClient::FetchStatus HttpRuleClient::fetch(const std::string &key, std::optional<Rule> &rule)
+{
+    std::cout << "[HttpRuleClient] Fetching rule by key: " << key << std::endl;
+
+    // Изменение правила, пришедшее во время запроса, важнее его ответа
+    uint64_t generation = cache_->generation(key);
 
-        Rule rule{
+    const auto &endpoint = settings_->getEndpoint();
+
+    // Есть версия закэшированного правила - спрашиваем только об изменениях
+    std::map<std::string, std::string> headers{{"Accept", WireFormat::accept(settings_->getWireFormat())}};
+    if (rule && !rule->version.empty())
+    {
+        headers["If-None-Match"] = "\"" + rule->version + "\"";
+    }
+
+    SimpleRequest request(
+        "GET",
+        "/rules/" + key,
+        "",
+        endpoint.host,
+        endpoint.port,
+        headers);
+
+    SimpleResponse response(200, "");
+
+    // Исключение тоже отказ, иначе пробный запрос half-open не завершится
+    bool sent = false;
+    try
+    {
+        sent = httpClient_->send(request, response);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "[HttpRuleClient] Request error: " << e.what() << std::endl;
+    }
+
+    if (!sent)
+    {
+        std::cerr << "[HttpRuleClient] Failed to send request" << std::endl;
+        breaker_.recordFailure();
+        return FetchStatus::Failed;
+    }
+
+    if (response.getStatus() == 404)
+    {
+        breaker_.recordSuccess();
+        std::cerr << "[HttpRuleClient] Rule not found: " << key << std::endl;
+        rule.reset();
+        cache_->remove(key);
+        return FetchStatus::NotFound;
+    }
+
+    if (response.getStatus() == 304 && rule)
+    {
+        // Правило не изменилось: продлеваем запись, тело не разбираем
+        breaker_.recordSuccess();
+        cache_->fill(key, *rule, generation);
+        std::cout << "[HttpRuleClient] Rule not modified: " << key << std::endl;
+        return FetchStatus::Found;
+    }
+
+    if (response.getStatus() != 200)
+    {
+        breaker_.recordFailure();
+        std::cerr << "[HttpRuleClient] Rule service error, status: " << response.getStatus() << std::endl;
+        return FetchStatus::Failed;
+    }
+
+    try
+    {
+        json data = WireFormat::decode(response.getBody(),
+                                       WireFormat::fromContentType(response.getHeader("Content-Type")));
+
+        rule = Rule{
             data["shortId"].get<std::string>(),
             data["targetUrl"].get<std::string>(),
             data["condition"].get<std::string>()};
+        rule->version = unquoteETag(response.getHeader("ETag"));
+    }
+    catch (const std::exception &e)
+    {
+        breaker_.recordFailure();
+        std::cerr << "[HttpRuleClient] Invalid rule response: " << e.what() << std::endl;
+        return FetchStatus::Failed;
+    }
 
-        // Кэшируем результат
-        cache_->put(key, rule);
-        std::cout << "[HttpRuleClient] Rule cached: " << rule.key << std::endl;
+    breaker_.recordSuccess();
 
-        return rule;
+    // Кэшируем результат
+    cache_->fill(key, *rule, generation);
+    std::cout << "[HttpRuleClient] Rule cached: " << rule->key << std::endl;
+
+    return FetchStatus::Found;
+}
+
+
+void HttpRuleClient::scheduleRefresh(const std::string &key)
+{
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        if (stopping_ || !refreshPending_.insert(key).second)
+        {
+            return;
+        }
+
+        refreshQueue_.push_back(key);
+        if (!refresher_.joinable())
+        {
+            refresher_ = std::thread(&HttpRuleClient::runRefresher, this);
+        }
+    }
+    refreshReady_.notify_one();
+}
+
+
+void HttpRuleClient::runRefresher()
+{
+    std::unique_lock<std::mutex> lock(refreshMutex_);
+    while (true)
+    {
+        refreshReady_.wait(lock, [this] { return stopping_ || !refreshQueue_.empty(); });
+        if (stopping_)
+        {
+            return;
+        }
+
+        // С пакетированием обновляем всю накопившуюся очередь одним запросом
+        std::size_t limit = settings_->getBatchWindow().count() > 0
+            ? static_cast<std::size_t>(settings_->getBatchMaxSize())
+            : 1;
+        std::vector<std::string> keys;
+        while (!refreshQueue_.empty() && keys.size() < limit)
+        {
+            keys.push_back(std::move(refreshQueue_.front()));
+            refreshQueue_.pop_front();
+        }
+        lock.unlock();
+
+        // При разомкнутом автомате записи остаются как есть до следующего обращения
+        if (breaker_.allowRequest())
+        {
+            try
+            {
+                if (limit == 1)
+                {
+                    std::optional<Rule> rule = cache_->find(keys.front());
+                    fetch(keys.front(), rule);
+                }
+                else
+                {
+                    std::unordered_map<std::string, Rule> cached;
+                    for (const auto &key : keys)
+                    {
+                        if (auto rule = cache_->find(key))
+                        {
+                            cached.emplace(key, std::move(*rule));
+                        }
+                    }
+
+                    std::unordered_map<std::string, Rule> rules;
+                    fetchMany(keys, cached, rules);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[HttpRuleClient] Refresh error: " << e.what() << std::endl;
+            }
+        }
+
+        lock.lock();
+        for (const auto &key : keys)
+        {
+            refreshPending_.erase(key);
+        }
+    }
+}
+
+
+bool HttpRuleClient::fetchMany(const std::vector<std::string> &keys,
+                               const std::unordered_map<std::string, Rule> &cached,
+                               std::unordered_map<std::string, Rule> &rules)
+{
+    std::cout << "[HttpRuleClient] Fetching " << keys.size() << " rules in batch" << std::endl;
+
+    json body = {{"shortIds", keys}};
+    json versions = json::object();
+    for (const auto &[key, rule] : cached)
+    {
+        if (!rule.version.empty())
+        {
+            versions[key] = rule.version;
+        }
+    }
+    if (!versions.empty())
+    {
+        body["ifNoneMatch"] = std::move(versions);
+    }
+
+    std::unordered_map<std::string, uint64_t> generations;
+    for (const auto &key : keys)
+    {
+        generations.emplace(key, cache_->generation(key));
+    }
+
+    const auto &endpoint = settings_->getEndpoint();
+    auto format = settings_->getWireFormat();
+
+    SimpleRequest request(
+        "POST",
+        "/rules:batchGet",
+        WireFormat::encode(body, format),
+        endpoint.host,
+        endpoint.port,
+        {{"Accept", WireFormat::accept(format)}, {"Content-Type", WireFormat::contentType(format)}});
+
+    SimpleResponse response(200, "");
+
+    bool sent = false;
+    try
+    {
+        sent = httpClient_->send(request, response);
     }
     catch (const std::exception &e)
     {
-        std::cerr << "[HttpRuleClient] Error: " << e.what() << std::endl;
-        return std::nullopt;
+        std::cerr << "[HttpRuleClient] Batch request error: " << e.what() << std::endl;
+    }
+
+    if (!sent || response.getStatus() != 200)
+    {
+        breaker_.recordFailure();
+        std::cerr << "[HttpRuleClient] Batch request failed, status: " << response.getStatus() << std::endl;
+        return false;
+    }
+
+    try
+    {
+        json data = WireFormat::decode(response.getBody(),
+                                       WireFormat::fromContentType(response.getHeader("Content-Type")));
+
+        for (const auto &item : data.at("rules"))
+        {
+            Rule rule{
+                item["shortId"].get<std::string>(),
+                item["targetUrl"].get<std::string>(),
+                item["condition"].get<std::string>()};
+            rule.version = item.value("version", "");
+            rules[rule.key] = rule;
+        }
+
+        // Неизменённые правила остаются прежними копиями
+        for (const auto &id : data.value("notModified", json::array()))
+        {
+            auto it = cached.find(id.get<std::string>());
+            if (it != cached.end())
+            {
+                rules.emplace(it->first, it->second);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        breaker_.recordFailure();
+        std::cerr << "[HttpRuleClient] Invalid batch response: " << e.what() << std::endl;
+        rules.clear();
+        return false;
+    }
+
+    breaker_.recordSuccess();
+
+    // Отсутствующих в ответе правил больше нет в rule-service
+    for (const auto &key : keys)
+    {
+        auto it = rules.find(key);
+        if (it != rules.end())
+        {
+            cache_->fill(key, it->second, generations.at(key));
+        }
+        else
+        {
+            cache_->remove(key);
+        }
+    }
+
+    std::cout << "[HttpRuleClient] Batch returned " << rules.size() << " of " << keys.size() << " rules" << std::endl;
+    return true;
+}
+
+
+std::optional<Rule> HttpRuleClient::fetchCoalesced(const std::string &key)
+{
+    const auto maxSize = static_cast<std::size_t>(settings_->getBatchMaxSize());
+
+    std::shared_ptr<PendingBatch> batch;
+    {
+        std::unique_lock<std::mutex> lock(batchMutex_);
+
+        // Присоединяемся к открытому пакету, если в нём есть место
+        if (openBatch_ && openBatch_->keys.size() < maxSize)
+        {
+            batch = openBatch_;
+            if (std::find(batch->keys.begin(), batch->keys.end(), key) == batch->keys.end())
+            {
+                batch->keys.push_back(key);
+            }
+            if (batch->keys.size() >= maxSize)
+            {
+                batchChanged_.notify_all();
+            }
+
+            batchChanged_.wait(lock, [&batch] { return batch->done; });
+            auto it = batch->rules.find(key);
+            return it == batch->rules.end() ? std::nullopt : std::make_optional(it->second);
+        }
+
+        // Открываем новый пакет и собираем промахи в течение окна
+        batch = std::make_shared<PendingBatch>();
+        batch->keys.push_back(key);
+        openBatch_ = batch;
+
+        batchChanged_.wait_for(lock, settings_->getBatchWindow(),
+                               [&batch, maxSize] { return batch->keys.size() >= maxSize; });
+        if (openBatch_ == batch)
+        {
+            openBatch_.reset();
+        }
+    }
+
+    // Пакет закрыт, ключи больше не меняются
+    std::unordered_map<std::string, Rule> rules;
+    try
+    {
+        if (batch->keys.size() == 1)
+        {
+            std::optional<Rule> rule;
+            if (fetch(key, rule) == FetchStatus::Found)
+            {
+                rules.emplace(key, std::move(*rule));
+            }
+        }
+        else
+        {
+            fetchMany(batch->keys, {}, rules);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // Ожидающие промахи должны проснуться в любом случае
+        std::cerr << "[HttpRuleClient] Batch error: " << e.what() << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    batch->rules = std::move(rules);
+    batch->done = true;
+    batchChanged_.notify_all();
+
+    auto it = batch->rules.find(key);
+    return it == batch->rules.end() ? std::nullopt : std::make_optional(it->second);
+}
+
+
+std::string HttpRuleClient::unquoteETag(const std::string &etag)
+{
+    std::string value = etag;
+    if (value.rfind("W/", 0) == 0)
+    {
+        value = value.substr(2);
+    }
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    {
+        value = value.substr(1, value.size() - 2);
     }
+    return value;
 }
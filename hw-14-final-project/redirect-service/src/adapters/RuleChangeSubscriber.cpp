@@ -0,0 +1,152 @@
+#include "adapters/RuleChangeSubscriber.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+#include "WireFormat.hpp"
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file RuleChangeSubscriber.cpp
+ * @brief Реализация подписки на поток изменений правил
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    /// Пауза перед повтором после ошибки
+    constexpr std::chrono::seconds RETRY_DELAY{1};
+}
+
+RuleChangeSubscriber::RuleChangeSubscriber(std::shared_ptr<IHttpClient> httpClient,
+                                           std::shared_ptr<IRuleServiceSettings> settings,
+                                           std::shared_ptr<IRulesCache> cache)
+    : httpClient_(httpClient), settings_(settings), cache_(cache)
+{
+    std::cout << "[RuleChangeSubscriber] Created" << std::endl;
+}
+
+RuleChangeSubscriber::~RuleChangeSubscriber()
+{
+    stop();
+}
+
+bool RuleChangeSubscriber::pollOnce()
+{
+    try
+    {
+        const auto& endpoint = settings_->getEndpoint();
+
+        std::string path = "/rules/changes?since=" + std::to_string(version_) +
+                           "&timeout=" + std::to_string(settings_->getChangeStreamTimeout().count());
+        if (!epoch_.empty())
+        {
+            path += "&epoch=" + epoch_;
+        }
+
+        SimpleRequest request("GET", path, "", endpoint.host, endpoint.port,
+                              {{"Accept", WireFormat::accept(settings_->getWireFormat())}});
+        SimpleResponse response(200, "");
+
+        if (!httpClient_->send(request, response) || response.getStatus() != 200)
+        {
+            std::cerr << "[RuleChangeSubscriber] Poll failed, status: " << response.getStatus() << std::endl;
+            return false;
+        }
+
+        json data = WireFormat::decode(response.getBody(),
+                                       WireFormat::fromContentType(response.getHeader("Content-Type")));
+
+        if (data["reset"].get<bool>())
+        {
+            std::cout << "[RuleChangeSubscriber] Change log reset, clearing cache" << std::endl;
+            cache_->clear();
+        }
+
+        for (const auto& change : data["changes"])
+        {
+            std::string key = change["shortId"].get<std::string>();
+
+            if (change["op"] == "delete")
+            {
+                cache_->remove(key);
+            }
+            else if (cache_->find(key))
+            {
+                // С версией следующее обновление по мягкому TTL обойдётся 304
+                Rule rule{key,
+                          change["targetUrl"].get<std::string>(),
+                          change["condition"].get<std::string>()};
+                rule.version = change.value("ruleVersion", "");
+                cache_->put(key, rule);
+            }
+            else
+            {
+                // Незакэшированные правила подгрузятся при первом обращении;
+                // remove меняет поколение ключа, и загрузка, начатая до
+                // изменения, не положит в кэш старое значение
+                cache_->remove(key);
+            }
+        }
+
+        epoch_ = data["epoch"].get<std::string>();
+        version_ = data["version"].get<uint64_t>();
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[RuleChangeSubscriber] Error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void RuleChangeSubscriber::start()
+{
+    if (worker_.joinable())
+    {
+        return;
+    }
+
+    std::cout << "[RuleChangeSubscriber] Subscribing to " << settings_->getUrl()
+              << "/rules/changes" << std::endl;
+    worker_ = std::thread(&RuleChangeSubscriber::run, this);
+}
+
+void RuleChangeSubscriber::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stopped_.notify_all();
+
+    // Иначе join ждал бы ответа long-poll до services.rule_changes.timeout_ms
+    httpClient_->shutdown();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+        std::cout << "[RuleChangeSubscriber] Stopped" << std::endl;
+    }
+}
+
+void RuleChangeSubscriber::run()
+{
+    while (true)
+    {
+        bool ok = pollOnce();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_)
+        {
+            return;
+        }
+
+        // После ошибки не долбим rule-service в цикле
+        if (!ok && stopped_.wait_for(lock, RETRY_DELAY, [this] { return stopping_; }))
+        {
+            return;
+        }
+    }
+}
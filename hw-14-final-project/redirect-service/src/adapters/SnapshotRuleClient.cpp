@@ -0,0 +1,404 @@
+#include "adapters/SnapshotRuleClient.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+#include "domain/RedirectResponse.hpp"
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+/**
+ * @file SnapshotRuleClient.cpp
+ * @brief Реализация клиента правил на локальном снимке
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    /// Пауза перед повтором после ошибки
+    constexpr std::chrono::seconds RETRY_DELAY{1};
+
+    /// Как часто сохранять накопленные изменения в файл
+    constexpr std::chrono::seconds SAVE_INTERVAL{60};
+}
+
+SnapshotRuleClient::SnapshotRuleClient(std::shared_ptr<IHttpClient> httpClient,
+                                       std::shared_ptr<IRuleServiceSettings> settings,
+                                       std::shared_ptr<IRuleEvaluator> evaluator)
+    : httpClient_(httpClient),
+      settings_(settings),
+      evaluator_(evaluator)
+{
+    std::cout << "[SnapshotRuleClient] Created" << std::endl;
+}
+
+SnapshotRuleClient::~SnapshotRuleClient()
+{
+    stop();
+}
+
+std::optional<Rule> SnapshotRuleClient::findByKey(const std::string& key)
+{
+    if (auto index = std::atomic_load(&index_))
+    {
+        const Rule* rule = index->find(key);
+        if (!rule)
+        {
+            return std::nullopt;
+        }
+
+        // Правило перенесено из файла снимка без подготовки (см. pollChanges):
+        // оно готовится при первом обращении и запоминается в отображении
+        if (!rule->redirect)
+        {
+            if (auto mapped = std::atomic_load(&mapped_))
+            {
+                if (auto record = mapped->lookup(key))
+                {
+                    Rule original = mappedRule(*mapped, *record);
+                    if (original.targetUrl == rule->targetUrl && original.condition == rule->condition)
+                    {
+                        return original;
+                    }
+                }
+            }
+        }
+        return *rule;
+    }
+
+    auto mapped = std::atomic_load(&mapped_);
+    if (!mapped)
+    {
+        return std::nullopt;
+    }
+
+    auto record = mapped->lookup(key);
+    if (!record)
+    {
+        return std::nullopt;
+    }
+    return mappedRule(*mapped, *record);
+}
+
+std::shared_ptr<const RuleIndex> SnapshotRuleClient::index() const
+{
+    auto index = std::atomic_load(&index_);
+    return index ? index : std::make_shared<const RuleIndex>();
+}
+
+bool SnapshotRuleClient::restoreSnapshot()
+{
+    const std::string path = settings_->getSnapshotPath();
+    if (path.empty())
+    {
+        return false;
+    }
+
+    auto mapped = MappedRuleIndex::open(path);
+    if (!mapped)
+    {
+        return false;
+    }
+
+    std::atomic_store(&mapped_, std::shared_ptr<const MappedRuleIndex>(mapped));
+    std::atomic_store(&index_, std::shared_ptr<const RuleIndex>());
+
+    epoch_ = mapped->epoch();
+    version_ = mapped->version();
+    loaded_ = true;
+    savedAt_ = std::chrono::steady_clock::now();
+
+    std::cout << "[SnapshotRuleClient] Serving " << mapped->size()
+              << " rules from " << path << ", version " << version_ << std::endl;
+    return true;
+}
+
+bool SnapshotRuleClient::loadSnapshot()
+{
+    try
+    {
+        // Версия журнала до выгрузки: всё, что позже, придёт потоком изменений
+        WireFormat::Format format;
+        auto head = fetch("/rules/changes?timeout=0", format);
+        if (!head)
+        {
+            return false;
+        }
+        json position = WireFormat::decode(*head, format);
+
+        // Выгрузка страницами: каждый ответ укладывается в предел тела HTTP-клиента
+        std::vector<Rule> rules;
+        const int pageSize = settings_->getSnapshotPageSize();
+        std::string cursor;
+        while (true)
+        {
+            auto body = fetch("/rules/export?limit=" + std::to_string(pageSize) +
+                              (cursor.empty() ? "" : "&after=" + cursor), format);
+            if (!body)
+            {
+                return false;
+            }
+
+            std::size_t received = 0;
+            for (const auto& data : WireFormat::decodeRecords(*body, format))
+            {
+                rules.push_back(compileRule(Rule{data["shortId"].get<std::string>(),
+                                                 data["targetUrl"].get<std::string>(),
+                                                 data["condition"].get<std::string>()}));
+                ++received;
+            }
+
+            if (received < static_cast<std::size_t>(pageSize))
+            {
+                break;
+            }
+            cursor = rules.back().key;
+        }
+
+        publish(std::make_shared<const RuleIndex>(std::move(rules)));
+
+        epoch_ = position["epoch"].get<std::string>();
+        version_ = position["version"].get<uint64_t>();
+        loaded_ = true;
+
+        std::cout << "[SnapshotRuleClient] Snapshot loaded: " << index()->size()
+                  << " rules, version " << version_ << std::endl;
+
+        dirty_ = true;
+        saveSnapshot();
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[SnapshotRuleClient] Snapshot error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool SnapshotRuleClient::pollChanges()
+{
+    if (!loaded_)
+    {
+        return loadSnapshot();
+    }
+
+    try
+    {
+        WireFormat::Format format;
+        auto body = fetch("/rules/changes?epoch=" + epoch_ +
+                          "&since=" + std::to_string(version_) +
+                          "&timeout=" + std::to_string(settings_->getChangeStreamTimeout().count()),
+                          format);
+        if (!body)
+        {
+            return false;
+        }
+
+        json data = WireFormat::decode(*body, format);
+
+        if (data["reset"].get<bool>())
+        {
+            std::cout << "[SnapshotRuleClient] Change log reset, reloading snapshot" << std::endl;
+            loaded_ = false;
+            return loadSnapshot();
+        }
+
+        if (!data["changes"].empty())
+        {
+            std::vector<RuleIndex::Change> changes;
+            changes.reserve(data["changes"].size());
+            for (const auto& change : data["changes"])
+            {
+                std::string key = change["shortId"].get<std::string>();
+                RuleIndex::RulePtr rule;
+                if (change["op"] != "delete")
+                {
+                    rule = std::make_shared<const Rule>(compileRule(Rule{key,
+                        change["targetUrl"].get<std::string>(),
+                        change["condition"].get<std::string>()}));
+                }
+                changes.push_back(RuleIndex::Change{std::move(key), std::move(rule)});
+            }
+
+            // Неизменённые правила разделяются с текущей версией индекса.
+            // Первая пачка после restoreSnapshot переносит правила из файла
+            // без разбора условий: разбираются только изменённые, остальные -
+            // при первом обращении, а файл остаётся отображённым как их кеш
+            auto current = std::atomic_load(&index_);
+            if (!current)
+            {
+                current = std::make_shared<const RuleIndex>(currentRules());
+            }
+            std::atomic_store(&index_, current->apply(changes));
+
+            std::cout << "[SnapshotRuleClient] Applied " << changes.size()
+                      << " changes" << std::endl;
+            dirty_ = true;
+        }
+
+        version_ = data["version"].get<uint64_t>();
+
+        if (dirty_ && std::chrono::steady_clock::now() - savedAt_ >= SAVE_INTERVAL)
+        {
+            saveSnapshot();
+        }
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[SnapshotRuleClient] Error: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void SnapshotRuleClient::start()
+{
+    if (worker_.joinable())
+    {
+        return;
+    }
+
+    // Первая загрузка синхронно, чтобы не отдавать 404 до появления снимка;
+    // сохранённый файл открывается за время mmap, а не разбора всех правил
+    if (!restoreSnapshot())
+    {
+        loadSnapshot();
+    }
+    worker_ = std::thread(&SnapshotRuleClient::run, this);
+}
+
+void SnapshotRuleClient::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stopped_.notify_all();
+
+    // Иначе join ждал бы ответа long-poll до services.rule_changes.timeout_ms
+    httpClient_->shutdown();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+        saveSnapshot();
+        std::cout << "[SnapshotRuleClient] Stopped" << std::endl;
+    }
+}
+
+std::optional<std::string> SnapshotRuleClient::fetch(const std::string& path, WireFormat::Format& format)
+{
+    const auto& endpoint = settings_->getEndpoint();
+
+    SimpleRequest request("GET", path, "", endpoint.host, endpoint.port,
+                          {{"Accept", WireFormat::accept(settings_->getWireFormat())}});
+    SimpleResponse response(200, "");
+
+    if (!httpClient_->send(request, response) || response.getStatus() != 200)
+    {
+        std::cerr << "[SnapshotRuleClient] Request " << path
+                  << " failed, status: " << response.getStatus() << std::endl;
+        return std::nullopt;
+    }
+
+    format = WireFormat::fromContentType(response.getHeader("Content-Type"));
+    return response.getBody();
+}
+
+Rule SnapshotRuleClient::compileRule(Rule rule)
+{
+    rule.redirect = RedirectResponse::render(rule.targetUrl);
+
+    try
+    {
+        rule.compiled = evaluator_->compile(rule.condition);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[SnapshotRuleClient] Cannot compile condition of " << rule.key
+                  << ": " << e.what() << std::endl;
+    }
+    return rule;
+}
+
+Rule SnapshotRuleClient::mappedRule(const MappedRuleIndex& mapped, uint32_t record)
+{
+    // Запоминается и неразобравшееся условие: иначе ошибка разбиралась бы на каждом запросе
+    auto prepared = mapped.prepared(record);
+    if (!prepared)
+    {
+        prepared = std::make_shared<const Rule>(compileRule(mapped.rule(record)));
+        mapped.setPrepared(record, prepared);
+    }
+    return *prepared;
+}
+
+void SnapshotRuleClient::publish(std::shared_ptr<const RuleIndex> index)
+{
+    std::atomic_store(&index_, std::move(index));
+
+    // Файл больше не нужен читателям, отображение снимется с последней ссылкой
+    std::atomic_store(&mapped_, std::shared_ptr<const MappedRuleIndex>());
+}
+
+std::vector<Rule> SnapshotRuleClient::currentRules()
+{
+    std::vector<Rule> rules;
+    if (auto index = std::atomic_load(&index_))
+    {
+        rules.reserve(index->size());
+        for (const auto& rule : index->rules())
+        {
+            rules.push_back(*rule);
+        }
+        return rules;
+    }
+
+    auto mapped = std::atomic_load(&mapped_);
+    if (!mapped)
+    {
+        return rules;
+    }
+
+    rules.reserve(mapped->size());
+    for (uint32_t record = 0; record < mapped->size(); ++record)
+    {
+        auto prepared = mapped->prepared(record);
+        rules.push_back(prepared ? *prepared : mapped->rule(record));
+    }
+    return rules;
+}
+
+void SnapshotRuleClient::saveSnapshot()
+{
+    const std::string path = settings_->getSnapshotPath();
+    if (path.empty() || !dirty_ || !loaded_)
+    {
+        return;
+    }
+
+    if (MappedRuleIndex::write(path, currentRules(), epoch_, version_))
+    {
+        dirty_ = false;
+        savedAt_ = std::chrono::steady_clock::now();
+    }
+}
+
+void SnapshotRuleClient::run()
+{
+    while (true)
+    {
+        bool ok = pollChanges();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_)
+        {
+            return;
+        }
+
+        if (!ok && stopped_.wait_for(lock, RETRY_DELAY, [this] { return stopping_; }))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include "analytics/FileAnalyticsSink.hpp"
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+/**
+ * @file FileAnalyticsSink.cpp
+ * @brief Реализация записи счётчиков редиректов в файл
+ * @author Anton Tobolkin
+ */
+
+FileAnalyticsSink::FileAnalyticsSink(const std::string& path)
+    : path_(path), out_(path, std::ios::app)
+{
+    if (!out_)
+    {
+        throw std::runtime_error("Cannot open analytics file: " + path);
+    }
+    std::cout << "[FileAnalyticsSink] Writing to " << path << std::endl;
+}
+
+void FileAnalyticsSink::write(const std::vector<RedirectCount>& counts)
+{
+    // Пачка собирается целиком и пишется одним вызовом
+    std::string batch;
+    for (const auto& count : counts)
+    {
+        json line = {
+            {"bucket", count.bucketStart},
+            {"shortId", count.shortId},
+            {"outcome", outcomeName(count.outcome)},
+            {"count", count.count}
+        };
+        batch += line.dump();
+        batch += '\n';
+    }
+
+    out_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    out_.flush();
+    if (!out_)
+    {
+        out_.clear();
+        throw std::runtime_error("Cannot write analytics file: " + path_);
+    }
+}
+
+const char* FileAnalyticsSink::outcomeName(RedirectOutcome outcome)
+{
+    switch (outcome)
+    {
+    case RedirectOutcome::Redirected:
+        return "redirected";
+    case RedirectOutcome::ConditionFailed:
+        return "condition_failed";
+    case RedirectOutcome::NotFound:
+        return "not_found";
+    }
+    return "unknown";
+}
@@ -0,0 +1,141 @@
+#include "analytics/HotKeyTracker.hpp"
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file HotKeyTracker.cpp
+ * @brief Реализация поиска самых запрашиваемых shortId
+ * @author Anton Tobolkin
+ */
+
+HotKeyTracker::HotKeyTracker(std::size_t k, std::size_t width, std::size_t depth,
+                             std::uint32_t sampleRate, std::uint64_t decayInterval,
+                             std::size_t shards)
+    : k_(std::max<std::size_t>(1, k)),
+      sampleRate_(std::max<std::uint32_t>(1, sampleRate)),
+      decayInterval_(decayInterval == 0
+                         ? 0
+                         : std::max<std::uint64_t>(1, decayInterval / std::max<std::size_t>(1, shards))),
+      sketch_(width, depth, shards),
+      hits_(new ShardHits[sketch_.shards()])
+{
+}
+
+void HotKeyTracker::hit(const std::string& key)
+{
+    if (sampleRate_ > 1)
+    {
+        thread_local std::uint32_t tick = 0;
+        if (++tick % sampleRate_ != 0)
+        {
+            return;
+        }
+    }
+
+    std::uint64_t hash = std::hash<std::string>{}(key);
+    std::uint32_t local = sketch_.add(hash);
+
+    std::uint64_t total = hits_[sketch_.shard()].value.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (decayInterval_ != 0 && total % decayInterval_ == 0)
+    {
+        decay();
+        return;
+    }
+
+    // Шаг считаем по своей копии, порог сравниваем с общей оценкой
+    if (local % UPDATE_STRIDE != 0)
+    {
+        return;
+    }
+    std::uint32_t count = sketch_.estimate(hash);
+    if (count <= threshold_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    admit(key, count);
+}
+
+std::uint64_t HotKeyTracker::totalHits() const
+{
+    std::uint64_t total = 0;
+    for (std::size_t shard = 0; shard < sketch_.shards(); ++shard)
+    {
+        total += hits_[shard].value.load(std::memory_order_relaxed);
+    }
+    return total * sampleRate_;
+}
+
+std::uint64_t HotKeyTracker::estimate(const std::string& key) const
+{
+    return static_cast<std::uint64_t>(sketch_.estimate(std::hash<std::string>{}(key))) * sampleRate_;
+}
+
+std::vector<HotKey> HotKeyTracker::top(std::size_t limit) const
+{
+    std::vector<HotKey> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result.reserve(top_.size());
+        for (const auto& [key, count] : top_)
+        {
+            result.push_back(HotKey{key, 0});
+        }
+    }
+
+    // Оценки в top-K обновляются через UPDATE_STRIDE, берём свежие из sketch
+    for (auto& hotKey : result)
+    {
+        hotKey.hits = estimate(hotKey.shortId);
+    }
+    std::sort(result.begin(), result.end(), [](const HotKey& a, const HotKey& b) {
+        return a.hits != b.hits ? a.hits > b.hits : a.shortId < b.shortId;
+    });
+
+    if (result.size() > limit)
+    {
+        result.resize(limit);
+    }
+    return result;
+}
+
+void HotKeyTracker::admit(const std::string& key, std::uint32_t count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = top_.find(key);
+    if (it != top_.end())
+    {
+        byCount_.erase({it->second, key});
+        it->second = count;
+        byCount_.emplace(count, key);
+    }
+    else if (top_.size() < k_)
+    {
+        top_.emplace(key, count);
+        byCount_.emplace(count, key);
+    }
+    else if (count > byCount_.begin()->first)
+    {
+        top_.erase(byCount_.begin()->second);
+        byCount_.erase(byCount_.begin());
+        top_.emplace(key, count);
+        byCount_.emplace(count, key);
+    }
+
+    threshold_.store(top_.size() < k_ ? 0 : byCount_.begin()->first, std::memory_order_relaxed);
+}
+
+void HotKeyTracker::decay()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    sketch_.decay();
+
+    byCount_.clear();
+    for (auto& [key, count] : top_)
+    {
+        count >>= 1;
+        byCount_.emplace(count, key);
+    }
+    threshold_.store(top_.size() < k_ ? 0 : byCount_.begin()->first, std::memory_order_relaxed);
+}
@@ -0,0 +1,55 @@
+#include "analytics/HotKeyWarmup.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+/**
+ * @file HotKeyWarmup.cpp
+ * @brief Реализация сохранения и чтения списка прогрева
+ * @author Anton Tobolkin
+ */
+
+bool HotKeyWarmup::save(const std::string& path, const std::vector<HotKey>& keys)
+{
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        for (const auto& hotKey : keys)
+        {
+            out << hotKey.shortId << '\n';
+        }
+        out.flush();
+        if (!out)
+        {
+            std::cerr << "[HotKeyWarmup] Cannot write " << tmpPath << std::endl;
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    // Читатель видит либо старый список, либо новый целиком
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "[HotKeyWarmup] Cannot replace " << path << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    std::cout << "[HotKeyWarmup] Saved " << keys.size() << " hot keys to " << path << std::endl;
+    return true;
+}
+
+std::vector<std::string> HotKeyWarmup::load(const std::string& path)
+{
+    std::vector<std::string> keys;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty())
+        {
+            keys.push_back(line);
+        }
+    }
+    return keys;
+}
@@ -0,0 +1,223 @@
+#include "analytics/RedirectAnalytics.hpp"
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @file RedirectAnalytics.cpp
+ * @brief Реализация асинхронного подсчёта редиректов
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    std::atomic<std::uint64_t> nextInstanceId{1};
+}
+
+RedirectAnalytics::RedirectAnalytics(std::shared_ptr<IAnalyticsSink> sink,
+                                     std::chrono::seconds bucket,
+                                     std::chrono::milliseconds flushInterval,
+                                     std::size_t bufferSize)
+    : id_(nextInstanceId.fetch_add(1, std::memory_order_relaxed)),
+      sink_(sink),
+      bucketSeconds_(std::max<std::int64_t>(1, bucket.count())),
+      flushInterval_(std::max(flushInterval, std::chrono::milliseconds(1)))
+{
+    while (ringCapacity_ < bufferSize)
+    {
+        ringCapacity_ <<= 1;
+    }
+    pool_ = std::make_shared<RingPool>(ringCapacity_);
+    updateBucket();
+
+    std::cout << "[RedirectAnalytics] Created, bucket " << bucketSeconds_ << "s, flush every "
+              << flushInterval_.count() << "ms, " << ringCapacity_ << " events per thread" << std::endl;
+}
+
+RedirectAnalytics::~RedirectAnalytics()
+{
+    stop();
+}
+
+void RedirectAnalytics::record(const std::string& shortId, RedirectOutcome outcome)
+{
+    Ring* ring = localRing();
+
+    std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) > ring->mask)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = ring->slots[head & ring->mask];
+    event.shortId.assign(shortId);
+    event.outcome = outcome;
+    event.bucketStart = bucketStart_.load(std::memory_order_relaxed);
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+RedirectAnalytics::LocalRing& RedirectAnalytics::localCache()
+{
+    thread_local LocalRing cache;
+    return cache;
+}
+
+RedirectAnalytics::Ring* RedirectAnalytics::localRing()
+{
+    LocalRing& cache = localCache();
+    if (cache.owner == id_)
+    {
+        return cache.ring;
+    }
+
+    // Первое событие потока в этом экземпляре (или после записи в другой)
+    cache.reset();
+    cache.ring = pool_->acquire();
+    cache.pool = pool_;
+    cache.owner = id_;
+    return cache.ring;
+}
+
+void RedirectAnalytics::LocalRing::reset()
+{
+    if (auto owned = pool.lock())
+    {
+        owned->release(ring);
+    }
+    owner = 0;
+    ring = nullptr;
+    pool.reset();
+}
+
+RedirectAnalytics::Ring* RedirectAnalytics::RingPool::acquire()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!free.empty())
+    {
+        Ring* ring = free.back();
+        free.pop_back();
+        return ring;
+    }
+    rings.push_back(std::make_unique<Ring>(capacity));
+    return rings.back().get();
+}
+
+void RedirectAnalytics::RingPool::release(Ring* ring)
+{
+    // Непрочитанные события остаются в буфере, их вычитает агрегатор
+    std::lock_guard<std::mutex> lock(mutex);
+    free.push_back(ring);
+}
+
+std::vector<RedirectAnalytics::Ring*> RedirectAnalytics::RingPool::snapshot()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Ring*> result;
+    result.reserve(rings.size());
+    for (const auto& ring : rings)
+    {
+        result.push_back(ring.get());
+    }
+    return result;
+}
+
+std::size_t RedirectAnalytics::buffers() const
+{
+    std::lock_guard<std::mutex> lock(pool_->mutex);
+    return pool_->rings.size();
+}
+
+void RedirectAnalytics::updateBucket()
+{
+    auto now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    bucketStart_.store(now - now % bucketSeconds_, std::memory_order_relaxed);
+}
+
+void RedirectAnalytics::flush()
+{
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+
+    // Список берётся под блокировкой пула, вычитывание идёт без неё
+    for (Ring* ring : pool_->snapshot())
+    {
+        std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+        {
+            const Event& event = ring->slots[tail & ring->mask];
+            ++pending_[CountKey{event.bucketStart, event.shortId, event.outcome}];
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+
+    // События, записанные после этой точки, попадут в следующий интервал
+    updateBucket();
+
+    if (pending_.empty())
+    {
+        return;
+    }
+
+    std::vector<RedirectCount> counts;
+    counts.reserve(pending_.size());
+    for (const auto& [key, count] : pending_)
+    {
+        counts.push_back(RedirectCount{std::get<0>(key), std::get<1>(key), std::get<2>(key), count});
+    }
+
+    try
+    {
+        sink_->write(counts);
+        pending_.clear();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[RedirectAnalytics] Cannot write " << counts.size()
+                  << " counters, will retry: " << e.what() << std::endl;
+    }
+}
+
+void RedirectAnalytics::start()
+{
+    if (worker_.joinable())
+    {
+        return;
+    }
+    worker_ = std::thread(&RedirectAnalytics::run, this);
+}
+
+void RedirectAnalytics::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stopped_.notify_all();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+        std::cout << "[RedirectAnalytics] Stopped, dropped " << dropped() << " events" << std::endl;
+    }
+
+    // Последняя пачка: события, записанные до остановки
+    flush();
+}
+
+void RedirectAnalytics::run()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stopped_.wait_for(lock, flushInterval_, [this] { return stopping_; }))
+            {
+                return;
+            }
+        }
+
+        flush();
+    }
+}
@@ -0,0 +1,357 @@
+#include "cache/MappedRuleIndex.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RULE_INDEX_HAS_MMAP 1
+#endif
+
+/**
+ * @file MappedRuleIndex.cpp
+ * @brief Реализация индекса правил в отображённом в память файле
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    constexpr char MAGIC[8] = {'R', 'U', 'L', 'E', 'I', 'D', 'X', '\0'};
+    constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t ruleCount;
+        uint64_t slotCount;
+        uint64_t changeVersion;
+        uint64_t slotsOffset;
+        uint64_t recordsOffset;
+        uint64_t arenaOffset;
+        uint64_t arenaSize;
+        uint32_t epochOffset;     ///< Эпоха хранится в арене
+        uint32_t epochLength;
+    };
+
+    struct FileSlot
+    {
+        uint64_t hash;
+        uint32_t record;
+        uint32_t reserved;
+    };
+
+    struct FileRecord
+    {
+        uint32_t keyOffset, keyLength;
+        uint32_t urlOffset, urlLength;
+        uint32_t conditionOffset, conditionLength;
+    };
+
+    /// Хеш не зависит от реализации стандартной библиотеки
+    uint64_t fnv1a(const char* data, std::size_t length)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /// Чтение структуры без требований к выравниванию
+    template<typename T>
+    T readAt(const char* base, uint64_t offset)
+    {
+        T value;
+        std::memcpy(&value, base + offset, sizeof(T));
+        return value;
+    }
+
+    /// Сбросить на диск содержимое файла или каталога (записи о его файлах)
+    bool syncPath(const std::string& path, bool directory)
+    {
+#ifdef RULE_INDEX_HAS_MMAP
+        int fd = ::open(path.c_str(), directory ? (O_RDONLY | O_DIRECTORY) : O_WRONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+#else
+        (void)path;
+        (void)directory;
+        return true;
+#endif
+    }
+
+    std::string parentDirectory(const std::string& path)
+    {
+        auto slash = path.find_last_of('/');
+        if (slash == std::string::npos)
+        {
+            return ".";
+        }
+        return slash == 0 ? "/" : path.substr(0, slash);
+    }
+}
+
+MappedRuleIndex::~MappedRuleIndex()
+{
+#ifdef RULE_INDEX_HAS_MMAP
+    if (mapped_)
+    {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+std::shared_ptr<MappedRuleIndex> MappedRuleIndex::open(const std::string& path)
+{
+    std::shared_ptr<MappedRuleIndex> index(new MappedRuleIndex());
+
+#ifdef RULE_INDEX_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(FileHeader)))
+    {
+        void* addr = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            index->data_ = static_cast<const char*>(addr);
+            index->size_ = static_cast<std::size_t>(st.st_size);
+            index->mapped_ = true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    if (!index->mapped_)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            return nullptr;
+        }
+        index->buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        index->data_ = index->buffer_.data();
+        index->size_ = index->buffer_.size();
+    }
+
+    if (index->size_ < sizeof(FileHeader))
+    {
+        std::cerr << "[MappedRuleIndex] Snapshot file too small: " << path << std::endl;
+        return nullptr;
+    }
+
+    auto header = readAt<FileHeader>(index->data_, 0);
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.formatVersion != FORMAT_VERSION)
+    {
+        std::cerr << "[MappedRuleIndex] Unsupported snapshot format: " << path << std::endl;
+        return nullptr;
+    }
+
+    // Таблица и записи должны целиком лежать в файле
+    bool valid = header.slotCount != 0 &&
+                 header.slotCount <= index->size_ / sizeof(FileSlot) &&
+                 header.ruleCount <= index->size_ / sizeof(FileRecord) &&
+                 header.arenaSize <= index->size_ &&
+                 (header.slotCount & (header.slotCount - 1)) == 0 &&
+                 header.slotCount > header.ruleCount &&
+                 header.slotsOffset + header.slotCount * sizeof(FileSlot) <= index->size_ &&
+                 header.recordsOffset + uint64_t(header.ruleCount) * sizeof(FileRecord) <= index->size_ &&
+                 header.arenaOffset + header.arenaSize <= index->size_ &&
+                 uint64_t(header.epochOffset) + header.epochLength <= header.arenaSize;
+
+    if (!valid)
+    {
+        std::cerr << "[MappedRuleIndex] Corrupted snapshot file: " << path << std::endl;
+        return nullptr;
+    }
+
+    index->ruleCount_ = header.ruleCount;
+    index->slotMask_ = header.slotCount - 1;
+    index->slotsOffset_ = header.slotsOffset;
+    index->recordsOffset_ = header.recordsOffset;
+    index->arenaOffset_ = header.arenaOffset;
+    index->arenaSize_ = header.arenaSize;
+    index->epoch_ = index->arenaString(header.epochOffset, header.epochLength);
+    index->version_ = header.changeVersion;
+    index->prepared_.resize(header.ruleCount);
+
+    std::cout << "[MappedRuleIndex] Opened " << path << ": " << header.ruleCount
+              << " rules, version " << header.changeVersion << std::endl;
+    return index;
+}
+
+bool MappedRuleIndex::write(const std::string& path,
+                            const std::vector<Rule>& rules,
+                            const std::string& epoch,
+                            uint64_t version)
+{
+    uint64_t slotCount = 2;
+    while (slotCount < uint64_t(rules.size()) * 2)
+    {
+        slotCount <<= 1;
+    }
+
+    std::string arena;
+    auto addString = [&arena](const std::string& s) {
+        uint32_t offset = static_cast<uint32_t>(arena.size());
+        arena += s;
+        return offset;
+    };
+
+    std::vector<FileSlot> slots(slotCount, FileSlot{0, EMPTY_SLOT, 0});
+    std::vector<FileRecord> records;
+    records.reserve(rules.size());
+
+    uint32_t epochOffset = addString(epoch);
+
+    for (const auto& rule : rules)
+    {
+        uint64_t hash = fnv1a(rule.key.data(), rule.key.size());
+        uint64_t pos = hash & (slotCount - 1);
+        while (slots[pos].record != EMPTY_SLOT)
+        {
+            pos = (pos + 1) & (slotCount - 1);
+        }
+        slots[pos] = FileSlot{hash, static_cast<uint32_t>(records.size()), 0};
+
+        FileRecord record{};
+        record.keyOffset = addString(rule.key);
+        record.keyLength = static_cast<uint32_t>(rule.key.size());
+        record.urlOffset = addString(rule.targetUrl);
+        record.urlLength = static_cast<uint32_t>(rule.targetUrl.size());
+        record.conditionOffset = addString(rule.condition);
+        record.conditionLength = static_cast<uint32_t>(rule.condition.size());
+        records.push_back(record);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.ruleCount = static_cast<uint32_t>(records.size());
+    header.slotCount = slotCount;
+    header.changeVersion = version;
+    header.slotsOffset = sizeof(FileHeader);
+    header.recordsOffset = header.slotsOffset + slotCount * sizeof(FileSlot);
+    header.arenaOffset = header.recordsOffset + records.size() * sizeof(FileRecord);
+    header.arenaSize = arena.size();
+    header.epochOffset = epochOffset;
+    header.epochLength = static_cast<uint32_t>(epoch.size());
+
+    // Пишем во временный файл и подменяем: читатель не увидит половину снимка
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(FileSlot));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FileRecord));
+        out.write(arena.data(), arena.size());
+
+        if (!out)
+        {
+            std::cerr << "[MappedRuleIndex] Failed to write " << tmpPath << std::endl;
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+
+    // Без fsync до rename после сбоя питания на месте снимка может оказаться пустой файл
+    if (!syncPath(tmpPath, false))
+    {
+        std::cerr << "[MappedRuleIndex] Failed to sync " << tmpPath << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::cerr << "[MappedRuleIndex] Failed to rename " << tmpPath << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    // Сама подмена хранится в каталоге: без его fsync после сбоя вернётся старый снимок
+    if (!syncPath(parentDirectory(path), true))
+    {
+        std::cerr << "[MappedRuleIndex] Failed to sync directory of " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "[MappedRuleIndex] Saved " << records.size() << " rules to " << path << std::endl;
+    return true;
+}
+
+std::optional<uint32_t> MappedRuleIndex::lookup(const std::string& key) const
+{
+    uint64_t hash = fnv1a(key.data(), key.size());
+    uint64_t pos = hash & slotMask_;
+
+    // Таблица заполнена не более чем наполовину, пустой слот найдётся
+    for (uint64_t probe = 0; probe <= slotMask_; ++probe)
+    {
+        auto slot = readAt<FileSlot>(data_, slotsOffset_ + pos * sizeof(FileSlot));
+        if (slot.record == EMPTY_SLOT || slot.record >= ruleCount_)
+        {
+            return std::nullopt;
+        }
+
+        if (slot.hash == hash)
+        {
+            auto record = readAt<FileRecord>(data_, recordsOffset_ + uint64_t(slot.record) * sizeof(FileRecord));
+            if (record.keyLength == key.size() &&
+                uint64_t(record.keyOffset) + record.keyLength <= arenaSize_ &&
+                std::memcmp(data_ + arenaOffset_ + record.keyOffset, key.data(), key.size()) == 0)
+            {
+                return slot.record;
+            }
+        }
+        pos = (pos + 1) & slotMask_;
+    }
+    return std::nullopt;
+}
+
+Rule MappedRuleIndex::rule(uint32_t record) const
+{
+    auto r = readAt<FileRecord>(data_, recordsOffset_ + uint64_t(record) * sizeof(FileRecord));
+    return Rule{arenaString(r.keyOffset, r.keyLength),
+                arenaString(r.urlOffset, r.urlLength),
+                arenaString(r.conditionOffset, r.conditionLength)};
+}
+
+std::shared_ptr<const Rule> MappedRuleIndex::prepared(uint32_t record) const
+{
+    return std::atomic_load(&prepared_[record]);
+}
+
+void MappedRuleIndex::setPrepared(uint32_t record, std::shared_ptr<const Rule> rule) const
+{
+    std::atomic_store(&prepared_[record], std::move(rule));
+}
+
+std::string MappedRuleIndex::arenaString(uint32_t offset, uint32_t length) const
+{
+    // Повреждённая запись даёт пустую строку, а не чтение за границей файла
+    if (uint64_t(offset) + length > arenaSize_)
+    {
+        return std::string();
+    }
+    return std::string(data_ + arenaOffset_ + offset, length);
+}
@@ -0,0 +1,147 @@
+#include "cache/RuleIndex.hpp"
+#include <functional>
+
+/**
+ * @file RuleIndex.cpp
+ * @brief Реализация неизменяемого индекса правил
+ * @author Anton Tobolkin
+ */
+
+RuleIndex::RuleIndex(std::vector<Rule> rules)
+{
+    rehash(rules.size());
+    rules_.reserve(rules.size());
+
+    for (auto& rule : rules)
+    {
+        upsert(std::make_shared<const Rule>(std::move(rule)));
+    }
+}
+
+std::shared_ptr<const RuleIndex> RuleIndex::apply(const std::vector<Change>& changes) const
+{
+    auto next = std::make_shared<RuleIndex>(*this);
+    for (const auto& change : changes)
+    {
+        if (change.rule)
+        {
+            next->upsert(change.rule);
+        }
+        else
+        {
+            next->erase(change.key);
+        }
+    }
+    return next;
+}
+
+const Rule* RuleIndex::find(const std::string& key) const
+{
+    if (slots_.empty())
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = slots_[probe(std::hash<std::string>{}(key), key)];
+    return slot.index == EMPTY ? nullptr : rules_[slot.index].get();
+}
+
+std::size_t RuleIndex::probe(std::size_t hash, const std::string& key) const
+{
+    std::size_t pos = hash & mask_;
+
+    // Линейное пробирование до свободного слота или того же ключа
+    while (slots_[pos].index != EMPTY &&
+           !(slots_[pos].hash == hash && rules_[slots_[pos].index]->key == key))
+    {
+        pos = (pos + 1) & mask_;
+    }
+    return pos;
+}
+
+void RuleIndex::upsert(RulePtr rule)
+{
+    if (slots_.size() < (rules_.size() + 1) * 2)
+    {
+        rehash(rules_.size() + 1);
+    }
+
+    std::size_t hash = std::hash<std::string>{}(rule->key);
+    std::size_t pos = probe(hash, rule->key);
+
+    if (slots_[pos].index != EMPTY)
+    {
+        rules_[slots_[pos].index] = std::move(rule);
+        return;
+    }
+
+    slots_[pos] = Slot{hash, static_cast<uint32_t>(rules_.size())};
+    rules_.push_back(std::move(rule));
+}
+
+void RuleIndex::erase(const std::string& key)
+{
+    if (slots_.empty())
+    {
+        return;
+    }
+
+    std::size_t hole = probe(std::hash<std::string>{}(key), key);
+    uint32_t removed = slots_[hole].index;
+    if (removed == EMPTY)
+    {
+        return;
+    }
+
+    // Последнее правило переезжает на место удалённого
+    uint32_t last = static_cast<uint32_t>(rules_.size() - 1);
+    if (removed != last)
+    {
+        const auto& moved = rules_[last];
+        slots_[probe(std::hash<std::string>{}(moved->key), moved->key)].index = removed;
+        rules_[removed] = std::move(rules_[last]);
+    }
+    rules_.pop_back();
+
+    // Сдвиг назад: цепочки после дыры не должны прерываться
+    slots_[hole] = Slot{};
+    std::size_t pos = (hole + 1) & mask_;
+    while (slots_[pos].index != EMPTY)
+    {
+        std::size_t home = slots_[pos].hash & mask_;
+        if (((pos - home) & mask_) >= ((pos - hole) & mask_))
+        {
+            slots_[hole] = slots_[pos];
+            slots_[pos] = Slot{};
+            hole = pos;
+        }
+        pos = (pos + 1) & mask_;
+    }
+}
+
+void RuleIndex::rehash(std::size_t count)
+{
+    std::size_t capacity = 2;
+    while (capacity < count * 2)
+    {
+        capacity <<= 1;
+    }
+
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot{});
+    mask_ = capacity - 1;
+
+    for (const auto& slot : old)
+    {
+        if (slot.index == EMPTY)
+        {
+            continue;
+        }
+        std::size_t pos = slot.hash & mask_;
+        while (slots_[pos].index != EMPTY)
+        {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos] = slot;
+    }
+}
@@ -16,10 +16,9 @@ RedirectHandler::RedirectHandler(std::shared_ptr<IRedirectService> redirectServi
 
 void RedirectHandler::handle(IRequest& req, IResponse& res)
 {
-    std::cout << "[RedirectHandler] Handling request: " << req.getMethod() << " " << req.getPath() << std::endl;
-    
-    // Извлекаем shortId из пути
-    std::string shortId = extractShortId(req.getPath());
+    // Успешный путь не пишет в лог: на каждый редирект это была бы
+    // синхронная запись в stdout под общей блокировкой потока
+    std::string_view shortId = extractShortId(req.getPathView());
     
     if (shortId.empty())
     {
@@ -30,27 +29,14 @@ void RedirectHandler::handle(IRequest& req, IResponse& res)
         return;
     }
     
-    std::cout << "[RedirectHandler] Extracted shortId: " << shortId << std::endl;
-    
-    // Строим запрос на редирект со всеми данными
+    // Заголовки не копируются: DSL запрашивает нужные прямо из запроса
     RedirectRequest redirectReq{
-        shortId,
-        req.getIp(),
-        req.getHeaders()
+        std::string(shortId),
+        std::string(req.getIpView()),
+        {},
+        [&req](const std::string& name) { return req.getHeaderView(name); }
     };
     
-    // Логируем контекст для отладки
-    std::cout << "[RedirectHandler] Client IP: " << redirectReq.ip << std::endl;
-    auto uaIt = redirectReq.headers.find("User-Agent");
-    if (uaIt != redirectReq.headers.end())
-    {
-        std::cout << "[RedirectHandler] User-Agent: " << uaIt->second << std::endl;
-    }
-    else
-    {
-        std::cout << "[RedirectHandler] User-Agent not found in headers" << std::endl;
-    }
-    
     // Вызываем сервис
     auto result = redirectService_->redirect(redirectReq);
     
@@ -62,33 +48,32 @@ void RedirectHandler::handle(IRequest& req, IResponse& res)
         res.setBody("Not Found: " + result.errorMessage);
         return;
     }
-    
-    std::cout << "[RedirectHandler] Redirecting to: " << result.targetUrl << std::endl;
-    
+
+    // Готовый ответ уходит в сокет без сборки заголовков
+    if (result.response)
+    {
+        res.setPrerendered(std::move(result.response));
+        return;
+    }
+
     // Возвращаем HTTP 302 редирект
     res.setStatus(302);
     res.setHeader("Location", result.targetUrl);
     res.setBody("");
 }
 
-std::string RedirectHandler::extractShortId(const std::string& path) const
+std::string_view RedirectHandler::extractShortId(std::string_view path) const
 {
     // Ожидаем путь вида: /r/promo
-    std::string prefix = "/r/";
+    constexpr std::string_view prefix = "/r/";
     
-    if (path.find(prefix) != 0)
+    if (path.substr(0, prefix.size()) != prefix)
     {
-        return "";
+        return {};
     }
     
-    std::string shortId = path.substr(prefix.length());
+    std::string_view shortId = path.substr(prefix.size());
     
     // Убираем query string если есть
-    size_t queryPos = shortId.find('?');
-    if (queryPos != std::string::npos)
-    {
-        shortId = shortId.substr(0, queryPos);
-    }
-    
-    return shortId;
+    return shortId.substr(0, shortId.find('?'));
 }
\ No newline at end of file
@@ -33,4 +33,23 @@ std::shared_ptr<ASTNode> ASTNode::makeBinaryOp(
     node->left = left;
     node->right = right;
     return node;
-}
\ No newline at end of file
+}
+
+std::shared_ptr<ASTNode> ASTNode::makeConstant(bool value)
+{
+    auto node = std::make_shared<ASTNode>();
+    node->type = NodeType::Constant;
+    node->value = value ? "true" : "false";
+    return node;
+}
+
+std::shared_ptr<ASTNode> ASTNode::makeChain(
+    OperatorType op,
+    std::vector<std::shared_ptr<ASTNode>> operands)
+{
+    auto node = std::make_shared<ASTNode>();
+    node->type = NodeType::Chain;
+    node->op = op;
+    node->operands = std::move(operands);
+    return node;
+}
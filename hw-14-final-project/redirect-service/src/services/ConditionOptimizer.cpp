@@ -0,0 +1,231 @@
+#include "services/ConditionOptimizer.hpp"
+#include "services/ChainStats.hpp"
+#include <algorithm>
+
+/**
+ * @file ConditionOptimizer.cpp
+ * @brief Реализация оптимизирующего прохода по DSL-условию
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    const char* operatorName(OperatorType op)
+    {
+        switch (op)
+        {
+        case OperatorType::Equal: return "==";
+        case OperatorType::NotEqual: return "!=";
+        case OperatorType::Less: return "<";
+        case OperatorType::Greater: return ">";
+        case OperatorType::LessOrEqual: return "<=";
+        case OperatorType::GreaterOrEqual: return ">=";
+        case OperatorType::And: return "AND";
+        case OperatorType::Or: return "OR";
+        }
+        return "?";
+    }
+
+    bool isLogical(OperatorType op)
+    {
+        return op == OperatorType::And || op == OperatorType::Or;
+    }
+}
+
+std::shared_ptr<ASTNode> ConditionOptimizer::optimize(const std::shared_ptr<ASTNode>& root)
+{
+    if (!root)
+    {
+        return ASTNode::makeConstant(false);
+    }
+
+    switch (root->type)
+    {
+    case NodeType::Literal:
+    case NodeType::Variable:
+        // Одиночный операнд интерпретатор считает истинным
+        return ASTNode::makeConstant(true);
+
+    case NodeType::Constant:
+    case NodeType::Chain:
+        return root;
+
+    case NodeType::BinaryOp:
+        if (isLogical(root->op))
+        {
+            return optimizeChain(root->op, *root);
+        }
+        // Интерпретатор сравнивает только переменную с литералом, иначе - false
+        return isComparison(*root) ? root : ASTNode::makeConstant(false);
+    }
+
+    return root;
+}
+
+double ConditionOptimizer::cost(const ASTNode& node)
+{
+    switch (node.type)
+    {
+    case NodeType::Literal:
+    case NodeType::Variable:
+    case NodeType::Constant:
+        return 0;
+
+    case NodeType::BinaryOp:
+        if (isLogical(node.op))
+        {
+            return (node.left ? cost(*node.left) : 0) + (node.right ? cost(*node.right) : 0);
+        }
+        return isComparison(node) ? variableCost(node.left->value) + 1 : 0;
+
+    case NodeType::Chain:
+    {
+        double total = 0;
+        for (const auto& operand : node.operands)
+        {
+            total += cost(*operand);
+        }
+        return total;
+    }
+    }
+
+    return 0;
+}
+
+std::string ConditionOptimizer::describe(const ASTNode& node)
+{
+    switch (node.type)
+    {
+    case NodeType::Literal:
+        return "\"" + node.value + "\"";
+
+    case NodeType::Variable:
+    case NodeType::Constant:
+        return node.value;
+
+    case NodeType::BinaryOp:
+        return "(" + (node.left ? describe(*node.left) : std::string("null")) + " " +
+               operatorName(node.op) + " " +
+               (node.right ? describe(*node.right) : std::string("null")) + ")";
+
+    case NodeType::Chain:
+    {
+        std::string result = std::string(operatorName(node.op)) + "(";
+        for (std::size_t i = 0; i < node.operands.size(); ++i)
+        {
+            result += (i ? ", " : "") + describe(*node.operands[i]);
+        }
+        return result + ")";
+    }
+    }
+
+    return "?";
+}
+
+bool ConditionOptimizer::isComparison(const ASTNode& node)
+{
+    return node.type == NodeType::BinaryOp && !isLogical(node.op) &&
+           node.left && node.left->type == NodeType::Variable &&
+           node.right && node.right->type == NodeType::Literal;
+}
+
+double ConditionOptimizer::variableCost(const std::string& name)
+{
+    // browser - перевод User-Agent в нижний регистр и несколько поисков подстрок
+    if (name == "browser")
+    {
+        return 8;
+    }
+    // date - копия закэшированной строки, header.* - поиск в заголовках
+    if (name == "date" || name.rfind("header.", 0) == 0)
+    {
+        return 2;
+    }
+    return 1;
+}
+
+std::shared_ptr<ASTNode> ConditionOptimizer::optimizeChain(OperatorType op, const ASTNode& node)
+{
+    std::vector<std::shared_ptr<ASTNode>> collected;
+    collectOperands(op, node.left, collected);
+    collectOperands(op, node.right, collected);
+
+    bool isAnd = op == OperatorType::And;
+    std::vector<std::shared_ptr<ASTNode>> operands;
+    std::vector<std::string> seen;
+
+    for (const auto& operand : collected)
+    {
+        if (operand->type == NodeType::Constant)
+        {
+            bool value = operand->value == "true";
+            if (value != isAnd)
+            {
+                // false для AND или true для OR определяет всю цепочку
+                return operand;
+            }
+            continue;
+        }
+
+        std::string key = describe(*operand);
+        if (std::find(seen.begin(), seen.end(), key) != seen.end())
+        {
+            continue;
+        }
+        seen.push_back(std::move(key));
+        operands.push_back(operand);
+    }
+
+    if (operands.empty())
+    {
+        return ASTNode::makeConstant(isAnd);
+    }
+    if (operands.size() == 1)
+    {
+        return operands.front();
+    }
+
+    // Начальный порядок - по стоимости; селективность уточнит его в работе
+    std::vector<std::pair<double, std::shared_ptr<ASTNode>>> ranked;
+    for (auto& operand : operands)
+    {
+        ranked.emplace_back(cost(*operand), std::move(operand));
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<double> costs;
+    operands.clear();
+    for (auto& [operandCost, operand] : ranked)
+    {
+        costs.push_back(operandCost);
+        operands.push_back(std::move(operand));
+    }
+
+    auto chain = ASTNode::makeChain(op, std::move(operands));
+    if (chain->operands.size() <= ChainStats::MAX_OPERANDS)
+    {
+        chain->stats = std::make_shared<ChainStats>(op, std::move(costs));
+    }
+    return chain;
+}
+
+void ConditionOptimizer::collectOperands(OperatorType op, const std::shared_ptr<ASTNode>& node,
+                                         std::vector<std::shared_ptr<ASTNode>>& operands)
+{
+    // Вложенная операция того же вида раскрывается в операнды цепочки
+    if (node && node->type == NodeType::BinaryOp && node->op == op)
+    {
+        collectOperands(op, node->left, operands);
+        collectOperands(op, node->right, operands);
+        return;
+    }
+
+    auto optimized = optimize(node);
+    if (optimized->type == NodeType::Chain && optimized->op == op)
+    {
+        operands.insert(operands.end(), optimized->operands.begin(), optimized->operands.end());
+        return;
+    }
+    operands.push_back(std::move(optimized));
+}
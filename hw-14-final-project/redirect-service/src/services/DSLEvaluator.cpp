@@ -1,7 +1,10 @@
 #include "services/DSLEvaluator.hpp"
+#include "services/ChainStats.hpp"
+#include "services/ConditionOptimizer.hpp"
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 
@@ -22,15 +25,16 @@ bool DSLEvaluator::evaluate(const std::string &condition, const RedirectRequest
     auto it = cache_.find(condition);
     if (it != cache_.end())
     {
-        return evaluateAST(it->second, req);
+        return evaluateCompiled(*it->second, req);
     }
 
     try
     {
-        auto ast = parser_.parse(condition);
+        auto ast = ConditionOptimizer::optimize(parser_.parse(condition));
+        attachMemo(*ast);
         cache_[condition] = ast;
         std::cout << "[DSLEvaluator] Parsed and cached condition: " << condition << std::endl;
-        return evaluateAST(ast, req);
+        return evaluateCompiled(*ast, req);
     }
     catch (const std::exception &e)
     {
@@ -39,7 +43,118 @@ bool DSLEvaluator::evaluate(const std::string &condition, const RedirectRequest
     }
 }
 
-bool DSLEvaluator::evaluateAST(const std::shared_ptr<ASTNode> &ast, const RedirectRequest &req)
+std::shared_ptr<const ASTNode> DSLEvaluator::compile(const std::string &condition)
+{
+    // Отдельный парсер: compile вызывается из потока загрузки снимка
+    RuleParser parser;
+    auto ast = ConditionOptimizer::optimize(parser.parse(condition));
+    attachMemo(*ast);
+    return ast;
+}
+
+bool DSLEvaluator::evaluateCompiled(const ASTNode &condition, const RedirectRequest &req)
+{
+    if (!condition.memo)
+    {
+        return evaluateAST(&condition, req);
+    }
+
+    // Ключ строится из сырых входов без разбора User-Agent: разбор нужен только при промахе
+    std::uint64_t key = DecisionMemo::SEED;
+    for (const auto &name : condition.memo->footprint())
+    {
+        key = mixMemoInput(key, name, req);
+    }
+
+    if (auto decision = condition.memo->find(key))
+    {
+        return *decision;
+    }
+
+    bool decision = evaluateAST(&condition, req);
+    condition.memo->store(key, decision);
+    return decision;
+}
+
+std::uint64_t DSLEvaluator::mixMemoInput(std::uint64_t key, const std::string &varName, const RedirectRequest &req)
+{
+    // browser однозначно определяется User-Agent - хешируем его как есть
+    if (varName == "browser")
+    {
+        return DecisionMemo::mix(key, req.header("User-Agent"));
+    }
+
+    if (varName == "date")
+    {
+        return DecisionMemo::mix(key, currentDate());
+    }
+
+    return DecisionMemo::mix(key, getVariableValue(varName, req));
+}
+
+void DSLEvaluator::attachMemo(ASTNode &root)
+{
+    // Константу вычислить дешевле, чем найти в таблице
+    if (root.type == NodeType::Constant)
+    {
+        return;
+    }
+
+    std::vector<std::string> names;
+    collectVariables(&root, names);
+
+    // ip и header.* почти уникальны для запроса - таблица бы не помогла
+    if (!std::all_of(names.begin(), names.end(), isMemoizable))
+    {
+        return;
+    }
+
+    root.memo = std::make_shared<DecisionMemo>(std::move(names));
+}
+
+void DSLEvaluator::collectVariables(const ASTNode *ast, std::vector<std::string> &names)
+{
+    if (!ast)
+        return;
+
+    if (ast->type == NodeType::Variable &&
+        std::find(names.begin(), names.end(), ast->value) == names.end())
+    {
+        names.push_back(ast->value);
+    }
+
+    collectVariables(ast->left.get(), names);
+    collectVariables(ast->right.get(), names);
+    for (const auto &operand : ast->operands)
+    {
+        collectVariables(operand.get(), names);
+    }
+}
+
+bool DSLEvaluator::isMemoizable(const std::string &varName)
+{
+    return varName == "browser" || varName == "country" || varName == "date";
+}
+
+const std::string &DSLEvaluator::currentDate()
+{
+    // Форматирование даты дороже самой проверки условия - держим значение минуту
+    thread_local std::time_t cachedMinute = -1;
+    thread_local std::string cachedDate;
+
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (now / 60 != cachedMinute)
+    {
+        std::tm tm = *std::localtime(&now);
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%d");
+        cachedDate = oss.str();
+        cachedMinute = now / 60;
+    }
+    return cachedDate;
+}
+
+bool DSLEvaluator::evaluateAST(const ASTNode *ast, const RedirectRequest &req)
 {
     if (!ast)
         return false;
@@ -52,13 +167,19 @@ bool DSLEvaluator::evaluateAST(const std::shared_ptr<ASTNode> &ast, const Redire
     case NodeType::Variable:
         return true;
 
+    case NodeType::Constant:
+        return ast->value == "true";
+
+    case NodeType::Chain:
+        return evaluateChain(*ast, req);
+
     case NodeType::BinaryOp:
     {
         if (ast->op == OperatorType::And)
-            return evaluateAST(ast->left, req) && evaluateAST(ast->right, req);
+            return evaluateAST(ast->left.get(), req) && evaluateAST(ast->right.get(), req);
 
         if (ast->op == OperatorType::Or)
-            return evaluateAST(ast->left, req) || evaluateAST(ast->right, req);
+            return evaluateAST(ast->left.get(), req) || evaluateAST(ast->right.get(), req);
 
         if (!ast->left || ast->left->type != NodeType::Variable)
         {
@@ -88,6 +209,52 @@ bool DSLEvaluator::evaluateAST(const std::shared_ptr<ASTNode> &ast, const Redire
     return false;
 }
 
+bool DSLEvaluator::evaluateChain(const ASTNode &chain, const RedirectRequest &req)
+{
+    // Цепочка завершается на первом false для AND и на первом true для OR
+    const bool isAnd = chain.op == OperatorType::And;
+    ChainStats *stats = chain.stats.get();
+
+    if (!stats)
+    {
+        for (const auto &operand : chain.operands)
+        {
+            if (evaluateAST(operand.get(), req) != isAnd)
+            {
+                return !isAnd;
+            }
+        }
+        return isAnd;
+    }
+
+    // Счётчики общие для всех потоков - пишем только выборку вычислений
+    thread_local std::uint32_t tick = 0;
+    const bool sampled = ++tick % ChainStats::SAMPLE_RATE == 0;
+
+    const std::uint64_t order = stats->order();
+    bool result = isAnd;
+    for (std::size_t position = 0; position < chain.operands.size(); ++position)
+    {
+        std::size_t operand = ChainStats::operandAt(order, position);
+        bool value = evaluateAST(chain.operands[operand].get(), req);
+        if (sampled)
+        {
+            stats->record(operand, value);
+        }
+        if (value != isAnd)
+        {
+            result = !isAnd;
+            break;
+        }
+    }
+
+    if (sampled)
+    {
+        stats->finishSample();
+    }
+    return result;
+}
+
 std::string DSLEvaluator::getVariableValue(
     const std::string &varName,
     const RedirectRequest &req)
@@ -97,9 +264,7 @@ std::string DSLEvaluator::getVariableValue(
     //
     if (varName == "browser")
     {
-        auto it = req.headers.find("User-Agent");
-        std::string ua = (it != req.headers.end()) ? it->second : "";
-        std::string uaLower = ua;
+        std::string uaLower(req.header("User-Agent"));
         std::transform(uaLower.begin(), uaLower.end(), uaLower.begin(), ::tolower);
 
         // порядок важен!
@@ -142,12 +307,7 @@ std::string DSLEvaluator::getVariableValue(
     //
     if (varName == "date")
     {
-        auto now = std::chrono::system_clock::now();
-        auto t = std::chrono::system_clock::to_time_t(now);
-        std::tm tm = *std::localtime(&t);
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%Y-%m-%d");
-        return oss.str();
+        return currentDate();
     }
 
     //
@@ -164,10 +324,7 @@ std::string DSLEvaluator::getVariableValue(
     if (varName.rfind("header.", 0) == 0)
     {
         const std::string headerName = varName.substr(7);
-        auto it = req.headers.find(headerName);
-        if (it != req.headers.end())
-            return it->second;
-        return "";
+        return std::string(req.header(headerName));
     }
 
     //
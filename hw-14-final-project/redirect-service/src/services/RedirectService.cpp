@@ -1,4 +1,6 @@
 #include "services/RedirectService.hpp"
+#include "services/ASTNode.hpp"
+#include "domain/RedirectResponse.hpp"
 #include <iostream>
 
 /**
@@ -9,16 +11,23 @@
 
 RedirectService::RedirectService(
     std::shared_ptr<IRuleClient> ruleClient,
-    std::shared_ptr<IRuleEvaluator> evaluator)
+    std::shared_ptr<IRuleEvaluator> evaluator,
+    std::shared_ptr<IRedirectAnalytics> analytics,
+    std::shared_ptr<HotKeyTracker> hotKeys)
     : ruleClient_(ruleClient)
     , evaluator_(evaluator)
+    , analytics_(analytics)
+    , hotKeys_(hotKeys)
 {
     std::cout << "[RedirectService] Service created with injected dependencies" << std::endl;
 }
 
 RedirectResult RedirectService::redirect(const RedirectRequest& req)
 {
-    std::cout << "[RedirectService] Processing redirect for: " << req.shortId << std::endl;
+    if (hotKeys_)
+    {
+        hotKeys_->hit(req.shortId);
+    }
     
     // Получаем правило из клиента
     auto rule = ruleClient_->findByKey(req.shortId);
@@ -26,19 +35,45 @@ RedirectResult RedirectService::redirect(const RedirectRequest& req)
     if (!rule.has_value())
     {
         std::cout << "[RedirectService] Rule not found" << std::endl;
+        if (analytics_)
+        {
+            analytics_->record(req.shortId, RedirectOutcome::NotFound);
+        }
         return RedirectResult{false, "", "Rule not found for key: " + req.shortId};
     }
     
-    // Оцениваем DSL условие
-    bool conditionMet = evaluator_->evaluate(rule->condition, req);
+    // Оцениваем DSL условие, предкомпилированное - без разбора строки
+    bool conditionMet = rule->compiled
+        ? evaluator_->evaluateCompiled(*rule->compiled, req)
+        : evaluator_->evaluate(rule->condition, req);
     
     if (!conditionMet)
     {
         std::cout << "[RedirectService] Condition not met" << std::endl;
+        if (analytics_)
+        {
+            analytics_->record(req.shortId, RedirectOutcome::ConditionFailed);
+        }
         return RedirectResult{false, "", "Condition not satisfied"};
     }
     
-    std::cout << "[RedirectService] Redirect successful to: " << rule->targetUrl << std::endl;
-    
-    return RedirectResult{true, rule->targetUrl, ""};
+    // Ответ собирается при кэшировании правила; здесь - только для правил без него
+    auto response = rule->redirect ? std::move(rule->redirect) : RedirectResponse::render(rule->targetUrl);
+    if (!response)
+    {
+        // Такой адрес дописал бы свои строки в заголовки ответа
+        std::cerr << "[RedirectService] Unsafe target URL for: " << req.shortId << std::endl;
+        if (analytics_)
+        {
+            analytics_->record(req.shortId, RedirectOutcome::NotFound);
+        }
+        return RedirectResult{false, "", "Invalid target URL for key: " + req.shortId};
+    }
+
+    if (analytics_)
+    {
+        analytics_->record(req.shortId, RedirectOutcome::Redirected);
+    }
+
+    return RedirectResult{true, std::move(rule->targetUrl), "", std::move(response)};
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "services/ConditionOptimizer.hpp"
+#include "services/ChainStats.hpp"
+#include "services/DSLEvaluator.hpp"
+#include "services/RuleParser.hpp"
+
+/**
+ * @file ConditionOptimizerTest.cpp
+ * @brief Unit-тесты для ConditionOptimizer и ChainStats
+ */
+
+namespace
+{
+std::shared_ptr<ASTNode> optimized(const std::string& condition)
+{
+    RuleParser parser;
+    return ConditionOptimizer::optimize(parser.parse(condition));
+}
+}
+
+// Вложенные AND сливаются в одну цепочку, дешёвые операнды идут первыми
+TEST(ConditionOptimizerTest, FlattensAndOrdersByCost)
+{
+    auto ast = optimized("browser == \"chrome\" AND (country == \"RU\" AND ip == \"10.0.0.1\")");
+
+    ASSERT_EQ(ast->type, NodeType::Chain);
+    EXPECT_EQ(ast->op, OperatorType::And);
+    ASSERT_EQ(ast->operands.size(), 3u);
+    EXPECT_EQ(ConditionOptimizer::describe(*ast->operands.back()), "(browser == \"chrome\")");
+    EXPECT_NE(ast->stats, nullptr);
+}
+
+// Повторяющиеся операнды удаляются, одиночный остаток заменяет цепочку
+TEST(ConditionOptimizerTest, RemovesDuplicatePredicates)
+{
+    auto ast = optimized("ip == \"1.1.1.1\" OR ip == \"1.1.1.1\"");
+
+    EXPECT_EQ(ConditionOptimizer::describe(*ast), "(ip == \"1.1.1.1\")");
+}
+
+// Константы сворачиваются так же, как их вычислил бы интерпретатор
+TEST(ConditionOptimizerTest, FoldsConstants)
+{
+    auto node = ASTNode::makeBinaryOp(OperatorType::Or,
+        ASTNode::makeBinaryOp(OperatorType::Equal, ASTNode::makeVariable("ip"), ASTNode::makeLiteral("1")),
+        ASTNode::makeLiteral("always"));
+    auto folded = ConditionOptimizer::optimize(node);
+    ASSERT_EQ(folded->type, NodeType::Constant);
+    EXPECT_EQ(folded->value, "true");
+
+    auto malformed = ASTNode::makeBinaryOp(OperatorType::And,
+        ASTNode::makeBinaryOp(OperatorType::Equal, ASTNode::makeLiteral("a"), ASTNode::makeLiteral("a")),
+        ASTNode::makeBinaryOp(OperatorType::Equal, ASTNode::makeVariable("ip"), ASTNode::makeLiteral("1")));
+    auto falsified = ConditionOptimizer::optimize(malformed);
+    ASSERT_EQ(falsified->type, NodeType::Constant);
+    EXPECT_EQ(falsified->value, "false");
+}
+
+// Оптимизированное условие вычисляется так же, как исходное
+TEST(ConditionOptimizerTest, PreservesSemantics)
+{
+    DSLEvaluator evaluator;
+    const std::string condition =
+        "(browser == \"firefox\" OR ip == \"10.0.0.1\") AND (ip != \"10.0.0.2\" AND country == \"RU\")";
+    auto compiled = evaluator.compile(condition);
+
+    RedirectRequest firefox{"test", "10.0.0.3", {{"User-Agent", "Mozilla/5.0 Firefox/121.0"}}};
+    RedirectRequest chromeAllowed{"test", "10.0.0.1", {{"User-Agent", "Mozilla/5.0 Chrome/120.0"}}};
+    RedirectRequest blocked{"test", "10.0.0.2", {{"User-Agent", "Mozilla/5.0 Firefox/121.0"}}};
+
+    // Достаточно вычислений, чтобы порядок операндов пересчитался несколько раз
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, firefox));
+        EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, chromeAllowed));
+        EXPECT_FALSE(evaluator.evaluateCompiled(*compiled, blocked));
+    }
+}
+
+// Операнд, чаще других завершающий AND, поднимается в начало
+TEST(ConditionOptimizerTest, ReordersBySelectivity)
+{
+    ChainStats stats(OperatorType::And, {1, 1, 1});
+
+    for (int i = 0; i < 100; ++i)
+    {
+        stats.record(0, true);
+        stats.record(1, true);
+        stats.record(2, false);
+    }
+    stats.reorder();
+
+    EXPECT_EQ(ChainStats::operandAt(stats.order(), 0), 2u);
+}
+
+// Для OR первым идёт операнд, чаще дающий true; дорогой - позже при равной селективности
+TEST(ConditionOptimizerTest, ReorderWeighsCost)
+{
+    ChainStats stats(OperatorType::Or, {8, 1});
+
+    for (int i = 0; i < 100; ++i)
+    {
+        stats.record(0, i % 2 == 0);
+        stats.record(1, i % 2 == 0);
+    }
+    stats.reorder();
+
+    EXPECT_EQ(ChainStats::operandAt(stats.order(), 0), 1u);
+    EXPECT_EQ(ChainStats::operandAt(stats.order(), 1), 0u);
+}
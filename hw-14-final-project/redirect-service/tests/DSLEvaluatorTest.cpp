@@ -247,3 +247,80 @@ TEST(DSLEvaluatorTest, MalformedExpressionReturnsFalse) {
     EXPECT_FALSE(evaluator.evaluate("AND browser == \"chrome\"", req)); // начинается с AND
     EXPECT_FALSE(evaluator.evaluate("browser == \"chrome\" OR", req)); // заканчивается OR
 }
+
+// Тест: заранее скомпилированное условие даёт тот же результат
+TEST(DSLEvaluatorTest, CompiledConditionMatchesEvaluate)
+{
+    DSLEvaluator evaluator;
+    const std::string condition = "browser == \"firefox\" OR country == \"US\"";
+
+    auto compiled = evaluator.compile(condition);
+    ASSERT_NE(compiled, nullptr);
+
+    RedirectRequest firefox{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Firefox/121.0"}}};
+    RedirectRequest chrome{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Chrome/120.0"}}};
+
+    EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, firefox));
+    EXPECT_FALSE(evaluator.evaluateCompiled(*compiled, chrome));
+    EXPECT_EQ(evaluator.evaluate(condition, chrome), evaluator.evaluateCompiled(*compiled, chrome));
+}
+
+// Тест: синтаксическая ошибка при компиляции
+TEST(DSLEvaluatorTest, CompileThrowsOnSyntaxError)
+{
+    DSLEvaluator evaluator;
+    EXPECT_THROW(evaluator.compile("browser == "), std::runtime_error);
+}
+
+// Тест: условие от browser/country получает таблицу решений
+TEST(DSLEvaluatorTest, CompileRecordsVariableFootprint)
+{
+    DSLEvaluator evaluator;
+
+    auto coarse = evaluator.compile("browser == \"firefox\" AND (country == \"RU\" OR browser == \"edge\")");
+    ASSERT_NE(coarse->memo, nullptr);
+    EXPECT_EQ(coarse->memo->footprint(), (std::vector<std::string>{"browser", "country"}));
+
+    // ip почти уникален для запроса - таблица не прикладывается
+    EXPECT_EQ(evaluator.compile("ip == \"10.0.0.1\"")->memo, nullptr);
+    EXPECT_EQ(evaluator.compile("browser == \"chrome\" AND ip == \"10.0.0.1\"")->memo, nullptr);
+}
+
+// Тест: запомненные решения не смешиваются между значениями переменных
+TEST(DSLEvaluatorTest, MemoizedDecisionsFollowVariableValues)
+{
+    DSLEvaluator evaluator;
+    auto compiled = evaluator.compile("browser == \"firefox\" OR browser == \"edge\"");
+
+    RedirectRequest firefox{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Firefox/121.0"}}};
+    RedirectRequest chrome{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Chrome/120.0"}}};
+    RedirectRequest edge{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Chrome/120.0 Edg/120.0"}}};
+
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, firefox));
+        EXPECT_FALSE(evaluator.evaluateCompiled(*compiled, chrome));
+        EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, edge));
+    }
+}
+
+// Тест: ключ таблицы - сырой User-Agent, browser при попадании не вычисляется
+TEST(DSLEvaluatorTest, MemoKeyUsesRawUserAgent)
+{
+    DSLEvaluator evaluator;
+    auto compiled = evaluator.compile("browser == \"firefox\"");
+    ASSERT_NE(compiled->memo, nullptr);
+
+    RedirectRequest firefox{"test", "0.0.0.0", {{"User-Agent", "Mozilla/5.0 Firefox/121.0"}}};
+    RedirectRequest noAgent{"test", "0.0.0.0", {}};
+
+    EXPECT_TRUE(evaluator.evaluateCompiled(*compiled, firefox));
+    EXPECT_FALSE(evaluator.evaluateCompiled(*compiled, noAgent));
+
+    auto byAgent = compiled->memo->find(DecisionMemo::hashValues({"Mozilla/5.0 Firefox/121.0"}));
+    ASSERT_TRUE(byAgent.has_value());
+    EXPECT_TRUE(*byAgent);
+    auto empty = compiled->memo->find(DecisionMemo::hashValues({""}));
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_FALSE(*empty);
+}
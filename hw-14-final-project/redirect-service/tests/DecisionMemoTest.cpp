@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "services/DecisionMemo.hpp"
+
+/**
+ * @file DecisionMemoTest.cpp
+ * @brief Unit-тесты для DecisionMemo
+ */
+
+// Пустая таблица ничего не находит, сохранённое решение находится
+TEST(DecisionMemoTest, StoresDecisions)
+{
+    DecisionMemo memo({"browser"});
+    auto chrome = DecisionMemo::hashValues({"chrome"});
+    auto firefox = DecisionMemo::hashValues({"firefox"});
+
+    EXPECT_FALSE(memo.find(chrome).has_value());
+
+    memo.store(chrome, true);
+    memo.store(firefox, false);
+
+    ASSERT_TRUE(memo.find(chrome).has_value());
+    EXPECT_TRUE(*memo.find(chrome));
+    ASSERT_TRUE(memo.find(firefox).has_value());
+    EXPECT_FALSE(*memo.find(firefox));
+}
+
+// Ключ учитывает границы значений
+TEST(DecisionMemoTest, HashSeparatesValues)
+{
+    EXPECT_NE(DecisionMemo::hashValues({"ab", "c"}), DecisionMemo::hashValues({"a", "bc"}));
+    EXPECT_NE(DecisionMemo::hashValues({"chrome", "RU"}), DecisionMemo::hashValues({"RU", "chrome"}));
+}
+
+// Нулевой ключ и ложное решение не путаются с пустым слотом
+TEST(DecisionMemoTest, ZeroKeyIsStored)
+{
+    DecisionMemo memo({});
+
+    memo.store(0, false);
+
+    ASSERT_TRUE(memo.find(0).has_value());
+    EXPECT_FALSE(*memo.find(0));
+}
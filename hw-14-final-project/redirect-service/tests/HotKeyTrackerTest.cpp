@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "analytics/HotKeyTracker.hpp"
+#include "analytics/HotKeyWarmup.hpp"
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file HotKeyTrackerTest.cpp
+ * @brief Unit-тесты для HotKeyTracker и HotKeyWarmup
+ */
+
+// Частые ключи попадают в top-K несмотря на длинный хвост редких
+TEST(HotKeyTrackerTest, FindsHeavyHittersAmongNoise)
+{
+    HotKeyTracker tracker(3, 2048, 4);
+
+    for (int round = 0; round < 200; ++round)
+    {
+        tracker.hit("promo");
+        tracker.hit("promo");
+        tracker.hit("promo");
+        tracker.hit("docs");
+        tracker.hit("docs");
+        tracker.hit("blog");
+        tracker.hit("rare-" + std::to_string(round));
+    }
+
+    auto top = tracker.top(10);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0].shortId, "promo");
+    EXPECT_EQ(top[1].shortId, "docs");
+    EXPECT_EQ(top[2].shortId, "blog");
+    EXPECT_GE(top[0].hits, 600u);
+    EXPECT_EQ(tracker.totalHits(), 1400u);
+
+    EXPECT_EQ(tracker.top(1).size(), 1u);
+    EXPECT_LT(tracker.estimate("rare-1"), tracker.estimate("blog"));
+}
+
+// Новый горячий ключ вытесняет остывший после деления счётчиков
+TEST(HotKeyTrackerTest, DecayLetsNewKeysReplaceOldOnes)
+{
+    HotKeyTracker tracker(1, 1024, 4, 1, 256);
+
+    for (int i = 0; i < 1024; ++i)
+    {
+        tracker.hit("old");
+    }
+    for (int i = 0; i < 2048; ++i)
+    {
+        tracker.hit("new");
+    }
+
+    auto top = tracker.top(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].shortId, "new");
+    EXPECT_LT(tracker.estimate("old"), 1024u);
+}
+
+// Выборка учитывает каждое N-е обращение потока, оценки масштабируются
+TEST(HotKeyTrackerTest, SamplingScalesEstimates)
+{
+    HotKeyTracker tracker(4, 1024, 4, 4);
+
+    std::thread worker([&tracker] {
+        for (int i = 0; i < 4000; ++i)
+        {
+            tracker.hit("promo");
+        }
+    });
+    worker.join();
+
+    EXPECT_EQ(tracker.totalHits(), 4000u);
+    EXPECT_EQ(tracker.estimate("promo"), 4000u);
+    ASSERT_EQ(tracker.top(1).size(), 1u);
+}
+
+// Счётчики по потокам: все обращения учтены, горячий ключ найден
+TEST(HotKeyTrackerTest, ShardedTrackerCountsAllThreads)
+{
+    HotKeyTracker tracker(2, 1024, 4, 1, 0, 4);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&tracker, t] {
+            for (int i = 0; i < 1000; ++i)
+            {
+                tracker.hit("promo");
+                tracker.hit("rare-" + std::to_string(t) + "-" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_EQ(tracker.totalHits(), 8000u);
+    EXPECT_GE(tracker.estimate("promo"), 4000u);
+    auto top = tracker.top(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].shortId, "promo");
+}
+
+// Список прогрева сохраняется в порядке горячести и читается обратно
+TEST(HotKeyTrackerTest, WarmupListRoundTrip)
+{
+    const std::string path = ::testing::TempDir() + "hot_keys.txt";
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(HotKeyWarmup::load(path).empty());
+
+    ASSERT_TRUE(HotKeyWarmup::save(path, {HotKey{"promo", 30}, HotKey{"docs", 20}}));
+    EXPECT_EQ(HotKeyWarmup::load(path), (std::vector<std::string>{"promo", "docs"}));
+
+    std::remove(path.c_str());
+}
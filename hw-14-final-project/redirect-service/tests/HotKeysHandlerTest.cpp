@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "handlers/HotKeysHandler.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+#include <nlohmann/json.hpp>
+
+/**
+ * Запрос с параметрами query string
+ */
+class HotKeysRequest : public SimpleRequest {
+public:
+    std::map<std::string, std::string> params;
+
+    explicit HotKeysRequest(std::map<std::string, std::string> query)
+        : SimpleRequest("GET", "/admin/hot-keys", "", "127.0.0.1", 8080, {}), params(std::move(query)) {}
+
+    std::map<std::string, std::string> getParams() const override { return params; }
+};
+
+TEST(HotKeysHandlerTest, ReturnsTopKeys) {
+    auto tracker = std::make_shared<HotKeyTracker>(10, 1024, 4);
+    for (int i = 0; i < 16; ++i) {
+        tracker->hit("promo");
+    }
+    for (int i = 0; i < 8; ++i) {
+        tracker->hit("docs");
+    }
+    HotKeysHandler handler(tracker);
+
+    HotKeysRequest request(std::map<std::string, std::string>{{"limit", "1"}});
+    SimpleResponse response;
+    handler.handle(request, response);
+
+    EXPECT_EQ(response.getStatus(), 200);
+    auto body = nlohmann::json::parse(response.getBody());
+    EXPECT_EQ(body["totalHits"], 24);
+    ASSERT_EQ(body["keys"].size(), 1u);
+    EXPECT_EQ(body["keys"][0]["shortId"], "promo");
+    EXPECT_EQ(body["keys"][0]["hits"], 16);
+}
+
+TEST(HotKeysHandlerTest, RejectsInvalidLimit) {
+    auto tracker = std::make_shared<HotKeyTracker>(10, 1024, 4);
+    HotKeysHandler handler(tracker);
+
+    HotKeysRequest request(std::map<std::string, std::string>{{"limit", "-1"}});
+    SimpleResponse response;
+    handler.handle(request, response);
+
+    EXPECT_EQ(response.getStatus(), 400);
+}
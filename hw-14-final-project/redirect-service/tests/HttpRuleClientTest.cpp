@@ -3,10 +3,17 @@
 #include "SimpleRequest.hpp"
 #include "SimpleResponse.hpp"
 #include "Environment.hpp"
+#include <atomic>
+#include <chrono>
 #include <optional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
 #include "settings/RuleServiceSettings.hpp"
+#include "WireFormat.hpp"
 
 /**
  * Заглушка IHttpClient
@@ -92,3 +99,380 @@ TEST(HttpRuleClientTest, FindByKeyNotFound)
     auto ruleOpt = client.findByKey("missingKey");
     EXPECT_FALSE(ruleOpt.has_value());
 }
+
+/**
+ * Заглушка rule-service, которую можно "уронить"
+ */
+class FlakyRuleServiceClient : public IHttpClient
+{
+public:
+    std::atomic<bool> up{true};
+    std::atomic<int> calls{0};
+    std::string targetUrl = "http://fresh";
+    std::string etag = "\"7\"";
+    std::string lastIfNoneMatch;
+
+    bool send(const IRequest &req, IResponse &res) override
+    {
+        ++calls;
+        if (!up)
+        {
+            return false;
+        }
+        if (req.getPath() == "/rules/gone")
+        {
+            res.setStatus(404);
+            return true;
+        }
+
+        auto headers = req.getHeaders();
+        lastIfNoneMatch = headers.count("If-None-Match") ? headers["If-None-Match"] : "";
+        res.setHeader("ETag", etag);
+        if (lastIfNoneMatch == etag)
+        {
+            res.setStatus(304);
+            return true;
+        }
+        res.setStatus(200);
+        res.setBody(R"({"shortId":"promo","targetUrl":")" + targetUrl + R"(","condition":""})");
+        return true;
+    }
+};
+
+/**
+ * Кэш, в котором возраст записей задаётся тестом
+ */
+class AgedRulesCache : public IRulesCache
+{
+public:
+    std::mutex mutex;
+    std::map<std::string, CachedRule> store;
+
+    void putAged(const std::string &key, const Rule &rule, std::chrono::milliseconds age)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        store[key] = CachedRule{rule, std::chrono::steady_clock::now() - age};
+    }
+
+    std::optional<CachedRule> findEntry(const std::string &key) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = store.find(key);
+        if (it == store.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    std::optional<Rule> find(const std::string &key) override
+    {
+        auto entry = findEntry(key);
+        if (!entry)
+            return std::nullopt;
+        return entry->rule;
+    }
+
+    void put(const std::string &key, const Rule &rule) override
+    {
+        putAged(key, rule, std::chrono::milliseconds(0));
+    }
+
+    void remove(const std::string &key) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        store.erase(key);
+    }
+
+    void clear() override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        store.clear();
+    }
+};
+
+namespace {
+std::shared_ptr<RuleServiceSettings> makeTtlSettings(int softTtlMs, int hardTtlMs, int breakerFailures = 0)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+    env->setProperty("services.rule_cache.soft_ttl_ms", softTtlMs);
+    env->setProperty("services.rule_cache.hard_ttl_ms", hardTtlMs);
+    env->setProperty("services.rule_breaker.failure_threshold", breakerFailures);
+    env->setProperty("services.rule_breaker.open_ms", 60000);
+    return std::make_shared<RuleServiceSettings>(env);
+}
+}
+
+// После soft TTL запись отдаётся сразу, а обновляется в фоне
+TEST(HttpRuleClientTest, SoftExpiredRuleIsServedAndRefreshedInBackground)
+{
+    auto httpClient = std::make_shared<FlakyRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+    cache->putAged("promo", Rule{"promo", "http://stale", ""}, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeTtlSettings(1000, 0), cache);
+
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "http://stale");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache->find("promo")->targetUrl != "http://fresh" && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(cache->find("promo")->targetUrl, "http://fresh");
+}
+
+// После hard TTL при недоступном rule-service отдаётся устаревшая запись
+TEST(HttpRuleClientTest, HardExpiredRuleIsServedWhenRuleServiceIsDown)
+{
+    auto httpClient = std::make_shared<FlakyRuleServiceClient>();
+    httpClient->up = false;
+    auto cache = std::make_shared<AgedRulesCache>();
+    cache->putAged("promo", Rule{"promo", "http://stale", ""}, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeTtlSettings(0, 1000), cache);
+
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "http://stale");
+    EXPECT_EQ(httpClient->calls, 1);
+
+    // Когда rule-service поднялся, истёкшая запись обновляется синхронно
+    httpClient->up = true;
+    rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "http://fresh");
+}
+
+// Удалённое в rule-service правило не отдаётся из кэша после hard TTL
+TEST(HttpRuleClientTest, HardExpiredRuleIsDroppedOnNotFound)
+{
+    auto httpClient = std::make_shared<FlakyRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+    cache->putAged("gone", Rule{"gone", "http://stale", ""}, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeTtlSettings(0, 1000), cache);
+
+    EXPECT_FALSE(client.findByKey("gone").has_value());
+    EXPECT_FALSE(cache->find("gone").has_value());
+}
+
+// Разомкнутый автомат: промахи не ждут rule-service, истёкшие записи отдаются
+TEST(HttpRuleClientTest, OpenBreakerSkipsRuleService)
+{
+    auto httpClient = std::make_shared<FlakyRuleServiceClient>();
+    httpClient->up = false;
+    auto cache = std::make_shared<AgedRulesCache>();
+    cache->putAged("promo", Rule{"promo", "http://stale", ""}, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeTtlSettings(0, 1000, 2), cache);
+
+    EXPECT_FALSE(client.findByKey("missing").has_value());
+    EXPECT_FALSE(client.findByKey("missing").has_value());
+    EXPECT_EQ(httpClient->calls, 2);
+
+    EXPECT_FALSE(client.findByKey("missing").has_value());
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "http://stale");
+    EXPECT_EQ(httpClient->calls, 2);
+}
+
+// Истёкшая запись с версией перепроверяется условным запросом: 304 продлевает её
+TEST(HttpRuleClientTest, HardExpiredRuleIsRevalidatedWithETag)
+{
+    auto httpClient = std::make_shared<FlakyRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+    Rule stale{"promo", "http://cached", ""};
+    stale.version = "7";
+    cache->putAged("promo", stale, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeTtlSettings(0, 1000), cache);
+
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(httpClient->lastIfNoneMatch, "\"7\"");
+    EXPECT_EQ(rule->targetUrl, "http://cached");
+
+    auto entry = cache->findEntry("promo");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - entry->storedAt, std::chrono::seconds(1));
+
+    // Правило изменилось: новая версия приходит с телом
+    httpClient->etag = "\"8\"";
+    cache->putAged("promo", stale, std::chrono::seconds(10));
+    rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "http://fresh");
+    EXPECT_EQ(rule->version, "8");
+}
+
+/**
+ * Заглушка rule-service с POST /rules:batchGet
+ */
+class BatchRuleServiceClient : public IHttpClient
+{
+public:
+    std::mutex mutex;
+    std::vector<nlohmann::json> batches;   ///< Тела пакетных запросов
+    std::vector<std::string> contentTypes; ///< Content-Type пакетных запросов
+    std::atomic<int> singleCalls{0};
+
+    bool send(const IRequest &req, IResponse &res) override
+    {
+        if (req.getPath() != "/rules:batchGet")
+        {
+            ++singleCalls;
+            res.setStatus(404);
+            return true;
+        }
+
+        auto body = WireFormat::decode(req.getBody(), WireFormat::fromContentType(req.getHeader("Content-Type")));
+        nlohmann::json rules = nlohmann::json::array();
+        nlohmann::json notModified = nlohmann::json::array();
+        for (const auto &id : body["shortIds"])
+        {
+            std::string key = id.get<std::string>();
+            if (key == "missing")
+                continue;
+            if (body.contains("ifNoneMatch") && body["ifNoneMatch"].value(key, "") == "1")
+            {
+                notModified.push_back(key);
+                continue;
+            }
+            rules.push_back({{"shortId", key}, {"targetUrl", "http://" + key}, {"condition", ""}, {"version", "2"}});
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(body);
+            contentTypes.push_back(req.getHeader("Content-Type"));
+        }
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
+        res.setStatus(200);
+        res.setHeader("Content-Type", WireFormat::contentType(format));
+        res.setBody(WireFormat::encode({{"rules", rules}, {"notModified", notModified}}, format));
+        return true;
+    }
+};
+
+namespace {
+std::shared_ptr<RuleServiceSettings> makeBatchSettings(int windowMs, int maxSize, int softTtlMs = 0,
+                                                       const std::string &wireFormat = "json")
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+    env->setProperty("services.rule_batch.window_ms", windowMs);
+    env->setProperty("services.rule_batch.max_size", maxSize);
+    env->setProperty("services.rule_cache.soft_ttl_ms", softTtlMs);
+    env->setProperty("services.rule_wire_format", wireFormat);
+    return std::make_shared<RuleServiceSettings>(env);
+}
+}
+
+// Одновременные промахи уходят одним пакетным запросом
+TEST(HttpRuleClientTest, ConcurrentMissesAreCoalescedIntoOneBatch)
+{
+    auto httpClient = std::make_shared<BatchRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+
+    // Пакет закрывается по заполнению, окно заведомо больше времени теста
+    HttpRuleClient client(httpClient, makeBatchSettings(10000, 4), cache);
+
+    std::vector<std::string> keys{"a", "b", "c", "missing"};
+    std::vector<std::optional<Rule>> results(keys.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        threads.emplace_back([&, i] { results[i] = client.findByKey(keys[i]); });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(httpClient->batches.size(), 1u);
+    EXPECT_EQ(httpClient->batches[0]["shortIds"].size(), 4u);
+    EXPECT_EQ(httpClient->singleCalls, 0);
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(results[i].has_value());
+        EXPECT_EQ(results[i]->targetUrl, "http://" + keys[i]);
+        EXPECT_EQ(results[i]->version, "2");
+        EXPECT_TRUE(cache->find(keys[i]).has_value());
+    }
+    EXPECT_FALSE(results[3].has_value());
+}
+
+// Одиночный промах за окно идёт обычным GET
+TEST(HttpRuleClientTest, LoneMissUsesSingleRequest)
+{
+    auto httpClient = std::make_shared<BatchRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+
+    HttpRuleClient client(httpClient, makeBatchSettings(1, 4), cache);
+
+    EXPECT_FALSE(client.findByKey("a").has_value());
+    EXPECT_EQ(httpClient->singleCalls, 1);
+    EXPECT_TRUE(httpClient->batches.empty());
+}
+
+// Фоновое обновление идёт пакетом с версиями закэшированных правил
+TEST(HttpRuleClientTest, BackgroundRefreshIsBatched)
+{
+    auto httpClient = std::make_shared<BatchRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+
+    Rule unchanged{"a", "http://cached-a", ""};
+    unchanged.version = "1";
+    cache->putAged("a", unchanged, std::chrono::seconds(10));
+    cache->putAged("b", Rule{"b", "http://cached-b", ""}, std::chrono::seconds(10));
+    cache->putAged("missing", Rule{"missing", "http://gone", ""}, std::chrono::seconds(10));
+
+    HttpRuleClient client(httpClient, makeBatchSettings(1, 8, 1000), cache);
+
+    // Поток обновления может забрать первый ключ отдельным пакетом,
+    // поэтому ждём, пока обновятся все три
+    client.findByKey("a");
+    client.findByKey("b");
+    client.findByKey("missing");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (client.pendingRefreshes() > 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(client.pendingRefreshes(), 0u);
+
+    EXPECT_EQ(cache->find("a")->targetUrl, "http://cached-a");
+    EXPECT_EQ(cache->find("b")->targetUrl, "http://b");
+    EXPECT_FALSE(cache->find("missing").has_value());
+    EXPECT_LT(std::chrono::steady_clock::now() - cache->findEntry("a")->storedAt, std::chrono::seconds(5));
+    EXPECT_EQ(httpClient->singleCalls, 0);
+    EXPECT_EQ(httpClient->batches.front()["ifNoneMatch"]["a"], "1");
+}
+
+// В режиме MessagePack пакет и ответ на него кодируются в MessagePack
+TEST(HttpRuleClientTest, BatchUsesMessagePackWhenConfigured)
+{
+    auto httpClient = std::make_shared<BatchRuleServiceClient>();
+    auto cache = std::make_shared<AgedRulesCache>();
+
+    HttpRuleClient client(httpClient, makeBatchSettings(10000, 2, 0, "msgpack"), cache);
+
+    std::optional<Rule> a;
+    std::optional<Rule> b;
+    std::thread first([&] { a = client.findByKey("a"); });
+    std::thread second([&] { b = client.findByKey("b"); });
+    first.join();
+    second.join();
+
+    ASSERT_EQ(httpClient->contentTypes.size(), 1u);
+    EXPECT_EQ(httpClient->contentTypes[0], "application/msgpack");
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a->targetUrl, "http://a");
+    EXPECT_EQ(b->version, "2");
+}
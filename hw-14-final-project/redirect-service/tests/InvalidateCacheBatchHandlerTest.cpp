@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "handlers/InvalidateCacheBatchHandler.hpp"
+#include "SimpleRequest.hpp"
+#include "SimpleResponse.hpp"
+#include "cache/IRulesCache.hpp"
+
+using ::testing::_;
+
+// Мок кеша
+class MockRulesCache : public IRulesCache {
+public:
+    MOCK_METHOD(std::optional<Rule>, find, (const std::string& id), (override));
+    MOCK_METHOD(void, clear, (), (override));
+    MOCK_METHOD(void, put, (const std::string& id, const Rule& rule), (override));
+    MOCK_METHOD(void, remove, (const std::string& id), (override));
+};
+
+TEST(InvalidateCacheBatchHandlerTest, RemovesAllKeys) {
+    auto cache = std::make_shared<MockRulesCache>();
+    InvalidateCacheBatchHandler handler(cache);
+
+    SimpleRequest request("POST", "/cache/invalidate", R"({"keys": ["a", "b"]})", "127.0.0.1", 8080, {});
+    SimpleResponse response;
+
+    EXPECT_CALL(*cache, remove("a")).Times(1);
+    EXPECT_CALL(*cache, remove("b")).Times(1);
+
+    handler.handle(request, response);
+
+    EXPECT_EQ(response.getStatus(), 204);
+    EXPECT_EQ(response.getBody(), "");
+}
+
+TEST(InvalidateCacheBatchHandlerTest, RejectsInvalidBody) {
+    auto cache = std::make_shared<MockRulesCache>();
+    InvalidateCacheBatchHandler handler(cache);
+
+    SimpleRequest request("POST", "/cache/invalidate", R"({"key": "a"})", "127.0.0.1", 8080, {});
+    SimpleResponse response;
+
+    EXPECT_CALL(*cache, remove(_)).Times(0);
+
+    handler.handle(request, response);
+
+    EXPECT_EQ(response.getStatus(), 400);
+}
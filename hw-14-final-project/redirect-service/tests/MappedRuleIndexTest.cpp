@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "cache/MappedRuleIndex.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace {
+std::string snapshotPath(const std::string& name)
+{
+    return ::testing::TempDir() + name;
+}
+}
+
+// Тест: записанный снимок читается обратно
+TEST(MappedRuleIndexTest, WriteAndOpenRoundTrip)
+{
+    const std::string path = snapshotPath("roundtrip.idx");
+
+    std::vector<Rule> rules;
+    for (int i = 0; i < 500; ++i)
+    {
+        rules.push_back(Rule{"key" + std::to_string(i), "https://t/" + std::to_string(i),
+                             "browser == \"chrome\""});
+    }
+    ASSERT_TRUE(MappedRuleIndex::write(path, rules, "epoch-1", 42));
+
+    auto index = MappedRuleIndex::open(path);
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->size(), 500u);
+    EXPECT_EQ(index->epoch(), "epoch-1");
+    EXPECT_EQ(index->version(), 42u);
+
+    auto record = index->lookup("key123");
+    ASSERT_TRUE(record.has_value());
+    Rule rule = index->rule(*record);
+    EXPECT_EQ(rule.key, "key123");
+    EXPECT_EQ(rule.targetUrl, "https://t/123");
+    EXPECT_EQ(rule.condition, "browser == \"chrome\"");
+
+    EXPECT_FALSE(index->lookup("missing").has_value());
+    std::remove(path.c_str());
+}
+
+// Тест: отсутствующий и повреждённый файлы не открываются
+TEST(MappedRuleIndexTest, RejectsMissingOrCorruptedFile)
+{
+    EXPECT_EQ(MappedRuleIndex::open(snapshotPath("does-not-exist.idx")), nullptr);
+
+    const std::string path = snapshotPath("corrupted.idx");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(256, 'x');
+    }
+    EXPECT_EQ(MappedRuleIndex::open(path), nullptr);
+
+    // Обрезанный снимок
+    ASSERT_TRUE(MappedRuleIndex::write(path, {Rule{"promo", "https://p", ""}}, "e", 1));
+    std::string content;
+    {
+        std::ifstream in(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() / 2);
+    }
+    EXPECT_EQ(MappedRuleIndex::open(path), nullptr);
+    std::remove(path.c_str());
+}
+
+// Тест: пустой снимок
+TEST(MappedRuleIndexTest, EmptySnapshot)
+{
+    const std::string path = snapshotPath("empty.idx");
+    ASSERT_TRUE(MappedRuleIndex::write(path, {}, "e", 0));
+
+    auto index = MappedRuleIndex::open(path);
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->size(), 0u);
+    EXPECT_FALSE(index->lookup("promo").has_value());
+    std::remove(path.c_str());
+}
+
+// Тест: перезапись заменяет снимок целиком и не оставляет временный файл
+TEST(MappedRuleIndexTest, OverwriteReplacesSnapshot)
+{
+    const std::string path = snapshotPath("overwrite.idx");
+    ASSERT_TRUE(MappedRuleIndex::write(path, {Rule{"promo", "https://old", ""}}, "e", 1));
+    ASSERT_TRUE(MappedRuleIndex::write(path, {Rule{"docs", "https://docs", ""}}, "e", 2));
+
+    auto index = MappedRuleIndex::open(path);
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->version(), 2u);
+    EXPECT_FALSE(index->lookup("promo").has_value());
+    EXPECT_TRUE(index->lookup("docs").has_value());
+    EXPECT_FALSE(std::ifstream(path + ".tmp").good());
+    std::remove(path.c_str());
+}
+
+// Тест: запись в несуществующий каталог - ошибка, а не исключение
+TEST(MappedRuleIndexTest, WriteFailsForMissingDirectory)
+{
+    const std::string path = snapshotPath("missing-dir/snapshot.idx");
+    EXPECT_FALSE(MappedRuleIndex::write(path, {Rule{"promo", "https://promo", ""}}, "e", 1));
+    EXPECT_EQ(MappedRuleIndex::open(path), nullptr);
+}
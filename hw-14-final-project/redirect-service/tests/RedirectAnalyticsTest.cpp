@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "analytics/RedirectAnalytics.hpp"
+#include "analytics/FileAnalyticsSink.hpp"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @file RedirectAnalyticsTest.cpp
+ * @brief Unit-тесты для RedirectAnalytics и FileAnalyticsSink
+ */
+
+/**
+ * Хранилище в памяти, складывает счётчики из всех пачек
+ */
+class RecordingAnalyticsSink : public IAnalyticsSink
+{
+public:
+    std::mutex mutex;
+    std::map<std::pair<std::string, RedirectOutcome>, std::uint64_t> totals;
+    int batches = 0;
+    int failuresLeft = 0;   ///< Сколько следующих записей завершить ошибкой
+
+    void write(const std::vector<RedirectCount>& counts) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failuresLeft > 0)
+        {
+            --failuresLeft;
+            throw std::runtime_error("sink unavailable");
+        }
+        ++batches;
+        for (const auto& count : counts)
+        {
+            totals[{count.shortId, count.outcome}] += count.count;
+        }
+    }
+
+    std::uint64_t total(const std::string& shortId, RedirectOutcome outcome)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return totals[{shortId, outcome}];
+    }
+};
+
+// События из многих потоков доходят до хранилища без потерь
+TEST(RedirectAnalyticsTest, AggregatesEventsFromManyThreads)
+{
+    auto sink = std::make_shared<RecordingAnalyticsSink>();
+    RedirectAnalytics analytics(sink, std::chrono::seconds(60), std::chrono::milliseconds(1), 256);
+    analytics.start();
+
+    constexpr int THREADS = 4;
+    constexpr int EVENTS = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&analytics] {
+            for (int i = 0; i < EVENTS; ++i)
+            {
+                analytics.record("promo", i % 2 ? RedirectOutcome::Redirected : RedirectOutcome::NotFound);
+                // Буфер меньше числа событий: даём агрегатору его вычитать
+                if (i % 128 == 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    analytics.stop();
+
+    std::uint64_t recorded = sink->total("promo", RedirectOutcome::Redirected) +
+                             sink->total("promo", RedirectOutcome::NotFound);
+    EXPECT_EQ(recorded + analytics.dropped(), static_cast<std::uint64_t>(THREADS * EVENTS));
+    EXPECT_GT(sink->total("promo", RedirectOutcome::Redirected), 0u);
+}
+
+// Полный буфер отбрасывает события, а не блокирует редирект
+TEST(RedirectAnalyticsTest, FullBufferDropsEvents)
+{
+    auto sink = std::make_shared<RecordingAnalyticsSink>();
+    RedirectAnalytics analytics(sink, std::chrono::seconds(60), std::chrono::milliseconds(1000), 4);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        analytics.record("promo", RedirectOutcome::Redirected);
+    }
+    analytics.flush();
+
+    EXPECT_EQ(analytics.dropped(), 6u);
+    EXPECT_EQ(sink->total("promo", RedirectOutcome::Redirected), 4u);
+    EXPECT_EQ(sink->batches, 1);
+
+    // Вычитанный буфер снова принимает события
+    analytics.record("promo", RedirectOutcome::Redirected);
+    analytics.flush();
+    EXPECT_EQ(sink->total("promo", RedirectOutcome::Redirected), 5u);
+}
+
+// Пачка, которую хранилище не приняло, уходит со следующей записью
+TEST(RedirectAnalyticsTest, FailedWriteIsRetried)
+{
+    auto sink = std::make_shared<RecordingAnalyticsSink>();
+    sink->failuresLeft = 1;
+    RedirectAnalytics analytics(sink, std::chrono::seconds(60), std::chrono::milliseconds(1000), 16);
+
+    analytics.record("promo", RedirectOutcome::ConditionFailed);
+    analytics.flush();
+    EXPECT_EQ(sink->batches, 0);
+
+    analytics.record("promo", RedirectOutcome::ConditionFailed);
+    analytics.flush();
+    EXPECT_EQ(sink->batches, 1);
+    EXPECT_EQ(sink->total("promo", RedirectOutcome::ConditionFailed), 2u);
+}
+
+// Файловое хранилище дописывает по строке NDJSON на счётчик
+TEST(RedirectAnalyticsTest, FileSinkAppendsNdjson)
+{
+    const std::string path = ::testing::TempDir() + "analytics.ndjson";
+    std::remove(path.c_str());
+
+    {
+        FileAnalyticsSink sink(path);
+        sink.write({RedirectCount{1700000040, "promo", RedirectOutcome::Redirected, 3}});
+        sink.write({RedirectCount{1700000040, "docs", RedirectOutcome::NotFound, 1}});
+    }
+
+    std::ifstream in(path);
+    std::vector<nlohmann::json> lines;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        lines.push_back(nlohmann::json::parse(line));
+    }
+
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0]["bucket"], 1700000040);
+    EXPECT_EQ(lines[0]["shortId"], "promo");
+    EXPECT_EQ(lines[0]["outcome"], "redirected");
+    EXPECT_EQ(lines[0]["count"], 3);
+    EXPECT_EQ(lines[1]["outcome"], "not_found");
+
+    std::remove(path.c_str());
+}
+
+// Буфер завершившегося потока достаётся следующему: поток на запрос не копит буферы
+TEST(RedirectAnalyticsTest, ReusesBuffersOfFinishedThreads)
+{
+    auto sink = std::make_shared<RecordingAnalyticsSink>();
+    RedirectAnalytics analytics(sink, std::chrono::seconds(60), std::chrono::milliseconds(1), 128);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::thread([&analytics] { analytics.record("promo", RedirectOutcome::Redirected); }).join();
+    }
+    analytics.flush();
+
+    EXPECT_EQ(analytics.buffers(), 1u);
+    EXPECT_EQ(sink->total("promo", RedirectOutcome::Redirected), 100u);
+    EXPECT_EQ(analytics.dropped(), 0u);
+}
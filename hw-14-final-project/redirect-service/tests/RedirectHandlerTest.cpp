@@ -44,6 +44,29 @@ TEST(RedirectHandlerTest, HandlesRedirect) {
     EXPECT_EQ(response.getBody(), ""); // если тело не устанавливается
 }
 
+TEST(RedirectHandlerTest, UsesPrerenderedResponse) {
+    auto service = std::make_shared<MockRedirectService>();
+    RedirectHandler handler(service);
+
+    SimpleRequest request("GET", "/r/abc123", "", "127.0.0.1", 8080);
+    SimpleResponse response;
+
+    RedirectResult expectedResult;
+    expectedResult.success = true;
+    expectedResult.targetUrl = "http://redirected.com";
+    expectedResult.response = PrerenderedResponse::redirect(302, "http://redirected.com", {{"Cache-Control", "no-store"}});
+
+    EXPECT_CALL(*service, redirect(_))
+        .WillOnce(Return(expectedResult));
+
+    handler.handle(request, response);
+
+    EXPECT_EQ(response.getStatus(), 302);
+    auto headers = response.getHeaders();
+    EXPECT_EQ(headers["Location"], "http://redirected.com");
+    EXPECT_EQ(headers["Cache-Control"], "no-store");
+}
+
 TEST(RedirectHandlerTest, HandlesRedirectNotFound) {
     auto service = std::make_shared<MockRedirectService>();
     RedirectHandler handler(service);
@@ -75,3 +98,32 @@ TEST(RedirectHandlerTest, HandlesRedirectNotFound) {
     auto headers = response.getHeaders();
     EXPECT_TRUE(headers.find("Location") == headers.end());
 }
+
+// shortId берётся из пути без query, заголовки читаются из самого запроса
+TEST(RedirectHandlerTest, PassesShortIdAndHeaderLookup) {
+    auto service = std::make_shared<MockRedirectService>();
+    RedirectHandler handler(service);
+
+    SimpleRequest request("GET", "/r/abc123?utm=mail", "", "127.0.0.1", 8080, {{"User-Agent", "TestAgent"}});
+    SimpleResponse response;
+
+    std::string shortId;
+    std::string userAgent;
+    std::size_t copiedHeaders = 1;
+    EXPECT_CALL(*service, redirect(_))
+        .WillOnce([&](const RedirectRequest& req) {
+            shortId = req.shortId;
+            userAgent = std::string(req.header("User-Agent"));
+            copiedHeaders = req.headers.size();
+            RedirectResult result;
+            result.success = true;
+            result.targetUrl = "http://redirected.com";
+            return result;
+        });
+
+    handler.handle(request, response);
+
+    EXPECT_EQ(shortId, "abc123");
+    EXPECT_EQ(userAgent, "TestAgent");
+    EXPECT_EQ(copiedHeaders, 0u);
+}
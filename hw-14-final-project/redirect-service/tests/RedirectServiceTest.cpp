@@ -4,6 +4,7 @@
 #include "ports/IRuleClient.hpp"
 #include "ports/IRuleEvaluator.hpp"
 #include "domain/Rule.hpp"
+#include "services/ASTNode.hpp"
 #include "domain/RedirectRequest.hpp"
 #include "domain/RedirectResult.hpp"
 
@@ -28,6 +29,15 @@ class MockRuleEvaluator : public IRuleEvaluator
 {
 public:
     MOCK_METHOD(bool, evaluate, (const std::string& condition, const RedirectRequest& request), (override));
+    MOCK_METHOD(std::shared_ptr<const ASTNode>, compile, (const std::string& condition), (override));
+    MOCK_METHOD(bool, evaluateCompiled, (const ASTNode& condition, const RedirectRequest& request), (override));
+};
+
+// Mock для IRedirectAnalytics
+class MockRedirectAnalytics : public IRedirectAnalytics
+{
+public:
+    MOCK_METHOD(void, record, (const std::string& shortId, RedirectOutcome outcome), (override));
 };
 
 // Fixture для тестов RedirectService
@@ -71,6 +81,8 @@ TEST_F(RedirectServiceTest, SuccessfulRedirect)
     EXPECT_TRUE(result.success);
     EXPECT_EQ(result.targetUrl, "https://example.com/promo");
     EXPECT_TRUE(result.errorMessage.empty());
+    ASSERT_NE(result.response, nullptr);
+    EXPECT_EQ(result.response->status(), 302);
 }
 
 // Тест: правило не найдено → error
@@ -260,4 +272,94 @@ TEST_F(RedirectServiceTest, DifferentClientIPs)
     EXPECT_TRUE(result2.success);
     EXPECT_EQ(result1.targetUrl, "https://test.example.com");
     EXPECT_EQ(result2.targetUrl, "https://test.example.com");
-}
\ No newline at end of file
+}
+// Тест: предкомпилированное условие вычисляется без разбора строки
+TEST_F(RedirectServiceTest, UsesCompiledCondition)
+{
+    // Arrange
+    RedirectRequest request{"promo", "127.0.0.1", {}};
+
+    Rule rule{"promo", "https://example.com/promo", "browser == \"chrome\""};
+    rule.compiled = ASTNode::makeLiteral("compiled");
+
+    EXPECT_CALL(*mockRuleClient, findByKey("promo"))
+        .WillOnce(Return(rule));
+
+    EXPECT_CALL(*mockEvaluator, evaluate(_, _)).Times(0);
+    EXPECT_CALL(*mockEvaluator, evaluateCompiled(_, _))
+        .WillOnce(Return(true));
+
+    // Act
+    RedirectResult result = service->redirect(request);
+
+    // Assert
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.targetUrl, "https://example.com/promo");
+}
+
+// Тест: готовый ответ правила отдаётся без повторной сборки
+TEST_F(RedirectServiceTest, ReusesPrerenderedResponse)
+{
+    // Arrange
+    RedirectRequest request{"promo", "127.0.0.1", {}};
+
+    Rule rule{"promo", "https://example.com/promo", ""};
+    rule.redirect = PrerenderedResponse::redirect(302, "https://example.com/promo");
+
+    EXPECT_CALL(*mockRuleClient, findByKey("promo"))
+        .WillOnce(Return(rule));
+    EXPECT_CALL(*mockEvaluator, evaluate(_, _))
+        .WillOnce(Return(true));
+
+    // Act
+    RedirectResult result = service->redirect(request);
+
+    // Assert
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.response, rule.redirect);
+}
+
+// Тест: адрес с переводом строки не попадает в заголовки ответа → error
+TEST_F(RedirectServiceTest, RejectsUnsafeTargetUrl)
+{
+    // Arrange
+    RedirectRequest request{"promo", "127.0.0.1", {}};
+
+    Rule rule{"promo", "https://example.com/\r\nSet-Cookie: session=x", ""};
+
+    EXPECT_CALL(*mockRuleClient, findByKey("promo"))
+        .WillOnce(Return(rule));
+    EXPECT_CALL(*mockEvaluator, evaluate(_, _))
+        .WillOnce(Return(true));
+
+    // Act
+    RedirectResult result = service->redirect(request);
+
+    // Assert
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.response, nullptr);
+    EXPECT_EQ(result.errorMessage, "Invalid target URL for key: promo");
+}
+
+// Тест: исход каждого запроса передаётся в аналитику
+TEST_F(RedirectServiceTest, RecordsOutcomeInAnalytics)
+{
+    auto analytics = std::make_shared<MockRedirectAnalytics>();
+    RedirectService tracked(mockRuleClient, mockEvaluator, analytics);
+
+    Rule rule{"promo", "https://example.com/promo", "browser == \"chrome\""};
+
+    EXPECT_CALL(*mockRuleClient, findByKey("promo")).WillRepeatedly(Return(rule));
+    EXPECT_CALL(*mockRuleClient, findByKey("unknown")).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*mockEvaluator, evaluate(_, _))
+        .WillOnce(Return(true))
+        .WillOnce(Return(false));
+
+    EXPECT_CALL(*analytics, record("promo", RedirectOutcome::Redirected));
+    EXPECT_CALL(*analytics, record("promo", RedirectOutcome::ConditionFailed));
+    EXPECT_CALL(*analytics, record("unknown", RedirectOutcome::NotFound));
+
+    tracked.redirect(RedirectRequest{"promo", "127.0.0.1", {}});
+    tracked.redirect(RedirectRequest{"promo", "127.0.0.1", {}});
+    tracked.redirect(RedirectRequest{"unknown", "127.0.0.1", {}});
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "adapters/RuleChangeSubscriber.hpp"
+#include "cache/RulesCache.hpp"
+#include "settings/RuleServiceSettings.hpp"
+#include "Environment.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * Заглушка IHttpClient: отдаёт заранее заданные ответы и запоминает пути
+ */
+class ScriptedHttpClient : public IHttpClient
+{
+public:
+    std::deque<std::string> bodies;
+    std::vector<std::string> paths;
+
+    bool send(const IRequest &req, IResponse &res) override
+    {
+        paths.push_back(req.getPath());
+        if (bodies.empty())
+        {
+            res.setStatus(503);
+            return true;
+        }
+        res.setStatus(200);
+        res.setBody(bodies.front());
+        bodies.pop_front();
+        return true;
+    }
+};
+
+/**
+ * Заглушка long-poll: send ждёт, пока не вызовут shutdown()
+ */
+class HangingHttpClient : public IHttpClient
+{
+public:
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool sending = false;
+    bool shutDown = false;
+
+    bool send(const IRequest &, IResponse &res) override
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        sending = true;
+        changed.notify_all();
+        changed.wait(lock, [this] { return shutDown; });
+        res.setStatus(500);
+        return false;
+    }
+
+    void shutdown() override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shutDown = true;
+        changed.notify_all();
+    }
+};
+
+/**
+ * Кэш на std::map
+ */
+class MapRulesCache : public IRulesCache
+{
+public:
+    std::map<std::string, Rule> store;
+
+    std::optional<Rule> find(const std::string &key) override
+    {
+        auto it = store.find(key);
+        if (it != store.end())
+            return it->second;
+        return std::nullopt;
+    }
+
+    void put(const std::string &key, const Rule &rule) override { store[key] = rule; }
+    void remove(const std::string &key) override { store.erase(key); }
+    void clear() override { store.clear(); }
+};
+
+namespace {
+std::shared_ptr<IRuleServiceSettings> makeSettings()
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8081"));
+    env->setProperty("services.rule_changes.timeout_ms", 0);
+    return std::make_shared<RuleServiceSettings>(env);
+}
+}
+
+// Первый ответ со сбросом очищает кэш и задаёт эпоху
+TEST(RuleChangeSubscriberTest, ResetClearsCache)
+{
+    auto http = std::make_shared<ScriptedHttpClient>();
+    auto cache = std::make_shared<MapRulesCache>();
+    cache->store["stale"] = Rule{"stale", "https://old", ""};
+    http->bodies.push_back(R"({"epoch":"e1","version":5,"reset":true,"changes":[]})");
+
+    RuleChangeSubscriber subscriber(http, makeSettings(), cache);
+
+    ASSERT_TRUE(subscriber.pollOnce());
+    EXPECT_TRUE(cache->store.empty());
+    EXPECT_EQ(subscriber.epoch(), "e1");
+    EXPECT_EQ(subscriber.version(), 5u);
+    EXPECT_EQ(http->paths[0], "/rules/changes?since=0&timeout=0");
+}
+
+// Upsert обновляет закэшированное правило, delete удаляет
+TEST(RuleChangeSubscriberTest, AppliesChangesToCachedRules)
+{
+    auto http = std::make_shared<ScriptedHttpClient>();
+    auto cache = std::make_shared<MapRulesCache>();
+    http->bodies.push_back(R"({"epoch":"e1","version":1,"reset":true,"changes":[]})");
+    http->bodies.push_back(R"({"epoch":"e1","version":4,"reset":false,"changes":[
+        {"version":2,"shortId":"promo","op":"upsert","targetUrl":"https://new","condition":"c","ruleVersion":"42"},
+        {"version":3,"shortId":"unseen","op":"upsert","targetUrl":"https://x","condition":""},
+        {"version":4,"shortId":"old","op":"delete"}]})");
+
+    RuleChangeSubscriber subscriber(http, makeSettings(), cache);
+    ASSERT_TRUE(subscriber.pollOnce());
+
+    cache->store["promo"] = Rule{"promo", "https://old", "c"};
+    cache->store["old"] = Rule{"old", "https://gone", ""};
+    ASSERT_TRUE(subscriber.pollOnce());
+
+    EXPECT_EQ(cache->store.at("promo").targetUrl, "https://new");
+    EXPECT_EQ(cache->store.at("promo").version, "42");
+    EXPECT_EQ(cache->store.count("unseen"), 0u);
+    EXPECT_EQ(cache->store.count("old"), 0u);
+    EXPECT_EQ(subscriber.version(), 4u);
+    EXPECT_EQ(http->paths[1], "/rules/changes?since=1&timeout=0&epoch=e1");
+}
+
+// Ошибка rule-service не сдвигает позицию
+TEST(RuleChangeSubscriberTest, FailureKeepsPosition)
+{
+    auto http = std::make_shared<ScriptedHttpClient>();
+    auto cache = std::make_shared<MapRulesCache>();
+
+    RuleChangeSubscriber subscriber(http, makeSettings(), cache);
+
+    EXPECT_FALSE(subscriber.pollOnce());
+    EXPECT_EQ(subscriber.version(), 0u);
+    EXPECT_TRUE(subscriber.epoch().empty());
+}
+
+// stop() прерывает висящий long-poll, а не ждёт его таймаута
+TEST(RuleChangeSubscriberTest, StopAbortsPendingPoll)
+{
+    auto http = std::make_shared<HangingHttpClient>();
+    auto cache = std::make_shared<MapRulesCache>();
+    RuleChangeSubscriber subscriber(http, makeSettings(), cache);
+
+    subscriber.start();
+    {
+        std::unique_lock<std::mutex> lock(http->mutex);
+        ASSERT_TRUE(http->changed.wait_for(lock, std::chrono::seconds(5), [&] { return http->sending; }));
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    subscriber.stop();
+
+    EXPECT_TRUE(http->shutDown);
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+}
+
+// Upsert незакэшированного правила отбрасывает его загрузку, начатую раньше
+TEST(RuleChangeSubscriberTest, UpsertDiscardsInFlightFill)
+{
+    auto http = std::make_shared<ScriptedHttpClient>();
+    auto cache = std::make_shared<RulesCache>();
+    http->bodies.push_back(R"({"epoch":"e1","version":2,"reset":false,"changes":[
+        {"version":2,"shortId":"promo","op":"upsert","targetUrl":"https://new","condition":""}]})");
+
+    RuleChangeSubscriber subscriber(http, makeSettings(), cache);
+
+    // Промах HttpRuleClient: поколение запомнено, ответ ещё не пришёл
+    uint64_t generation = cache->generation("promo");
+    ASSERT_TRUE(subscriber.pollOnce());
+    cache->fill("promo", Rule{"promo", "https://old", ""}, generation);
+
+    EXPECT_FALSE(cache->find("promo").has_value());
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "cache/RuleIndex.hpp"
+#include <map>
+#include <random>
+
+// Тест: поиск существующих и отсутствующих ключей
+TEST(RuleIndexTest, FindsRulesByKey)
+{
+    std::vector<Rule> rules;
+    for (int i = 0; i < 1000; ++i)
+    {
+        rules.push_back(Rule{"key" + std::to_string(i), "https://t/" + std::to_string(i), ""});
+    }
+
+    RuleIndex index(rules);
+
+    EXPECT_EQ(index.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const Rule* rule = index.find("key" + std::to_string(i));
+        ASSERT_NE(rule, nullptr);
+        EXPECT_EQ(rule->targetUrl, "https://t/" + std::to_string(i));
+    }
+    EXPECT_EQ(index.find("missing"), nullptr);
+}
+
+// Тест: повтор ключа - остаётся последнее правило
+TEST(RuleIndexTest, LastDuplicateWins)
+{
+    RuleIndex index({Rule{"promo", "https://old", ""}, Rule{"promo", "https://new", ""}});
+
+    EXPECT_EQ(index.size(), 1u);
+    ASSERT_NE(index.find("promo"), nullptr);
+    EXPECT_EQ(index.find("promo")->targetUrl, "https://new");
+}
+
+// Тест: пустой индекс
+TEST(RuleIndexTest, EmptyIndex)
+{
+    RuleIndex empty;
+    EXPECT_EQ(empty.find("promo"), nullptr);
+
+    RuleIndex built(std::vector<Rule>{});
+    EXPECT_EQ(built.find("promo"), nullptr);
+}
+
+// Тест: apply даёт тот же результат, что сборка с нуля, и не трогает прежнюю версию
+TEST(RuleIndexTest, ApplyMatchesRebuild)
+{
+    std::map<std::string, std::string> expected;
+    auto index = std::make_shared<const RuleIndex>();
+    std::mt19937 random(42);
+
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<RuleIndex::Change> changes;
+        for (int i = 0; i < 20; ++i)
+        {
+            std::string key = "key" + std::to_string(random() % 64);
+            if (random() % 3 == 0)
+            {
+                changes.push_back(RuleIndex::Change{key, nullptr});
+                expected.erase(key);
+            }
+            else
+            {
+                std::string url = "https://t/" + std::to_string(round * 100 + i);
+                changes.push_back(RuleIndex::Change{key, std::make_shared<const Rule>(Rule{key, url, ""})});
+                expected[key] = url;
+            }
+        }
+
+        auto previous = index;
+        auto previousSize = previous->size();
+        index = index->apply(changes);
+        EXPECT_EQ(previous->size(), previousSize);
+
+        ASSERT_EQ(index->size(), expected.size());
+        for (int k = 0; k < 64; ++k)
+        {
+            std::string key = "key" + std::to_string(k);
+            const Rule* rule = index->find(key);
+            auto it = expected.find(key);
+            if (it == expected.end())
+            {
+                EXPECT_EQ(rule, nullptr) << key;
+            }
+            else
+            {
+                ASSERT_NE(rule, nullptr) << key;
+                EXPECT_EQ(rule->targetUrl, it->second);
+            }
+        }
+    }
+}
@@ -22,3 +22,107 @@ TEST(RuleServiceSettingsTest, ThrowsWhenUrlMissing)
         RuleServiceSettings settings(env);
     }, std::runtime_error);
 }
+
+// Тест: настройки подписки на изменения правил
+TEST(RuleServiceSettingsTest, ReadsChangeStreamSettings)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+
+    RuleServiceSettings defaults(env);
+    EXPECT_FALSE(defaults.isSnapshotMode());
+    EXPECT_TRUE(defaults.getSnapshotPath().empty());
+    EXPECT_TRUE(defaults.isChangeStreamEnabled());
+    EXPECT_EQ(defaults.getChangeStreamTimeout(), std::chrono::milliseconds(25000));
+
+    env->setProperty("services.rule_snapshot.enabled", true);
+    env->setProperty("services.rule_snapshot.path", std::string("/var/lib/redirect/rules.idx"));
+    env->setProperty("services.rule_changes.enabled", false);
+    env->setProperty("services.rule_changes.timeout_ms", 5000);
+
+    RuleServiceSettings custom(env);
+    EXPECT_TRUE(custom.isSnapshotMode());
+    EXPECT_EQ(custom.getSnapshotPath(), "/var/lib/redirect/rules.idx");
+    EXPECT_FALSE(custom.isChangeStreamEnabled());
+    EXPECT_EQ(custom.getChangeStreamTimeout(), std::chrono::milliseconds(5000));
+}
+
+// Тест: TTL кэша и автомат отказов rule-service
+TEST(RuleServiceSettingsTest, ReadsCacheTtlAndBreakerSettings)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+
+    RuleServiceSettings defaults(env);
+    EXPECT_EQ(defaults.getCacheSoftTtl().count(), 0);
+    EXPECT_EQ(defaults.getCacheHardTtl().count(), 0);
+    EXPECT_EQ(defaults.getBreakerFailureThreshold(), 5);
+    EXPECT_EQ(defaults.getBreakerOpenTimeout(), std::chrono::milliseconds(5000));
+
+    env->setProperty("services.rule_cache.soft_ttl_ms", 30000);
+    env->setProperty("services.rule_cache.hard_ttl_ms", 600000);
+    env->setProperty("services.rule_breaker.failure_threshold", 3);
+    env->setProperty("services.rule_breaker.open_ms", 1000);
+
+    RuleServiceSettings custom(env);
+    EXPECT_EQ(custom.getCacheSoftTtl(), std::chrono::milliseconds(30000));
+    EXPECT_EQ(custom.getCacheHardTtl(), std::chrono::milliseconds(600000));
+    EXPECT_EQ(custom.getBreakerFailureThreshold(), 3);
+    EXPECT_EQ(custom.getBreakerOpenTimeout(), std::chrono::milliseconds(1000));
+}
+
+// Тест: пакетные запросы выключены по умолчанию, размер пакета ограничен
+TEST(RuleServiceSettingsTest, ReadsBatchSettings)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+
+    RuleServiceSettings defaults(env);
+    EXPECT_EQ(defaults.getBatchWindow().count(), 0);
+    EXPECT_EQ(defaults.getBatchMaxSize(), 32);
+
+    env->setProperty("services.rule_batch.window_ms", 2);
+    env->setProperty("services.rule_batch.max_size", 1000);
+
+    RuleServiceSettings custom(env);
+    EXPECT_EQ(custom.getBatchWindow(), std::chrono::milliseconds(2));
+    EXPECT_EQ(custom.getBatchMaxSize(), 100);
+}
+
+// Тест: формат обмена - JSON по умолчанию, опечатка в настройке - ошибка
+TEST(RuleServiceSettingsTest, ReadsWireFormat)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8080"));
+
+    EXPECT_EQ(RuleServiceSettings(env).getWireFormat(), WireFormat::Format::Json);
+
+    env->setProperty("services.rule_wire_format", std::string("msgpack"));
+    EXPECT_EQ(RuleServiceSettings(env).getWireFormat(), WireFormat::Format::MessagePack);
+
+    env->setProperty("services.rule_wire_format", std::string("cbor"));
+    EXPECT_THROW(RuleServiceSettings settings(env), std::runtime_error);
+}
+
+// Тест: адрес разбирается один раз при создании настроек
+TEST(RuleServiceSettingsTest, ParsesEndpointOnce)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://rule-service:8081"));
+
+    RuleServiceSettings settings(env);
+
+    EXPECT_EQ(settings.getEndpoint().host, "rule-service");
+    EXPECT_EQ(settings.getEndpoint().port, 8081);
+}
+
+// Тест: некорректный URL отклоняется при старте
+TEST(RuleServiceSettingsTest, ThrowsWhenUrlInvalid)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_service_url", std::string("http://rule-service"));
+
+    EXPECT_THROW({
+        RuleServiceSettings settings(env);
+    }, std::runtime_error);
+}
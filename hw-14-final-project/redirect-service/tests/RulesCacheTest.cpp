@@ -21,6 +21,35 @@ TEST(RulesCacheTest, PutAndFindRule)
     EXPECT_EQ(result->condition, "browser == chrome");
 }
 
+// Ответ 302 собирается при кэшировании и разделяется всеми чтениями
+TEST(RulesCacheTest, PutPrerendersRedirect)
+{
+    RulesCache cache;
+    cache.put("promo", Rule{"promo", "https://example.com", ""});
+
+    auto first = cache.find("promo");
+    auto second = cache.find("promo");
+    ASSERT_TRUE(first && second);
+    ASSERT_NE(first->redirect, nullptr);
+    EXPECT_EQ(first->redirect, second->redirect);
+    EXPECT_NE(first->redirect->head().find("Location: https://example.com\r\n"), std::string::npos);
+}
+
+// Запись помнит момент сохранения, перезапись его обновляет
+TEST(RulesCacheTest, FindEntryReportsStoredAt)
+{
+    RulesCache cache;
+    auto before = std::chrono::steady_clock::now();
+    cache.put("promo", Rule{"promo", "https://example.com", ""});
+
+    auto entry = cache.findEntry("promo");
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->rule.targetUrl, "https://example.com");
+    EXPECT_GE(entry->storedAt, before);
+    EXPECT_LE(entry->storedAt, std::chrono::steady_clock::now());
+    EXPECT_FALSE(cache.findEntry("missing").has_value());
+}
+
 TEST(RulesCacheTest, FindNonExistentRule)
 {
     RulesCache cache;
@@ -67,3 +96,71 @@ TEST(RulesCacheTest, OverwriteExistingRule)
     EXPECT_EQ(result->targetUrl, "https://new.example.com");
     EXPECT_EQ(result->condition, "browser == firefox");
 }
+
+TEST(RulesCacheTest, CapacityCanBeChangedLive)
+{
+    RulesCache cache(2);
+    cache.put("a", Rule{"a", "url1", ""});
+    cache.put("b", Rule{"b", "url2", ""});
+    cache.put("c", Rule{"c", "url3", ""});
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.find("c").has_value());
+
+    cache.setCapacity(1);
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.setCapacity(0);
+    cache.put("d", Rule{"d", "url4", ""});
+    cache.put("e", Rule{"e", "url5", ""});
+    EXPECT_EQ(cache.size(), 3u);
+}
+
+// Полный кэш принимает новый ключ, только если фильтр допуска его предпочёл
+TEST(RulesCacheTest, AdmissionPolicyProtectsFullCache)
+{
+    RulesCache cache(1);
+    cache.setAdmissionPolicy([](const std::string& candidate, const std::string&) {
+        return candidate == "hot";
+    });
+
+    cache.put("promo", Rule{"promo", "https://promo", ""});
+    cache.put("cold", Rule{"cold", "https://cold", ""});
+    EXPECT_TRUE(cache.find("promo").has_value());
+    EXPECT_FALSE(cache.find("cold").has_value());
+
+    // Обновление закэшированного ключа фильтр не проверяет
+    cache.put("promo", Rule{"promo", "https://promo-2", ""});
+    EXPECT_EQ(cache.find("promo")->targetUrl, "https://promo-2");
+
+    cache.put("hot", Rule{"hot", "https://hot", ""});
+    EXPECT_TRUE(cache.find("hot").has_value());
+    EXPECT_FALSE(cache.find("promo").has_value());
+}
+
+// Загрузка, начатая до изменения ключа, в кэше не остаётся
+TEST(RulesCacheTest, FillDiscardedAfterConcurrentChange)
+{
+    RulesCache cache;
+
+    uint64_t generation = cache.generation("promo");
+    cache.fill("promo", Rule{"promo", "https://fresh", ""}, generation);
+    EXPECT_TRUE(cache.find("promo").has_value());
+
+    generation = cache.generation("promo");
+    cache.remove("promo");
+    cache.fill("promo", Rule{"promo", "https://stale", ""}, generation);
+    EXPECT_FALSE(cache.find("promo").has_value());
+
+    generation = cache.generation("docs");
+    cache.clear();
+    cache.fill("docs", Rule{"docs", "https://stale", ""}, generation);
+    EXPECT_FALSE(cache.find("docs").has_value());
+
+    // Новое значение из журнала не затирается загрузкой старого
+    generation = cache.generation("promo");
+    cache.put("promo", Rule{"promo", "https://pushed", ""});
+    cache.fill("promo", Rule{"promo", "https://stale", ""}, generation);
+    auto rule = cache.find("promo");
+    EXPECT_TRUE(!rule || rule->targetUrl == "https://pushed");
+}
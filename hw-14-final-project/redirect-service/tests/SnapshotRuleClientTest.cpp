@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+#include "adapters/SnapshotRuleClient.hpp"
+#include "services/DSLEvaluator.hpp"
+#include "settings/RuleServiceSettings.hpp"
+#include "Environment.hpp"
+#include <cstdio>
+#include <deque>
+#include <cstdint>
+#include <map>
+#include <sstream>
+
+/**
+ * Заглушка rule-service: выгрузка и очередь ответов /rules/changes
+ */
+class FakeRuleServiceClient : public IHttpClient
+{
+public:
+    std::string exportBody;
+    std::deque<std::string> changes;
+    int exportCalls = 0;
+    bool down = false;
+
+    bool send(const IRequest &req, IResponse &res) override
+    {
+        if (down)
+        {
+            return false;
+        }
+
+        if (req.getPath().rfind("/rules/export", 0) == 0)
+        {
+            ++exportCalls;
+            res.setStatus(200);
+            res.setBody(exportPage(req.getPath()));
+            return true;
+        }
+
+        if (req.getPath().rfind("/rules/changes", 0) == 0 && !changes.empty())
+        {
+            res.setStatus(200);
+            res.setBody(changes.front());
+            changes.pop_front();
+            return true;
+        }
+
+        res.setStatus(503);
+        return true;
+    }
+
+private:
+    // Строки exportBody после ключа after, не больше limit
+    std::string exportPage(const std::string& path) const
+    {
+        auto param = [&path](const std::string& name) -> std::string {
+            auto pos = path.find(name + "=");
+            if (pos == std::string::npos)
+            {
+                return "";
+            }
+            pos += name.size() + 1;
+            return path.substr(pos, path.find('&', pos) - pos);
+        };
+        std::string after = param("after");
+        std::string limitValue = param("limit");
+        std::size_t limit = limitValue.empty() ? SIZE_MAX : std::stoul(limitValue);
+
+        std::istringstream lines(exportBody);
+        std::string line;
+        std::string page;
+        bool started = after.empty();
+        std::size_t taken = 0;
+        while (std::getline(lines, line) && taken < limit)
+        {
+            if (started)
+            {
+                page += line + "\n";
+                ++taken;
+            }
+            else if (line.find("\"shortId\":\"" + after + "\"") != std::string::npos)
+            {
+                started = true;
+            }
+        }
+        return page;
+    }
+};
+
+namespace {
+std::shared_ptr<IRuleServiceSettings> makeSnapshotSettings(const std::string& path = "", int pageSize = 5000)
+{
+    auto env = std::make_shared<Environment>();
+    env->setProperty("services.rule_snapshot.page_size", pageSize);
+    env->setProperty("services.rule_service_url", std::string("http://localhost:8081"));
+    env->setProperty("services.rule_changes.timeout_ms", 0);
+    env->setProperty("services.rule_snapshot.path", path);
+    return std::make_shared<RuleServiceSettings>(env);
+}
+
+const std::string EXPORT_BODY =
+    R"({"shortId":"promo","targetUrl":"https://promo","condition":"browser == \"chrome\""})" "\n"
+    R"({"shortId":"docs","targetUrl":"https://docs","condition":"country == \"RU\""})" "\n";
+}
+
+// Тест: снимок загружается целиком, условия предкомпилированы
+TEST(SnapshotRuleClientTest, LoadsSnapshotWithCompiledConditions)
+{
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->exportBody = EXPORT_BODY;
+    http->changes.push_back(R"({"epoch":"e1","version":7,"reset":true,"changes":[]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings(), std::make_shared<DSLEvaluator>());
+
+    ASSERT_TRUE(client.loadSnapshot());
+    EXPECT_EQ(client.version(), 7u);
+    EXPECT_EQ(client.index()->size(), 2u);
+
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "https://promo");
+    EXPECT_NE(rule->compiled, nullptr);
+    EXPECT_FALSE(client.findByKey("missing").has_value());
+}
+
+// Тест: выгрузка запрашивается страницами до неполной
+TEST(SnapshotRuleClientTest, LoadsSnapshotPageByPage)
+{
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->exportBody = EXPORT_BODY +
+        R"({"shortId":"blog","targetUrl":"https://blog","condition":""})" "\n";
+    http->changes.push_back(R"({"epoch":"e1","version":1,"reset":true,"changes":[]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings("", 2), std::make_shared<DSLEvaluator>());
+
+    ASSERT_TRUE(client.loadSnapshot());
+    EXPECT_EQ(http->exportCalls, 2);
+    EXPECT_EQ(client.index()->size(), 3u);
+    EXPECT_TRUE(client.findByKey("promo").has_value());
+    EXPECT_TRUE(client.findByKey("blog").has_value());
+}
+
+// Тест: изменения собирают новый индекс, старый остаётся у читателей
+TEST(SnapshotRuleClientTest, AppliesChangesByIndexSwap)
+{
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->exportBody = EXPORT_BODY;
+    http->changes.push_back(R"({"epoch":"e1","version":1,"reset":true,"changes":[]})");
+    http->changes.push_back(R"({"epoch":"e1","version":3,"reset":false,"changes":[
+        {"version":2,"shortId":"promo","op":"upsert","targetUrl":"https://new","condition":""},
+        {"version":3,"shortId":"docs","op":"delete"}]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings(), std::make_shared<DSLEvaluator>());
+    ASSERT_TRUE(client.loadSnapshot());
+    auto before = client.index();
+
+    ASSERT_TRUE(client.pollChanges());
+
+    EXPECT_EQ(client.version(), 3u);
+    EXPECT_EQ(client.findByKey("promo")->targetUrl, "https://new");
+    EXPECT_FALSE(client.findByKey("docs").has_value());
+
+    // Прежний индекс не изменился
+    EXPECT_EQ(before->find("promo")->targetUrl, "https://promo");
+    EXPECT_NE(before->find("docs"), nullptr);
+}
+
+// Тест: сброс журнала ведёт к полной перезагрузке
+TEST(SnapshotRuleClientTest, ResetReloadsSnapshot)
+{
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->exportBody = EXPORT_BODY;
+    http->changes.push_back(R"({"epoch":"e1","version":1,"reset":true,"changes":[]})");
+    http->changes.push_back(R"({"epoch":"e2","version":0,"reset":true,"changes":[]})");
+    http->changes.push_back(R"({"epoch":"e2","version":0,"reset":true,"changes":[]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings(), std::make_shared<DSLEvaluator>());
+    ASSERT_TRUE(client.loadSnapshot());
+    ASSERT_TRUE(client.pollChanges());
+
+    EXPECT_EQ(http->exportCalls, 2);
+    EXPECT_EQ(client.version(), 0u);
+}
+
+// Тест: недоступность rule-service не трогает текущий снимок
+TEST(SnapshotRuleClientTest, KeepsSnapshotWhenRuleServiceDown)
+{
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->exportBody = EXPORT_BODY;
+    http->changes.push_back(R"({"epoch":"e1","version":1,"reset":true,"changes":[]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings(), std::make_shared<DSLEvaluator>());
+    ASSERT_TRUE(client.loadSnapshot());
+
+    http->down = true;
+    EXPECT_FALSE(client.pollChanges());
+    EXPECT_TRUE(client.findByKey("promo").has_value());
+}
+
+// Тест: после перезапуска правила отдаются из файла без выгрузки
+TEST(SnapshotRuleClientTest, RestoresFromFileAndCatchesUp)
+{
+    const std::string path = ::testing::TempDir() + "snapshot-client.idx";
+    std::remove(path.c_str());
+
+    {
+        auto http = std::make_shared<FakeRuleServiceClient>();
+        http->exportBody = EXPORT_BODY;
+        http->changes.push_back(R"({"epoch":"e1","version":7,"reset":true,"changes":[]})");
+
+        SnapshotRuleClient client(http, makeSnapshotSettings(path), std::make_shared<DSLEvaluator>());
+        ASSERT_TRUE(client.loadSnapshot());
+    }
+
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->changes.push_back(R"({"epoch":"e1","version":8,"reset":false,"changes":[
+        {"version":8,"shortId":"docs","op":"delete"}]})");
+
+    SnapshotRuleClient client(http, makeSnapshotSettings(path), std::make_shared<DSLEvaluator>());
+    ASSERT_TRUE(client.restoreSnapshot());
+    EXPECT_EQ(client.version(), 7u);
+
+    auto rule = client.findByKey("promo");
+    ASSERT_TRUE(rule.has_value());
+    EXPECT_EQ(rule->targetUrl, "https://promo");
+    EXPECT_NE(rule->compiled, nullptr);
+    EXPECT_TRUE(client.findByKey("docs").has_value());
+
+    ASSERT_TRUE(client.pollChanges());
+    EXPECT_EQ(http->exportCalls, 0);
+    EXPECT_FALSE(client.findByKey("docs").has_value());
+    EXPECT_TRUE(client.findByKey("promo").has_value());
+
+    std::remove(path.c_str());
+}
+
+namespace {
+/**
+ * Разбор условий со счётчиком вызовов
+ */
+class CountingEvaluator : public DSLEvaluator
+{
+public:
+    int compiles = 0;
+
+    std::shared_ptr<const ASTNode> compile(const std::string& condition) override
+    {
+        ++compiles;
+        return DSLEvaluator::compile(condition);
+    }
+};
+}
+
+// Тест: первое изменение после восстановления из файла разбирает только изменённые правила
+TEST(SnapshotRuleClientTest, FirstChangeAfterRestoreCompilesOnlyChangedRules)
+{
+    const std::string path = ::testing::TempDir() + "snapshot-lazy.idx";
+    std::remove(path.c_str());
+
+    {
+        auto http = std::make_shared<FakeRuleServiceClient>();
+        http->exportBody = EXPORT_BODY;
+        http->changes.push_back(R"({"epoch":"e1","version":7,"reset":true,"changes":[]})");
+
+        SnapshotRuleClient client(http, makeSnapshotSettings(path), std::make_shared<DSLEvaluator>());
+        ASSERT_TRUE(client.loadSnapshot());
+    }
+
+    auto http = std::make_shared<FakeRuleServiceClient>();
+    http->changes.push_back(R"({"epoch":"e1","version":8,"reset":false,"changes":[
+        {"version":8,"shortId":"promo","op":"upsert","targetUrl":"https://promo2","condition":"browser == \"firefox\""}]})");
+
+    auto evaluator = std::make_shared<CountingEvaluator>();
+    SnapshotRuleClient client(http, makeSnapshotSettings(path), evaluator);
+    ASSERT_TRUE(client.restoreSnapshot());
+    ASSERT_TRUE(client.pollChanges());
+    EXPECT_EQ(evaluator->compiles, 1);
+
+    auto promo = client.findByKey("promo");
+    ASSERT_TRUE(promo.has_value());
+    EXPECT_EQ(promo->targetUrl, "https://promo2");
+    EXPECT_NE(promo->compiled, nullptr);
+
+    // Неизменённое правило разбирается при первом обращении и запоминается
+    auto docs = client.findByKey("docs");
+    ASSERT_TRUE(docs.has_value());
+    EXPECT_NE(docs->compiled, nullptr);
+    EXPECT_EQ(evaluator->compiles, 2);
+    EXPECT_TRUE(client.findByKey("docs").has_value());
+    EXPECT_EQ(evaluator->compiles, 2);
+
+    std::remove(path.c_str());
+}
+
+// Правило из файла готовится один раз: ответ 302 и ошибка разбора запоминаются
+TEST(SnapshotRuleClientTest, MappedRulePreparedOnce)
+{
+    const std::string path = ::testing::TempDir() + "snapshot-prepared.idx";
+    ASSERT_TRUE(MappedRuleIndex::write(path, {Rule{"promo", "https://promo", "browser == \"chrome\""},
+                                              Rule{"broken", "https://broken", "browser =="}}, "e1", 3));
+
+    auto evaluator = std::make_shared<CountingEvaluator>();
+    SnapshotRuleClient client(std::make_shared<FakeRuleServiceClient>(), makeSnapshotSettings(path), evaluator);
+    ASSERT_TRUE(client.restoreSnapshot());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto promo = client.findByKey("promo");
+        ASSERT_TRUE(promo.has_value());
+        EXPECT_NE(promo->redirect, nullptr);
+        EXPECT_NE(promo->compiled, nullptr);
+
+        auto broken = client.findByKey("broken");
+        ASSERT_TRUE(broken.has_value());
+        EXPECT_NE(broken->redirect, nullptr);
+        EXPECT_EQ(broken->compiled, nullptr);
+    }
+    EXPECT_EQ(evaluator->compiles, 2);
+
+    std::remove(path.c_str());
+}
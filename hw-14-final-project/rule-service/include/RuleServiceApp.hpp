@@ -1,6 +1,8 @@
 #pragma once
 
 #include "BoostBeastApplication.hpp"
+#include "ports/IRuleChangeLog.hpp"
+#include <memory>
 
 class RuleServiceApp : public BoostBeastApplication
 {
@@ -9,4 +11,13 @@ public:
     ~RuleServiceApp() override;
 
     void configureInjection() override;
+
+protected:
+    /**
+     * @brief Отпустить подписчиков /rules/changes, чтобы остановка не ждала их таймаута
+     */
+    void onDrain() override;
+
+private:
+    std::shared_ptr<IRuleChangeLog> changeLog_;
 };
\ No newline at end of file
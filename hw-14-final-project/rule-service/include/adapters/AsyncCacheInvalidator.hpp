@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ports/ICacheInvalidator.hpp"
+#include "settings/ICacheInvalidatorSettings.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file AsyncCacheInvalidator.hpp
+ * @brief Асинхронная пакетная инвалидация кэша
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class AsyncCacheInvalidator
+ * @brief Декоратор ICacheInvalidator: копит изменения и отправляет их в фоне
+ *
+ * Методы только ставят shortId в очередь и сразу возвращают true, поэтому
+ * запись правила не ждёт redirect-service. Фоновый поток после первого
+ * изменения выжидает окно coalesce, затем отправляет накопленное одной
+ * командой: invalidate для одного ключа, invalidateBatch для нескольких,
+ * invalidateAll, если за окно запрошен полный сброс. При разрушении
+ * накопленное досылается.
+ */
+class AsyncCacheInvalidator : public ICacheInvalidator
+{
+public:
+    /**
+     * @brief Конструктор, запускает фоновый поток
+     * @param delegate Синхронный инвалидатор (например, HttpCacheInvalidator)
+     * @param settings Окно накопления изменений
+     */
+    AsyncCacheInvalidator(std::shared_ptr<ICacheInvalidator> delegate,
+                          std::shared_ptr<ICacheInvalidatorSettings> settings);
+
+    /**
+     * @brief Досылает накопленное и останавливает поток
+     */
+    ~AsyncCacheInvalidator() override;
+
+    bool invalidate(const std::string& shortId) override;
+    bool invalidateBatch(const std::vector<std::string>& shortIds) override;
+    bool invalidateAll() override;
+
+private:
+    void run();
+
+    /**
+     * @brief Отправить накопленное через delegate_
+     */
+    void flush(std::set<std::string> keys, bool all);
+
+    std::shared_ptr<ICacheInvalidator> delegate_;
+    std::chrono::milliseconds coalesceWindow_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::set<std::string> pending_;   ///< shortId, ожидающие отправки
+    bool pendingAll_ = false;         ///< Запрошен полный сброс
+    bool stopping_ = false;
+
+    std::thread worker_;
+};
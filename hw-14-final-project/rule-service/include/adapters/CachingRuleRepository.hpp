@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ports/IRuleRepository.hpp"
+#include "settings/IRuleCacheSettings.hpp"
+#include "domain/Rule.hpp"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file CachingRuleRepository.hpp
+ * @brief Кэширующий декоратор репозитория правил
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class CachingRuleRepository
+ * @brief Read-through кэш findById поверх другого IRuleRepository
+ *
+ * Кэш ограничен по размеру (вытесняется давно не читанное правило) и по
+ * времени жизни записи. Запоминаются и отсутствующие правила, чтобы промахи
+ * redirect-service по несуществующим shortId тоже не доходили до БД.
+ * create/update/deleteById проходят в исходный репозиторий и сбрасывают
+ * запись. Списки (findPage, findBatch) не кэшируются. findByIds берёт
+ * найденное из кэша и одним запросом дочитывает промахи.
+ */
+class CachingRuleRepository : public IRuleRepository
+{
+public:
+    /**
+     * @brief Конструктор
+     * @param repository Исходный репозиторий (например, PostgreSQL)
+     * @param settings Размер и TTL кэша
+     */
+    CachingRuleRepository(std::shared_ptr<IRuleRepository> repository,
+                          std::shared_ptr<IRuleCacheSettings> settings);
+
+    std::optional<std::string> create(const Rule& rule) override;
+    std::optional<Rule> findById(const std::string& shortId) override;
+    PaginatedRules findPage(const std::string& afterCursor, int limit) override;
+    std::vector<Rule> findBatch(const std::string& afterShortId, int limit) override;
+    std::vector<Rule> findByIds(const std::vector<std::string>& shortIds) override;
+    std::optional<std::string> update(const std::string& shortId, const Rule& rule) override;
+    bool deleteById(const std::string& shortId) override;
+
+    /**
+     * @brief Текущее число записей в кэше
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Изменить ёмкость на лету, лишние записи вытесняются сразу
+     */
+    void setCapacity(std::size_t capacity);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        std::optional<Rule> rule;                  ///< nullopt - правила нет в БД
+        Clock::time_point expiresAt;
+        std::list<std::string>::iterator lruPos;   ///< Позиция в lru_
+    };
+
+    /**
+     * @brief Найти свежую запись; устаревшая удаляется (под mutex_)
+     * @return true, если запись есть (rule - правило или nullopt для отсутствующего)
+     */
+    bool lookupLocked(const std::string& shortId, std::optional<Rule>& rule);
+
+    /**
+     * @brief Положить запись, вытеснив давно не читанные (под mutex_)
+     */
+    void storeLocked(const std::string& shortId, const std::optional<Rule>& rule);
+
+    /**
+     * @brief Сбросить запись после изменения правила
+     */
+    void invalidate(const std::string& shortId);
+
+    std::shared_ptr<IRuleRepository> repository_;
+    std::size_t capacity_;   ///< Под mutex_
+    const std::chrono::milliseconds ttl_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_;   ///< Недавно прочитанные первыми
+
+    // Растёт при каждой инвалидации: загрузка, начатая до неё,
+    // не должна положить в кэш устаревшее значение
+    uint64_t generation_ = 0;
+};
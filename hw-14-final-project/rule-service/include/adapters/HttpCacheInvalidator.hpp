@@ -1,24 +1,47 @@
 #pragma once
 
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include "ports/ICacheInvalidator.hpp"
 #include "settings/ICacheInvalidatorSettings.hpp"
 #include "HttpClient.hpp"
 
 /**
  * @brief HTTP-клиент для инвалидации кэша через IHttpClient
+ *
+ * Команда рассылается всем репликам redirect-service параллельно,
+ * запрос к каждой реплике повторяется с экспоненциальной паузой.
+ * Адреса реплик берутся из настроек уже разобранными.
  */
 class HttpCacheInvalidator : public ICacheInvalidator
 {
 private:
     std::shared_ptr<IHttpClient> httpClient_;
-    std::string redirectServiceUrl_;
+    std::vector<HttpEndpoint> endpoints_;
+    int maxRetries_;
+    std::chrono::milliseconds retryBackoff_;
+
+    /**
+     * @brief Отправить команду всем репликам
+     * @return true если все реплики ответили 204
+     */
+    bool broadcast(const std::string& method, const std::string& path,
+                   const std::string& body, const std::map<std::string, std::string>& headers);
+
+    /**
+     * @brief Отправить команду одной реплике с повторами
+     */
+    bool sendWithRetry(const HttpEndpoint& endpoint, const std::string& method, const std::string& path,
+                       const std::string& body, const std::map<std::string, std::string>& headers);
 
 public:
     HttpCacheInvalidator(std::shared_ptr<IHttpClient> httpClient,
                          std::shared_ptr<ICacheInvalidatorSettings> settings);
 
     bool invalidate(const std::string& shortId) override;
+    bool invalidateBatch(const std::vector<std::string>& shortIds) override;
     bool invalidateAll() override;
 };
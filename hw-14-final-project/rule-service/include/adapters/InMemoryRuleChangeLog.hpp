@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ports/IRuleChangeLog.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @file InMemoryRuleChangeLog.hpp
+ * @brief Журнал изменений правил в памяти
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class InMemoryRuleChangeLog
+ * @brief Ограниченный журнал последних изменений с long-poll ожиданием
+ *
+ * Хранит не больше capacity последних изменений. Подписчик, отставший
+ * сильнее, или пришедший с эпохой прошлого запуска rule-service, получает
+ * reset = true и должен сбросить свой кэш целиком.
+ */
+class InMemoryRuleChangeLog : public IRuleChangeLog
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 10000;
+
+    explicit InMemoryRuleChangeLog(std::size_t capacity = DEFAULT_CAPACITY);
+
+    uint64_t append(RuleChange::Type type, const Rule& rule) override;
+    RuleChangeBatch since(const std::string& epoch, uint64_t sinceVersion,
+                          std::chrono::milliseconds timeout) override;
+    void shutdown() override;
+
+    /**
+     * @brief Эпоха текущего запуска журнала
+     */
+    const std::string& epoch() const;
+
+private:
+    const std::size_t capacity_;
+    const std::string epoch_;
+
+    std::mutex mutex_;
+    std::condition_variable appended_;
+    std::deque<RuleChange> changes_;   ///< Последние изменения по возрастанию версии
+    uint64_t version_ = 0;
+    bool closed_ = false;              ///< После shutdown() since() отвечает сразу
+};
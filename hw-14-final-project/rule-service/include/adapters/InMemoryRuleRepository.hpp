@@ -3,8 +3,11 @@
 #include "ports/IRuleRepository.hpp"
 #include "domain/Rule.hpp"
 #include "domain/PaginatedRules.hpp"
-#include <ThreadSafeMap.hpp>
-#include <memory>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <iostream>
 
@@ -24,16 +27,27 @@ public:
     InMemoryRuleRepository();
     ~InMemoryRuleRepository() override;
 
-    bool create(const Rule& rule) override;
+    std::optional<std::string> create(const Rule& rule) override;
     std::optional<Rule> findById(const std::string& shortId) override;
-    PaginatedRules findAll(int page, int pageSize) override;
-    bool update(const std::string& shortId, const Rule& rule) override;
+    PaginatedRules findPage(const std::string& afterCursor, int limit) override;
+    std::vector<Rule> findBatch(const std::string& afterShortId, int limit) override;
+    std::vector<Rule> findByIds(const std::vector<std::string>& shortIds) override;
+    std::optional<std::string> update(const std::string& shortId, const Rule& rule) override;
     bool deleteById(const std::string& shortId) override;
 
 private:
-    // Потокобезопасное хранилище правил: shortId → Rule
-    ThreadSafeMap<std::string, Rule> rules_;
-    
-    // Счётчик для отслеживания всех когда-либо созданных правил
-    int totalCount_ = 0;
+    mutable std::shared_mutex mutex_;
+
+    // Правила в порядке создания, новые первыми: seq → Rule.
+    // Порядковый номер играет роль (created_at, id) из PostgreSQL и служит курсором.
+    std::map<uint64_t, Rule, std::greater<uint64_t>> rulesBySeq_;
+
+    // Индекс shortId → seq (упорядочен по shortId для findBatch)
+    std::map<std::string, uint64_t> seqByShortId_;
+
+    // Следующий порядковый номер (растёт монотонно, не переиспользуется)
+    uint64_t nextSeq_ = 1;
+
+    // Следующая версия правила: аналог updated_at, растёт при создании и обновлении
+    uint64_t nextVersion_ = 1;
 };
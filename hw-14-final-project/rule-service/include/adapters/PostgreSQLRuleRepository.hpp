@@ -5,6 +5,7 @@
 #include "domain/RuleEntity.hpp"
 #include "domain/PaginatedRules.hpp"
 #include <settings/IDbSettings.hpp>
+#include <ConnectionPool.hpp>
 #include <pqxx/pqxx>
 #include <memory>
 #include <string>
@@ -18,13 +19,20 @@
 /**
  * @class PostgreSQLRuleRepository
  * @brief Реализация IRuleRepository для PostgreSQL
+ *
+ * Соединения libpqxx не потокобезопасны, поэтому каждый запрос берёт
+ * собственное соединение из пула размером IDbSettings::getPoolSize().
+ * SQL всех запросов подготавливается один раз на соединение. Перед
+ * выдачей соединение проверяется запросом SELECT 1, если простояло в пуле
+ * дольше IDbSettings::getPoolValidationInterval().
  */
 class PostgreSQLRuleRepository : public IRuleRepository
 {
 public:
     /**
      * @brief Конструктор с параметрами подключения
-     * @param connectionString Строка подключения PostgreSQL
+     * @param dbSettings Параметры подключения и размер пула
+     * @throws std::exception если не удалось открыть соединения пула
      */
     explicit PostgreSQLRuleRepository(std::shared_ptr<IDbSettings> dbSettings);
     
@@ -33,15 +41,43 @@ public:
      */
     ~PostgreSQLRuleRepository() override;
 
-    bool create(const Rule& rule) override;
+    std::optional<std::string> create(const Rule& rule) override;
     std::optional<Rule> findById(const std::string& shortId) override;
-    PaginatedRules findAll(int page, int pageSize) override;
-    bool update(const std::string& shortId, const Rule& rule) override;
+    PaginatedRules findPage(const std::string& afterCursor, int limit) override;
+    std::vector<Rule> findBatch(const std::string& afterShortId, int limit) override;
+    std::vector<Rule> findByIds(const std::vector<std::string>& shortIds) override;
+    std::optional<std::string> update(const std::string& shortId, const Rule& rule) override;
     bool deleteById(const std::string& shortId) override;
 
+    /**
+     * @brief Изменить размер пула соединений на лету
+     * @throws std::invalid_argument если size == 0
+     */
+    void resizePool(std::size_t size);
+
 private:
-    std::unique_ptr<pqxx::connection> connection_;
+    using Pool = ConnectionPool<pqxx::connection>;
+
+    std::unique_ptr<Pool> pool_;
+
+    /**
+     * @brief Подготовить SQL всех запросов репозитория на соединении
+     */
+    static void prepareStatements(pqxx::connection& connection);
+
+    /**
+     * @brief Выполнить func на соединении из пула
+     *
+     * При потере связи соединение не возвращается в пул (будет пересоздано).
+     */
+    template <typename Func>
+    auto withConnection(Func&& func);
     
+    /**
+     * @brief Версия правила (Rule::version) по значению updated_at
+     */
+    static std::string versionOf(const std::string& updatedAt);
+
     /**
      * @brief Конвертировать RuleEntity в Rule
      */
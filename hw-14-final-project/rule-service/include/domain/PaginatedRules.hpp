@@ -1,5 +1,7 @@
 #pragma once
 #include "Rule.hpp"
+#include <optional>
+#include <string>
 #include <vector>
 
 /**
@@ -10,12 +12,12 @@
 
 /**
  * @struct PaginatedRules
- * @brief Результат запроса списка правил с пагинацией
+ * @brief Результат запроса страницы правил по курсору
  */
 struct PaginatedRules
 {
-    std::vector<Rule> rules;  ///< Список правил
-    int totalCount;           ///< Общее количество правил в БД
-    int page;                 ///< Текущая страница (начинается с 1)
-    int pageSize;             ///< Размер страницы
-};
\ No newline at end of file
+    std::vector<Rule> rules;               ///< Список правил (новые первыми)
+    std::string nextCursor;                ///< Курсор следующей страницы ("" - страниц больше нет)
+    std::optional<long long> totalCount;   ///< Оценка общего количества правил (если известна)
+    int pageSize;                          ///< Размер страницы
+};
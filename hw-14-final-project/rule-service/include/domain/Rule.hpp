@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <tuple>
 
 /**
  * @file Rule.hpp
@@ -16,8 +17,13 @@ struct Rule
     std::string shortId;     ///< Короткий ID (PRIMARY KEY)
     std::string targetUrl;   ///< Целевой URL для редиректа
     std::string condition;   ///< DSL-условие активации правила
+    std::string version{};   ///< Версия правила для ETag, меняется при каждом обновлении (может отсутствовать)
 };
 
+/**
+ * @brief Сравнение по содержимому, версия не учитывается
+ */
+
 inline bool operator==(const Rule& a, const Rule& b)
 {
     return std::tie(a.shortId, a.targetUrl, a.condition) ==
@@ -0,0 +1,40 @@
+#pragma once
+#include "Rule.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file RuleChange.hpp
+ * @brief Запись журнала изменений правил
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @struct RuleChange
+ * @brief Одно изменение правила с монотонной версией
+ */
+struct RuleChange
+{
+    enum class Type
+    {
+        Upsert,   ///< Правило создано или обновлено
+        Delete    ///< Правило удалено
+    };
+
+    uint64_t version;   ///< Версия журнала после изменения
+    Type type;          ///< Тип изменения
+    Rule rule;          ///< Новое состояние правила (для Delete заполнен только shortId)
+};
+
+/**
+ * @struct RuleChangeBatch
+ * @brief Ответ журнала на запрос изменений после версии
+ */
+struct RuleChangeBatch
+{
+    std::string epoch;                ///< Идентификатор запуска журнала
+    uint64_t version;                 ///< Текущая версия журнала
+    bool reset;                       ///< true - клиент отстал или журнал перезапущен, нужен полный сброс
+    std::vector<RuleChange> changes;  ///< Изменения по возрастанию версии
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "IHttpHandler.hpp"
+#include "ports/IRuleService.hpp"
+#include <memory>
+
+/**
+ * @file BatchGetRulesHandler.hpp
+ * @brief Обработчик получения нескольких правил одним запросом
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class BatchGetRulesHandler
+ * @brief Обрабатывает POST /rules:batchGet
+ *
+ * Тело запроса: {"shortIds": [...], "ifNoneMatch": {"<shortId>": "<version>"}}.
+ * Поле ifNoneMatch необязательно: правила, версия которых совпала,
+ * возвращаются только списком notModified, без содержимого.
+ * Ответ: {"rules": [...], "notModified": [...]}; отсутствующих правил
+ * в ответе нет. Не больше 100 идентификаторов за запрос.
+ */
+class BatchGetRulesHandler : public IHttpHandler
+{
+public:
+    /**
+     * @brief Конструктор с инъекцией зависимостей
+     */
+    explicit BatchGetRulesHandler(std::shared_ptr<IRuleService> ruleService);
+
+    /**
+     * @brief Обработать HTTP-запрос
+     */
+    void handle(IRequest& req, IResponse& res) override;
+
+private:
+    std::shared_ptr<IRuleService> ruleService_;
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "IHttpHandler.hpp"
+#include "ports/IRuleService.hpp"
+#include <memory>
+
+/**
+ * @file ExportRulesHandler.hpp
+ * @brief Обработчик потоковой выгрузки всех правил
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class ExportRulesHandler
+ * @brief Обрабатывает GET /rules/export
+ *
+ * Отдаёт все правила в формате NDJSON (одно правило - одна строка JSON)
+ * chunked-ответом. Правила читаются порциями по ключевому курсору,
+ * поэтому потребление памяти не зависит от размера таблицы.
+ *
+ * Параметры запроса:
+ * - batch - размер порции (по умолчанию 500, максимум 5000)
+ * - after - выгружать правила с shortId после этого (страница выгрузки)
+ * - limit - не больше стольких правил (по умолчанию все)
+ *
+ * Ошибка чтения после начала выгрузки уже не может стать кодом 500:
+ * поток обрывается без завершающего chunk, и клиент видит неполный ответ.
+ */
+class ExportRulesHandler : public IHttpHandler
+{
+public:
+    /**
+     * @brief Конструктор с инъекцией зависимостей
+     */
+    explicit ExportRulesHandler(std::shared_ptr<IRuleService> ruleService);
+
+    /**
+     * @brief Обработать HTTP-запрос
+     */
+    void handle(IRequest& req, IResponse& res) override;
+
+private:
+    std::shared_ptr<IRuleService> ruleService_;
+};
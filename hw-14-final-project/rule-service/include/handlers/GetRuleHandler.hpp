@@ -12,6 +12,9 @@
 /**
  * @class GetRuleHandler
  * @brief Обрабатывает GET /rules/{shortId}
+ *
+ * Версия правила отдаётся в ETag. Если она совпала с If-None-Match,
+ * ответ 304 без тела: клиент продолжает пользоваться своей копией.
  */
 class GetRuleHandler : public IHttpHandler
 {
@@ -33,4 +36,9 @@ private:
      * @brief Извлечь shortId из пути /rules/{shortId}
      */
     std::string extractShortId(const std::string& path) const;
+
+    /**
+     * @brief Есть ли etag в значении If-None-Match (список через запятую или "*")
+     */
+    static bool matchesIfNoneMatch(const std::string& ifNoneMatch, const std::string& etag);
 };
\ No newline at end of file
@@ -11,7 +11,10 @@
 
 /**
  * @class ListRulesHandler
- * @brief Обрабатывает GET /rules
+ * @brief Обрабатывает GET /rules?cursor=&size=
+ *
+ * Страница отдаётся вместе с nextCursor; для следующей страницы клиент
+ * передаёт его в параметре cursor (null - страниц больше нет).
  */
 class ListRulesHandler : public IHttpHandler
 {
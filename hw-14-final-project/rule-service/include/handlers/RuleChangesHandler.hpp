@@ -0,0 +1,43 @@
+#pragma once
+#include "IHttpHandler.hpp"
+#include "ports/IRuleChangeLog.hpp"
+#include <memory>
+
+/**
+ * @file RuleChangesHandler.hpp
+ * @brief Обработчик long-poll подписки на изменения правил
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @class RuleChangesHandler
+ * @brief Обрабатывает GET /rules/changes
+ *
+ * Возвращает изменения правил после версии since. Если их нет, держит
+ * запрос до появления изменений или до истечения timeout.
+ *
+ * Параметры запроса:
+ * - epoch - эпоха из предыдущего ответа (пусто - первый запрос)
+ * - since - последняя применённая версия (по умолчанию 0)
+ * - timeout - время ожидания в мс (по умолчанию 25000, максимум 60000)
+ *
+ * При reset = true подписчик должен сбросить кэш и продолжить с version.
+ * Изменение upsert несёт targetUrl, condition и ruleVersion - версию
+ * правила, которую GET /rules/{shortId} отдаёт в ETag.
+ */
+class RuleChangesHandler : public IHttpHandler
+{
+public:
+    /**
+     * @brief Конструктор с инъекцией зависимостей
+     */
+    explicit RuleChangesHandler(std::shared_ptr<IRuleChangeLog> changeLog);
+
+    /**
+     * @brief Обработать HTTP-запрос
+     */
+    void handle(IRequest& req, IResponse& res) override;
+
+private:
+    std::shared_ptr<IRuleChangeLog> changeLog_;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 
 /**
  * @file ICacheInvalidator.hpp
@@ -23,6 +24,13 @@ public:
      */
     virtual bool invalidate(const std::string& shortId) = 0;
 
+    /**
+     * @brief Инвалидировать кэш для набора shortId одной командой
+     * @param shortIds Короткие идентификаторы правил
+     * @return true если успешно отправлено
+     */
+    virtual bool invalidateBatch(const std::vector<std::string>& shortIds) = 0;
+
     /**
      * @brief Инвалидировать весь кэш
      * @return true если успешно отправлено
@@ -0,0 +1,45 @@
+#pragma once
+#include "domain/Rule.hpp"
+#include "domain/RuleChange.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @file IRuleChangeLog.hpp
+ * @brief Интерфейс журнала изменений правил
+ * @author Anton Tobolkin
+ */
+
+/**
+ * @interface IRuleChangeLog
+ * @brief Порт версионированного журнала изменений для подписчиков
+ */
+class IRuleChangeLog
+{
+public:
+    virtual ~IRuleChangeLog() = default;
+
+    /**
+     * @brief Записать изменение и разбудить ожидающих подписчиков
+     * @return Версия журнала после изменения
+     */
+    virtual uint64_t append(RuleChange::Type type, const Rule& rule) = 0;
+
+    /**
+     * @brief Получить изменения после версии (long-poll)
+     *
+     * Если новых изменений нет, ждёт их появления не дольше timeout.
+     *
+     * @param epoch Эпоха, в которой клиент получил sinceVersion ("" - первый запрос)
+     * @param sinceVersion Последняя применённая клиентом версия
+     * @param timeout Максимальное время ожидания
+     */
+    virtual RuleChangeBatch since(const std::string& epoch, uint64_t sinceVersion,
+                                  std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * @brief Разбудить ожидающих в since() и больше не ждать (остановка сервиса)
+     */
+    virtual void shutdown() = 0;
+};
@@ -3,6 +3,7 @@
 #include "domain/PaginatedRules.hpp"
 #include <optional>
 #include <string>
+#include <vector>
 
 /**
  * @file IRuleRepository.hpp
@@ -21,23 +22,59 @@ public:
 
     /**
      * @brief Создать новое правило
+     * @return Версия созданного правила (Rule::version) или std::nullopt, если создать не удалось
      */
-    virtual bool create(const Rule& rule) = 0;
+    virtual std::optional<std::string> create(const Rule& rule) = 0;
 
     /**
      * @brief Получить правило по shortId
+     * @return std::nullopt, только если правила точно нет
+     * @throws std::exception при ошибке хранилища
      */
     virtual std::optional<Rule> findById(const std::string& shortId) = 0;
 
     /**
-     * @brief Получить список всех правил с пагинацией
+     * @brief Получить страницу правил по курсору
+     *
+     * Keyset-пагинация по (created_at, id), новые правила первыми: страница
+     * начинается строго после курсора, поэтому стоимость запроса не зависит
+     * от глубины. Общее количество - только оценка, без COUNT(*).
+     *
+     * @param afterCursor nextCursor предыдущей страницы ("" - первая страница)
+     * @param limit Максимальный размер страницы
+     * @return Страница правил и курсор следующей
+     * @throws std::invalid_argument если курсор некорректен
+     * @throws std::exception при ошибке хранилища
      */
-    virtual PaginatedRules findAll(int page, int pageSize) = 0;
+    virtual PaginatedRules findPage(const std::string& afterCursor, int limit) = 0;
+
+    /**
+     * @brief Получить очередную порцию правил по ключевому курсору
+     *
+     * Keyset-пагинация по short_id: каждая порция начинается строго после
+     * переданного ключа, поэтому стоимость запроса не зависит от глубины.
+     *
+     * @param afterShortId shortId последнего правила предыдущей порции ("" - с начала)
+     * @param limit Максимальный размер порции
+     * @return Правила, упорядоченные по shortId
+     * @throws std::exception при ошибке хранилища (порция не подменяется пустой)
+     */
+    virtual std::vector<Rule> findBatch(const std::string& afterShortId, int limit) = 0;
+
+    /**
+     * @brief Получить несколько правил одним запросом
+     *
+     * @param shortIds Идентификаторы (повторы допустимы)
+     * @return Найденные правила в произвольном порядке; отсутствующих нет в результате
+     * @throws std::exception при ошибке хранилища
+     */
+    virtual std::vector<Rule> findByIds(const std::vector<std::string>& shortIds) = 0;
 
     /**
      * @brief Обновить правило
+     * @return Новая версия правила (Rule::version) или std::nullopt, если правила нет или запись не удалась
      */
-    virtual bool update(const std::string& shortId, const Rule& rule) = 0;
+    virtual std::optional<std::string> update(const std::string& shortId, const Rule& rule) = 0;
 
     /**
      * @brief Удалить правило
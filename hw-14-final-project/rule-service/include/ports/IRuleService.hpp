@@ -3,6 +3,7 @@
 #include "domain/PaginatedRules.hpp"
 #include <string>
 #include <optional>
+#include <vector>
 
 /**
  * @file IRuleService.hpp
@@ -21,7 +22,9 @@ public:
     
     virtual bool create(const Rule& rule) = 0;
     virtual std::optional<Rule> findById(const std::string& shortId) = 0;
-    virtual PaginatedRules findAll(int page, int pageSize) = 0;
+    virtual PaginatedRules findPage(const std::string& afterCursor, int limit) = 0;
+    virtual std::vector<Rule> findBatch(const std::string& afterShortId, int limit) = 0;
+    virtual std::vector<Rule> findByIds(const std::vector<std::string>& shortIds) = 0;
     virtual bool update(const std::string& shortId, const Rule& rule) = 0;
     virtual bool deleteById(const std::string& shortId) = 0;
 };
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 #include "ports/IRuleRepository.hpp"
+#include "ports/IRuleChangeLog.hpp"
 #include "domain/Rule.hpp"
 #include "domain/PaginatedRules.hpp"
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <optional>
 #include "ports/IRuleService.hpp"
 
@@ -15,15 +20,28 @@
 /**
  * @class RuleService
  * @brief Сервис для CRUD операций с правилами
+ *
+ * Запись в хранилище и в журнал изменений идут под блокировкой правила:
+ * иначе две конкурентные записи одного правила могли бы попасть в журнал
+ * в обратном порядке, и подписчики остались бы со старой версией. Порядок
+ * записей разных правил подписчикам не важен, поэтому блокировки разбиты
+ * на WRITE_STRIPES полос по хешу shortId и записи разных правил идут
+ * параллельно (кроме редких совпадений полосы).
  */
 class RuleService : public IRuleService
 {
 public:
+    /// Число полос блокировок записи
+    static constexpr std::size_t WRITE_STRIPES = 64;
+
     /**
      * @brief Конструктор с инъекцией зависимостей
+     * @param repository Хранилище правил
+     * @param changeLog Журнал изменений для подписчиков (redirect-service)
      */
     // FIXME: добавить ICacheInvalidator
-    explicit RuleService(std::shared_ptr<IRuleRepository> repository);
+    RuleService(std::shared_ptr<IRuleRepository> repository,
+                std::shared_ptr<IRuleChangeLog> changeLog);
 
     /**
      * @brief Создать новое правило
@@ -40,12 +58,27 @@ public:
     std::optional<Rule> findById(const std::string &shortId);
 
     /**
-     * @brief Получить список всех правил
-     * @param page Номер страницы (начинается с 1)
-     * @param pageSize Размер страницы
-     * @return Пагинированный результат
+     * @brief Получить страницу правил по курсору
+     * @param afterCursor Курсор предыдущей страницы ("" - первая страница)
+     * @param limit Размер страницы
+     * @return Пагинированный результат с курсором следующей страницы
+     */
+    PaginatedRules findPage(const std::string &afterCursor, int limit);
+
+    /**
+     * @brief Получить порцию правил для выгрузки
+     * @param afterShortId shortId последнего правила предыдущей порции ("" - с начала)
+     * @param limit Размер порции
+     * @return Правила, упорядоченные по shortId
+     */
+    std::vector<Rule> findBatch(const std::string &afterShortId, int limit);
+
+    /**
+     * @brief Получить несколько правил одним запросом к хранилищу
+     * @param shortIds Короткие идентификаторы
+     * @return Найденные правила (отсутствующих нет в результате)
      */
-    PaginatedRules findAll(int page, int pageSize);
+    std::vector<Rule> findByIds(const std::vector<std::string> &shortIds);
 
     /**
      * @brief Обновить правило
@@ -66,4 +99,12 @@ public:
 
 private:
     std::shared_ptr<IRuleRepository> repository_;
+    std::shared_ptr<IRuleChangeLog> changeLog_;
+    /// Порядок записей правила в журнале = порядок его записей в хранилище
+    std::array<std::mutex, WRITE_STRIPES> writeStripes_;
+
+    /**
+     * @brief Блокировка записи правила
+     */
+    std::mutex &writeMutex(const std::string &shortId);
 };
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "ICacheInvalidatorSettings.hpp"
 #include <IEnvironment.hpp>
 
@@ -13,18 +17,79 @@
  */
 class CacheInvalidatorSettings : public ICacheInvalidatorSettings {
 private:
-    std::string redirectServiceUrl_;
+    std::vector<std::string> redirectServiceUrls_;
+    std::vector<HttpEndpoint> redirectServiceEndpoints_;
+    std::chrono::milliseconds coalesceWindow_;
+    int maxRetries_;
+    std::chrono::milliseconds retryBackoff_;
 
 public:
+    static constexpr int DEFAULT_COALESCE_MS = 50;
+    static constexpr int DEFAULT_MAX_RETRIES = 3;
+    static constexpr int DEFAULT_RETRY_BACKOFF_MS = 100;
+
     explicit CacheInvalidatorSettings(std::shared_ptr<IEnvironment> env) {
-        try {
-            redirectServiceUrl_ = env->get<std::string>("redirect_service.url");
-        } catch (...) {
-            throw std::runtime_error("Missing required setting: redirect_service.url");
+        // Несколько реплик перечисляются через запятую в redirect_service.urls
+        std::string urls = env->get<std::string>("redirect_service.urls", "");
+        std::stringstream ss(urls);
+        std::string url;
+        while (std::getline(ss, url, ',')) {
+            url.erase(0, url.find_first_not_of(" \t"));
+            url.erase(url.find_last_not_of(" \t") + 1);
+            if (!url.empty()) {
+                redirectServiceUrls_.push_back(url);
+            }
+        }
+
+        if (redirectServiceUrls_.empty()) {
+            try {
+                redirectServiceUrls_.push_back(env->get<std::string>("redirect_service.url"));
+            } catch (...) {
+                throw std::runtime_error("Missing required setting: redirect_service.url");
+            }
+        }
+
+        for (const auto& replicaUrl : redirectServiceUrls_) {
+            try {
+                redirectServiceEndpoints_.push_back(HttpEndpoint::parse(replicaUrl));
+            } catch (const std::exception& e) {
+                // Некорректная реплика не мешает рассылке остальным
+                std::cerr << "[CacheInvalidatorSettings] Skipping replica: " << e.what() << std::endl;
+            }
+        }
+
+        coalesceWindow_ = std::chrono::milliseconds(
+            env->get<int>("redirect_service.coalesce_ms", DEFAULT_COALESCE_MS));
+        maxRetries_ = env->get<int>("redirect_service.max_retries", DEFAULT_MAX_RETRIES);
+        retryBackoff_ = std::chrono::milliseconds(
+            env->get<int>("redirect_service.retry_backoff_ms", DEFAULT_RETRY_BACKOFF_MS));
+
+        if (coalesceWindow_.count() < 0 || maxRetries_ < 0 || retryBackoff_.count() < 0) {
+            throw std::runtime_error("Invalid cache invalidation settings: values must not be negative");
         }
     }
 
     std::string getRedirectServiceUrl() const override {
-        return redirectServiceUrl_;
+        return redirectServiceUrls_.front();
+    }
+
+    std::vector<std::string> getRedirectServiceUrls() const override {
+        return redirectServiceUrls_;
+    }
+
+    const std::vector<HttpEndpoint>& getRedirectServiceEndpoints() const override {
+        return redirectServiceEndpoints_;
+    }
+
+    std::chrono::milliseconds getCoalesceWindow() const override {
+        return coalesceWindow_;
+    }
+
+    int getMaxRetries() const override {
+        return maxRetries_;
+    }
+
+    std::chrono::milliseconds getRetryBackoff() const override {
+        return retryBackoff_;
     }
-};
\ No newline at end of file
+};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "HttpEndpoint.hpp"
+#include <chrono>
 #include <string>
+#include <vector>
 
 /**
  * @brief Интерфейс настроек для сброса кэша в redirect-service. 
@@ -9,4 +12,19 @@ class ICacheInvalidatorSettings {
 public:
     virtual ~ICacheInvalidatorSettings() = default;
     virtual std::string getRedirectServiceUrl() const = 0;
-};
\ No newline at end of file
+
+    /// URL всех реплик redirect-service (первый совпадает с getRedirectServiceUrl)
+    virtual std::vector<std::string> getRedirectServiceUrls() const = 0;
+
+    /// Разобранные адреса реплик; некорректные URL пропущены
+    virtual const std::vector<HttpEndpoint>& getRedirectServiceEndpoints() const = 0;
+
+    /// Окно, за которое изменения копятся в один пакетный запрос
+    virtual std::chrono::milliseconds getCoalesceWindow() const = 0;
+
+    /// Число повторов запроса к реплике после неудачи
+    virtual int getMaxRetries() const = 0;
+
+    /// Пауза перед первым повтором, далее удваивается
+    virtual std::chrono::milliseconds getRetryBackoff() const = 0;
+};
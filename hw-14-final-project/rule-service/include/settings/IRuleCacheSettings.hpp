@@ -0,0 +1,14 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Интерфейс настроек in-process кэша правил перед репозиторием.
+ */
+class IRuleCacheSettings {
+public:
+    virtual ~IRuleCacheSettings() = default;
+    virtual std::size_t getCapacity() const = 0;
+    virtual std::chrono::milliseconds getTtl() const = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include "IRuleCacheSettings.hpp"
+#include <IEnvironment.hpp>
+
+/**
+ * @file RuleCacheSettings.hpp
+ * @brief Реализация настроек кэша правил (rule_cache.*)
+ * @author Anton Tobolkin
+ */
+class RuleCacheSettings : public IRuleCacheSettings {
+private:
+    std::size_t capacity_;
+    std::chrono::milliseconds ttl_;
+
+public:
+    static constexpr int DEFAULT_CAPACITY = 10000;
+    static constexpr int DEFAULT_TTL_MS = 30000;
+
+    explicit RuleCacheSettings(std::shared_ptr<IEnvironment> env) {
+        int capacity = env->get<int>("rule_cache.capacity", DEFAULT_CAPACITY);
+        int ttlMs = env->get<int>("rule_cache.ttl_ms", DEFAULT_TTL_MS);
+
+        if (capacity < 1) {
+            throw std::runtime_error("Invalid setting: rule_cache.capacity must be positive");
+        }
+        if (ttlMs < 1) {
+            throw std::runtime_error("Invalid setting: rule_cache.ttl_ms must be positive");
+        }
+
+        capacity_ = static_cast<std::size_t>(capacity);
+        ttl_ = std::chrono::milliseconds(ttlMs);
+    }
+
+    std::size_t getCapacity() const override {
+        return capacity_;
+    }
+
+    std::chrono::milliseconds getTtl() const override {
+        return ttl_;
+    }
+};
@@ -1,6 +1,5 @@
 #include "RuleServiceApp.hpp"
 #include <iostream>
-#include <csignal>
 
 /**
  * @file main.cpp
@@ -8,29 +7,12 @@
  * @author Anton Tobolkin
  */
 
-// Глобальный указатель для обработки сигналов
-RuleServiceApp* g_app = nullptr;
-
-void signalHandler(int signal)
-{
-    std::cout << "\n[main] Received signal " << signal << std::endl;
-    if (g_app)
-    {
-        g_app->stop();
-    }
-}
-
 int main(int argc, char* argv[])
 {
     try
     { 
-        // Создаем приложение
+        // Создаем приложение; SIGINT/SIGTERM обрабатывает сервер в start()
         RuleServiceApp app;
-        g_app = &app;
-        
-        // Устанавливаем обработчики сигналов
-        std::signal(SIGINT, signalHandler);
-        std::signal(SIGTERM, signalHandler);
 
         std::cout << "========================================" << std::endl;
         std::cout << "  Starting server..." << std::endl;
@@ -1,11 +1,17 @@
 #include "RuleServiceApp.hpp"
 #include "adapters/PostgreSQLRuleRepository.hpp"
+#include "adapters/CachingRuleRepository.hpp"
 #include "adapters/HttpCacheInvalidator.hpp"
+#include "adapters/AsyncCacheInvalidator.hpp"
+#include "adapters/InMemoryRuleChangeLog.hpp"
 #include "services/RuleService.hpp"
 #include "ports/IRuleService.hpp"
 #include "handlers/CreateRuleHandler.hpp"
 #include "handlers/GetRuleHandler.hpp"
 #include "handlers/ListRulesHandler.hpp"
+#include "handlers/ExportRulesHandler.hpp"
+#include "handlers/BatchGetRulesHandler.hpp"
+#include "handlers/RuleChangesHandler.hpp"
 #include "handlers/UpdateRuleHandler.hpp"
 #include "handlers/DeleteRuleHandler.hpp"
 #include "handlers/InvalidateCacheHandler.hpp"
@@ -16,9 +22,11 @@
 #include <iostream>
 #include "settings/DbSettings.hpp"
 #include "settings/CacheInvalidatorSettings.hpp"
+#include "settings/RuleCacheSettings.hpp"
 #include <adapters/InMemoryRuleRepository.hpp>
 #include "ports/IRuleRepository.hpp"
 #include "ports/ICacheInvalidator.hpp"
+#include "ports/IRuleChangeLog.hpp"
 #include <HttpClient.hpp>
 
 namespace di = boost::di;
@@ -39,19 +47,54 @@ RuleServiceApp::~RuleServiceApp()
     std::cout << "[RuleServiceApp] Application destroyed" << std::endl;
 }
 
+void RuleServiceApp::onDrain()
+{
+    if (changeLog_)
+    {
+        changeLog_->shutdown();
+    }
+}
+
 void RuleServiceApp::configureInjection()
 {
     std::cout << "[RuleServiceApp] Configuring DI injector..." << std::endl;
 
-    // Всё создаётся через DI
+    // Репозиторий собираем вручную: кэширующий декоратор оборачивает
+    // другой IRuleRepository, что DI не может связать сам
+    auto dbSettings = std::make_shared<DbSettings>(env_);
+    auto postgresRepository = std::make_shared<PostgreSQLRuleRepository>(dbSettings);
+    auto repository = std::make_shared<CachingRuleRepository>(
+        postgresRepository,
+        //std::make_shared<InMemoryRuleRepository>(),
+        std::make_shared<RuleCacheSettings>(env_));
+
+    // Размеры пула и кэша меняются без перезапуска при правке config.json
+    reloadableEnv_->subscribe([postgresRepository, repository](std::shared_ptr<IEnvironment> env) {
+        postgresRepository->resizePool(DbSettings(env).getPoolSize());
+        repository->setCapacity(RuleCacheSettings(env).getCapacity());
+    });
+
+    // Инвалидация кэша redirect-service: запись правила не ждёт ответа реплик,
+    // изменения копятся и рассылаются пакетами в фоне
+    auto invalidatorSettings = std::make_shared<CacheInvalidatorSettings>(env_);
+    auto httpClient = std::make_shared<HttpClient>();
+    auto cacheInvalidator = std::make_shared<AsyncCacheInvalidator>(
+        std::make_shared<HttpCacheInvalidator>(httpClient, invalidatorSettings),
+        invalidatorSettings);
+
+    // Журнал изменений для подписчиков GET /rules/changes
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    changeLog_ = changeLog;
+
+    // Остальное создаётся через DI
     auto injector = di::make_injector(
         di::bind<IEnvironment>().to(env_),
-        di::bind<IDbSettings>().to<DbSettings>().in(di::singleton),
-        di::bind<IRuleRepository>().to<PostgreSQLRuleRepository>().in(di::singleton),
-        //di::bind<IRuleRepository>().to<InMemoryRuleRepository>().in(di::singleton),
-        di::bind<IHttpClient>().to<HttpClient>().in(di::singleton),
-        di::bind<ICacheInvalidatorSettings>().to<CacheInvalidatorSettings>().in(di::singleton),
-        di::bind<ICacheInvalidator>().to<HttpCacheInvalidator>().in(di::singleton),
+        di::bind<IDbSettings>().to(dbSettings),
+        di::bind<IRuleRepository>().to(repository),
+        di::bind<IHttpClient>().to(httpClient),
+        di::bind<ICacheInvalidatorSettings>().to(invalidatorSettings),
+        di::bind<ICacheInvalidator>().to(cacheInvalidator),
+        di::bind<IRuleChangeLog>().to(changeLog),
         di::bind<IRuleService>().to<RuleService>().in(di::singleton)
     );
 
@@ -65,6 +108,16 @@ void RuleServiceApp::configureInjection()
     handlers_[getHandlerKey("GET", "/rules")] =
         injector.create<std::shared_ptr<ListRulesHandler>>();
 
+    // Точные совпадения имеют приоритет над GET /rules/*
+    handlers_[getHandlerKey("GET", "/rules/export")] =
+        injector.create<std::shared_ptr<ExportRulesHandler>>();
+
+    handlers_[getHandlerKey("GET", "/rules/changes")] =
+        injector.create<std::shared_ptr<RuleChangesHandler>>();
+
+    handlers_[getHandlerKey("POST", "/rules:batchGet")] =
+        injector.create<std::shared_ptr<BatchGetRulesHandler>>();
+
     handlers_[getHandlerKey("PUT", "/rules/*")] =
         injector.create<std::shared_ptr<UpdateRuleHandler>>();
 
@@ -0,0 +1,127 @@
+#include "adapters/AsyncCacheInvalidator.hpp"
+#include <iostream>
+#include <utility>
+
+/**
+ * @file AsyncCacheInvalidator.cpp
+ * @brief Реализация асинхронной пакетной инвалидации кэша
+ * @author Anton Tobolkin
+ */
+
+AsyncCacheInvalidator::AsyncCacheInvalidator(std::shared_ptr<ICacheInvalidator> delegate,
+                                             std::shared_ptr<ICacheInvalidatorSettings> settings)
+    : delegate_(delegate),
+      coalesceWindow_(settings->getCoalesceWindow())
+{
+    worker_ = std::thread(&AsyncCacheInvalidator::run, this);
+    std::cout << "[AsyncCacheInvalidator] Created, coalesce window="
+              << coalesceWindow_.count() << "ms" << std::endl;
+}
+
+AsyncCacheInvalidator::~AsyncCacheInvalidator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    worker_.join();
+    std::cout << "[AsyncCacheInvalidator] Stopped" << std::endl;
+}
+
+bool AsyncCacheInvalidator::invalidate(const std::string& shortId)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.insert(shortId);
+    }
+    changed_.notify_one();
+    return true;
+}
+
+bool AsyncCacheInvalidator::invalidateBatch(const std::vector<std::string>& shortIds)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.insert(shortIds.begin(), shortIds.end());
+    }
+    changed_.notify_one();
+    return true;
+}
+
+bool AsyncCacheInvalidator::invalidateAll()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pendingAll_ = true;
+    }
+    changed_.notify_one();
+    return true;
+}
+
+void AsyncCacheInvalidator::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        changed_.wait(lock, [this] {
+            return stopping_ || pendingAll_ || !pending_.empty();
+        });
+
+        // Копим изменения в течение окна (при остановке - не ждём)
+        if (!stopping_)
+        {
+            changed_.wait_for(lock, coalesceWindow_, [this] { return stopping_; });
+        }
+
+        std::set<std::string> keys;
+        keys.swap(pending_);
+        bool all = std::exchange(pendingAll_, false);
+
+        if (!keys.empty() || all)
+        {
+            lock.unlock();
+            flush(std::move(keys), all);
+            lock.lock();
+        }
+
+        if (stopping_ && pending_.empty() && !pendingAll_)
+        {
+            return;
+        }
+    }
+}
+
+void AsyncCacheInvalidator::flush(std::set<std::string> keys, bool all)
+{
+    try
+    {
+        bool success = true;
+
+        // Полный сброс покрывает все накопленные ключи
+        if (all)
+        {
+            success = delegate_->invalidateAll();
+        }
+        else if (keys.size() == 1)
+        {
+            success = delegate_->invalidate(*keys.begin());
+        }
+        else
+        {
+            success = delegate_->invalidateBatch(std::vector<std::string>(keys.begin(), keys.end()));
+        }
+
+        if (!success)
+        {
+            std::cerr << "[AsyncCacheInvalidator] Failed to invalidate "
+                      << (all ? std::string("all cache") : std::to_string(keys.size()) + " rules")
+                      << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[AsyncCacheInvalidator] Error: " << e.what() << std::endl;
+    }
+}
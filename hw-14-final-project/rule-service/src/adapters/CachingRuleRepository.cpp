@@ -0,0 +1,215 @@
+#include "adapters/CachingRuleRepository.hpp"
+#include <iostream>
+
+/**
+ * @file CachingRuleRepository.cpp
+ * @brief Реализация кэширующего декоратора репозитория правил
+ * @author Anton Tobolkin
+ */
+
+CachingRuleRepository::CachingRuleRepository(std::shared_ptr<IRuleRepository> repository,
+                                             std::shared_ptr<IRuleCacheSettings> settings)
+    : repository_(repository),
+      capacity_(settings->getCapacity()),
+      ttl_(settings->getTtl())
+{
+    std::cout << "[CachingRuleRepository] Created, capacity=" << capacity_
+              << ", ttl=" << ttl_.count() << "ms" << std::endl;
+}
+
+std::optional<std::string> CachingRuleRepository::create(const Rule& rule)
+{
+    auto created = repository_->create(rule);
+    // Сбрасываем запомненное отсутствие правила
+    invalidate(rule.shortId);
+    return created;
+}
+
+std::optional<Rule> CachingRuleRepository::findById(const std::string& shortId)
+{
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::optional<Rule> cached;
+        if (lookupLocked(shortId, cached))
+        {
+            std::cout << "[CachingRuleRepository] Cache hit: " << shortId << std::endl;
+            return cached;
+        }
+        generation = generation_;
+    }
+
+    // Промах: читаем из исходного репозитория без блокировки кэша
+    std::cout << "[CachingRuleRepository] Cache miss: " << shortId << std::endl;
+    auto rule = repository_->findById(shortId);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Пока читали, правило могли изменить - такое значение не кэшируем
+    if (generation != generation_ || entries_.count(shortId))
+    {
+        return rule;
+    }
+
+    storeLocked(shortId, rule);
+    return rule;
+}
+
+PaginatedRules CachingRuleRepository::findPage(const std::string& afterCursor, int limit)
+{
+    return repository_->findPage(afterCursor, limit);
+}
+
+std::vector<Rule> CachingRuleRepository::findBatch(const std::string& afterShortId, int limit)
+{
+    return repository_->findBatch(afterShortId, limit);
+}
+
+std::vector<Rule> CachingRuleRepository::findByIds(const std::vector<std::string>& shortIds)
+{
+    std::vector<Rule> rules;
+    std::vector<std::string> misses;
+    std::unordered_set<std::string> seen;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (const auto& shortId : shortIds)
+        {
+            if (!seen.insert(shortId).second)
+            {
+                continue;
+            }
+
+            std::optional<Rule> cached;
+            if (!lookupLocked(shortId, cached))
+            {
+                misses.push_back(shortId);
+            }
+            else if (cached)
+            {
+                rules.push_back(std::move(*cached));
+            }
+        }
+        generation = generation_;
+    }
+
+    if (misses.empty())
+    {
+        return rules;
+    }
+
+    // Все промахи - одним запросом к исходному репозиторию
+    std::cout << "[CachingRuleRepository] Cache misses: " << misses.size()
+              << " of " << seen.size() << std::endl;
+    auto loaded = repository_->findByIds(misses);
+
+    std::unordered_map<std::string, const Rule*> byId;
+    for (const auto& rule : loaded)
+    {
+        byId.emplace(rule.shortId, &rule);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    bool cacheable = generation == generation_;
+    for (const auto& shortId : misses)
+    {
+        auto it = byId.find(shortId);
+        std::optional<Rule> rule;
+        if (it != byId.end())
+        {
+            rule = *it->second;
+            rules.push_back(*it->second);
+        }
+
+        // Отсутствующие тоже запоминаем, как в findById
+        if (cacheable && !entries_.count(shortId))
+        {
+            storeLocked(shortId, rule);
+        }
+    }
+    return rules;
+}
+
+std::optional<std::string> CachingRuleRepository::update(const std::string& shortId, const Rule& rule)
+{
+    auto updated = repository_->update(shortId, rule);
+    invalidate(shortId);
+    return updated;
+}
+
+bool CachingRuleRepository::deleteById(const std::string& shortId)
+{
+    bool deleted = repository_->deleteById(shortId);
+    invalidate(shortId);
+    return deleted;
+}
+
+std::size_t CachingRuleRepository::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void CachingRuleRepository::setCapacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    capacity_ = capacity;
+    while (entries_.size() > capacity_)
+    {
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    std::cout << "[CachingRuleRepository] Capacity set to " << capacity_ << std::endl;
+}
+
+bool CachingRuleRepository::lookupLocked(const std::string& shortId, std::optional<Rule>& rule)
+{
+    auto it = entries_.find(shortId);
+    if (it == entries_.end())
+    {
+        return false;
+    }
+
+    if (Clock::now() < it->second.expiresAt)
+    {
+        lru_.splice(lru_.begin(), lru_, it->second.lruPos);
+        rule = it->second.rule;
+        return true;
+    }
+
+    // Запись устарела
+    lru_.erase(it->second.lruPos);
+    entries_.erase(it);
+    return false;
+}
+
+void CachingRuleRepository::storeLocked(const std::string& shortId, const std::optional<Rule>& rule)
+{
+    while (!lru_.empty() && entries_.size() >= capacity_)
+    {
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+    }
+
+    lru_.push_front(shortId);
+    entries_.emplace(shortId, Entry{rule, Clock::now() + ttl_, lru_.begin()});
+}
+
+void CachingRuleRepository::invalidate(const std::string& shortId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ++generation_;
+
+    auto it = entries_.find(shortId);
+    if (it != entries_.end())
+    {
+        std::cout << "[CachingRuleRepository] Invalidating: " << shortId << std::endl;
+        lru_.erase(it->second.lruPos);
+        entries_.erase(it);
+    }
+}
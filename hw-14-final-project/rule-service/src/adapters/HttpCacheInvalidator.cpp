@@ -1,118 +1,135 @@
 #include "adapters/HttpCacheInvalidator.hpp"
 #include "SimpleRequest.hpp"
 #include "SimpleResponse.hpp"
+#include <nlohmann/json.hpp>
+#include <future>
 #include <iostream>
-#include <regex>
+#include <thread>
 
-std::pair<std::string, int> parseUrl(const std::string &url)
-{
-    std::regex urlRegex(R"(http://([^:]+):(\d+))");
-    std::smatch match;
+using json = nlohmann::json;
 
-    if (std::regex_match(url, match, urlRegex))
+HttpCacheInvalidator::HttpCacheInvalidator(std::shared_ptr<IHttpClient> httpClient,
+                                           std::shared_ptr<ICacheInvalidatorSettings> settings)
+    : httpClient_(httpClient),
+      endpoints_(settings->getRedirectServiceEndpoints()),
+      maxRetries_(settings->getMaxRetries()),
+      retryBackoff_(settings->getRetryBackoff())
+{
+    for (const auto &endpoint : endpoints_)
     {
-        std::string host = match[1].str();
-        int port = std::stoi(match[2].str());
-        return {host, port};
+        std::cout << "[HttpCacheInvalidator] Created with redirect-service URL: "
+                  << endpoint.toString() << std::endl;
     }
-
-    throw std::runtime_error("Invalid URL format: " + url);
 }
 
-HttpCacheInvalidator::HttpCacheInvalidator(std::shared_ptr<IHttpClient> httpClient,
-                                           std::shared_ptr<ICacheInvalidatorSettings> settings)
-    : httpClient_(httpClient), redirectServiceUrl_(settings->getRedirectServiceUrl())
+bool HttpCacheInvalidator::invalidate(const std::string &shortId)
 {
-    std::cout << "[HttpCacheInvalidator] Created with redirect-service URL: " 
-              << redirectServiceUrl_ << std::endl;
+    std::cout << "[HttpCacheInvalidator] Invalidating cache for: " << shortId << std::endl;
+    return broadcast("DELETE", "/cache/invalidate/" + shortId, "", {});
 }
 
-bool HttpCacheInvalidator::invalidate(const std::string& shortId)
+bool HttpCacheInvalidator::invalidateBatch(const std::vector<std::string> &shortIds)
 {
-    try
+    if (shortIds.empty())
     {
-        std::cout << "[HttpCacheInvalidator] Invalidating cache for: " << shortId << std::endl;
-
-        auto [host, port] = parseUrl(redirectServiceUrl_);
-
-        SimpleRequest request(
-            "DELETE",
-            "/cache/invalidate/" + shortId,
-            "",
-            host,
-            port,
-            {});
+        return true;
+    }
 
-        SimpleResponse response(204, "");
+    std::cout << "[HttpCacheInvalidator] Invalidating cache for " << shortIds.size()
+              << " rules" << std::endl;
 
-        if (!httpClient_->send(request, response))
-        {
-            std::cerr << "[HttpCacheInvalidator] Failed to send request" << std::endl;
-            return false;
-        }
+    json body = {{"keys", shortIds}};
+    return broadcast("POST", "/cache/invalidate", body.dump(),
+                     {{"Content-Type", "application/json"}});
+}
 
-        bool success = (response.getStatus() == 204);
-        
-        if (success)
-        {
-            std::cout << "[HttpCacheInvalidator] Cache invalidation successful" << std::endl;
-        }
-        else
-        {
-            std::cerr << "[HttpCacheInvalidator] Cache invalidation failed with status: " 
-                      << response.getStatus() << std::endl;
-        }
+bool HttpCacheInvalidator::invalidateAll()
+{
+    std::cout << "[HttpCacheInvalidator] Invalidating all cache" << std::endl;
+    return broadcast("DELETE", "/cache/invalidate", "", {});
+}
 
-        return success;
-    }
-    catch (const std::exception& e)
+bool HttpCacheInvalidator::broadcast(const std::string &method, const std::string &path,
+                                     const std::string &body,
+                                     const std::map<std::string, std::string> &headers)
+{
+    if (endpoints_.empty())
     {
-        std::cerr << "[HttpCacheInvalidator] Error: " << e.what() << std::endl;
+        std::cerr << "[HttpCacheInvalidator] No valid redirect-service URLs configured" << std::endl;
         return false;
     }
-}
 
-bool HttpCacheInvalidator::invalidateAll()
-{
-    try
+    // Одна реплика - без лишнего потока
+    if (endpoints_.size() == 1)
     {
-        std::cout << "[HttpCacheInvalidator] Invalidating all cache" << std::endl;
+        return sendWithRetry(endpoints_.front(), method, path, body, headers);
+    }
 
-        auto [host, port] = parseUrl(redirectServiceUrl_);
+    std::vector<std::future<bool>> results;
+    results.reserve(endpoints_.size());
+    for (const auto &endpoint : endpoints_)
+    {
+        results.push_back(std::async(std::launch::async, [&, endpoint] {
+            return sendWithRetry(endpoint, method, path, body, headers);
+        }));
+    }
 
-        SimpleRequest request(
-            "DELETE",
-            "/cache/invalidate",
-            "",
-            host,
-            port,
-            {});
+    bool success = true;
+    for (auto &result : results)
+    {
+        success = result.get() && success;
+    }
+    return success;
+}
 
-        SimpleResponse response(204, "");
+bool HttpCacheInvalidator::sendWithRetry(const HttpEndpoint &endpoint, const std::string &method,
+                                         const std::string &path, const std::string &body,
+                                         const std::map<std::string, std::string> &headers)
+{
+    auto backoff = retryBackoff_;
 
-        if (!httpClient_->send(request, response))
+    for (int attempt = 0; attempt <= maxRetries_; ++attempt)
+    {
+        if (attempt > 0)
         {
-            std::cerr << "[HttpCacheInvalidator] Failed to send request" << std::endl;
-            return false;
+            std::cerr << "[HttpCacheInvalidator] Retrying " << endpoint.host << ":" << endpoint.port
+                      << " in " << backoff.count() << "ms (attempt " << attempt << "/"
+                      << maxRetries_ << ")" << std::endl;
+            std::this_thread::sleep_for(backoff);
+            backoff *= 2;
         }
 
-        bool success = (response.getStatus() == 204);
-        
-        if (success)
+        try
         {
-            std::cout << "[HttpCacheInvalidator] Cache invalidation successful" << std::endl;
+            SimpleRequest request(method, path, body, endpoint.host, endpoint.port, headers);
+            SimpleResponse response(204, "");
+
+            if (!httpClient_->send(request, response))
+            {
+                std::cerr << "[HttpCacheInvalidator] Failed to send request" << std::endl;
+                continue;
+            }
+
+            if (response.getStatus() == 204)
+            {
+                std::cout << "[HttpCacheInvalidator] Cache invalidation successful" << std::endl;
+                return true;
+            }
+
+            std::cerr << "[HttpCacheInvalidator] Cache invalidation failed with status: "
+                      << response.getStatus() << std::endl;
+
+            // Ошибка клиента не исправится повтором
+            if (response.getStatus() >= 400 && response.getStatus() < 500)
+            {
+                return false;
+            }
         }
-        else
+        catch (const std::exception &e)
         {
-            std::cerr << "[HttpCacheInvalidator] Cache invalidation failed with status: " 
-                      << response.getStatus() << std::endl;
+            std::cerr << "[HttpCacheInvalidator] Error: " << e.what() << std::endl;
         }
-
-        return success;
-    }
-    catch (const std::exception& e)
-    {
-        std::cerr << "[HttpCacheInvalidator] Error: " << e.what() << std::endl;
-        return false;
     }
+
+    return false;
 }
@@ -0,0 +1,112 @@
+#include "adapters/InMemoryRuleChangeLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+/**
+ * @file InMemoryRuleChangeLog.cpp
+ * @brief Реализация журнала изменений правил в памяти
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+/**
+ * @brief Случайный идентификатор запуска: версии разных запусков несравнимы
+ */
+std::string makeEpoch()
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd() ^ static_cast<uint64_t>(
+        std::chrono::system_clock::now().time_since_epoch().count()));
+
+    std::ostringstream out;
+    out << std::hex << gen();
+    return out.str();
+}
+}
+
+InMemoryRuleChangeLog::InMemoryRuleChangeLog(std::size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1),
+      epoch_(makeEpoch())
+{
+    std::cout << "[InMemoryRuleChangeLog] Created, epoch=" << epoch_
+              << ", capacity=" << capacity_ << std::endl;
+}
+
+uint64_t InMemoryRuleChangeLog::append(RuleChange::Type type, const Rule& rule)
+{
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        version = ++version_;
+        changes_.push_back(RuleChange{version, type, rule});
+        if (changes_.size() > capacity_)
+        {
+            changes_.pop_front();
+        }
+    }
+    appended_.notify_all();
+
+    std::cout << "[InMemoryRuleChangeLog] Version " << version << ": "
+              << (type == RuleChange::Type::Upsert ? "upsert " : "delete ")
+              << rule.shortId << std::endl;
+    return version;
+}
+
+RuleChangeBatch InMemoryRuleChangeLog::since(const std::string& epoch, uint64_t sinceVersion,
+                                             std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    RuleChangeBatch batch{epoch_, version_, false, {}};
+
+    // Другой запуск журнала или версия из будущего - историю не восстановить
+    if (epoch != epoch_ || sinceVersion > version_)
+    {
+        batch.reset = true;
+        return batch;
+    }
+
+    // Нужные изменения уже вытеснены из журнала
+    uint64_t oldest = changes_.empty() ? version_ + 1 : changes_.front().version;
+    if (sinceVersion + 1 < oldest && sinceVersion < version_)
+    {
+        batch.reset = true;
+        return batch;
+    }
+
+    // Новых изменений нет - ждём, пока сервис не начал остановку
+    if (sinceVersion == version_)
+    {
+        appended_.wait_for(lock, timeout, [this, sinceVersion] {
+            return version_ > sinceVersion || closed_;
+        });
+    }
+
+    for (auto it = changes_.rbegin(); it != changes_.rend() && it->version > sinceVersion; ++it)
+    {
+        batch.changes.push_back(*it);
+    }
+    std::reverse(batch.changes.begin(), batch.changes.end());
+    batch.version = version_;
+    return batch;
+}
+
+void InMemoryRuleChangeLog::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    appended_.notify_all();
+    std::cout << "[InMemoryRuleChangeLog] Shut down, waiting subscribers released" << std::endl;
+}
+
+const std::string& InMemoryRuleChangeLog::epoch() const
+{
+    return epoch_;
+}
@@ -1,5 +1,8 @@
 #include "adapters/InMemoryRuleRepository.hpp"
 #include <iostream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
 
 /**
  * @file InMemoryRuleRepository.cpp
@@ -8,7 +11,6 @@
  */
 
 InMemoryRuleRepository::InMemoryRuleRepository()
-    : totalCount_(0)
 {
     std::cout << "[InMemoryRuleRepository] Created" << std::endl;
     
@@ -51,7 +53,7 @@ InMemoryRuleRepository::InMemoryRuleRepository()
     Rule rule13{"premium_app", "https://premium.example.com", "header.User-Agent == \"PremiumApp\""};
     create(rule13);
 
-    std::cout << "[InMemoryRuleRepository] Initialized with " << totalCount_ << " test rules" << std::endl;
+    std::cout << "[InMemoryRuleRepository] Initialized with " << rulesBySeq_.size() << " test rules" << std::endl;
 }
 
 InMemoryRuleRepository::~InMemoryRuleRepository()
@@ -59,114 +61,171 @@ InMemoryRuleRepository::~InMemoryRuleRepository()
     std::cout << "[InMemoryRuleRepository] Destroyed" << std::endl;
 }
 
-bool InMemoryRuleRepository::create(const Rule& rule)
+std::optional<std::string> InMemoryRuleRepository::create(const Rule& rule)
 {
     std::cout << "[InMemoryRuleRepository] Creating rule: " << rule.shortId << std::endl;
-    
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
     // Проверяем, не существует ли уже
-    if (rules_.contains(rule.shortId))
+    if (seqByShortId_.count(rule.shortId))
     {
         std::cout << "[InMemoryRuleRepository] Rule already exists: " << rule.shortId << std::endl;
-        return false;
+        return std::nullopt;
     }
-    
-    // Создаём shared_ptr для хранения в ThreadSafeMap
-    auto rulePtr = std::make_shared<Rule>(rule);
-    rules_.insert(rule.shortId, rulePtr);
-    totalCount_++;
-    
+
+    uint64_t seq = nextSeq_++;
+    auto& stored = rulesBySeq_.emplace(seq, rule).first->second;
+    stored.version = std::to_string(nextVersion_++);
+    seqByShortId_.emplace(rule.shortId, seq);
+
     std::cout << "[InMemoryRuleRepository] Rule created successfully" << std::endl;
-    return true;
+    return stored.version;
 }
 
 std::optional<Rule> InMemoryRuleRepository::findById(const std::string& shortId)
 {
     std::cout << "[InMemoryRuleRepository] Finding rule: " << shortId << std::endl;
-    
-    auto rulePtr = rules_.find(shortId);
-    if (!rulePtr)
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    auto it = seqByShortId_.find(shortId);
+    if (it == seqByShortId_.end())
     {
         std::cout << "[InMemoryRuleRepository] Rule not found: " << shortId << std::endl;
         return std::nullopt;
     }
-    
-    std::cout << "[InMemoryRuleRepository] Rule found: " << rulePtr->targetUrl << std::endl;
-    return *rulePtr;  // Разыменовываем shared_ptr в Rule
+
+    const Rule& rule = rulesBySeq_.at(it->second);
+    std::cout << "[InMemoryRuleRepository] Rule found: " << rule.targetUrl << std::endl;
+    return rule;
 }
 
-PaginatedRules InMemoryRuleRepository::findAll(int page, int pageSize)
+PaginatedRules InMemoryRuleRepository::findPage(const std::string& afterCursor, int limit)
 {
-    std::cout << "[InMemoryRuleRepository] Listing all rules: page=" << page 
-              << ", pageSize=" << pageSize << std::endl;
-    
-    // Получаем все правила из ThreadSafeMap
-    auto allRulesPtr = rules_.getAll();
-    
-    // Разыменовываем shared_ptr в вектор Rule
-    std::vector<Rule> allRules;
-    allRules.reserve(allRulesPtr.size());
-    for (const auto& rulePtr : allRulesPtr)
+    std::cout << "[InMemoryRuleRepository] Listing rules after cursor '" << afterCursor
+              << "', limit=" << limit << std::endl;
+
+    // Курсор - порядковый номер последнего правила предыдущей страницы
+    uint64_t afterSeq = 0;
+    if (!afterCursor.empty())
     {
-        allRules.push_back(*rulePtr);
+        if (afterCursor.find_first_not_of("0123456789") != std::string::npos ||
+            afterCursor.size() > 19)
+        {
+            throw std::invalid_argument("Invalid cursor: " + afterCursor);
+        }
+        afterSeq = std::stoull(afterCursor);
     }
-    
-    // Вычисляем пагинацию
-    int totalCount = static_cast<int>(allRules.size());
-    int startIndex = (page - 1) * pageSize;
-    int endIndex = std::min(startIndex + pageSize, totalCount);
-    
-    // Извлекаем нужный диапазон
-    std::vector<Rule> pageRules;
-    if (startIndex < totalCount)
+
+    PaginatedRules result;
+    result.pageSize = limit;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // Первое правило строго старше курсора (порядок убывающий)
+    auto it = afterCursor.empty() ? rulesBySeq_.begin() : rulesBySeq_.upper_bound(afterSeq);
+    for (; it != rulesBySeq_.end() && static_cast<int>(result.rules.size()) < limit; ++it)
     {
-        pageRules.assign(allRules.begin() + startIndex, allRules.begin() + endIndex);
+        result.rules.push_back(it->second);
     }
-    
-    PaginatedRules result;
-    result.rules = pageRules;
-    result.page = page;
-    result.pageSize = pageSize;
-    result.totalCount = totalCount;
-    
-    std::cout << "[InMemoryRuleRepository] Returning " << pageRules.size() 
-              << " rules (total: " << totalCount << ")" << std::endl;
-    
+
+    // Курсор выдаём только если за страницей есть ещё правила
+    if (it != rulesBySeq_.end() && !result.rules.empty())
+    {
+        result.nextCursor = std::to_string(std::prev(it)->first);
+    }
+    result.totalCount = static_cast<long long>(rulesBySeq_.size());
+
+    std::cout << "[InMemoryRuleRepository] Returning " << result.rules.size()
+              << " rules (total: " << rulesBySeq_.size() << ")" << std::endl;
+
     return result;
 }
 
-bool InMemoryRuleRepository::update(const std::string& shortId, const Rule& rule)
+std::vector<Rule> InMemoryRuleRepository::findBatch(const std::string& afterShortId, int limit)
+{
+    std::cout << "[InMemoryRuleRepository] Fetching batch after '" << afterShortId
+              << "', limit=" << limit << std::endl;
+
+    std::vector<Rule> batch;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    // Индекс упорядочен по shortId - порция начинается сразу после курсора
+    for (auto it = seqByShortId_.upper_bound(afterShortId);
+         it != seqByShortId_.end() && static_cast<int>(batch.size()) < limit; ++it)
+    {
+        batch.push_back(rulesBySeq_.at(it->second));
+    }
+
+    std::cout << "[InMemoryRuleRepository] Returning batch of " << batch.size() << " rules" << std::endl;
+    return batch;
+}
+
+std::vector<Rule> InMemoryRuleRepository::findByIds(const std::vector<std::string>& shortIds)
+{
+    std::cout << "[InMemoryRuleRepository] Finding " << shortIds.size() << " rules by id" << std::endl;
+
+    std::vector<Rule> rules;
+    std::set<std::string> seen;
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    for (const auto& shortId : shortIds)
+    {
+        auto it = seqByShortId_.find(shortId);
+        if (it != seqByShortId_.end() && seen.insert(shortId).second)
+        {
+            rules.push_back(rulesBySeq_.at(it->second));
+        }
+    }
+
+    std::cout << "[InMemoryRuleRepository] Found " << rules.size() << " rules" << std::endl;
+    return rules;
+}
+
+std::optional<std::string> InMemoryRuleRepository::update(const std::string& shortId, const Rule& rule)
 {
     std::cout << "[InMemoryRuleRepository] Updating rule: " << shortId << std::endl;
-    
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
     // Проверяем существование
-    if (!rules_.contains(shortId))
+    auto it = seqByShortId_.find(shortId);
+    if (it == seqByShortId_.end())
     {
         std::cout << "[InMemoryRuleRepository] Rule not found for update: " << shortId << std::endl;
-        return false;
+        return std::nullopt;
     }
-    
-    // Обновляем (перезаписываем)
-    auto rulePtr = std::make_shared<Rule>(rule);
-    rules_.insert(shortId, rulePtr);
-    
+
+    // Обновляем на месте: позиция в списке (как created_at) не меняется
+    Rule& stored = rulesBySeq_.at(it->second);
+    stored.targetUrl = rule.targetUrl;
+    stored.condition = rule.condition;
+    stored.version = std::to_string(nextVersion_++);
+
     std::cout << "[InMemoryRuleRepository] Rule updated successfully" << std::endl;
-    return true;
+    return stored.version;
 }
 
 bool InMemoryRuleRepository::deleteById(const std::string& shortId)
 {
     std::cout << "[InMemoryRuleRepository] Deleting rule: " << shortId << std::endl;
-    
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
     // Проверяем существование
-    if (!rules_.contains(shortId))
+    auto it = seqByShortId_.find(shortId);
+    if (it == seqByShortId_.end())
     {
         std::cout << "[InMemoryRuleRepository] Rule not found for delete: " << shortId << std::endl;
         return false;
     }
 
-    rules_.remove(shortId);
-    totalCount_--;
-    
+    rulesBySeq_.erase(it->second);
+    seqByShortId_.erase(it);
+
     std::cout << "[InMemoryRuleRepository] Rule deleted successfully: " << shortId << std::endl;
     return true;
 }
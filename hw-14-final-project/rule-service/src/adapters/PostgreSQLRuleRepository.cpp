@@ -19,20 +19,48 @@ PostgreSQLRuleRepository::PostgreSQLRuleRepository(std::shared_ptr<IDbSettings>
         " user=" + dbSettings->getUser() +
         " password=" + dbSettings->getPassword();
 
-    try
+    auto factory = [connectionString]()
+    {
+        auto connection = std::make_unique<pqxx::connection>(connectionString);
+        if (!connection->is_open())
+        {
+            throw std::runtime_error("Failed to open database connection");
+        }
+        prepareStatements(*connection);
+
+        std::cout << "[PostgreSQLRuleRepository] Connected to: "
+                  << connection->dbname() << std::endl;
+        return connection;
+    };
+
+    // is_open() не замечает соединение, разорванное сервером или сетью, пока
+    // по нему не попробуют что-то отправить, - поэтому проверяем запросом
+    auto healthCheck = [](pqxx::connection &connection)
     {
-        std::cout << "[PostgreSQLRuleRepository] Connecting to database..." << std::endl;
-        connection_ = std::make_unique<pqxx::connection>(connectionString);
+        if (!connection.is_open())
+        {
+            return false;
+        }
 
-        if (connection_->is_open())
+        try
         {
-            std::cout << "[PostgreSQLRuleRepository] Connected to: "
-                      << connection_->dbname() << std::endl;
+            pqxx::nontransaction txn(connection);
+            txn.exec("SELECT 1");
+            return true;
         }
-        else
+        catch (const std::exception &e)
         {
-            throw std::runtime_error("Failed to open database connection");
+            std::cerr << "[PostgreSQLRuleRepository] Health check failed: " << e.what() << std::endl;
+            return false;
         }
+    };
+
+    try
+    {
+        std::cout << "[PostgreSQLRuleRepository] Connecting to database, pool size="
+                  << dbSettings->getPoolSize() << "..." << std::endl;
+        pool_ = std::make_unique<Pool>(dbSettings->getPoolSize(), factory, healthCheck,
+                                       std::chrono::seconds(5), dbSettings->getPoolValidationInterval());
     }
     catch (const std::exception &e)
     {
@@ -43,169 +71,297 @@ PostgreSQLRuleRepository::PostgreSQLRuleRepository(std::shared_ptr<IDbSettings>
 
 PostgreSQLRuleRepository::~PostgreSQLRuleRepository()
 {
-    if (connection_ && connection_->is_open())
+    // Соединения закрываются деструкторами pqxx::connection
+    pool_.reset();
+    std::cout << "[PostgreSQLRuleRepository] Database connections closed" << std::endl;
+}
+
+void PostgreSQLRuleRepository::prepareStatements(pqxx::connection &connection)
+{
+    connection.prepare("rule_insert",
+        "INSERT INTO rules (short_id, target_url, condition) "
+        "VALUES ($1, $2, $3) RETURNING updated_at");
+
+    connection.prepare("rule_find",
+        "SELECT short_id, target_url, condition, created_at, updated_at "
+        "FROM rules WHERE short_id = $1");
+
+    // Keyset-пагинация по индексу (created_at DESC, id DESC): без OFFSET.
+    // created_at объявлен NOT NULL (init.sql): строка с NULL не попала бы
+    // ни на одну страницу, а курсор по ней не из чего было бы собрать
+    connection.prepare("rule_page_first",
+        "SELECT id, short_id, target_url, condition, created_at, updated_at, "
+        "EXTRACT(EPOCH FROM date_trunc('second', created_at))::BIGINT * 1000000 "
+        "+ EXTRACT(MICROSECONDS FROM created_at)::BIGINT % 1000000 AS created_us "
+        "FROM rules ORDER BY created_at DESC, id DESC LIMIT $1");
+
+    connection.prepare("rule_page_after",
+        "SELECT id, short_id, target_url, condition, created_at, updated_at, "
+        "EXTRACT(EPOCH FROM date_trunc('second', created_at))::BIGINT * 1000000 "
+        "+ EXTRACT(MICROSECONDS FROM created_at)::BIGINT % 1000000 AS created_us "
+        "FROM rules WHERE (created_at, id) < "
+        "(TIMESTAMP 'epoch' + $1::FLOAT8 * INTERVAL '1 microsecond', $2::INTEGER) "
+        "ORDER BY created_at DESC, id DESC LIMIT $3");
+
+    // Оценка количества строк из статистики планировщика вместо COUNT(*)
+    connection.prepare("rule_count_estimate",
+        "SELECT reltuples::BIGINT FROM pg_class WHERE oid = 'rules'::regclass");
+
+    // Keyset-пагинация по уникальному индексу short_id: без OFFSET и COUNT(*)
+    connection.prepare("rule_batch",
+        "SELECT short_id, target_url, condition, created_at, updated_at "
+        "FROM rules WHERE short_id > $1 ORDER BY short_id LIMIT $2");
+
+    // Несколько правил одним запросом по уникальному индексу short_id
+    connection.prepare("rule_find_many",
+        "SELECT short_id, target_url, condition, created_at, updated_at "
+        "FROM rules WHERE short_id = ANY($1::TEXT[])");
+
+    connection.prepare("rule_update",
+        "UPDATE rules SET target_url = $1, condition = $2, updated_at = CURRENT_TIMESTAMP "
+        "WHERE short_id = $3 RETURNING updated_at");
+
+    connection.prepare("rule_delete",
+        "DELETE FROM rules WHERE short_id = $1");
+}
+
+template <typename Func>
+auto PostgreSQLRuleRepository::withConnection(Func &&func)
+{
+    auto connection = pool_->acquire();
+    try
+    {
+        return func(*connection);
+    }
+    catch (const pqxx::broken_connection &)
     {
-        connection_->close();
-        std::cout << "[PostgreSQLRuleRepository] Database connection closed" << std::endl;
+        // Связь потеряна: соединение не вернётся в пул, следующий запрос получит новое
+        std::cerr << "[PostgreSQLRuleRepository] Connection lost, dropping it from pool" << std::endl;
+        connection.invalidate();
+        throw;
     }
 }
 
-bool PostgreSQLRuleRepository::create(const Rule &rule)
+std::optional<std::string> PostgreSQLRuleRepository::create(const Rule &rule)
 {
     try
     {
         std::cout << "[PostgreSQLRuleRepository] Creating rule: " << rule.shortId << std::endl;
 
-        pqxx::work txn(*connection_);
-
-        // Подготовленный запрос для вставки
-        std::string query =
-            "INSERT INTO rules (short_id, target_url, condition) "
-            "VALUES ($1, $2, $3)";
-
-        txn.exec_params(query, rule.shortId, rule.targetUrl, rule.condition);
-        txn.commit();
+        // Версию назначает БД: updated_at из RETURNING, без повторного чтения
+        pqxx::result result = withConnection([&](pqxx::connection &connection)
+        {
+            pqxx::work txn(connection);
+            auto inserted = txn.exec_prepared("rule_insert", rule.shortId, rule.targetUrl, rule.condition);
+            txn.commit();
+            return inserted;
+        });
 
         std::cout << "[PostgreSQLRuleRepository] Rule created successfully" << std::endl;
-        return true;
+        return versionOf(result[0]["updated_at"].as<std::string>());
     }
     catch (const pqxx::unique_violation &e)
     {
         std::cerr << "[PostgreSQLRuleRepository] Rule already exists: " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
     }
     catch (const std::exception &e)
     {
         std::cerr << "[PostgreSQLRuleRepository] Create error: " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
     }
 }
 
 std::optional<Rule> PostgreSQLRuleRepository::findById(const std::string &shortId)
 {
-    try
+    std::cout << "[PostgreSQLRuleRepository] Finding rule: " << shortId << std::endl;
+
+    // Ошибки БД и пула пробрасываются: кэш не должен принять их за отсутствие правила
+    pqxx::result result = withConnection([&](pqxx::connection &connection)
     {
-        std::cout << "[PostgreSQLRuleRepository] Finding rule: " << shortId << std::endl;
+        pqxx::read_transaction txn(connection);
+        return txn.exec_prepared("rule_find", shortId);
+    });
 
-        pqxx::work txn(*connection_);
+    if (result.empty())
+    {
+        std::cout << "[PostgreSQLRuleRepository] Rule not found" << std::endl;
+        return std::nullopt;
+    }
 
-        std::string query =
-            "SELECT short_id, target_url, condition, created_at, updated_at "
-            "FROM rules WHERE short_id = $1";
+    // Извлекаем данные из первой строки
+    auto row = result[0];
 
-        pqxx::result result = txn.exec_params(query, shortId);
+    RuleEntity entity{
+        row["short_id"].as<std::string>(),
+        row["target_url"].as<std::string>(),
+        row["condition"].as<std::string>(),
+        row["created_at"].as<std::string>(),
+        row["updated_at"].as<std::string>()};
 
-        if (result.empty())
+    std::cout << "[PostgreSQLRuleRepository] Rule found" << std::endl;
+    return entityToRule(entity);
+}
+
+PaginatedRules PostgreSQLRuleRepository::findPage(const std::string &afterCursor, int limit)
+{
+    std::cout << "[PostgreSQLRuleRepository] Finding rules after cursor '"
+              << afterCursor << "', size=" << limit << std::endl;
+
+    // Курсор "<created_at в микросекундах от эпохи>.<id>" последней строки страницы
+    long long afterMicros = 0;
+    long long afterId = 0;
+    if (!afterCursor.empty())
+    {
+        auto dot = afterCursor.find('.');
+        std::string micros = afterCursor.substr(0, dot);
+        std::string id = dot == std::string::npos ? "" : afterCursor.substr(dot + 1);
+        auto isNumber = [](const std::string &s)
         {
-            std::cout << "[PostgreSQLRuleRepository] Rule not found" << std::endl;
-            return std::nullopt;
+            return !s.empty() && s.size() <= 18 &&
+                   s.find_first_not_of("0123456789") == std::string::npos;
+        };
+        if (!isNumber(micros) || !isNumber(id))
+        {
+            throw std::invalid_argument("Invalid cursor: " + afterCursor);
         }
+        afterMicros = std::stoll(micros);
+        afterId = std::stoll(id);
+    }
 
-        // Извлекаем данные из первой строки
-        auto row = result[0];
-
+    // Берём на одну строку больше, чтобы понять, есть ли следующая страница
+    pqxx::result result;
+    pqxx::result estimate;
+    withConnection([&](pqxx::connection &connection)
+    {
+        pqxx::read_transaction txn(connection);
+        result = afterCursor.empty()
+            ? txn.exec_prepared("rule_page_first", limit + 1)
+            : txn.exec_prepared("rule_page_after", afterMicros, afterId, limit + 1);
+        estimate = txn.exec_prepared("rule_count_estimate");
+    });
+
+    PaginatedRules page;
+    page.pageSize = limit;
+
+    int rowCount = static_cast<int>(result.size());
+    for (int i = 0; i < rowCount && i < limit; ++i)
+    {
+        const auto &row = result[i];
         RuleEntity entity{
             row["short_id"].as<std::string>(),
             row["target_url"].as<std::string>(),
             row["condition"].as<std::string>(),
             row["created_at"].as<std::string>(),
             row["updated_at"].as<std::string>()};
+        page.rules.push_back(entityToRule(entity));
 
-        std::cout << "[PostgreSQLRuleRepository] Rule found" << std::endl;
-        return entityToRule(entity);
+        // Лишняя строка есть - значит, страница не последняя
+        if (i == limit - 1 && rowCount > limit)
+        {
+            page.nextCursor = row["created_us"].as<std::string>() + "." +
+                              row["id"].as<std::string>();
+        }
     }
-    catch (const std::exception &e)
+
+    // reltuples = -1, пока таблица ни разу не анализировалась
+    if (!estimate.empty() && estimate[0][0].as<long long>() >= 0)
     {
-        std::cerr << "[PostgreSQLRuleRepository] Find error: " << e.what() << std::endl;
-        return std::nullopt;
+        page.totalCount = estimate[0][0].as<long long>();
     }
+
+    std::cout << "[PostgreSQLRuleRepository] Found " << page.rules.size() << " rules" << std::endl;
+    return page;
 }
 
-PaginatedRules PostgreSQLRuleRepository::findAll(int page, int pageSize)
+std::vector<Rule> PostgreSQLRuleRepository::findBatch(const std::string &afterShortId, int limit)
 {
-    try
-    {
-        std::cout << "[PostgreSQLRuleRepository] Finding all rules, page="
-                  << page << ", size=" << pageSize << std::endl;
+    std::cout << "[PostgreSQLRuleRepository] Fetching batch after '" << afterShortId
+              << "', limit=" << limit << std::endl;
 
-        pqxx::work txn(*connection_);
-
-        // Вычисляем OFFSET
-        int offset = (page - 1) * pageSize;
+    pqxx::result result = withConnection([&](pqxx::connection &connection)
+    {
+        pqxx::read_transaction txn(connection);
+        return txn.exec_prepared("rule_batch", afterShortId, limit);
+    });
 
-        // Запрос с пагинацией
-        std::string query =
-            "SELECT short_id, target_url, condition, created_at, updated_at "
-            "FROM rules ORDER BY created_at DESC LIMIT $1 OFFSET $2";
+    std::vector<Rule> rules;
+    rules.reserve(result.size());
+    for (const auto &row : result)
+    {
+        RuleEntity entity{
+            row["short_id"].as<std::string>(),
+            row["target_url"].as<std::string>(),
+            row["condition"].as<std::string>(),
+            row["created_at"].as<std::string>(),
+            row["updated_at"].as<std::string>()};
+        rules.push_back(entityToRule(entity));
+    }
 
-        pqxx::result result = txn.exec_params(query, pageSize, offset);
+    std::cout << "[PostgreSQLRuleRepository] Fetched " << rules.size() << " rules" << std::endl;
+    return rules;
+}
 
-        // Получаем общее количество
-        std::string countQuery = "SELECT COUNT(*) FROM rules";
-        pqxx::result countResult = txn.exec(countQuery);
-        int totalCount = countResult[0][0].as<int>();
+std::vector<Rule> PostgreSQLRuleRepository::findByIds(const std::vector<std::string> &shortIds)
+{
+    std::cout << "[PostgreSQLRuleRepository] Finding " << shortIds.size() << " rules by id" << std::endl;
 
-        // Конвертируем результаты
-        std::vector<Rule> rules;
-        for (const auto &row : result)
-        {
-            RuleEntity entity{
-                row["short_id"].as<std::string>(),
-                row["target_url"].as<std::string>(),
-                row["condition"].as<std::string>(),
-                row["created_at"].as<std::string>(),
-                row["updated_at"].as<std::string>()};
-            rules.push_back(entityToRule(entity));
-        }
+    if (shortIds.empty())
+    {
+        return {};
+    }
 
-        std::cout << "[PostgreSQLRuleRepository] Found " << rules.size() << " rules" << std::endl;
+    pqxx::result result = withConnection([&](pqxx::connection &connection)
+    {
+        pqxx::read_transaction txn(connection);
+        return txn.exec_prepared("rule_find_many", shortIds);
+    });
 
-        return PaginatedRules{
-            rules,
-            totalCount,
-            page,
-            pageSize};
-    }
-    catch (const std::exception &e)
+    std::vector<Rule> rules;
+    rules.reserve(result.size());
+    for (const auto &row : result)
     {
-        std::cerr << "[PostgreSQLRuleRepository] FindAll error: " << e.what() << std::endl;
-        return PaginatedRules{{}, 0, page, pageSize};
+        RuleEntity entity{
+            row["short_id"].as<std::string>(),
+            row["target_url"].as<std::string>(),
+            row["condition"].as<std::string>(),
+            row["created_at"].as<std::string>(),
+            row["updated_at"].as<std::string>()};
+        rules.push_back(entityToRule(entity));
     }
+
+    std::cout << "[PostgreSQLRuleRepository] Found " << rules.size() << " rules" << std::endl;
+    return rules;
 }
 
-bool PostgreSQLRuleRepository::update(const std::string &shortId, const Rule &rule)
+std::optional<std::string> PostgreSQLRuleRepository::update(const std::string &shortId, const Rule &rule)
 {
     try
     {
         std::cout << "[PostgreSQLRuleRepository] Updating rule: " << shortId << std::endl;
 
-        pqxx::work txn(*connection_);
-
-        std::string query =
-            "UPDATE rules SET target_url = $1, condition = $2, updated_at = CURRENT_TIMESTAMP "
-            "WHERE short_id = $3";
-
-        pqxx::result result = txn.exec_params(query, rule.targetUrl, rule.condition, shortId);
-        txn.commit();
+        pqxx::result result = withConnection([&](pqxx::connection &connection)
+        {
+            pqxx::work txn(connection);
+            auto updated = txn.exec_prepared("rule_update", rule.targetUrl, rule.condition, shortId);
+            txn.commit();
+            return updated;
+        });
 
         // Проверяем, была ли обновлена хотя бы одна строка
-        bool updated = result.affected_rows() > 0;
-
-        if (updated)
-        {
-            std::cout << "[PostgreSQLRuleRepository] Rule updated successfully" << std::endl;
-        }
-        else
+        if (result.empty())
         {
             std::cout << "[PostgreSQLRuleRepository] Rule not found for update" << std::endl;
+            return std::nullopt;
         }
 
-        return updated;
+        std::cout << "[PostgreSQLRuleRepository] Rule updated successfully" << std::endl;
+        return versionOf(result[0]["updated_at"].as<std::string>());
     }
     catch (const std::exception &e)
     {
         std::cerr << "[PostgreSQLRuleRepository] Update error: " << e.what() << std::endl;
-        return false;
+        return std::nullopt;
     }
 }
 
@@ -215,12 +371,13 @@ bool PostgreSQLRuleRepository::deleteById(const std::string &shortId)
     {
         std::cout << "[PostgreSQLRuleRepository] Deleting rule: " << shortId << std::endl;
 
-        pqxx::work txn(*connection_);
-
-        std::string query = "DELETE FROM rules WHERE short_id = $1";
-
-        pqxx::result result = txn.exec_params(query, shortId);
-        txn.commit();
+        pqxx::result result = withConnection([&](pqxx::connection &connection)
+        {
+            pqxx::work txn(connection);
+            auto deleted = txn.exec_prepared("rule_delete", shortId);
+            txn.commit();
+            return deleted;
+        });
 
         // Проверяем, была ли удалена хотя бы одна строка
         bool deleted = result.affected_rows() > 0;
@@ -243,13 +400,34 @@ bool PostgreSQLRuleRepository::deleteById(const std::string &shortId)
     }
 }
 
+void PostgreSQLRuleRepository::resizePool(std::size_t size)
+{
+    pool_->resize(size);
+    std::cout << "[PostgreSQLRuleRepository] Connection pool resized to " << size << std::endl;
+}
+
+std::string PostgreSQLRuleRepository::versionOf(const std::string &updatedAt)
+{
+    // Цифры updated_at ("2025-01-01 12:00:00.123456" -> "20250101120000123456"), годится для ETag
+    std::string version;
+    for (char ch : updatedAt)
+    {
+        if (ch >= '0' && ch <= '9')
+        {
+            version += ch;
+        }
+    }
+    return version;
+}
+
 Rule PostgreSQLRuleRepository::entityToRule(const RuleEntity &entity) const
 {
-    // Конвертируем RuleEntity (с timestamps) в Rule (без timestamps)
+    // Конвертируем RuleEntity (с timestamps) в Rule; версия - из updated_at
     return Rule{
         entity.shortId,
         entity.targetUrl,
-        entity.condition};
+        entity.condition,
+        versionOf(entity.updatedAt)};
 }
 
 RuleEntity PostgreSQLRuleRepository::ruleToEntity(const Rule &rule) const
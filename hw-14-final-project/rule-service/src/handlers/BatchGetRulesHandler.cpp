@@ -0,0 +1,110 @@
+#include "handlers/BatchGetRulesHandler.hpp"
+#include "WireFormat.hpp"
+#include <nlohmann/json.hpp>
+#include <iostream>
+
+using json = nlohmann::json;
+
+/**
+ * @file BatchGetRulesHandler.cpp
+ * @brief Реализация обработчика получения нескольких правил
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    constexpr size_t MAX_BATCH_SIZE = 100;
+}
+
+BatchGetRulesHandler::BatchGetRulesHandler(std::shared_ptr<IRuleService> ruleService)
+    : ruleService_(ruleService)
+{
+    std::cout << "[BatchGetRulesHandler] Handler created" << std::endl;
+}
+
+void BatchGetRulesHandler::handle(IRequest& req, IResponse& res)
+{
+    std::cout << "[BatchGetRulesHandler] Processing POST /rules:batchGet" << std::endl;
+
+    try
+    {
+        json body = WireFormat::decode(req.getBody(),
+                                       WireFormat::fromContentType(req.getHeader("Content-Type")));
+
+        if (!body.contains("shortIds") || !body["shortIds"].is_array())
+        {
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Missing required field: shortIds"})");
+            return;
+        }
+
+        auto shortIds = body["shortIds"].get<std::vector<std::string>>();
+        if (shortIds.size() > MAX_BATCH_SIZE)
+        {
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Too many shortIds"})");
+            return;
+        }
+
+        std::map<std::string, std::string> knownVersions;
+        if (body.contains("ifNoneMatch") && body["ifNoneMatch"].is_object())
+        {
+            knownVersions = body["ifNoneMatch"].get<std::map<std::string, std::string>>();
+        }
+
+        auto rules = ruleService_->findByIds(shortIds);
+
+        json found = json::array();
+        json notModified = json::array();
+        for (const auto& rule : rules)
+        {
+            auto known = knownVersions.find(rule.shortId);
+            if (!rule.version.empty() && known != knownVersions.end() && known->second == rule.version)
+            {
+                notModified.push_back(rule.shortId);
+                continue;
+            }
+
+            json item = {
+                {"shortId", rule.shortId},
+                {"targetUrl", rule.targetUrl},
+                {"condition", rule.condition}
+            };
+            if (!rule.version.empty())
+            {
+                item["version"] = rule.version;
+            }
+            found.push_back(std::move(item));
+        }
+
+        json response = {
+            {"rules", found},
+            {"notModified", notModified}
+        };
+
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
+
+        res.setStatus(200);
+        res.setHeader("Content-Type", WireFormat::contentType(format));
+        res.setBody(WireFormat::encode(response, format));
+
+        std::cout << "[BatchGetRulesHandler] Requested " << shortIds.size() << ", returned "
+                  << found.size() << ", not modified " << notModified.size() << std::endl;
+    }
+    catch (const json::exception& e)
+    {
+        std::cerr << "[BatchGetRulesHandler] JSON error: " << e.what() << std::endl;
+        res.setStatus(400);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Invalid JSON"})");
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[BatchGetRulesHandler] Error: " << e.what() << std::endl;
+        res.setStatus(500);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Internal server error"})");
+    }
+}
@@ -1,4 +1,5 @@
 #include "handlers/CreateRuleHandler.hpp"
+#include "PrerenderedResponse.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -37,6 +38,15 @@ void CreateRuleHandler::handle(IRequest& req, IResponse& res)
             return;
         }
         
+        // targetUrl уходит в заголовок Location готового ответа как есть
+        if (!PrerenderedResponse::isSafeHeaderValue(body["targetUrl"].get<std::string>()))
+        {
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Invalid targetUrl: control characters are not allowed"})");
+            return;
+        }
+
         // Создаем объект Rule
         Rule rule{
             body["shortId"].get<std::string>(),
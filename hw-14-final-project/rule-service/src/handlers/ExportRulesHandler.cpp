@@ -0,0 +1,150 @@
+#include "handlers/ExportRulesHandler.hpp"
+#include "WireFormat.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+using json = nlohmann::json;
+
+/**
+ * @file ExportRulesHandler.cpp
+ * @brief Реализация обработчика потоковой выгрузки правил
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    constexpr int DEFAULT_BATCH_SIZE = 500;
+    constexpr int MAX_BATCH_SIZE = 5000;
+
+    /**
+     * @brief Разобрать положительное целое параметра запроса
+     * @return false, если значение не число целиком или не больше нуля
+     */
+    bool parsePositive(const std::string& value, long long& result)
+    {
+        char* end = nullptr;
+        errno = 0;
+        result = std::strtoll(value.c_str(), &end, 10);
+        return !value.empty() && *end == '\0' && errno == 0 && result > 0;
+    }
+}
+
+ExportRulesHandler::ExportRulesHandler(std::shared_ptr<IRuleService> ruleService)
+    : ruleService_(ruleService)
+{
+    std::cout << "[ExportRulesHandler] Handler created" << std::endl;
+}
+
+void ExportRulesHandler::handle(IRequest& req, IResponse& res)
+{
+    std::cout << "[ExportRulesHandler] Processing GET /rules/export" << std::endl;
+
+    try
+    {
+        auto params = req.getParams();
+
+        long long requested = DEFAULT_BATCH_SIZE;
+        if (params.count("batch") && !parsePositive(params.at("batch"), requested))
+        {
+            requested = 0;
+        }
+
+        if (requested < 1 || requested > MAX_BATCH_SIZE)
+        {
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Invalid batch size"})");
+            return;
+        }
+        int batchSize = static_cast<int>(requested);
+
+        // Страница выгрузки: правила после after, не больше limit (0 - все)
+        std::string after = params.count("after") ? params.at("after") : "";
+        long long limit = 0;
+        if (params.count("limit"))
+        {
+            if (!parsePositive(params.at("limit"), limit))
+            {
+                res.setStatus(400);
+                res.setHeader("Content-Type", "application/json");
+                res.setBody(R"({"error": "Invalid limit"})");
+                return;
+            }
+        }
+
+        // NDJSON или записи MessagePack с varint-длиной
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
+
+        res.setStatus(200);
+        res.setHeader("Content-Type", WireFormat::streamContentType(format));
+
+        auto ruleService = ruleService_;
+        // Генератор выполняется уже после отправки 200 и заголовков, поэтому
+        // ошибка в нём не превращается в 500: исключение уходит в сетевой
+        // адаптер, и тот обрывает поток без завершающего chunk
+        res.setChunkedBody([ruleService, batchSize, format, after, limit](const IResponse::ChunkWriter& write) {
+            std::string cursor = after;
+            long long exported = 0;
+
+            while (limit == 0 || exported < limit)
+            {
+                int size = limit == 0 ? batchSize
+                                      : static_cast<int>(std::min<long long>(batchSize, limit - exported));
+                std::vector<Rule> batch;
+                try
+                {
+                    batch = ruleService->findBatch(cursor, size);
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[ExportRulesHandler] Export aborted after "
+                              << exported << " rules: " << e.what() << std::endl;
+                    throw;
+                }
+                if (batch.empty())
+                {
+                    break;
+                }
+
+                // Одна порция - один chunk
+                std::string chunk;
+                for (const auto& rule : batch)
+                {
+                    json record = {
+                        {"shortId", rule.shortId},
+                        {"targetUrl", rule.targetUrl},
+                        {"condition", rule.condition}
+                    };
+                    WireFormat::appendRecord(chunk, record, format);
+                }
+
+                if (!write(chunk))
+                {
+                    std::cout << "[ExportRulesHandler] Client disconnected after "
+                              << exported << " rules" << std::endl;
+                    return;
+                }
+
+                exported += static_cast<long long>(batch.size());
+                cursor = batch.back().shortId;
+
+                if (static_cast<int>(batch.size()) < size)
+                {
+                    break;
+                }
+            }
+
+            std::cout << "[ExportRulesHandler] Exported " << exported << " rules" << std::endl;
+        });
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[ExportRulesHandler] Error: " << e.what() << std::endl;
+        res.setStatus(500);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Internal server error"})");
+    }
+}
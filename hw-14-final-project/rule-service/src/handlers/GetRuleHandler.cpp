@@ -1,4 +1,5 @@
 #include "handlers/GetRuleHandler.hpp"
+#include "WireFormat.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -46,16 +47,31 @@ void GetRuleHandler::handle(IRequest& req, IResponse& res)
             return;
         }
         
-        // Формируем JSON ответ
+        // Правило не изменилось с версии клиента - тело не нужно
+        if (!rule->version.empty())
+        {
+            std::string etag = "\"" + rule->version + "\"";
+            res.setHeader("ETag", etag);
+
+            if (matchesIfNoneMatch(req.getHeader("If-None-Match"), etag))
+            {
+                res.setStatus(304);
+                std::cout << "[GetRuleHandler] Rule not modified" << std::endl;
+                return;
+            }
+        }
+
+        // Формируем ответ в формате, который принимает клиент
         json response = {
             {"shortId", rule->shortId},
             {"targetUrl", rule->targetUrl},
             {"condition", rule->condition}
         };
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
         
         res.setStatus(200);
-        res.setHeader("Content-Type", "application/json");
-        res.setBody(response.dump());
+        res.setHeader("Content-Type", WireFormat::contentType(format));
+        res.setBody(WireFormat::encode(response, format));
         
         std::cout << "[GetRuleHandler] Rule found" << std::endl;
     }
@@ -88,4 +104,38 @@ std::string GetRuleHandler::extractShortId(const std::string& path) const
     }
     
     return shortId;
-}
\ No newline at end of file
+}
+
+bool GetRuleHandler::matchesIfNoneMatch(const std::string& ifNoneMatch, const std::string& etag)
+{
+    size_t pos = 0;
+    while (pos < ifNoneMatch.size())
+    {
+        size_t comma = ifNoneMatch.find(',', pos);
+        if (comma == std::string::npos)
+        {
+            comma = ifNoneMatch.size();
+        }
+
+        std::string candidate = ifNoneMatch.substr(pos, comma - pos);
+        size_t first = candidate.find_first_not_of(" \t");
+        size_t last = candidate.find_last_not_of(" \t");
+        if (first != std::string::npos)
+        {
+            candidate = candidate.substr(first, last - first + 1);
+
+            // Слабое сравнение: для GET префикс W/ не важен
+            if (candidate.rfind("W/", 0) == 0)
+            {
+                candidate = candidate.substr(2);
+            }
+            if (candidate == "*" || candidate == etag)
+            {
+                return true;
+            }
+        }
+
+        pos = comma + 1;
+    }
+    return false;
+}
@@ -1,6 +1,8 @@
 #include "handlers/ListRulesHandler.hpp"
+#include "WireFormat.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
+#include <stdexcept>
 
 using json = nlohmann::json;
 
@@ -25,12 +27,12 @@ void ListRulesHandler::handle(IRequest& req, IResponse& res)
         // Получаем параметры пагинации из query string
         auto params = req.getParams();
         
-        int page = 1;
+        std::string cursor;
         int pageSize = 10;
         
-        if (params.count("page"))
+        if (params.count("cursor"))
         {
-            page = std::stoi(params.at("page"));
+            cursor = params.at("cursor");
         }
         
         if (params.count("size"))
@@ -39,7 +41,7 @@ void ListRulesHandler::handle(IRequest& req, IResponse& res)
         }
         
         // Валидация параметров
-        if (page < 1 || pageSize < 1 || pageSize > 100)
+        if (pageSize < 1 || pageSize > 100)
         {
             res.setStatus(400);
             res.setHeader("Content-Type", "application/json");
@@ -47,10 +49,10 @@ void ListRulesHandler::handle(IRequest& req, IResponse& res)
             return;
         }
         
-        std::cout << "[ListRulesHandler] Fetching page=" << page << ", size=" << pageSize << std::endl;
+        std::cout << "[ListRulesHandler] Fetching cursor='" << cursor << "', size=" << pageSize << std::endl;
         
-        // Получаем список правил
-        auto result = ruleService_->findAll(page, pageSize);
+        // Получаем страницу правил
+        auto result = ruleService_->findPage(cursor, pageSize);
         
         // Формируем JSON ответ
         json rulesArray = json::array();
@@ -65,17 +67,32 @@ void ListRulesHandler::handle(IRequest& req, IResponse& res)
         
         json response = {
             {"rules", rulesArray},
-            {"totalCount", result.totalCount},
-            {"page", result.page},
-            {"pageSize", result.pageSize}
+            {"pageSize", result.pageSize},
+            {"nextCursor", result.nextCursor.empty() ? json(nullptr) : json(result.nextCursor)}
         };
         
+        // Общее количество - оценка, отдаём только если хранилище её знает
+        if (result.totalCount)
+        {
+            response["totalCount"] = *result.totalCount;
+        }
+        
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
+        
         res.setStatus(200);
-        res.setHeader("Content-Type", "application/json");
-        res.setBody(response.dump());
+        res.setHeader("Content-Type", WireFormat::contentType(format));
+        res.setBody(WireFormat::encode(response, format));
         
         std::cout << "[ListRulesHandler] Returned " << result.rules.size() << " rules" << std::endl;
     }
+    catch (const std::invalid_argument& e)
+    {
+        // Некорректный курсор или size
+        std::cerr << "[ListRulesHandler] Invalid request: " << e.what() << std::endl;
+        res.setStatus(400);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Invalid pagination parameters"})");
+    }
     catch (const std::exception& e)
     {
         std::cerr << "[ListRulesHandler] Error: " << e.what() << std::endl;
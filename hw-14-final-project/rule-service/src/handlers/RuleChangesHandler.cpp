@@ -0,0 +1,105 @@
+#include "handlers/RuleChangesHandler.hpp"
+#include "WireFormat.hpp"
+#include <nlohmann/json.hpp>
+#include <iostream>
+
+using json = nlohmann::json;
+
+/**
+ * @file RuleChangesHandler.cpp
+ * @brief Реализация обработчика подписки на изменения правил
+ * @author Anton Tobolkin
+ */
+
+namespace
+{
+    constexpr long long DEFAULT_TIMEOUT_MS = 25000;
+    constexpr long long MAX_TIMEOUT_MS = 60000;
+
+    bool isNumber(const std::string& s)
+    {
+        return !s.empty() && s.size() <= 18 &&
+               s.find_first_not_of("0123456789") == std::string::npos;
+    }
+}
+
+RuleChangesHandler::RuleChangesHandler(std::shared_ptr<IRuleChangeLog> changeLog)
+    : changeLog_(changeLog)
+{
+    std::cout << "[RuleChangesHandler] Handler created" << std::endl;
+}
+
+void RuleChangesHandler::handle(IRequest& req, IResponse& res)
+{
+    try
+    {
+        auto params = req.getParams();
+
+        std::string epoch = params.count("epoch") ? params.at("epoch") : "";
+        std::string since = params.count("since") ? params.at("since") : "0";
+        std::string timeout = params.count("timeout") ? params.at("timeout")
+                                                      : std::to_string(DEFAULT_TIMEOUT_MS);
+
+        if (!isNumber(since) || !isNumber(timeout) || std::stoll(timeout) > MAX_TIMEOUT_MS)
+        {
+            res.setStatus(400);
+            res.setHeader("Content-Type", "application/json");
+            res.setBody(R"({"error": "Invalid since or timeout"})");
+            return;
+        }
+
+        auto batch = changeLog_->since(epoch, std::stoull(since),
+                                       std::chrono::milliseconds(std::stoll(timeout)));
+
+        json changes = json::array();
+        for (const auto& change : batch.changes)
+        {
+            json item = {
+                {"version", change.version},
+                {"shortId", change.rule.shortId}
+            };
+            if (change.type == RuleChange::Type::Upsert)
+            {
+                item["op"] = "upsert";
+                item["targetUrl"] = change.rule.targetUrl;
+                item["condition"] = change.rule.condition;
+                if (!change.rule.version.empty())
+                {
+                    item["ruleVersion"] = change.rule.version;
+                }
+            }
+            else
+            {
+                item["op"] = "delete";
+            }
+            changes.push_back(item);
+        }
+
+        json response = {
+            {"epoch", batch.epoch},
+            {"version", batch.version},
+            {"reset", batch.reset},
+            {"changes", changes}
+        };
+
+        auto format = WireFormat::negotiate(req.getHeader("Accept"));
+
+        res.setStatus(200);
+        res.setHeader("Content-Type", WireFormat::contentType(format));
+        res.setBody(WireFormat::encode(response, format));
+
+        if (!batch.changes.empty() || batch.reset)
+        {
+            std::cout << "[RuleChangesHandler] Sent " << batch.changes.size()
+                      << " changes, version=" << batch.version
+                      << (batch.reset ? " (reset)" : "") << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[RuleChangesHandler] Error: " << e.what() << std::endl;
+        res.setStatus(500);
+        res.setHeader("Content-Type", "application/json");
+        res.setBody(R"({"error": "Internal server error"})");
+    }
+}
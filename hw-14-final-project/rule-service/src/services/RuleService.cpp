@@ -1,4 +1,5 @@
 #include "services/RuleService.hpp"
+#include <functional>
 #include <iostream>
 
 /**
@@ -7,8 +8,9 @@
  * @author Anton Tobolkin
  */
 
-RuleService::RuleService(std::shared_ptr<IRuleRepository> repository)
-    : repository_(repository)
+RuleService::RuleService(std::shared_ptr<IRuleRepository> repository,
+                         std::shared_ptr<IRuleChangeLog> changeLog)
+    : repository_(repository), changeLog_(changeLog)
 {
     std::cout << "[RuleService] Service created" << std::endl;
 }
@@ -16,7 +18,14 @@ RuleService::RuleService(std::shared_ptr<IRuleRepository> repository)
 bool RuleService::create(const Rule &rule)
 {
     std::cout << "[RuleService] Creating rule: " << rule.shortId << std::endl;
-    return repository_->create(rule);
+    std::lock_guard<std::mutex> lock(writeMutex(rule.shortId));
+    auto version = repository_->create(rule);
+    if (version)
+    {
+        // Версия из хранилища уходит подписчикам: по ней они спросят If-None-Match
+        changeLog_->append(RuleChange::Type::Upsert, Rule{rule.shortId, rule.targetUrl, rule.condition, *version});
+    }
+    return version.has_value();
 }
 
 std::optional<Rule> RuleService::findById(const std::string &shortId)
@@ -25,20 +34,49 @@ std::optional<Rule> RuleService::findById(const std::string &shortId)
     return repository_->findById(shortId);
 }
 
-PaginatedRules RuleService::findAll(int page, int pageSize)
+PaginatedRules RuleService::findPage(const std::string &afterCursor, int limit)
 {
-    std::cout << "[RuleService] Listing rules, page=" << page << ", size=" << pageSize << std::endl;
-    return repository_->findAll(page, pageSize);
+    std::cout << "[RuleService] Listing rules after cursor '" << afterCursor << "', size=" << limit << std::endl;
+    return repository_->findPage(afterCursor, limit);
+}
+
+std::vector<Rule> RuleService::findBatch(const std::string &afterShortId, int limit)
+{
+    std::cout << "[RuleService] Fetching batch after '" << afterShortId << "', limit=" << limit << std::endl;
+    return repository_->findBatch(afterShortId, limit);
+}
+
+std::vector<Rule> RuleService::findByIds(const std::vector<std::string> &shortIds)
+{
+    std::cout << "[RuleService] Finding " << shortIds.size() << " rules by id" << std::endl;
+    return repository_->findByIds(shortIds);
 }
 
 bool RuleService::update(const std::string &shortId, const Rule &rule)
 {
     std::cout << "[RuleService] Updating rule: " << shortId << std::endl;
-    return repository_->update(shortId, rule);
+    std::lock_guard<std::mutex> lock(writeMutex(shortId));
+    auto version = repository_->update(shortId, rule);
+    if (version)
+    {
+        changeLog_->append(RuleChange::Type::Upsert, Rule{shortId, rule.targetUrl, rule.condition, *version});
+    }
+    return version.has_value();
 }
 
 bool RuleService::deleteById(const std::string &shortId)
 {
     std::cout << "[RuleService] Deleting rule: " << shortId << std::endl;
-    return repository_->deleteById(shortId);
+    std::lock_guard<std::mutex> lock(writeMutex(shortId));
+    bool deleted = repository_->deleteById(shortId);
+    if (deleted)
+    {
+        changeLog_->append(RuleChange::Type::Delete, Rule{shortId, "", ""});
+    }
+    return deleted;
+}
+
+std::mutex &RuleService::writeMutex(const std::string &shortId)
+{
+    return writeStripes_[std::hash<std::string>{}(shortId) % WRITE_STRIPES];
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "adapters/AsyncCacheInvalidator.hpp"
+#include "settings/CacheInvalidatorSettings.hpp"
+#include "Environment.hpp"
+#include <thread>
+
+using ::testing::_;
+using ::testing::Return;
+
+class MockCacheInvalidator : public ICacheInvalidator {
+public:
+    MOCK_METHOD(bool, invalidate, (const std::string& shortId), (override));
+    MOCK_METHOD(bool, invalidateBatch, (const std::vector<std::string>& shortIds), (override));
+    MOCK_METHOD(bool, invalidateAll, (), (override));
+};
+
+namespace {
+std::shared_ptr<ICacheInvalidatorSettings> makeAsyncSettings(int coalesceMs) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("redirect_service.url", std::string("http://localhost:9000"));
+    env->setProperty("redirect_service.coalesce_ms", coalesceMs);
+    return std::make_shared<CacheInvalidatorSettings>(env);
+}
+}
+
+// Вызов не ждёт отправки
+TEST(AsyncCacheInvalidatorTest, ReturnsImmediately) {
+    auto delegate = std::make_shared<MockCacheInvalidator>();
+    EXPECT_CALL(*delegate, invalidate("promo")).WillOnce(Return(true));
+
+    AsyncCacheInvalidator inv(delegate, makeAsyncSettings(10000));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(inv.invalidate("promo"));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // Деструктор досылает накопленное, не дожидаясь окна
+}
+
+// Изменения за окно уходят одним пакетом без дублей
+TEST(AsyncCacheInvalidatorTest, CoalescesChangesIntoBatch) {
+    auto delegate = std::make_shared<MockCacheInvalidator>();
+    EXPECT_CALL(*delegate, invalidateBatch(std::vector<std::string>{"a", "b", "c"}))
+        .WillOnce(Return(true));
+
+    {
+        AsyncCacheInvalidator inv(delegate, makeAsyncSettings(50));
+        inv.invalidate("b");
+        inv.invalidate("a");
+        inv.invalidateBatch({"c", "a"});
+    }
+}
+
+// Полный сброс поглощает накопленные ключи
+TEST(AsyncCacheInvalidatorTest, InvalidateAllSupersedesKeys) {
+    auto delegate = std::make_shared<MockCacheInvalidator>();
+    EXPECT_CALL(*delegate, invalidateAll()).WillOnce(Return(true));
+    EXPECT_CALL(*delegate, invalidate(_)).Times(0);
+    EXPECT_CALL(*delegate, invalidateBatch(_)).Times(0);
+
+    {
+        AsyncCacheInvalidator inv(delegate, makeAsyncSettings(50));
+        inv.invalidate("a");
+        inv.invalidateAll();
+        inv.invalidate("b");
+    }
+}
+
+// После окна отправляется следующий пакет
+TEST(AsyncCacheInvalidatorTest, SendsSeparateBatchesAcrossWindows) {
+    auto delegate = std::make_shared<MockCacheInvalidator>();
+    EXPECT_CALL(*delegate, invalidate("first")).WillOnce(Return(true));
+    EXPECT_CALL(*delegate, invalidate("second")).WillOnce(Return(true));
+
+    AsyncCacheInvalidator inv(delegate, makeAsyncSettings(1));
+    inv.invalidate("first");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    inv.invalidate("second");
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "handlers/BatchGetRulesHandler.hpp"
+#include "IRequest.hpp"
+#include "IResponse.hpp"
+#include "ports/IRuleService.hpp"
+#include <nlohmann/json.hpp>
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+using ::testing::SaveArg;
+using ::testing::UnorderedElementsAre;
+
+// --- Моки ---
+
+class MockRequest : public IRequest
+{
+public:
+    MOCK_METHOD(std::string, getBody, (), (const, override));
+    MOCK_METHOD(std::string, getPath, (), (const, override));
+    MOCK_METHOD(std::string, getMethod, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getParams, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getHeaders, (), (const, override));
+    MOCK_METHOD(std::string, getIp, (), (const, override));
+    MOCK_METHOD(int, getPort, (), (const, override));
+};
+
+class MockResponse : public IResponse
+{
+public:
+    MOCK_METHOD(void, setStatus, (int), (override));
+    MOCK_METHOD(void, setBody, (const std::string &), (override));
+    MOCK_METHOD(void, setHeader, (const std::string &, const std::string &), (override));
+};
+
+class MockRuleService : public IRuleService {
+public:
+    MOCK_METHOD(bool, create, (const Rule& rule), (override));
+    MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
+    MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
+    MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
+};
+
+// --- Тесты ---
+
+TEST(BatchGetRulesHandlerTest, Handle_ReturnsFoundRules) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::vector<std::string> requested;
+    std::string body;
+
+    EXPECT_CALL(req, getBody()).WillOnce(Return(R"({"shortIds": ["promo", "docs", "missing"]})"));
+    EXPECT_CALL(*ruleService, findByIds(_))
+        .WillOnce(DoAll(SaveArg<0>(&requested), Return(std::vector<Rule>{
+            Rule{"promo", "https://promo", "", "3"},
+            Rule{"docs", "https://docs", "country == \"RU\""}})));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(_)).WillOnce(SaveArg<0>(&body));
+
+    BatchGetRulesHandler handler(ruleService);
+    handler.handle(req, res);
+
+    EXPECT_THAT(requested, UnorderedElementsAre("promo", "docs", "missing"));
+
+    auto response = nlohmann::json::parse(body);
+    ASSERT_EQ(response["rules"].size(), 2u);
+    EXPECT_EQ(response["rules"][0]["shortId"], "promo");
+    EXPECT_EQ(response["rules"][0]["version"], "3");
+    EXPECT_EQ(response["rules"][1]["targetUrl"], "https://docs");
+    EXPECT_FALSE(response["rules"][1].contains("version"));
+    EXPECT_TRUE(response["notModified"].empty());
+}
+
+// Правила с совпавшей версией возвращаются только списком notModified
+TEST(BatchGetRulesHandlerTest, Handle_ReportsNotModified) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::string body;
+
+    EXPECT_CALL(req, getBody()).WillOnce(Return(
+        R"({"shortIds": ["promo", "docs"], "ifNoneMatch": {"promo": "3", "docs": "1"}})"));
+    EXPECT_CALL(*ruleService, findByIds(_)).WillOnce(Return(std::vector<Rule>{
+        Rule{"promo", "https://promo", "", "3"},
+        Rule{"docs", "https://docs", "", "2"}}));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(_)).WillOnce(SaveArg<0>(&body));
+
+    BatchGetRulesHandler handler(ruleService);
+    handler.handle(req, res);
+
+    auto response = nlohmann::json::parse(body);
+    ASSERT_EQ(response["rules"].size(), 1u);
+    EXPECT_EQ(response["rules"][0]["shortId"], "docs");
+    ASSERT_EQ(response["notModified"].size(), 1u);
+    EXPECT_EQ(response["notModified"][0], "promo");
+}
+
+TEST(BatchGetRulesHandlerTest, Handle_RejectsInvalidRequest) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::string tooMany = R"({"shortIds": [)";
+    for (int i = 0; i < 101; ++i)
+    {
+        tooMany += (i ? ",\"" : "\"") + std::to_string(i) + "\"";
+    }
+    tooMany += "]}";
+
+    EXPECT_CALL(req, getBody())
+        .WillOnce(Return(R"({"keys": ["promo"]})"))
+        .WillOnce(Return(tooMany))
+        .WillOnce(Return("not json"));
+    EXPECT_CALL(*ruleService, findByIds(_)).Times(0);
+    EXPECT_CALL(res, setStatus(400)).Times(3);
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json")).Times(3);
+    EXPECT_CALL(res, setBody(R"({"error": "Missing required field: shortIds"})"));
+    EXPECT_CALL(res, setBody(R"({"error": "Too many shortIds"})"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid JSON"})"));
+
+    BatchGetRulesHandler handler(ruleService);
+    handler.handle(req, res);
+    handler.handle(req, res);
+    handler.handle(req, res);
+}
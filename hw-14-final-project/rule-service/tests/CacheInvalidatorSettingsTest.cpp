@@ -35,3 +35,43 @@ TEST(CacheInvalidatorSettingsTest, ThrowsIfMissingSetting) {
         std::runtime_error
     );
 }
+
+// ===== Тест 3: несколько реплик в redirect_service.urls =====
+
+TEST(CacheInvalidatorSettingsTest, ParsesReplicaList) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("redirect_service.urls", std::string("http://r1:8080, http://r2:8080,"));
+
+    CacheInvalidatorSettings settings(env);
+
+    EXPECT_EQ(settings.getRedirectServiceUrls(),
+              (std::vector<std::string>{"http://r1:8080", "http://r2:8080"}));
+    EXPECT_EQ(settings.getRedirectServiceUrl(), "http://r1:8080");
+}
+
+// ===== Тест 4: параметры рассылки по умолчанию =====
+
+TEST(CacheInvalidatorSettingsTest, UsesDefaultDeliverySettings) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("redirect_service.url", std::string("http://localhost:9000"));
+
+    CacheInvalidatorSettings settings(env);
+
+    EXPECT_EQ(settings.getCoalesceWindow(),
+              std::chrono::milliseconds(CacheInvalidatorSettings::DEFAULT_COALESCE_MS));
+    EXPECT_EQ(settings.getMaxRetries(), CacheInvalidatorSettings::DEFAULT_MAX_RETRIES);
+    EXPECT_EQ(settings.getRetryBackoff(),
+              std::chrono::milliseconds(CacheInvalidatorSettings::DEFAULT_RETRY_BACKOFF_MS));
+}
+
+// ===== Тест 5: адреса реплик разбираются заранее =====
+
+TEST(CacheInvalidatorSettingsTest, ParsesEndpointsSkippingInvalid) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("redirect_service.urls", std::string("http://r1:8080,http://bad-url,http://r2:9090"));
+
+    CacheInvalidatorSettings settings(env);
+
+    EXPECT_EQ(settings.getRedirectServiceEndpoints(),
+              (std::vector<HttpEndpoint>{{"r1", 8080}, {"r2", 9090}}));
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "adapters/CachingRuleRepository.hpp"
+#include "ports/IRuleRepository.hpp"
+#include <stdexcept>
+#include <thread>
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::Throw;
+
+class MockRuleRepository : public IRuleRepository {
+public:
+    MOCK_METHOD(std::optional<std::string>, create, (const Rule& rule), (override));
+    MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
+    MOCK_METHOD(std::optional<std::string>, update, (const std::string& shortId, const Rule& rule), (override));
+    MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
+};
+
+class StubRuleCacheSettings : public IRuleCacheSettings {
+public:
+    StubRuleCacheSettings(std::size_t capacity, std::chrono::milliseconds ttl)
+        : capacity_(capacity), ttl_(ttl) {}
+
+    std::size_t getCapacity() const override { return capacity_; }
+    std::chrono::milliseconds getTtl() const override { return ttl_; }
+
+private:
+    std::size_t capacity_;
+    std::chrono::milliseconds ttl_;
+};
+
+namespace {
+std::shared_ptr<IRuleCacheSettings> settings(std::size_t capacity,
+                                             std::chrono::milliseconds ttl = std::chrono::seconds(60))
+{
+    return std::make_shared<StubRuleCacheSettings>(capacity, ttl);
+}
+}
+
+// Повторное чтение обслуживается из памяти
+TEST(CachingRuleRepositoryTest, FindById_CachesHit)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    Rule rule{"promo", "https://example.com", "country == \"RU\""};
+    EXPECT_CALL(*repo, findById("promo")).Times(1).WillOnce(Return(rule));
+
+    EXPECT_EQ(cache.findById("promo"), rule);
+    EXPECT_EQ(cache.findById("promo"), rule);
+}
+
+// Отсутствие правила тоже запоминается
+TEST(CachingRuleRepositoryTest, FindById_CachesMiss)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    EXPECT_CALL(*repo, findById("missing")).Times(1).WillOnce(Return(std::nullopt));
+
+    EXPECT_FALSE(cache.findById("missing").has_value());
+    EXPECT_FALSE(cache.findById("missing").has_value());
+}
+
+// Ошибка хранилища пробрасывается и не запоминается как отсутствие правила
+TEST(CachingRuleRepositoryTest, FindById_DoesNotCacheErrors)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    Rule rule{"promo", "https://example.com", ""};
+    EXPECT_CALL(*repo, findById("promo"))
+        .WillOnce(Throw(std::runtime_error("connection lost")))
+        .WillOnce(Return(rule));
+
+    EXPECT_THROW(cache.findById("promo"), std::runtime_error);
+    EXPECT_EQ(cache.findById("promo"), rule);
+}
+
+// Устаревшая запись перечитывается
+TEST(CachingRuleRepositoryTest, FindById_ExpiresAfterTtl)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10, std::chrono::milliseconds(10)));
+
+    Rule rule{"promo", "https://example.com", "cond"};
+    EXPECT_CALL(*repo, findById("promo")).Times(2).WillRepeatedly(Return(rule));
+
+    cache.findById("promo");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    cache.findById("promo");
+}
+
+// При переполнении вытесняется давно не читанное правило
+TEST(CachingRuleRepositoryTest, FindById_EvictsLeastRecentlyUsed)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(2));
+
+    EXPECT_CALL(*repo, findById("a")).Times(1).WillOnce(Return(Rule{"a", "u", "c"}));
+    EXPECT_CALL(*repo, findById("b")).Times(2).WillRepeatedly(Return(Rule{"b", "u", "c"}));
+    EXPECT_CALL(*repo, findById("c")).Times(1).WillOnce(Return(Rule{"c", "u", "c"}));
+
+    cache.findById("a");
+    cache.findById("b");
+    cache.findById("a");   // "a" свежее, чем "b"
+    cache.findById("c");   // вытесняет "b"
+
+    EXPECT_EQ(cache.size(), 2u);
+    cache.findById("a");   // из кэша
+    cache.findById("b");   // снова из репозитория
+}
+
+// update сбрасывает запись, следующее чтение видит новое значение
+TEST(CachingRuleRepositoryTest, Update_InvalidatesEntry)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    Rule oldRule{"promo", "https://old.example.com", "cond"};
+    Rule newRule{"promo", "https://new.example.com", "cond"};
+
+    EXPECT_CALL(*repo, findById("promo"))
+        .WillOnce(Return(oldRule))
+        .WillOnce(Return(newRule));
+    EXPECT_CALL(*repo, update("promo", newRule)).WillOnce(Return(std::string("2")));
+
+    EXPECT_EQ(cache.findById("promo"), oldRule);
+    EXPECT_TRUE(cache.update("promo", newRule));
+    EXPECT_EQ(cache.findById("promo"), newRule);
+}
+
+// create сбрасывает запомненное отсутствие правила
+TEST(CachingRuleRepositoryTest, Create_InvalidatesNegativeEntry)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    Rule rule{"fresh", "https://example.com", "cond"};
+    EXPECT_CALL(*repo, findById("fresh"))
+        .WillOnce(Return(std::nullopt))
+        .WillOnce(Return(rule));
+    EXPECT_CALL(*repo, create(rule)).WillOnce(Return(std::string("1")));
+
+    EXPECT_FALSE(cache.findById("fresh").has_value());
+    EXPECT_TRUE(cache.create(rule));
+    EXPECT_EQ(cache.findById("fresh"), rule);
+}
+
+// deleteById сбрасывает запись
+TEST(CachingRuleRepositoryTest, Delete_InvalidatesEntry)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    EXPECT_CALL(*repo, findById("promo"))
+        .WillOnce(Return(Rule{"promo", "u", "c"}))
+        .WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*repo, deleteById("promo")).WillOnce(Return(true));
+
+    cache.findById("promo");
+    EXPECT_TRUE(cache.deleteById("promo"));
+    EXPECT_FALSE(cache.findById("promo").has_value());
+}
+
+// Списки не кэшируются
+// findByIds дочитывает одним запросом только промахи, отсутствие тоже запоминается
+TEST(CachingRuleRepositoryTest, FindByIds_LoadsOnlyMisses)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    Rule promo{"promo", "https://promo", ""};
+    Rule docs{"docs", "https://docs", ""};
+    EXPECT_CALL(*repo, findById("promo")).WillOnce(Return(promo));
+    EXPECT_CALL(*repo, findByIds(std::vector<std::string>{"docs", "missing"}))
+        .Times(1)
+        .WillOnce(Return(std::vector<Rule>{docs}));
+
+    cache.findById("promo");
+
+    auto first = cache.findByIds({"promo", "docs", "missing", "docs"});
+    ASSERT_EQ(first.size(), 2u);
+    EXPECT_EQ(first[0], promo);
+    EXPECT_EQ(first[1], docs);
+
+    // Всё уже в кэше, включая отсутствующее правило
+    auto second = cache.findByIds({"docs", "missing"});
+    ASSERT_EQ(second.size(), 1u);
+    EXPECT_EQ(second[0], docs);
+}
+
+TEST(CachingRuleRepositoryTest, FindPage_PassesThrough)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(10));
+
+    PaginatedRules page;
+    page.pageSize = 5;
+    EXPECT_CALL(*repo, findPage("", 5)).Times(2).WillRepeatedly(Return(page));
+
+    cache.findPage("", 5);
+    cache.findPage("", 5);
+}
+
+// Уменьшение ёмкости на лету вытесняет давно не читанные правила
+TEST(CachingRuleRepositoryTest, SetCapacity_EvictsLeastRecentlyUsed)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    CachingRuleRepository cache(repo, settings(3));
+
+    EXPECT_CALL(*repo, findById("a")).Times(2).WillRepeatedly(Return(Rule{"a", "u", "c"}));
+    EXPECT_CALL(*repo, findById("b")).Times(1).WillOnce(Return(Rule{"b", "u", "c"}));
+    EXPECT_CALL(*repo, findById("c")).Times(1).WillOnce(Return(Rule{"c", "u", "c"}));
+
+    cache.findById("a");
+    cache.findById("b");
+    cache.findById("c");
+
+    cache.setCapacity(2);
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.findById("b");   // из кэша
+    cache.findById("a");   // вытеснено, снова из репозитория
+}
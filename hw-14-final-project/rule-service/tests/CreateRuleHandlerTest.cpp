@@ -37,7 +37,9 @@ class MockRuleService : public IRuleService {
 public:
     MOCK_METHOD(bool, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
@@ -45,6 +47,7 @@ public:
 class MockCacheInvalidator : public ICacheInvalidator {
 public:
     MOCK_METHOD(bool, invalidate, (const std::string& shortId), (override));
+    MOCK_METHOD(bool, invalidateBatch, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, invalidateAll, (), (override));
 };
 
@@ -76,4 +79,21 @@ TEST(CreateRuleHandlerTest, Handle_CreatesRuleSuccessfully) {
     handler.handle(req, res);
 }
 
+// targetUrl с CR/LF отклоняется до обращения к сервису
+TEST(CreateRuleHandlerTest, Handle_TargetUrlWithControlCharacters) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    auto cacheInvalidator = std::make_shared<MockCacheInvalidator>();
+    MockRequest req;
+    MockResponse res;
+
+    std::string jsonBody = R"({"shortId": "rule-123", "targetUrl": "http://example.com\r\nSet-Cookie: a=b", "condition": "cond"})";
 
+    EXPECT_CALL(req, getBody()).WillOnce(Return(jsonBody));
+    EXPECT_CALL(*ruleService, create(_)).Times(0);
+    EXPECT_CALL(res, setStatus(400));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid targetUrl: control characters are not allowed"})"));
+
+    CreateRuleHandler handler(ruleService, cacheInvalidator);
+    handler.handle(req, res);
+}
@@ -37,7 +37,9 @@ class MockRuleService : public IRuleService {
 public:
     MOCK_METHOD(bool, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
@@ -46,6 +48,7 @@ public:
 class MockCacheInvalidator : public ICacheInvalidator {
 public:
     MOCK_METHOD(bool, invalidate, (const std::string& shortId), (override));
+    MOCK_METHOD(bool, invalidateBatch, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, invalidateAll, (), (override));
 };
 
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "handlers/ExportRulesHandler.hpp"
+#include "IRequest.hpp"
+#include "IResponse.hpp"
+#include "ports/IRuleService.hpp"
+#include "WireFormat.hpp"
+
+using ::testing::_;
+using ::testing::Return;
+
+// --- Моки ---
+
+class MockRequest : public IRequest
+{
+public:
+    MOCK_METHOD(std::string, getBody, (), (const, override));
+    MOCK_METHOD(std::string, getPath, (), (const, override));
+    MOCK_METHOD(std::string, getMethod, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getParams, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getHeaders, (), (const, override));
+    MOCK_METHOD(std::string, getIp, (), (const, override));
+    MOCK_METHOD(int, getPort, (), (const, override));
+};
+
+class MockResponse : public IResponse
+{
+public:
+    MOCK_METHOD(void, setStatus, (int), (override));
+    MOCK_METHOD(void, setBody, (const std::string &), (override));
+    MOCK_METHOD(void, setHeader, (const std::string &, const std::string &), (override));
+};
+
+// Как сетевой адаптер: генератор тела сохраняется и запускается позже
+class StreamingResponse : public MockResponse
+{
+public:
+    void setChunkedBody(ChunkProducer chunked) override
+    {
+        producer = std::move(chunked);
+    }
+
+    ChunkProducer producer;
+};
+
+class MockRuleService : public IRuleService {
+public:
+    MOCK_METHOD(bool, create, (const Rule& rule), (override));
+    MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
+    MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
+    MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
+};
+
+// --- Тесты ---
+
+TEST(ExportRulesHandlerTest, Handle_StreamsAllBatchesAsNdjson) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "2"}};
+
+    std::vector<Rule> first = {{"a", "https://a.com", "c1"}, {"b", "https://b.com", "c2"}};
+    std::vector<Rule> second = {{"c", "https://c.com", ""}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    // Курсор второй порции - последний shortId первой
+    EXPECT_CALL(*ruleService, findBatch("", 2)).WillOnce(Return(first));
+    EXPECT_CALL(*ruleService, findBatch("b", 2)).WillOnce(Return(second));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/x-ndjson"));
+    EXPECT_CALL(res, setBody(
+        "{\"condition\":\"c1\",\"shortId\":\"a\",\"targetUrl\":\"https://a.com\"}\n"
+        "{\"condition\":\"c2\",\"shortId\":\"b\",\"targetUrl\":\"https://b.com\"}\n"
+        "{\"condition\":\"\",\"shortId\":\"c\",\"targetUrl\":\"https://c.com\"}\n"));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// По Accept записи идут в MessagePack с varint-длиной
+TEST(ExportRulesHandlerTest, Handle_StreamsMessagePackWhenAccepted) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "2"}};
+    std::vector<Rule> rules = {{"a", "https://a.com", "c1"}};
+    std::string body;
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(req, getHeaders()).WillRepeatedly(Return(std::map<std::string, std::string>{
+        {"Accept", WireFormat::CLIENT_ACCEPT}}));
+    EXPECT_CALL(*ruleService, findBatch("", 2)).WillOnce(Return(rules));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/msgpack"));
+    EXPECT_CALL(res, setBody(_)).WillOnce(testing::SaveArg<0>(&body));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+
+    auto records = WireFormat::decodeRecords(body, WireFormat::Format::MessagePack);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0]["shortId"], "a");
+    EXPECT_EQ(records[0]["condition"], "c1");
+}
+
+TEST(ExportRulesHandlerTest, Handle_StopsOnEmptyBatch) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "1"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findBatch("", 1))
+        .WillOnce(Return(std::vector<Rule>{{"only", "https://only.com", ""}}));
+    EXPECT_CALL(*ruleService, findBatch("only", 1)).WillOnce(Return(std::vector<Rule>{}));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/x-ndjson"));
+    EXPECT_CALL(res, setBody(_));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// Страница выгрузки: с курсора after и не больше limit правил
+TEST(ExportRulesHandlerTest, Handle_ExportsPageAfterCursor) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "2"}, {"after", "b"}, {"limit", "3"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findBatch("b", 2))
+        .WillOnce(Return(std::vector<Rule>{{"c", "https://c.com", ""}, {"d", "https://d.com", ""}}));
+    EXPECT_CALL(*ruleService, findBatch("d", 1))
+        .WillOnce(Return(std::vector<Rule>{{"e", "https://e.com", ""}}));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/x-ndjson"));
+    EXPECT_CALL(res, setBody(_));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+TEST(ExportRulesHandlerTest, Handle_InvalidBatchSize) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "100000"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findBatch(_, _)).Times(0);
+    EXPECT_CALL(res, setStatus(400));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid batch size"})"));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// batch не число - 400, а не исключение std::stoi
+TEST(ExportRulesHandlerTest, Handle_NonNumericBatchSize) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "abc"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findBatch(_, _)).Times(0);
+    EXPECT_CALL(res, setStatus(400));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid batch size"})"));
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// Ошибка БД посреди выгрузки: 200 уже отправлен, генератор бросает исключение,
+// и сетевой адаптер обрывает поток без завершающего chunk
+TEST(ExportRulesHandlerTest, Handle_RepositoryErrorAbortsStream) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    StreamingResponse res;
+
+    std::map<std::string, std::string> params = {{"batch", "1"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findBatch("", 1))
+        .WillOnce(Return(std::vector<Rule>{{"a", "https://a.com", ""}}));
+    EXPECT_CALL(*ruleService, findBatch("a", 1))
+        .WillOnce(testing::Throw(std::runtime_error("db down")));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/x-ndjson"));
+    EXPECT_CALL(res, setStatus(500)).Times(0);
+    EXPECT_CALL(res, setBody(_)).Times(0);
+
+    ExportRulesHandler handler(ruleService);
+    handler.handle(req, res);
+
+    // Генератор запускается адаптером после отправки заголовков
+    ASSERT_TRUE(res.producer);
+    std::vector<std::string> sent;
+    EXPECT_THROW(res.producer([&sent](const std::string& chunk) {
+        sent.push_back(chunk);
+        return true;
+    }), std::runtime_error);
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0], "{\"condition\":\"\",\"shortId\":\"a\",\"targetUrl\":\"https://a.com\"}\n");
+}
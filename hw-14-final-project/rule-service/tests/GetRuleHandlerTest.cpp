@@ -5,6 +5,7 @@
 #include "IRequest.hpp"
 #include "IResponse.hpp"
 #include "ports/IRuleService.hpp"
+#include "WireFormat.hpp"
 
 using ::testing::_;
 using ::testing::Return;
@@ -35,7 +36,9 @@ class MockRuleService : public IRuleService {
 public:
     MOCK_METHOD(bool, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
@@ -92,3 +95,68 @@ TEST(GetRuleHandlerTest, Handle_InvalidShortId) {
     GetRuleHandler handler(ruleService);
     handler.handle(req, res);
 }
+
+// Версия правила отдаётся в ETag
+TEST(GetRuleHandlerTest, Handle_SetsETagFromVersion) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    Rule rule{"rule-123", "https://example.com", "cond", "42"};
+
+    EXPECT_CALL(req, getPath()).WillOnce(Return("/rules/rule-123"));
+    EXPECT_CALL(req, getHeaders()).WillRepeatedly(Return(std::map<std::string, std::string>{}));
+    EXPECT_CALL(*ruleService, findById("rule-123")).WillOnce(Return(std::make_optional(rule)));
+    EXPECT_CALL(res, setHeader("ETag", "\"42\""));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(_));
+
+    GetRuleHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// Совпавший If-None-Match - 304 без тела
+TEST(GetRuleHandlerTest, Handle_NotModifiedWhenETagMatches) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    Rule rule{"rule-123", "https://example.com", "cond", "42"};
+
+    EXPECT_CALL(req, getPath()).WillOnce(Return("/rules/rule-123"));
+    EXPECT_CALL(req, getHeaders()).WillRepeatedly(Return(std::map<std::string, std::string>{
+        {"If-None-Match", "\"41\", W/\"42\""}}));
+    EXPECT_CALL(*ruleService, findById("rule-123")).WillOnce(Return(std::make_optional(rule)));
+    EXPECT_CALL(res, setHeader("ETag", "\"42\""));
+    EXPECT_CALL(res, setStatus(304));
+    EXPECT_CALL(res, setBody(_)).Times(0);
+
+    GetRuleHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+// Клиент, принимающий MessagePack, получает его вместо JSON
+TEST(GetRuleHandlerTest, Handle_EncodesMessagePackWhenAccepted) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    Rule rule{"rule-123", "https://example.com", "cond"};
+    std::string body;
+
+    EXPECT_CALL(req, getPath()).WillOnce(Return("/rules/rule-123"));
+    EXPECT_CALL(req, getHeaders()).WillRepeatedly(Return(std::map<std::string, std::string>{
+        {"Accept", "application/msgpack"}}));
+    EXPECT_CALL(*ruleService, findById("rule-123")).WillOnce(Return(std::make_optional(rule)));
+    EXPECT_CALL(res, setStatus(200));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/msgpack"));
+    EXPECT_CALL(res, setBody(_)).WillOnce(testing::SaveArg<0>(&body));
+
+    GetRuleHandler handler(ruleService);
+    handler.handle(req, res);
+
+    auto decoded = WireFormat::decode(body, WireFormat::Format::MessagePack);
+    EXPECT_EQ(decoded["shortId"], "rule-123");
+    EXPECT_EQ(decoded["targetUrl"], "https://example.com");
+}
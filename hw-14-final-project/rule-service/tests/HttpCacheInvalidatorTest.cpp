@@ -6,6 +6,8 @@
 #include "Environment.hpp"
 #include "IRequest.hpp"
 #include "IResponse.hpp"
+#include <mutex>
+#include <set>
 
 using ::testing::_;
 using ::testing::Invoke;
@@ -21,9 +23,11 @@ public:
 
 // ===== ФАБРИКА окружения =====
 
-std::shared_ptr<ICacheInvalidatorSettings> makeSettings(const std::string& url) {
+std::shared_ptr<ICacheInvalidatorSettings> makeSettings(const std::string& url, int maxRetries = 0) {
     auto env = std::make_shared<Environment>();
     env->setProperty("redirect_service.url", url);
+    env->setProperty("redirect_service.max_retries", maxRetries);
+    env->setProperty("redirect_service.retry_backoff_ms", 1);
     return std::make_shared<CacheInvalidatorSettings>(env);
 }
 
@@ -99,7 +103,7 @@ TEST(HttpCacheInvalidatorTest, InvalidateAll_FailsWithNon204) {
     HttpCacheInvalidator inv(http, settings);
 
     EXPECT_CALL(*http, send(_, _))
-        .WillOnce(Invoke([](const IRequest& req, IResponse& res) {
+        .WillOnce(Invoke([](const IRequest&, IResponse& res) {
             res.setStatus(500);
             return true;
         }));
@@ -114,10 +118,101 @@ TEST(HttpCacheInvalidatorTest, InvalidateAll_FailsWithNon204) {
 TEST(HttpCacheInvalidatorTest, InvalidUrl_ReturnsFalse) {
     auto http = std::make_shared<MockHttpClient>();
 
-    // URL без порта → parseUrl() должно упасть → invalidate() вернуть false
+    // URL без порта отбрасывается настройками → invalidate() вернуть false
     auto settings = makeSettings("http://bad-url-value");
 
     HttpCacheInvalidator inv(http, settings);
 
     EXPECT_FALSE(inv.invalidate("promo"));
 }
+
+// ===================================================================
+// === ТЕСТ 6: повтор после сбоя отправки ============================
+// ===================================================================
+
+TEST(HttpCacheInvalidatorTest, Invalidate_RetriesAfterFailure) {
+    auto http = std::make_shared<MockHttpClient>();
+    auto settings = makeSettings("http://localhost:9000", 2);
+
+    HttpCacheInvalidator inv(http, settings);
+
+    EXPECT_CALL(*http, send(_, _))
+        .WillOnce(Return(false))
+        .WillOnce(Invoke([](const IRequest&, IResponse& res) {
+            res.setStatus(204);
+            return true;
+        }));
+
+    EXPECT_TRUE(inv.invalidate("promo"));
+}
+
+// ===================================================================
+// === ТЕСТ 7: ошибка клиента (4xx) не повторяется ===================
+// ===================================================================
+
+TEST(HttpCacheInvalidatorTest, Invalidate_DoesNotRetryClientError) {
+    auto http = std::make_shared<MockHttpClient>();
+    auto settings = makeSettings("http://localhost:9000", 3);
+
+    HttpCacheInvalidator inv(http, settings);
+
+    EXPECT_CALL(*http, send(_, _))
+        .WillOnce(Invoke([](const IRequest&, IResponse& res) {
+            res.setStatus(404);
+            return true;
+        }));
+
+    EXPECT_FALSE(inv.invalidate("promo"));
+}
+
+// ===================================================================
+// === ТЕСТ 8: пакет ключей уходит одним POST ========================
+// ===================================================================
+
+TEST(HttpCacheInvalidatorTest, InvalidateBatch_PostsKeys) {
+    auto http = std::make_shared<MockHttpClient>();
+    auto settings = makeSettings("http://localhost:9000");
+
+    HttpCacheInvalidator inv(http, settings);
+
+    EXPECT_CALL(*http, send(_, _))
+        .WillOnce(Invoke([](const IRequest& req, IResponse& res) {
+            EXPECT_EQ(req.getMethod(), "POST");
+            EXPECT_EQ(req.getPath(), "/cache/invalidate");
+            EXPECT_EQ(req.getBody(), R"({"keys":["a","b"]})");
+
+            res.setStatus(204);
+            return true;
+        }));
+
+    EXPECT_TRUE(inv.invalidateBatch({"a", "b"}));
+}
+
+// ===================================================================
+// === ТЕСТ 9: рассылка всем репликам ================================
+// ===================================================================
+
+TEST(HttpCacheInvalidatorTest, InvalidateAll_FansOutToReplicas) {
+    auto http = std::make_shared<MockHttpClient>();
+
+    auto env = std::make_shared<Environment>();
+    env->setProperty("redirect_service.urls", std::string("http://r1:8080, http://r2:8080"));
+    env->setProperty("redirect_service.max_retries", 0);
+    auto settings = std::make_shared<CacheInvalidatorSettings>(env);
+
+    HttpCacheInvalidator inv(http, settings);
+
+    std::mutex mutex;
+    std::set<std::string> hosts;
+    EXPECT_CALL(*http, send(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([&](const IRequest& req, IResponse& res) {
+            std::lock_guard<std::mutex> lock(mutex);
+            hosts.insert(req.getIp());
+            res.setStatus(204);
+            return true;
+        }));
+
+    EXPECT_TRUE(inv.invalidateAll());
+    EXPECT_EQ(hosts, (std::set<std::string>{"r1", "r2"}));
+}
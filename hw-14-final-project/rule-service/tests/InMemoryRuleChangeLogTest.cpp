@@ -0,0 +1,108 @@
+#include "adapters/InMemoryRuleChangeLog.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// Изменения выдаются после указанной версии по возрастанию
+TEST(InMemoryRuleChangeLogTest, ReturnsChangesAfterVersion)
+{
+    InMemoryRuleChangeLog log;
+    log.append(RuleChange::Type::Upsert, Rule{"a", "u", "c"});
+    log.append(RuleChange::Type::Upsert, Rule{"b", "u", "c"});
+    log.append(RuleChange::Type::Delete, Rule{"a", "", ""});
+
+    auto batch = log.since(log.epoch(), 1, 0ms);
+
+    EXPECT_FALSE(batch.reset);
+    EXPECT_EQ(batch.version, 3u);
+    ASSERT_EQ(batch.changes.size(), 2u);
+    EXPECT_EQ(batch.changes[0].version, 2u);
+    EXPECT_EQ(batch.changes[0].rule.shortId, "b");
+    EXPECT_EQ(batch.changes[1].type, RuleChange::Type::Delete);
+}
+
+// Первый запрос (без эпохи) и чужая эпоха требуют полного сброса
+TEST(InMemoryRuleChangeLogTest, UnknownEpochResets)
+{
+    InMemoryRuleChangeLog log;
+    log.append(RuleChange::Type::Upsert, Rule{"a", "u", "c"});
+
+    auto first = log.since("", 0, 0ms);
+    EXPECT_TRUE(first.reset);
+    EXPECT_EQ(first.epoch, log.epoch());
+    EXPECT_EQ(first.version, 1u);
+
+    auto stale = log.since("previous-run", 1, 0ms);
+    EXPECT_TRUE(stale.reset);
+}
+
+// Отставший сильнее ёмкости журнала подписчик получает сброс
+TEST(InMemoryRuleChangeLogTest, EvictedHistoryResets)
+{
+    InMemoryRuleChangeLog log(2);
+    for (int i = 0; i < 5; ++i)
+    {
+        log.append(RuleChange::Type::Upsert, Rule{"r" + std::to_string(i), "u", "c"});
+    }
+
+    EXPECT_TRUE(log.since(log.epoch(), 1, 0ms).reset);
+
+    auto recent = log.since(log.epoch(), 3, 0ms);
+    EXPECT_FALSE(recent.reset);
+    EXPECT_EQ(recent.changes.size(), 2u);
+}
+
+// Без новых изменений запрос ждёт до таймаута
+TEST(InMemoryRuleChangeLogTest, WaitsUntilTimeout)
+{
+    InMemoryRuleChangeLog log;
+
+    auto start = std::chrono::steady_clock::now();
+    auto batch = log.since(log.epoch(), 0, 30ms);
+
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 30ms);
+    EXPECT_FALSE(batch.reset);
+    EXPECT_TRUE(batch.changes.empty());
+}
+
+// Ожидающий подписчик просыпается при новом изменении
+TEST(InMemoryRuleChangeLogTest, WakesUpOnAppend)
+{
+    InMemoryRuleChangeLog log;
+
+    std::thread writer([&log] {
+        std::this_thread::sleep_for(20ms);
+        log.append(RuleChange::Type::Upsert, Rule{"fresh", "u", "c"});
+    });
+
+    auto batch = log.since(log.epoch(), 0, 5s);
+    writer.join();
+
+    ASSERT_EQ(batch.changes.size(), 1u);
+    EXPECT_EQ(batch.changes[0].rule.shortId, "fresh");
+}
+
+// Остановка сервиса отпускает ожидающих подписчиков сразу
+TEST(InMemoryRuleChangeLogTest, ShutdownReleasesWaiters)
+{
+    InMemoryRuleChangeLog log;
+
+    std::thread stopper([&log] {
+        std::this_thread::sleep_for(20ms);
+        log.shutdown();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto batch = log.since(log.epoch(), 0, 5s);
+    stopper.join();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+    EXPECT_FALSE(batch.reset);
+    EXPECT_TRUE(batch.changes.empty());
+
+    // После остановки новые запросы тоже не ждут
+    start = std::chrono::steady_clock::now();
+    log.since(log.epoch(), 0, 5s);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+}
@@ -1,5 +1,7 @@
 #include "adapters/InMemoryRuleRepository.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
 
 class InMemoryRuleRepositoryTest : public ::testing::Test
 {
@@ -20,7 +22,8 @@ protected:
 TEST_F(InMemoryRuleRepositoryTest, InitializationTest)
 {
     // Проверяем, что репозиторий создал все тестовые правила
-    auto page1 = repo->findAll(1, 100);
+    auto page1 = repo->findPage("", 100);
+    EXPECT_EQ(page1.rules.size(), 13u);
     EXPECT_EQ(page1.totalCount, 13);
 
     // Проверяем наличие конкретного правила
@@ -33,7 +36,7 @@ TEST_F(InMemoryRuleRepositoryTest, InitializationTest)
 TEST_F(InMemoryRuleRepositoryTest, CreateDuplicateRule)
 {
     Rule duplicate{"promo", "https://example.com/promo2", "country == \"US\""};
-    bool created = repo->create(duplicate);
+    bool created = repo->create(duplicate).has_value();
     EXPECT_FALSE(created);  // Дубликат не создаётся
 }
 
@@ -46,7 +49,7 @@ TEST_F(InMemoryRuleRepositoryTest, FindByIdNonExistent)
 TEST_F(InMemoryRuleRepositoryTest, UpdateRule)
 {
     Rule updated{"promo", "https://example.com/promo-updated", "country == \"RU\""};
-    bool updatedOk = repo->update("promo", updated);
+    bool updatedOk = repo->update("promo", updated).has_value();
     EXPECT_TRUE(updatedOk);
 
     auto ruleOpt = repo->findById("promo");
@@ -54,10 +57,25 @@ TEST_F(InMemoryRuleRepositoryTest, UpdateRule)
     EXPECT_EQ(ruleOpt->targetUrl, "https://example.com/promo-updated");
 }
 
+// Версия (для ETag) меняется при каждом обновлении
+TEST_F(InMemoryRuleRepositoryTest, UpdateChangesVersion)
+{
+    auto before = repo->findById("promo");
+    ASSERT_TRUE(before.has_value());
+    EXPECT_FALSE(before->version.empty());
+    EXPECT_EQ(repo->findById("promo")->version, before->version);
+
+    ASSERT_TRUE(repo->update("promo", Rule{"promo", "https://example.com/v2", ""}));
+
+    auto after = repo->findById("promo");
+    ASSERT_TRUE(after.has_value());
+    EXPECT_NE(after->version, before->version);
+}
+
 TEST_F(InMemoryRuleRepositoryTest, UpdateNonExistentRule)
 {
     Rule updated{"fake", "https://fake.com", "country == \"US\""};
-    bool updatedOk = repo->update("fake", updated);
+    bool updatedOk = repo->update("fake", updated).has_value();
     EXPECT_FALSE(updatedOk);
 }
 
@@ -78,16 +96,93 @@ TEST_F(InMemoryRuleRepositoryTest, DeleteNonExistentRule)
 
 TEST_F(InMemoryRuleRepositoryTest, PaginationTest)
 {
-    // Получаем первые 5 правил
-    auto page1 = repo->findAll(1, 5);
+    // Получаем первые 5 правил (новые первыми)
+    auto page1 = repo->findPage("", 5);
     EXPECT_EQ(page1.rules.size(), 5);
     EXPECT_EQ(page1.totalCount, 13);
+    EXPECT_EQ(page1.rules.front().shortId, "premium_app");
+    ASSERT_FALSE(page1.nextCursor.empty());
 
     // Следующая страница
-    auto page2 = repo->findAll(2, 5);
+    auto page2 = repo->findPage(page1.nextCursor, 5);
     EXPECT_EQ(page2.rules.size(), 5);
+    ASSERT_FALSE(page2.nextCursor.empty());
 
-    // Последняя страница (13 правил => 3-я страница 3 элемента)
-    auto page3 = repo->findAll(3, 5);
+    // Последняя страница (13 правил => 3-я страница 3 элемента, курсора нет)
+    auto page3 = repo->findPage(page2.nextCursor, 5);
     EXPECT_EQ(page3.rules.size(), 3);
+    EXPECT_EQ(page3.rules.back().shortId, "promo");
+    EXPECT_TRUE(page3.nextCursor.empty());
+}
+
+TEST_F(InMemoryRuleRepositoryTest, PaginationIsStableUnderChanges)
+{
+    auto page1 = repo->findPage("", 5);
+
+    // Новое правило и удаление уже выданного не сдвигают следующую страницу
+    repo->create(Rule{"fresh", "https://fresh.example.com", "country == \"RU\""});
+    repo->deleteById(page1.rules.front().shortId);
+
+    auto page2 = repo->findPage(page1.nextCursor, 5);
+    ASSERT_EQ(page2.rules.size(), 5u);
+    EXPECT_EQ(page2.rules.front().shortId, "edge_de");
+
+    // Обновление не меняет позицию правила в списке
+    repo->update("edge_de", Rule{"edge_de", "https://de.example.com/moved", "browser == \"edge\""});
+    auto again = repo->findPage(page1.nextCursor, 5);
+    EXPECT_EQ(again.rules.front().shortId, "edge_de");
+    EXPECT_EQ(again.rules.front().targetUrl, "https://de.example.com/moved");
+}
+
+TEST_F(InMemoryRuleRepositoryTest, InvalidCursorThrows)
+{
+    EXPECT_THROW(repo->findPage("abc", 5), std::invalid_argument);
+    EXPECT_THROW(repo->findPage("-1", 5), std::invalid_argument);
+}
+
+
+TEST_F(InMemoryRuleRepositoryTest, FindBatchKeysetPagination)
+{
+    // Проходим все правила порциями по 5 по ключевому курсору
+    std::vector<std::string> exported;
+    std::string cursor;
+    while (true)
+    {
+        auto batch = repo->findBatch(cursor, 5);
+        if (batch.empty())
+        {
+            break;
+        }
+        for (const auto& rule : batch)
+        {
+            exported.push_back(rule.shortId);
+        }
+        cursor = batch.back().shortId;
+    }
+
+    // Все 13 правил, без дублей и в порядке shortId
+    ASSERT_EQ(exported.size(), 13u);
+    EXPECT_TRUE(std::is_sorted(exported.begin(), exported.end()));
+    EXPECT_EQ(std::adjacent_find(exported.begin(), exported.end()), exported.end());
+}
+
+TEST_F(InMemoryRuleRepositoryTest, FindBatchStartsAfterCursor)
+{
+    auto batch = repo->findBatch("promo", 100);
+
+    ASSERT_FALSE(batch.empty());
+    for (const auto& rule : batch)
+    {
+        EXPECT_GT(rule.shortId, "promo");
+    }
+}
+
+TEST_F(InMemoryRuleRepositoryTest, FindByIdsSkipsMissingAndDuplicates)
+{
+    auto rules = repo->findByIds({"docs", "nonexistent", "promo", "docs"});
+
+    ASSERT_EQ(rules.size(), 2u);
+    EXPECT_EQ(rules[0].shortId, "docs");
+    EXPECT_EQ(rules[1].shortId, "promo");
+    EXPECT_TRUE(repo->findByIds({}).empty());
 }
@@ -34,6 +34,7 @@ public:
 class MockCacheInvalidator : public ICacheInvalidator {
 public:
     MOCK_METHOD(bool, invalidate, (const std::string& shortId), (override));
+    MOCK_METHOD(bool, invalidateBatch, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, invalidateAll, (), (override));
 };
 
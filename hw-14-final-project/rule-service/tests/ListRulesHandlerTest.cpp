@@ -5,9 +5,12 @@
 #include "IRequest.hpp"
 #include "IResponse.hpp"
 #include "ports/IRuleService.hpp"
+#include <nlohmann/json.hpp>
+#include <stdexcept>
 
 using ::testing::_;
 using ::testing::Return;
+using ::testing::SaveArg;
 
 // --- Моки ---
 
@@ -35,7 +38,9 @@ class MockRuleService : public IRuleService {
 public:
     MOCK_METHOD(bool, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
@@ -47,25 +52,32 @@ TEST(ListRulesHandlerTest, Handle_ReturnsPaginatedRulesSuccessfully) {
     MockRequest req;
     MockResponse res;
 
-    std::map<std::string, std::string> params = {{"page", "2"}, {"size", "5"}};
+    std::map<std::string, std::string> params = {{"cursor", "1700000000000000.7"}, {"size", "2"}};
 
     PaginatedRules result;
-    result.page = 2;
-    result.pageSize = 5;
+    result.pageSize = 2;
+    result.nextCursor = "1700000000000000.5";
     result.totalCount = 12;
     result.rules = {
         {"rule-6", "https://url6.com", "cond6"},
-        {"rule-7", "https://url7.com", "cond7"}
+        {"rule-5", "https://url5.com", "cond5"}
     };
 
+    std::string body;
     EXPECT_CALL(req, getParams()).WillOnce(Return(params));
-    EXPECT_CALL(*ruleService, findAll(2, 5)).WillOnce(Return(result));
+    EXPECT_CALL(*ruleService, findPage("1700000000000000.7", 2)).WillOnce(Return(result));
     EXPECT_CALL(res, setStatus(200));
     EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
-    EXPECT_CALL(res, setBody(_));
+    EXPECT_CALL(res, setBody(_)).WillOnce(SaveArg<0>(&body));
 
     ListRulesHandler handler(ruleService);
     handler.handle(req, res);
+
+    auto json = nlohmann::json::parse(body);
+    EXPECT_EQ(json["rules"].size(), 2u);
+    EXPECT_EQ(json["nextCursor"], "1700000000000000.5");
+    EXPECT_EQ(json["totalCount"], 12);
+    EXPECT_EQ(json["pageSize"], 2);
 }
 
 TEST(ListRulesHandlerTest, Handle_UsesDefaultPaginationWhenParamsMissing) {
@@ -76,19 +88,23 @@ TEST(ListRulesHandlerTest, Handle_UsesDefaultPaginationWhenParamsMissing) {
     std::map<std::string, std::string> params;  // пустой map
 
     PaginatedRules result;
-    result.page = 1;
     result.pageSize = 10;
-    result.totalCount = 0;
     result.rules = {};
 
+    std::string body;
     EXPECT_CALL(req, getParams()).WillOnce(Return(params));
-    EXPECT_CALL(*ruleService, findAll(1, 10)).WillOnce(Return(result));
+    EXPECT_CALL(*ruleService, findPage("", 10)).WillOnce(Return(result));
     EXPECT_CALL(res, setStatus(200));
     EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
-    EXPECT_CALL(res, setBody(_));
+    EXPECT_CALL(res, setBody(_)).WillOnce(SaveArg<0>(&body));
 
     ListRulesHandler handler(ruleService);
     handler.handle(req, res);
+
+    // Последняя страница: курсора нет, оценка количества не передаётся
+    auto json = nlohmann::json::parse(body);
+    EXPECT_TRUE(json["nextCursor"].is_null());
+    EXPECT_FALSE(json.contains("totalCount"));
 }
 
 TEST(ListRulesHandlerTest, Handle_InvalidPaginationParameters) {
@@ -96,9 +112,27 @@ TEST(ListRulesHandlerTest, Handle_InvalidPaginationParameters) {
     MockRequest req;
     MockResponse res;
 
-    std::map<std::string, std::string> params = {{"page", "0"}, {"size", "101"}};
+    std::map<std::string, std::string> params = {{"size", "101"}};
+
+    EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(res, setStatus(400));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid pagination parameters"})"));
+
+    ListRulesHandler handler(ruleService);
+    handler.handle(req, res);
+}
+
+TEST(ListRulesHandlerTest, Handle_InvalidCursor) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    MockRequest req;
+    MockResponse res;
+
+    std::map<std::string, std::string> params = {{"cursor", "garbage"}};
 
     EXPECT_CALL(req, getParams()).WillOnce(Return(params));
+    EXPECT_CALL(*ruleService, findPage("garbage", 10))
+        .WillOnce(::testing::Throw(std::invalid_argument("Invalid cursor")));
     EXPECT_CALL(res, setStatus(400));
     EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
     EXPECT_CALL(res, setBody(R"({"error": "Invalid pagination parameters"})"));
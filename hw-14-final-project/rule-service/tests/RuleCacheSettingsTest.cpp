@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "settings/RuleCacheSettings.hpp"
+#include "Environment.hpp"
+
+// ===== Тест 1: значения по умолчанию =====
+
+TEST(RuleCacheSettingsTest, UsesDefaults) {
+    auto env = std::make_shared<Environment>();
+
+    RuleCacheSettings settings(env);
+
+    EXPECT_EQ(settings.getCapacity(), static_cast<std::size_t>(RuleCacheSettings::DEFAULT_CAPACITY));
+    EXPECT_EQ(settings.getTtl(), std::chrono::milliseconds(RuleCacheSettings::DEFAULT_TTL_MS));
+}
+
+// ===== Тест 2: значения из rule_cache.* =====
+
+TEST(RuleCacheSettingsTest, LoadsFromEnvironment) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("rule_cache.capacity", 500);
+    env->setProperty("rule_cache.ttl_ms", 2000);
+
+    RuleCacheSettings settings(env);
+
+    EXPECT_EQ(settings.getCapacity(), 500u);
+    EXPECT_EQ(settings.getTtl(), std::chrono::milliseconds(2000));
+}
+
+// ===== Тест 3: неположительные значения запрещены =====
+
+TEST(RuleCacheSettingsTest, ThrowsOnNonPositiveValues) {
+    auto env = std::make_shared<Environment>();
+    env->setProperty("rule_cache.capacity", 0);
+
+    EXPECT_THROW(RuleCacheSettings settings(env), std::runtime_error);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "handlers/RuleChangesHandler.hpp"
+#include "adapters/InMemoryRuleChangeLog.hpp"
+#include "IRequest.hpp"
+#include "SimpleResponse.hpp"
+#include <nlohmann/json.hpp>
+
+using ::testing::Return;
+using json = nlohmann::json;
+
+class MockRequest : public IRequest
+{
+public:
+    MOCK_METHOD(std::string, getBody, (), (const, override));
+    MOCK_METHOD(std::string, getPath, (), (const, override));
+    MOCK_METHOD(std::string, getMethod, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getParams, (), (const, override));
+    MOCK_METHOD((std::map<std::string, std::string>), getHeaders, (), (const, override));
+    MOCK_METHOD(std::string, getIp, (), (const, override));
+    MOCK_METHOD(int, getPort, (), (const, override));
+};
+
+namespace {
+void withParams(MockRequest& req, const std::map<std::string, std::string>& params)
+{
+    EXPECT_CALL(req, getParams()).WillRepeatedly(Return(params));
+}
+}
+
+// Первый запрос получает эпоху и сигнал полного сброса
+TEST(RuleChangesHandlerTest, FirstRequestResets)
+{
+    auto log = std::make_shared<InMemoryRuleChangeLog>();
+    log->append(RuleChange::Type::Upsert, Rule{"promo", "https://example.com", "cond"});
+    RuleChangesHandler handler(log);
+
+    MockRequest req;
+    withParams(req, {{"timeout", "0"}});
+    SimpleResponse res;
+    handler.handle(req, res);
+
+    ASSERT_EQ(res.getStatus(), 200);
+    auto body = json::parse(res.getBody());
+    EXPECT_EQ(body["epoch"], log->epoch());
+    EXPECT_EQ(body["version"], 1);
+    EXPECT_TRUE(body["reset"].get<bool>());
+    EXPECT_TRUE(body["changes"].empty());
+}
+
+// Изменения отдаются с операцией и новым состоянием правила
+TEST(RuleChangesHandlerTest, ReturnsChangesSinceVersion)
+{
+    auto log = std::make_shared<InMemoryRuleChangeLog>();
+    log->append(RuleChange::Type::Upsert, Rule{"promo", "https://example.com", "cond", "17"});
+    log->append(RuleChange::Type::Delete, Rule{"old", "", ""});
+    RuleChangesHandler handler(log);
+
+    MockRequest req;
+    withParams(req, {{"epoch", log->epoch()}, {"since", "0"}, {"timeout", "0"}});
+    SimpleResponse res;
+    handler.handle(req, res);
+
+    ASSERT_EQ(res.getStatus(), 200);
+    auto body = json::parse(res.getBody());
+    EXPECT_FALSE(body["reset"].get<bool>());
+    ASSERT_EQ(body["changes"].size(), 2u);
+    EXPECT_EQ(body["changes"][0]["op"], "upsert");
+    EXPECT_EQ(body["changes"][0]["targetUrl"], "https://example.com");
+    EXPECT_EQ(body["changes"][0]["ruleVersion"], "17");
+    EXPECT_EQ(body["changes"][1]["op"], "delete");
+    EXPECT_EQ(body["changes"][1]["shortId"], "old");
+}
+
+// Некорректные параметры
+TEST(RuleChangesHandlerTest, InvalidParams)
+{
+    auto log = std::make_shared<InMemoryRuleChangeLog>();
+    RuleChangesHandler handler(log);
+
+    MockRequest req;
+    withParams(req, {{"since", "abc"}});
+    SimpleResponse res;
+    handler.handle(req, res);
+    EXPECT_EQ(res.getStatus(), 400);
+
+    MockRequest longReq;
+    withParams(longReq, {{"timeout", "600000"}});
+    SimpleResponse longRes;
+    handler.handle(longReq, longRes);
+    EXPECT_EQ(longRes.getStatus(), 400);
+}
@@ -3,6 +3,12 @@
 
 #include "services/RuleService.hpp"
 #include "ports/IRuleRepository.hpp"
+#include "adapters/InMemoryRuleChangeLog.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using ::testing::_;
 using ::testing::Return;
@@ -10,22 +16,25 @@ using ::testing::Invoke;
 
 class MockRuleRepository : public IRuleRepository {
 public:
-    MOCK_METHOD(bool, create, (const Rule& rule), (override));
+    MOCK_METHOD(std::optional<std::string>, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
-    MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
+    MOCK_METHOD(std::optional<std::string>, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
 
 TEST(RuleServiceTest, Create_DelegatesToRepository)
 {
     auto repo = std::make_shared<MockRuleRepository>();
-    RuleService service(repo);
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
 
     Rule rule{"promo", "https://ya.ru", "cond"};
 
     EXPECT_CALL(*repo, create(rule))
-        .WillOnce(Return(true));
+        .WillOnce(Return(std::string("1")));
 
     bool result = service.create(rule);
 
@@ -35,7 +44,8 @@ TEST(RuleServiceTest, Create_DelegatesToRepository)
 TEST(RuleServiceTest, FindById_DelegatesToRepository)
 {
     auto repo = std::make_shared<MockRuleRepository>();
-    RuleService service(repo);
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
 
     Rule expected{"promo", "https://target", "cond"};
 
@@ -50,40 +60,79 @@ TEST(RuleServiceTest, FindById_DelegatesToRepository)
     EXPECT_EQ(result->condition, "cond");
 }
 
-TEST(RuleServiceTest, FindAll_DelegatesToRepository)
+TEST(RuleServiceTest, FindPage_DelegatesToRepository)
 {
     auto repo = std::make_shared<MockRuleRepository>();
-    RuleService service(repo);
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
 
     PaginatedRules paginated;
-    paginated.page = 2;
     paginated.pageSize = 5;
+    paginated.nextCursor = "1700000000000000.42";
     paginated.totalCount = 100;
     paginated.rules = {
         {"id1", "u1", "c1"},
         {"id2", "u2", "c2"}
     };
 
-    EXPECT_CALL(*repo, findAll(2, 5))
+    EXPECT_CALL(*repo, findPage("1700000000000000.50", 5))
         .WillOnce(Return(paginated));
 
-    auto result = service.findAll(2, 5);
+    auto result = service.findPage("1700000000000000.50", 5);
 
-    EXPECT_EQ(result.page, 2);
     EXPECT_EQ(result.pageSize, 5);
+    EXPECT_EQ(result.nextCursor, "1700000000000000.42");
     EXPECT_EQ(result.totalCount, 100);
     ASSERT_EQ(result.rules.size(), 2);
 }
 
+TEST(RuleServiceTest, FindBatch_DelegatesToRepository)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
+
+    std::vector<Rule> batch = {
+        {"id3", "u3", "c3"},
+        {"id4", "u4", "c4"}
+    };
+
+    EXPECT_CALL(*repo, findBatch("id2", 2))
+        .WillOnce(Return(batch));
+
+    auto result = service.findBatch("id2", 2);
+
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].shortId, "id3");
+}
+
+TEST(RuleServiceTest, FindByIds_DelegatesToRepository)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
+
+    std::vector<std::string> ids = {"id1", "missing"};
+    std::vector<Rule> found = {{"id1", "u1", "c1"}};
+
+    EXPECT_CALL(*repo, findByIds(ids))
+        .WillOnce(Return(found));
+
+    auto result = service.findByIds(ids);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].shortId, "id1");
+}
+
 TEST(RuleServiceTest, Update_DelegatesToRepository)
 {
     auto repo = std::make_shared<MockRuleRepository>();
-    RuleService service(repo);
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
 
     Rule rule{"promo", "url", "cond"};
 
     EXPECT_CALL(*repo, update("promo", rule))
-        .WillOnce(Return(true));
+        .WillOnce(Return(std::string("2")));
 
     bool ok = service.update("promo", rule);
 
@@ -93,7 +142,8 @@ TEST(RuleServiceTest, Update_DelegatesToRepository)
 TEST(RuleServiceTest, DeleteById_DelegatesToRepository)
 {
     auto repo = std::make_shared<MockRuleRepository>();
-    RuleService service(repo);
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
 
     EXPECT_CALL(*repo, deleteById("promo"))
         .WillOnce(Return(true));
@@ -102,3 +152,123 @@ TEST(RuleServiceTest, DeleteById_DelegatesToRepository)
 
     EXPECT_TRUE(ok);
 }
+
+TEST(RuleServiceTest, Writes_AppendToChangeLog)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
+
+    Rule rule{"promo", "url", "cond"};
+
+    EXPECT_CALL(*repo, create(rule)).WillOnce(Return(std::string("1")));
+    EXPECT_CALL(*repo, update("promo", rule)).WillOnce(Return(std::string("2")));
+    EXPECT_CALL(*repo, deleteById("promo")).WillOnce(Return(true));
+    EXPECT_CALL(*repo, deleteById("missing")).WillOnce(Return(false));
+
+    service.create(rule);
+    service.update("promo", rule);
+    service.deleteById("promo");
+    service.deleteById("missing");   // неуспешная запись в журнал не попадает
+
+    auto batch = changeLog->since(changeLog->epoch(), 0, std::chrono::milliseconds(0));
+    ASSERT_EQ(batch.changes.size(), 3u);
+    EXPECT_EQ(batch.changes[0].type, RuleChange::Type::Upsert);
+    EXPECT_EQ(batch.changes[1].type, RuleChange::Type::Upsert);
+    EXPECT_EQ(batch.changes[2].type, RuleChange::Type::Delete);
+    EXPECT_EQ(batch.changes[2].rule.shortId, "promo");
+    EXPECT_EQ(batch.version, 3u);
+
+    // Upsert несёт версию правила из хранилища
+    EXPECT_EQ(batch.changes[0].rule.version, "1");
+    EXPECT_EQ(batch.changes[1].rule.version, "2");
+}
+
+// Конкурентные записи попадают в журнал в том же порядке, что и в хранилище
+TEST(RuleServiceTest, Writes_AppendInRepositoryOrder)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
+
+    std::mutex orderMutex;
+    std::vector<std::string> written;
+    std::atomic<int> inside{0};
+    std::atomic<int> maxInside{0};
+
+    EXPECT_CALL(*repo, update(_, _)).WillRepeatedly(Invoke([&](const std::string&, const Rule& rule) {
+        int now = ++inside;
+        maxInside = std::max(maxInside.load(), now);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            written.push_back(rule.targetUrl);
+        }
+        --inside;
+        return std::optional<std::string>(rule.targetUrl);
+    }));
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t)
+    {
+        writers.emplace_back([&service, t] {
+            for (int i = 0; i < 10; ++i)
+            {
+                service.update("promo", Rule{"promo", "url-" + std::to_string(t) + "-" + std::to_string(i), ""});
+            }
+        });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    auto batch = changeLog->since(changeLog->epoch(), 0, std::chrono::milliseconds(0));
+    ASSERT_EQ(batch.changes.size(), written.size());
+    for (std::size_t i = 0; i < written.size(); ++i)
+    {
+        EXPECT_EQ(batch.changes[i].rule.targetUrl, written[i]);
+    }
+    EXPECT_EQ(maxInside.load(), 1);
+}
+
+// Записи разных правил не ждут друг друга
+TEST(RuleServiceTest, Writes_DifferentRulesRunConcurrently)
+{
+    auto repo = std::make_shared<MockRuleRepository>();
+    auto changeLog = std::make_shared<InMemoryRuleChangeLog>();
+    RuleService service(repo, changeLog);
+
+    // Второй ключ из другой полосы блокировок
+    std::string other = "other";
+    auto stripe = [](const std::string& key) { return std::hash<std::string>{}(key) % RuleService::WRITE_STRIPES; };
+    while (stripe(other) == stripe("promo"))
+    {
+        other += "_";
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int inside = 0;
+    bool overlapped = false;
+
+    EXPECT_CALL(*repo, update(_, _)).WillRepeatedly(Invoke([&](const std::string&, const Rule&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++inside;
+        cv.notify_all();
+        // Ждём вторую запись внутри хранилища; при общей блокировке её не будет
+        if (cv.wait_for(lock, std::chrono::seconds(2), [&] { return inside == 2; }))
+        {
+            overlapped = true;
+        }
+        return std::optional<std::string>("1");
+    }));
+
+    std::thread first([&] { service.update("promo", Rule{"promo", "url", ""}); });
+    std::thread second([&] { service.update(other, Rule{other, "url", ""}); });
+    first.join();
+    second.join();
+
+    EXPECT_TRUE(overlapped);
+    EXPECT_EQ(changeLog->since(changeLog->epoch(), 0, std::chrono::milliseconds(0)).changes.size(), 2u);
+}
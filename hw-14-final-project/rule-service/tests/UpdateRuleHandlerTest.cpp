@@ -36,7 +36,9 @@ class MockRuleService : public IRuleService {
 public:
     MOCK_METHOD(bool, create, (const Rule& rule), (override));
     MOCK_METHOD(std::optional<Rule>, findById, (const std::string& shortId), (override));
-    MOCK_METHOD(PaginatedRules, findAll, (int page, int pageSize), (override));
+    MOCK_METHOD(PaginatedRules, findPage, (const std::string& afterCursor, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findBatch, (const std::string& afterShortId, int limit), (override));
+    MOCK_METHOD(std::vector<Rule>, findByIds, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, update, (const std::string& shortId, const Rule& rule), (override));
     MOCK_METHOD(bool, deleteById, (const std::string& shortId), (override));
 };
@@ -44,6 +46,7 @@ public:
 class MockCacheInvalidator : public ICacheInvalidator {
 public:
     MOCK_METHOD(bool, invalidate, (const std::string& shortId), (override));
+    MOCK_METHOD(bool, invalidateBatch, (const std::vector<std::string>& shortIds), (override));
     MOCK_METHOD(bool, invalidateAll, (), (override));
 };
 
@@ -144,3 +147,23 @@ TEST(UpdateRuleHandlerTest, Handle_InvalidJSON) {
     UpdateRuleHandler handler(ruleService, cacheInvalidator);
     handler.handle(req, res);
 }
+
+// targetUrl с CR/LF отклоняется до обращения к сервису
+TEST(UpdateRuleHandlerTest, Handle_TargetUrlWithControlCharacters) {
+    auto ruleService = std::make_shared<MockRuleService>();
+    auto cacheInvalidator = std::make_shared<MockCacheInvalidator>();
+    MockRequest req;
+    MockResponse res;
+
+    std::string jsonBody = R"({"targetUrl": "http://example.com\r\nSet-Cookie: a=b", "condition": "cond"})";
+
+    EXPECT_CALL(req, getPath()).WillOnce(Return("/rules/rule-123"));
+    EXPECT_CALL(req, getBody()).WillOnce(Return(jsonBody));
+    EXPECT_CALL(*ruleService, update(_, _)).Times(0);
+    EXPECT_CALL(res, setStatus(400));
+    EXPECT_CALL(res, setHeader("Content-Type", "application/json"));
+    EXPECT_CALL(res, setBody(R"({"error": "Invalid targetUrl: control characters are not allowed"})"));
+
+    UpdateRuleHandler handler(ruleService, cacheInvalidator);
+    handler.handle(req, res);
+}